@@ -42,7 +42,8 @@ namespace Imagine::Runtime {
 
 
 		Math::ChaikinCurves<> m_ChaikinCurves{};
-		LineObject m_Line{};
+		std::vector<Vertex> m_Line{};
+		DrawContext m_DrawContext;
 
 
 		std::filesystem::path m_ModelPath{"EngineAssets/Models/Box.glb"};
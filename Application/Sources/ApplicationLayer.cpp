@@ -39,12 +39,12 @@ namespace Imagine::Runtime {
 		*m_Mesh = CPUMesh::LoadExternalModelAsMesh("EngineAssets/Models/Box.glb");
 
 		m_OriginalMeshEntityID = SceneManager::GetMainScene()->CreateEntity();
-		SceneManager::GetMainScene()->GetEntity(m_OriginalMeshEntityID).LocalPosition = {-1, 0, 0};
+		SceneManager::GetMainScene()->SetLocalPosition(m_OriginalMeshEntityID, {-1, 0, 0});
 
 		m_Mesh->gpu = m_Renderer->LoadMesh(*m_Mesh);
 
 		m_LoopMeshEntityID = SceneManager::GetMainScene()->CreateEntity();
-		SceneManager::GetMainScene()->GetEntity(m_LoopMeshEntityID).LocalPosition = {1, 0, 0};
+		SceneManager::GetMainScene()->SetLocalPosition(m_LoopMeshEntityID, {1, 0, 0});
 
 		m_MeshGraph->Clear();
 		m_MeshGraph->AddMesh(*m_Mesh);
@@ -76,21 +76,20 @@ namespace Imagine::Runtime {
 	}
 
 	void ApplicationLayer::OnRender(DrawContext &ctx) {
-		LineObject line;
-		if (!m_ChaikinCurves.line.empty()) {
-			line.points.clear();
-			line.points.reserve(m_ChaikinCurves.line.size() + 1);
+		ctx.AddLineStrip(m_Line);
+
+		// The control points are drawn as a closed loop.
+		const uint32_t count = static_cast<uint32_t>(m_ChaikinCurves.line.size());
+		if (count > 1) {
+			const uint32_t first = ctx.LineVertices.size();
 			for (const auto &p: m_ChaikinCurves.line) {
-				Vertex v{};
-				v.position = p;
-				v.color = {0.2, 0.3, 0.8, 1.0};
-				line.points.push_back(v);
+				ctx.LineVertices.push_back(Vertex::PC(p, {0.2, 0.3, 0.8, 1.0}));
+			}
+			for (uint32_t i = 0; i < count; ++i) {
+				ctx.LineIndices.push_back(first + i);
+				ctx.LineIndices.push_back(first + (i + 1) % count);
 			}
-			line.points.push_back(line.points.front());
 		}
-
-		if (m_Line.points.size() > 1) ctx.OpaqueLines.push_back(m_Line);
-		if (line.points.size() > 1) ctx.OpaqueLines.push_back(line);
 	}
 
 	void ApplicationLayer::OnEvent(Event &event) {
@@ -110,9 +109,9 @@ namespace Imagine::Runtime {
 
 		if (handled) return;
 		handled = dispatch.Dispatch<AppRenderEvent>([this](AppRenderEvent &event) {
-			DrawContext ctx;
-			OnRender(ctx);
-			Renderer::Get()->Draw(ctx);
+			m_DrawContext.Reset();
+			OnRender(m_DrawContext);
+			Renderer::Get()->Draw(m_DrawContext);
 			return false;
 		});
 
@@ -307,20 +306,20 @@ namespace Imagine::Runtime {
 			ImGui::BeginDisabled(m_ChaikinCurves.line.empty());
 			if (ImGui::Button("Create Curve")) {
 				const auto vecLine = m_ChaikinCurves.CalculateChaikin();
-				m_Line.points.clear();
-				m_Line.points.reserve(vecLine.size() + 1);
+				m_Line.clear();
+				m_Line.reserve(vecLine.size() + 1);
 				for (const auto &p: vecLine) {
 					Vertex v{};
 					v.position = p;
 					v.color = {0.8, 0.3, 0.2, 1.0};
-					m_Line.points.push_back(v);
+					m_Line.push_back(v);
 				}
-				m_Line.points.push_back(m_Line.points.front());
+				m_Line.push_back(m_Line.front());
 			}
 			ImGui::EndDisabled();
 
 			if (ImGui::Button("Delete Curve")) {
-				m_Line.points.clear();
+				m_Line.clear();
 			}
 		}
 		ImGui::End();
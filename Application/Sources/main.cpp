@@ -13,6 +13,31 @@
 #include "Imagine/Physics/ObjectLayerPairFilter.hpp"
 #include "Imagine/Scripting/ScriptingLayer.hpp"
 
+namespace {
+	/// Simulate a physics recording without the window nor the scenes, and report the cost of its steps.
+	/// @return 0 if the replay ended on the state of the recording.
+	int ReplayPhysics(const char *filePath) {
+		using namespace Imagine;
+		const std::optional<PhysicsRecording> recording = PhysicsRecording::Read(filePath);
+		if (!recording) return 1;
+
+		JobSystem::Initialize();
+		PhysicsLayer layer;
+		layer.OnAttach();
+		const PhysicsReplayStats stats = layer.Replay(recording.value());
+		layer.OnDetach();
+		JobSystem::Shutdown();
+
+		MGN_INFO("Replayed {} frames in {} steps: {:.3f} ms, {:.3f} ms per step, {:.3f} ms max.", stats.frames, stats.steps, stats.stepsMs, stats.steps ? stats.stepsMs / static_cast<double>(stats.steps) : 0.0, stats.maxStepMs);
+		if (!stats.identical) {
+			MGN_ERROR("The replay of '{}' diverged from the recorded run.", filePath);
+			return 1;
+		}
+		MGN_INFO("The replay of '{}' matches the recorded run.", filePath);
+		return 0;
+	}
+} // namespace
+
 int main(int argc, char **argv) {
 	using namespace Imagine;
 
@@ -30,6 +55,14 @@ int main(int argc, char **argv) {
 	// This needs to be done before any other Jolt function is called.
 	JPH::RegisterDefaultAllocator();
 
+	// '--replay <file>' simulates a physics recording headless then exits, to benchmark the physics steps.
+	for (int i = 1; i + 1 < argc; ++i) {
+		if (std::string_view{argv[i]} != "--replay") continue;
+		const int result = ReplayPhysics(argv[i + 1]);
+		Imagine::Log::Shutdown();
+		return result;
+	}
+
 	ApplicationParameters params{
 			std::string{"Imagine"},
 			MGN_MAKE_VERSION(0, 0, 1),
@@ -44,6 +77,21 @@ int main(int argc, char **argv) {
 			},
 	};
 
+	// '--capture [frames]' runs a fixed number of frames along a fixed camera path and writes the last one with the frame timings.
+	for (int i = 1; i < argc; ++i) {
+		if (std::string_view{argv[i]} != "--capture") continue;
+		CaptureParameters capture{};
+		if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+			capture.FrameCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		const Real duration = static_cast<Real>(capture.FrameCount * capture.TimeStep);
+		capture.CameraPath = {
+				CameraKey{0, Vec3{-7, 6, 0}, 30, 90},
+				CameraKey{duration, Vec3{7, 6, 0}, 15, 90},
+		};
+		params.Capture = capture;
+	}
+
 	// ApplicationParameters params {
 	// 	std::string{"Imagine"},
 	// MGN_MAKE_VERSION(0,0,1),
@@ -0,0 +1,102 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Benchmark.hpp"
+
+namespace {
+	struct BenchPosition {
+		float x{0}, y{0}, z{0};
+	};
+
+	struct BenchVelocity {
+		float x{1}, y{2}, z{3};
+	};
+
+	struct BenchHealth {
+		float value{100};
+	};
+
+	template<typename T>
+	ArchetypeStorage::ComponentIndex RegisterComponent(ArchetypeStorage &storage) {
+		return storage.RegisterComponent(
+				UUIDFromType<T>(),
+				sizeof(T),
+				[](void *data, uint32_t size) { new (data) T(); },
+				[](void *data, uint32_t size) { reinterpret_cast<T *>(data)->~T(); },
+				[](void *data, uint32_t size, ConstBufferView view) { new (data) T(view.As<T>()); });
+	}
+
+	/// Every entity has a position and a velocity, one in two also has a health to split the entities in two archetypes.
+	void RunArchetypeVsSparseSet(const uint32_t count) {
+		const std::string suffix = std::to_string(count) + " entities";
+		constexpr uint32_t iterations = 10;
+
+		// Sparse Sets
+		{
+			RawSparseSet<uint32_t> positions = RawSparseSet<uint32_t>::Instantiate<BenchPosition>(count);
+			RawSparseSet<uint32_t> velocities = RawSparseSet<uint32_t>::Instantiate<BenchVelocity>(count);
+			RawSparseSet<uint32_t> healths = RawSparseSet<uint32_t>::Instantiate<BenchHealth>(count);
+
+			const double create = Bench::Measure(1, [&]() {
+				for (uint32_t i = 0; i < count; ++i) {
+					positions.Create(i);
+					velocities.Create(i);
+					if (i % 2 == 0) healths.Create(i);
+				}
+			});
+			Bench::Report("ArchetypeVsSparseSet", "SparseSet create " + suffix, create, count);
+
+			const double iterate = Bench::Measure(iterations, [&]() {
+				for (auto it = velocities.begin(); it != velocities.end(); ++it) {
+					const BenchVelocity &velocity = it.GetView().As<BenchVelocity>();
+					auto *position = static_cast<BenchPosition *>(positions.Get(it.GetID()));
+					position->x += velocity.x;
+					position->y += velocity.y;
+					position->z += velocity.z;
+				}
+			});
+			Bench::DoNotOptimize(positions.Get(0));
+			Bench::Report("ArchetypeVsSparseSet", "SparseSet iterate (position, velocity) " + suffix, iterate, count);
+		}
+
+		// Archetypes
+		{
+			ArchetypeStorage storage;
+			const auto position = RegisterComponent<BenchPosition>(storage);
+			const auto velocity = RegisterComponent<BenchVelocity>(storage);
+			RegisterComponent<BenchHealth>(storage);
+			storage.Reserve(count);
+
+			const double create = Bench::Measure(1, [&]() {
+				for (uint32_t i = 0; i < count; ++i) {
+					storage.Add(i, UUIDFromType<BenchPosition>());
+					storage.Add(i, UUIDFromType<BenchVelocity>());
+					if (i % 2 == 0) storage.Add(i, UUIDFromType<BenchHealth>());
+				}
+			});
+			Bench::Report("ArchetypeVsSparseSet", "Archetype create " + suffix, create, count);
+
+			const std::array<ArchetypeStorage::ComponentIndex, 2> query{position, velocity};
+			const double iterate = Bench::Measure(iterations, [&]() {
+				storage.ForEachChunk(query, [](const ArchetypeStorage::ChunkView &view) {
+					BenchPosition *positions = view.Column<BenchPosition>(0);
+					const BenchVelocity *velocities = view.Column<BenchVelocity>(1);
+					for (uint32_t i = 0; i < view.count; ++i) {
+						positions[i].x += velocities[i].x;
+						positions[i].y += velocities[i].y;
+						positions[i].z += velocities[i].z;
+					}
+				});
+			});
+			Bench::DoNotOptimize(storage.TryGet(0, UUIDFromType<BenchPosition>()));
+			Bench::Report("ArchetypeVsSparseSet", "Archetype iterate (position, velocity) " + suffix, iterate, count);
+		}
+	}
+} // namespace
+
+MGN_BENCHMARK(ArchetypeVsSparseSet) {
+	for (const uint32_t count: {10'000u, 100'000u, 1'000'000u}) {
+		RunArchetypeVsSparseSet(count);
+	}
+}
@@ -0,0 +1,55 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Assets/FileAssetManager.hpp"
+
+namespace {
+	class BenchAsset final : public Asset {
+	public:
+		MGN_IMPLEMENT_ASSET(AssetType::Script);
+	};
+
+	Path GetBenchPath(const uint32_t index) {
+		return Path{FileSource::Assets, fmt::format("Folder_{}/asset_{}.lua", index % 64, index)};
+	}
+} // namespace
+
+MGN_BENCHMARK(AssetRegistryLookup) {
+	constexpr uint32_t lookups = 10'000;
+
+	for (const uint32_t count: {1'000u, 10'000u, 100'000u}) {
+		FileAssetManager manager;
+		for (uint32_t i = 0; i < count; ++i) {
+			manager.AddAsset(CreateRef<BenchAsset>(), GetBenchPath(i));
+		}
+
+		std::vector<Path> hits;
+		std::vector<Path> misses;
+		hits.reserve(lookups);
+		misses.reserve(lookups);
+		for (uint32_t i = 0; i < lookups; ++i) {
+			hits.push_back(GetBenchPath((i * 7919u) % count));
+			misses.push_back(GetBenchPath(count + i));
+		}
+
+		const double hit = Bench::Measure(5, [&]() {
+			uint32_t found = 0;
+			for (const Path &path: hits) {
+				found += manager.IsAssetImported(path);
+			}
+			Bench::DoNotOptimize(found);
+		});
+		Bench::Report("AssetRegistryLookup", fmt::format("{} assets, hit", count), hit, lookups);
+
+		const double miss = Bench::Measure(5, [&]() {
+			uint32_t found = 0;
+			for (const Path &path: misses) {
+				found += manager.IsAssetImported(path);
+			}
+			Bench::DoNotOptimize(found);
+		});
+		Bench::Report("AssetRegistryLookup", fmt::format("{} assets, miss", count), miss, lookups);
+	}
+}
@@ -0,0 +1,81 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Assets/AssetImporter.hpp"
+#include "Imagine/Assets/FileAssetManager.hpp"
+
+namespace {
+	class BenchStreamedAsset final : public Asset {
+	public:
+		MGN_IMPLEMENT_ASSET(AssetType::Script);
+	};
+
+	struct FrameTimes {
+		double worst{0};
+		double total{0};
+		uint32_t firstCompleteFrame{0};
+	};
+
+	/**
+	 * Simulate the opening of a scene: every frame touches the asset of each renderable like the draw path does.
+	 * The frame is done either with the blocking GetAsset or with the streaming TryGetAsset.
+	 */
+	FrameTimes SimulateSceneOpen(const bool streaming, const uint32_t assetCount, const uint32_t renderables, const uint32_t frames) {
+		FileAssetManager manager;
+		std::vector<AssetHandle> handles;
+		handles.reserve(assetCount);
+		for (uint32_t i = 0; i < assetCount; ++i) {
+			Ref<BenchStreamedAsset> asset = CreateRef<BenchStreamedAsset>();
+			manager.AddAsset(asset, Path{FileSource::Assets, fmt::format("Streamed/asset_{}.lua", i)});
+			manager.UnloadAsset(asset->Handle);
+			handles.push_back(asset->Handle);
+		}
+
+		FrameTimes times{};
+		times.firstCompleteFrame = frames;
+		for (uint32_t frame = 0; frame < frames; ++frame) {
+			const auto start = std::chrono::high_resolution_clock::now();
+			manager.UpdateRequests();
+			uint32_t drawn = 0;
+			for (uint32_t i = 0; i < renderables; ++i) {
+				const AssetHandle handle = handles[i % assetCount];
+				const Ref<Asset> asset = streaming ? manager.TryGetAsset(handle) : manager.GetAsset(handle);
+				drawn += asset != nullptr;
+			}
+			// Stand-in for the rest of a 60 fps frame, giving time to the streaming workers.
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			const auto end = std::chrono::high_resolution_clock::now();
+
+			const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+			times.worst = std::max(times.worst, ms);
+			times.total += ms;
+			if (drawn == renderables && times.firstCompleteFrame == frames) {
+				times.firstCompleteFrame = frame;
+			}
+		}
+		return times;
+	}
+} // namespace
+
+MGN_BENCHMARK(AssetStreaming) {
+	constexpr uint32_t assetCount = 64;
+	constexpr uint32_t renderables = 1'000;
+	constexpr uint32_t frames = 120;
+
+	// Each import takes a few milliseconds, like reading and parsing a small model.
+	AssetImporter::RegisterImporter(AssetType::Script, [](const AssetMetadata &) -> Ref<Asset> {
+		std::this_thread::sleep_for(std::chrono::milliseconds(4));
+		return CreateRef<BenchStreamedAsset>();
+	});
+
+	for (const bool streaming: {false, true}) {
+		const FrameTimes times = SimulateSceneOpen(streaming, assetCount, renderables, frames);
+		const char *mode = streaming ? "streaming" : "blocking";
+		Bench::Report("AssetStreaming", fmt::format("{} worst frame", mode), times.worst, renderables);
+		Bench::Report("AssetStreaming", fmt::format("{} {} frames (complete at frame {})", mode, frames, times.firstCompleteFrame), times.total, frames);
+	}
+
+	AssetImporter::RegisterImporter(AssetType::Script, nullptr);
+}
@@ -0,0 +1,50 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Rendering/DebugDrawBuffer.hpp"
+
+MGN_BENCHMARK(DebugDraw) {
+	constexpr uint32_t count = 200'000;
+
+	JobSystem::Initialize();
+
+	// The triangles of the debug view, drawn from the jobs as Jolt does.
+	std::mutex mutex;
+	std::vector<Vertex> vertices;
+	const double locked = Bench::Measure(10, [&]() {
+		vertices.clear();
+		JobSystem::ParallelFor(count, 256, [&](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				const Vertex vertex = Vertex::PC({static_cast<float>(i), 0, 0}, {0, 1, 0, 1});
+				auto lock = std::scoped_lock(mutex);
+				vertices.push_back(vertex);
+				vertices.push_back(vertex);
+				vertices.push_back(vertex);
+			}
+		});
+		Bench::DoNotOptimize(vertices.size());
+	});
+	Bench::Report("DebugDraw", fmt::format("{} triangles, vector behind a mutex", count), locked, count);
+
+	// The first frame grows the buffer, the measured ones reuse it.
+	DebugDrawBuffer buffer;
+	const double lockFree = Bench::Measure(10, [&]() {
+		buffer.Reset();
+		JobSystem::ParallelFor(count, 256, [&](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				const Vertex vertex = Vertex::PC({static_cast<float>(i), 0, 0}, {0, 1, 0, 1});
+				Vertex *triangle = buffer.Append(3);
+				if (!triangle) continue;
+				triangle[0] = vertex;
+				triangle[1] = vertex;
+				triangle[2] = vertex;
+			}
+		});
+		Bench::DoNotOptimize(buffer.GetVertices().size());
+	});
+	Bench::Report("DebugDraw", fmt::format("{} triangles, lock free buffer (x{:.2f})", count, locked / lockFree), lockFree, count);
+
+	JobSystem::Shutdown();
+}
@@ -0,0 +1,75 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Components/Renderable.hpp"
+#include "Imagine/Rendering/DrawExtractor.hpp"
+
+namespace {
+	class BenchGPUMesh final : public GPUMesh {
+	public:
+		explicit BenchGPUMesh(const uint64_t id) : m_ID(id) {}
+		virtual ~BenchGPUMesh() override = default;
+		virtual uint64_t GetID() override { return m_ID; }
+
+	private:
+		uint64_t m_ID;
+	};
+} // namespace
+
+MGN_BENCHMARK(DrawExtraction) {
+	constexpr uint32_t count = 100'000;
+	constexpr uint32_t assetCount = 64;
+	constexpr uint32_t surfacesPerAsset = 4;
+
+	// Each asset is a model of a few nodes, the surfaces are pinned so no asset manager is needed.
+	DrawExtractor extractor;
+	std::vector<AssetHandle> assets;
+	std::vector<Ref<GPUMesh>> meshes;
+	for (uint32_t i = 0; i < assetCount; ++i) {
+		std::vector<RenderObject> surfaces;
+		for (uint32_t j = 0; j < surfacesPerAsset; ++j) {
+			const Ref<GPUMesh> &mesh = meshes.emplace_back(CreateRef<BenchGPUMesh>(i * surfacesPerAsset + j));
+			surfaces.emplace_back(Math::Translate(Math::Identity<Mat4>(), Vec3(0, static_cast<Real>(j), 0)), mesh.get());
+		}
+		assets.emplace_back();
+		extractor.SetSurfaces(assets.back(), std::move(surfaces));
+	}
+
+	Scene scene;
+	scene.Prepare(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		const EntityID id = scene.CreateEntity();
+		scene.SetLocalPosition(id, Vec3(static_cast<Real>(i % 100), static_cast<Real>(i / 100), 0));
+		scene.AddComponent<Renderable>(id, assets[i % assetCount]);
+	}
+	scene.CacheTransforms();
+
+	DrawContext ctx;
+	const uint64_t surfaces = static_cast<uint64_t>(count) * surfacesPerAsset;
+	const uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+	double reference = 0;
+	for (const uint32_t threads: {1u, 2u, 4u, 8u, 16u, 32u}) {
+		if (threads > hardware) break;
+		JobSystem::Initialize(threads - 1);
+		const double ms = Bench::Measure(10, [&]() {
+			ctx.Clear();
+			extractor.ExtractRenderables(scene, ctx);
+		});
+		if (threads == 1) reference = ms;
+		Bench::Report("DrawExtraction", fmt::format("{} threads, {} renderables (x{:.2f})", threads, count, reference / ms), ms, surfaces);
+		JobSystem::Shutdown();
+	}
+
+	if (ctx.OpaqueSurfaces.size() != surfaces) {
+		MGN_CORE_ERROR("Extracted {} surfaces instead of {}.", ctx.OpaqueSurfaces.size(), surfaces);
+	}
+
+	const double gizmos = Bench::Measure(10, [&]() {
+		ctx.Clear();
+		DrawExtractor::ExtractGizmos(scene, ctx);
+	});
+	Bench::Report("DrawExtraction", fmt::format("gizmos, {} entities", count), gizmos, count);
+	Bench::DoNotOptimize(ctx.LineIndices.size());
+}
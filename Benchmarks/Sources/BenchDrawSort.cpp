@@ -0,0 +1,52 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Rendering/DrawSort.hpp"
+
+MGN_BENCHMARK(DrawSort) {
+	constexpr uint32_t count = 100'000;
+	constexpr uint32_t meshCount = 256;
+
+	// A scene of a few materials and meshes seen at random distances.
+	std::vector<RenderObject> surfaces;
+	surfaces.reserve(count);
+	std::vector<int> meshes(meshCount);
+	for (uint32_t i = 0; i < count; ++i) {
+		const uint64_t hash = DrawSortKey::Fold(i + 1, 64);
+		RenderObject &surface = surfaces.emplace_back(Math::Identity<Mat4>(), nullptr);
+		const uint64_t key = DrawSortKey::Make(DrawSortKey::Opaque, NULL_ASSET_HANDLE, NULL_ASSET_HANDLE, &meshes[hash % meshCount]);
+		surface.sortKey = DrawSortKey::WithDepth(key, static_cast<float>(hash >> 40));
+	}
+
+	DrawContext ctx;
+	// Every run starts from a copy of the surfaces, as the sort is done in place.
+	const double copy = Bench::Measure(10, [&]() {
+		ctx.OpaqueSurfaces.clear();
+		ctx.OpaqueSurfaces.Append(surfaces);
+	});
+	Bench::Report("DrawSort", "copy of the surfaces only", copy, count);
+
+	const double comparison = Bench::Measure(10, [&]() {
+		ctx.OpaqueSurfaces.clear();
+		ctx.OpaqueSurfaces.Append(surfaces);
+		std::stable_sort(ctx.OpaqueSurfaces.begin(), ctx.OpaqueSurfaces.end(), [](const RenderObject &a, const RenderObject &b) { return a.sortKey < b.sortKey; });
+	});
+	Bench::Report("DrawSort", fmt::format("std::stable_sort, {} surfaces", count), comparison, count);
+
+	DrawSorter sorter;
+	const double radix = Bench::Measure(10, [&]() {
+		ctx.OpaqueSurfaces.clear();
+		ctx.OpaqueSurfaces.Append(surfaces);
+		sorter.Sort(ctx);
+	});
+	Bench::Report("DrawSort", fmt::format("radix sort, {} surfaces (x{:.2f})", count, comparison / radix), radix, count);
+
+	// Changes of mesh between consecutive draws, which each cost an index buffer bind.
+	uint32_t changes = 0;
+	for (uint32_t i = 1; i < count; ++i) {
+		changes += (ctx.OpaqueSurfaces[i].sortKey >> DrawSortKey::c_MeshShift) != (ctx.OpaqueSurfaces[i - 1].sortKey >> DrawSortKey::c_MeshShift);
+	}
+	MGN_CORE_INFO("{} mesh changes after the sort, for {} meshes.", changes, meshCount);
+}
@@ -0,0 +1,51 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Rendering/FrustumCuller.hpp"
+
+MGN_BENCHMARK(FrustumCulling) {
+	constexpr uint32_t count = 100'000;
+
+	// A grid of boxes around the camera, which sees about a fifth of them.
+	std::vector<RenderObject> surfaces;
+	surfaces.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		const Vec3 position{static_cast<Real>(i % 316) - 158, 0, static_cast<Real>(i / 316) - 158};
+		RenderObject &surface = surfaces.emplace_back(Math::Translate(Math::Identity<Mat4>(), position), nullptr);
+		surface.bounds = BoundingBox{Vec3(-0.5), Vec3(0.5)};
+		surface.lodCount = 4;
+	}
+
+	const Mat4 view = glm::lookAt(Vec3(0, 10, 0), Vec3(0, 0, 50), Vec3(0, 1, 0));
+	const Mat4 projection = glm::perspective(glm::radians(Real(70)), Real(16) / Real(9), Real(0.1), Real(1000));
+
+	FrustumCuller culler;
+	DrawContext ctx;
+	// Every run starts from a copy of the surfaces, as the culling removes the invisible ones.
+	const double copy = Bench::Measure(10, [&]() {
+		ctx.OpaqueSurfaces.clear();
+		ctx.OpaqueSurfaces.Append(surfaces);
+	});
+	Bench::Report("FrustumCulling", "copy of the surfaces only", copy, count);
+
+	const uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+	double reference = 0;
+	for (const uint32_t threads: {1u, 2u, 4u, 8u, 16u, 32u}) {
+		if (threads > hardware) break;
+		JobSystem::Initialize(threads - 1);
+		const double ms = Bench::Measure(10, [&]() {
+			ctx.OpaqueSurfaces.clear();
+			ctx.OpaqueSurfaces.Append(surfaces);
+			culler.ResetStats();
+			culler.Cull(view, projection, ctx);
+		});
+		if (threads == 1) reference = ms;
+		Bench::Report("FrustumCulling", fmt::format("{} threads, {} surfaces (x{:.2f})", threads, count, reference / ms), ms, count);
+		JobSystem::Shutdown();
+	}
+
+	const CullingStats &stats = culler.GetStats();
+	MGN_CORE_INFO("{} visible, {} culled, LODs {}/{}/{}/{}", stats.visible, stats.culled, stats.lods[0], stats.lods[1], stats.lods[2], stats.lods[3]);
+}
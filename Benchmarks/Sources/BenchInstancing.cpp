@@ -0,0 +1,67 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Rendering/DrawSort.hpp"
+#include "Imagine/Rendering/InstanceBatcher.hpp"
+
+namespace {
+	class BenchGPUMesh final : public GPUMesh {
+	public:
+		virtual ~BenchGPUMesh() override = default;
+		virtual uint64_t GetID() override { return 0; }
+	};
+} // namespace
+
+MGN_BENCHMARK(Instancing) {
+	constexpr uint32_t count = 10'000;
+	constexpr uint32_t meshCount = 4;
+
+	// The stress scene: a few meshes duplicated over a grid, with a rotation and a non uniform scale each.
+	BenchGPUMesh meshes[meshCount];
+	std::vector<RenderObject> surfaces;
+	surfaces.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		const Vec3 position{static_cast<Real>(i % 100), 0, static_cast<Real>(i / 100)};
+		Mat4 transform = Math::Translate(Math::Identity<Mat4>(), position);
+		transform = glm::rotate(transform, static_cast<Real>(i) * Real(0.01), Vec3(0, 1, 0));
+		transform = glm::scale(transform, Vec3(1, 1 + static_cast<Real>(i % 3), 1));
+		BenchGPUMesh *mesh = &meshes[DrawSortKey::Fold(i + 1, 64) % meshCount];
+		RenderObject &surface = surfaces.emplace_back(transform, mesh);
+		surface.sortKey = DrawSortKey::WithDepth(DrawSortKey::Make(DrawSortKey::Opaque, NULL_ASSET_HANDLE, NULL_ASSET_HANDLE, mesh), static_cast<float>(i));
+	}
+
+	DrawContext ctx;
+	ctx.OpaqueSurfaces.Append(surfaces);
+	DrawSorter sorter;
+	sorter.Sort(ctx);
+
+	InstanceBatcher batcher;
+	const double build = Bench::Measure(10, [&]() { batcher.Build(ctx.OpaqueSurfaces); });
+	Bench::Report("Instancing", fmt::format("batches, {} surfaces", count), build, count);
+	MGN_CORE_INFO("{} draws instead of {} for {} meshes.", batcher.GetBatches().size(), count, meshCount);
+
+	// The per draw inverse of the matrix that the instance buffer replaces.
+	std::vector<GPUInstanceData> instances(count);
+	const double scalar = Bench::Measure(10, [&]() {
+		for (uint32_t i = 0; i < count; ++i) {
+			instances[i].worldMatrix = glm::fmat4(ctx.OpaqueSurfaces[i].transform);
+			instances[i].normalMatrix = glm::transpose(glm::inverse(instances[i].worldMatrix));
+		}
+		Bench::DoNotOptimize(instances.data());
+	});
+	Bench::Report("Instancing", fmt::format("glm::inverse, {} instances", count), scalar, count);
+
+	const uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+	for (const uint32_t threads: {1u, 2u, 4u, 8u, 16u, 32u}) {
+		if (threads > hardware) break;
+		JobSystem::Initialize(threads - 1);
+		const double ms = Bench::Measure(10, [&]() {
+			InstanceBatcher::WriteInstances(ctx.OpaqueSurfaces, instances.data());
+			Bench::DoNotOptimize(instances.data());
+		});
+		Bench::Report("Instancing", fmt::format("SIMD, {} threads, {} instances (x{:.2f})", threads, count, scalar / ms), ms, count);
+		JobSystem::Shutdown();
+	}
+}
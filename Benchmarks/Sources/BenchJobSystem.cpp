@@ -0,0 +1,72 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Benchmark.hpp"
+
+namespace {
+	struct BenchRenderable {
+		AssetHandle handle{};
+	};
+
+	struct GatheredSurface {
+		Mat4 world;
+		AssetHandle handle;
+	};
+
+	/// Gather the lights and the renderables of the scene like Application::DrawScenes does, with every worker.
+	double Gather(Scene &scene, std::vector<Light> &lights, std::vector<std::vector<GatheredSurface>> &surfaces) {
+		return Bench::Measure(10, [&]() {
+			std::atomic<uint32_t> lightCount{0};
+			scene.ParallelForEachWithComponent<Light>([&scene, &lights, &lightCount](const EntityID id, const Light &comp) {
+				const uint32_t index = lightCount.fetch_add(1, std::memory_order_relaxed);
+				const Mat4 world = scene.GetWorldTransform(id);
+				const Mat4 normal = glm::transpose(glm::inverse(world));
+				Light light = comp;
+				light.position = world * Vec4(light.position, 1);
+				light.direction = normal * glm::fvec4(0, -1, 0, 0);
+				lights[index] = light;
+			});
+
+			for (std::vector<GatheredSurface> &list: surfaces) {
+				list.clear();
+			}
+			scene.ParallelForEachWithComponent<BenchRenderable>([&scene, &surfaces](const EntityID id, const BenchRenderable &renderable) {
+				surfaces[JobSystem::GetThreadIndex()].push_back({scene.GetWorldTransform(id), renderable.handle});
+			});
+			Bench::DoNotOptimize(lights[0]);
+		});
+	}
+} // namespace
+
+MGN_BENCHMARK(JobSystemScaling) {
+	constexpr uint32_t count = 200'000;
+
+	Scene scene;
+	scene.RegisterType<BenchRenderable>();
+	scene.Prepare(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		const EntityID id = scene.CreateEntity();
+		scene.SetLocalPosition(id, Vec3(static_cast<Real>(i % 100), static_cast<Real>(i / 100), 0));
+		scene.AddComponent<BenchRenderable>(id);
+		if (i % 4 == 0) scene.AddComponent<Light>(id);
+	}
+	scene.CacheTransforms();
+
+	std::vector<Light> lights(count);
+	const uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+	double reference = 0;
+	for (const uint32_t threads: {1u, 2u, 4u, 8u, 16u, 32u}) {
+		if (threads > hardware) break;
+		JobSystem::Initialize(threads - 1);
+		std::vector<std::vector<GatheredSurface>> surfaces(JobSystem::GetThreadCount());
+		for (std::vector<GatheredSurface> &list: surfaces) {
+			list.reserve(count);
+		}
+
+		const double ms = Gather(scene, lights, surfaces);
+		if (threads == 1) reference = ms;
+		Bench::Report("JobSystemScaling", fmt::format("{} threads, {} entities (x{:.2f})", threads, count, reference / ms), ms, count);
+		JobSystem::Shutdown();
+	}
+}
@@ -0,0 +1,45 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Rendering/LightClusters.hpp"
+
+MGN_BENCHMARK(LightClusters) {
+	constexpr uint32_t count = 4096;
+	constexpr uint32_t width = 1920;
+	constexpr uint32_t height = 1080;
+
+	// Small point and spot lights spread on a 400 x 400 area in front of the camera, a few of them behind it.
+	std::vector<Light> lights(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		Light &light = lights[i];
+		light.type = i % 4 == 0 ? LIGHT_SPOT : LIGHT_POINT;
+		light.position = {static_cast<float>(i % 64) * 6.25f - 200.0f, static_cast<float>(i % 7), static_cast<float>(i / 64) * 6.25f - 20.0f};
+		light.direction = {0, -(2.0f + static_cast<float>(i % 13)), 0, 0.6f};
+	}
+
+	const Mat4 view = glm::lookAt(Vec3(0, 10, -30), Vec3(0, 0, 50), Vec3(0, 1, 0));
+	Mat4 projection = glm::perspective(glm::radians(Real(70)), Real(width) / Real(height), Real(0.1), Real(10000));
+	projection[1][1] *= -1;
+
+	LightClusters clusters;
+	const uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+	double reference = 0;
+	for (const uint32_t threads: {1u, 2u, 4u, 8u, 16u, 32u}) {
+		if (threads > hardware) break;
+		JobSystem::Initialize(threads - 1);
+		const double ms = Bench::Measure(20, [&]() {
+			clusters.Build(lights, view, projection, width, height);
+			Bench::DoNotOptimize(clusters.GetIndices().data());
+		});
+		if (threads == 1) reference = ms;
+		Bench::Report("LightClusters", fmt::format("{} threads, {} lights (x{:.2f})", threads, count, reference / ms), ms, count);
+		JobSystem::Shutdown();
+	}
+
+	const LightClusterStats &stats = clusters.GetStats();
+	const double average = stats.occupiedClusters ? static_cast<double>(stats.indices) / static_cast<double>(stats.occupiedClusters) : 0.0;
+	MGN_CORE_INFO("    {} culled, {} indices in {}/{} clusters, {} dropped.", stats.culledLights, stats.indices, stats.occupiedClusters, clusters.GetClusterCount(), stats.droppedIndices);
+	MGN_CORE_INFO("    A pixel shades {:.1f} lights on average and {} at most, instead of {}.", average, stats.maxLightsInCluster, count);
+}
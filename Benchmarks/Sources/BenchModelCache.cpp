@@ -0,0 +1,101 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Assets/Importers/ModelCache.hpp"
+#include "Imagine/ThirdParty/Assimp.hpp"
+
+namespace {
+	/// Write a grid of 'size' x 'size' quads as an .obj using a 'textureSize' texture.
+	void WriteGridModel(const std::filesystem::path &folder, const uint32_t size, const uint32_t textureSize) {
+		{
+			std::ofstream texture(folder / "grid.ppm", std::ios::binary);
+			texture << "P6\n" << textureSize << ' ' << textureSize << "\n255\n";
+			std::vector<uint8_t> row(textureSize * 3);
+			for (uint32_t y = 0; y < textureSize; ++y) {
+				for (uint32_t x = 0; x < textureSize; ++x) {
+					row[x * 3 + 0] = static_cast<uint8_t>(x);
+					row[x * 3 + 1] = static_cast<uint8_t>(y);
+					row[x * 3 + 2] = static_cast<uint8_t>(x ^ y);
+				}
+				texture.write(reinterpret_cast<const char *>(row.data()), static_cast<std::streamsize>(row.size()));
+			}
+		}
+
+		{
+			std::ofstream material(folder / "grid.mtl");
+			material << "newmtl grid\nKd 1 1 1\nmap_Kd grid.ppm\n";
+		}
+
+		std::ofstream obj(folder / "grid.obj");
+		obj << "mtllib grid.mtl\no grid\n";
+		const float scale = 1.0f / static_cast<float>(size);
+		for (uint32_t y = 0; y <= size; ++y) {
+			for (uint32_t x = 0; x <= size; ++x) {
+				obj << "v " << x * scale << ' ' << std::sin(static_cast<float>(x + y) * 0.1f) * 0.05f << ' ' << y * scale << '\n';
+				obj << "vt " << x * scale << ' ' << y * scale << '\n';
+			}
+		}
+		obj << "usemtl grid\n";
+		for (uint32_t y = 0; y < size; ++y) {
+			for (uint32_t x = 0; x < size; ++x) {
+				const uint32_t a = y * (size + 1) + x + 1;
+				const uint32_t b = a + 1;
+				const uint32_t c = a + size + 1;
+				const uint32_t d = c + 1;
+				obj << "f " << a << '/' << a << ' ' << c << '/' << c << ' ' << b << '/' << b << '\n';
+				obj << "f " << b << '/' << b << ' ' << c << '/' << c << ' ' << d << '/' << d << '\n';
+			}
+		}
+	}
+} // namespace
+
+MGN_BENCHMARK(ModelCache) {
+	constexpr uint32_t gridSize = 256;
+	constexpr uint32_t textureSize = 2048;
+
+	const std::filesystem::path root = std::filesystem::temp_directory_path() / "imagine_bench_model";
+	std::filesystem::remove_all(root);
+	std::filesystem::create_directories(root);
+	WriteGridModel(root, gridSize, textureSize);
+
+	// The importer references the default materials.
+	CPUMaterial::InitDefaultMaterials(NULL_ASSET_HANDLE, NULL_ASSET_HANDLE);
+
+	const std::filesystem::path source = root / "grid.obj";
+	const std::filesystem::path cooked = root / fmt::format("grid{}", ModelCache::c_Extension);
+	constexpr uint32_t settings = ThirdParty::Assimp::GetSmoothPostProcess();
+	const uint64_t triangles = static_cast<uint64_t>(gridSize) * gridSize * 2;
+
+	Ref<CPUModel> imported;
+	const double cold = Bench::Measure(3, [&]() {
+		imported = CPUModel::ImportModel(source);
+	});
+	Bench::Report("ModelCache", "cold (assimp + stb), per triangle", cold, triangles);
+
+	uint64_t key = 0;
+	const double hash = Bench::Measure(5, [&]() {
+		key = ModelCache::ComputeKey(source, settings);
+	});
+	Bench::Report("ModelCache", "key (xxHash64 of the source)", hash, std::filesystem::file_size(source));
+
+	const double cook = Bench::Measure(3, [&]() {
+		ModelCache::Write(*imported, key, cooked);
+	});
+	Bench::Report("ModelCache", fmt::format("cook ({} MB)", std::filesystem::file_size(cooked) / (1024 * 1024)), cook, triangles);
+
+	Ref<CPUModel> warm;
+	const double read = Bench::Measure(5, [&]() {
+		warm = ModelCache::Read(cooked, ModelCache::ComputeKey(source, settings));
+	});
+	Bench::Report("ModelCache", "warm (key + cooked file), per triangle", read, triangles);
+	Bench::DoNotOptimize(warm);
+
+	if (!warm || warm->Meshes.size() != imported->Meshes.size() || warm->Textures.size() != imported->Textures.size()) {
+		MGN_CORE_ERROR("The cooked model doesn't match the imported one.");
+	}
+
+	CPUMaterial::DestroyDefaultMaterials();
+	std::filesystem::remove_all(root);
+}
@@ -0,0 +1,61 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Components/Physicalisable.hpp"
+#include "Imagine/Layers/PhysicsLayer.hpp"
+
+#include <Jolt/Core/Memory.h>
+
+MGN_BENCHMARK(PhysicsReplay) {
+	constexpr uint32_t count = 4'000;
+	constexpr uint32_t frames = 300;
+
+	JPH::RegisterDefaultAllocator();
+	JobSystem::Initialize();
+
+	PhysicsLayer layer;
+	layer.OnAttach();
+
+	std::optional<PhysicsRecording> recording;
+	{
+		// Spheres piling up on a ground, colliding all along the recording.
+		const std::vector<Scene::Ref> scenes{std::make_shared<Scene>()};
+		Scene &scene = *scenes.front();
+		scene.Prepare(count + 1);
+		const EntityID ground = scene.CreateEntity();
+		Physicalisable *groundComp = scene.AddComponent<Physicalisable>(ground);
+		groundComp->Shape = ColliderShapes::Box{Vec3(100, 1, 100)};
+		groundComp->RBType = RB_Static;
+		for (uint32_t i = 0; i < count; ++i) {
+			const EntityID id = scene.CreateEntity();
+			scene.SetLocalPosition(id, Vec3(static_cast<Real>(i % 20), 2 + static_cast<Real>(i / 400) * 1.5, static_cast<Real>((i / 20) % 20)));
+			scene.AddComponent<Physicalisable>(id)->Shape = ColliderShapes::Sphere{0.5};
+		}
+		scene.CacheTransforms();
+		PhysicsLayer::SetSimulating(false);
+		layer.Synchronize(scene);
+
+		PhysicsLayer::SetSimulating(true);
+		layer.StartRecording(scenes);
+		for (uint32_t i = 0; i < frames; ++i) {
+			AppUpdateEvent update{TimeStep{1.0 / 60.0}};
+			layer.OnEvent(update);
+		}
+		recording = layer.StopRecording();
+		PhysicsLayer::SetSimulating(false);
+	}
+
+	// The replay runs the same steps each time, only their cost changes from one build to the other.
+	PhysicsReplayStats stats{};
+	const double ms = Bench::Measure(3, [&]() {
+		stats = layer.Replay(recording.value());
+		Bench::DoNotOptimize(stats.steps);
+	});
+	Bench::Report("PhysicsReplay", fmt::format("{} bodies, {} frames, {:.3f} ms per step", count, frames, stats.steps ? stats.stepsMs / static_cast<double>(stats.steps) : 0.0), ms, stats.steps);
+	Bench::Report("PhysicsReplay", fmt::format("max step, {}", stats.identical ? "identical to the recording" : "DIVERGED from the recording"), stats.maxStepMs, 1);
+
+	layer.OnDetach();
+	JobSystem::Shutdown();
+}
@@ -0,0 +1,93 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Layers/PhysicsLayer.hpp"
+
+#include <Jolt/Core/Memory.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+
+namespace {
+	constexpr uint32_t c_BodyCount = 10'000;
+	constexpr double c_Duration = 60.0;
+
+	/// Drop a grid of boxes and spheres on a floor, at staggered heights so they don't all land on the same step.
+	void CreateBodies(JPH::BodyInterface &bodies) {
+		JPH::BodyCreationSettings floor{new JPH::BoxShape(JPH::Vec3(200, 1, 200)), JPH::RVec3(0, -1, 0), JPH::Quat::sIdentity(), JPH::EMotionType::Static, PhysicalLayers::NON_MOVING};
+		bodies.CreateAndAddBody(floor, JPH::EActivation::DontActivate);
+
+		const JPH::RefConst<JPH::Shape> box = new JPH::BoxShape(JPH::Vec3(0.5f, 0.5f, 0.5f));
+		const JPH::RefConst<JPH::Shape> sphere = new JPH::SphereShape(0.5f);
+		for (uint32_t i = 0; i < c_BodyCount; ++i) {
+			const float x = static_cast<float>(i % 100) * 3.0f - 150.0f;
+			const float z = static_cast<float>(i / 100) * 3.0f - 150.0f;
+			const float y = 2.0f + static_cast<float>(i % 37);
+			JPH::BodyCreationSettings settings{i % 2 ? box : sphere, JPH::RVec3(x, y, z), JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, PhysicalLayers::MOVING};
+			bodies.CreateAndAddBody(settings, JPH::EActivation::Activate);
+		}
+	}
+
+	/// The time of a frame at 60 fps, with a 100 ms hitch every 2 seconds.
+	double GetFrameTime(const uint32_t frame) {
+		return frame % 120 == 119 ? 0.1 : 1.0 / 60.0;
+	}
+
+	struct RunResult {
+		double totalMs{0.0};
+		double worstFrameMs{0.0};
+		uint64_t steps{0};
+	};
+
+	template<typename Func>
+	RunResult Run(PhysicsLayer &layer, Func &&step) {
+		CreateBodies(layer.GetPhysicsSystem().GetBodyInterface());
+		layer.GetPhysicsSystem().OptimizeBroadPhase();
+
+		RunResult result;
+		double elapsed = 0.0;
+		for (uint32_t frame = 0; elapsed < c_Duration; ++frame) {
+			const double seconds = GetFrameTime(frame);
+			const auto start = std::chrono::high_resolution_clock::now();
+			result.steps += step(seconds);
+			const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			result.totalMs += ms;
+			result.worstFrameMs = std::max(result.worstFrameMs, ms);
+			elapsed += seconds;
+		}
+		return result;
+	}
+} // namespace
+
+MGN_BENCHMARK(PhysicsStep) {
+	JPH::RegisterDefaultAllocator();
+	JobSystem::Initialize(std::max(1u, std::thread::hardware_concurrency()) - 1);
+
+	{
+		// A single variable step per frame, like the layer did before the fixed time step.
+		PhysicsLayer layer;
+		layer.OnAttach();
+		const RunResult variable = Run(layer, [&layer](const double seconds) {
+			layer.GetPhysicsSystem().Update(static_cast<float>(seconds), 4, &layer.m_TempAllocator, &layer.m_JobSystem);
+			return 1u;
+		});
+		layer.OnDetach();
+		Bench::Report("PhysicsStep", fmt::format("variable, {} bodies, {} s ({:.2f} ms worst frame)", c_BodyCount, c_Duration, variable.worstFrameMs), variable.totalMs, variable.steps);
+	}
+
+	for (const uint32_t rate: {60u, 120u}) {
+		FixedTimestepSettings settings;
+		settings.Rate = rate;
+		PhysicsLayer layer{settings};
+		layer.OnAttach();
+		const RunResult fixed = Run(layer, [&layer](const double seconds) { return layer.Simulate(seconds); });
+		const FixedTimestepStats &stats = layer.GetTimestep().GetStats();
+		layer.OnDetach();
+		Bench::Report("PhysicsStep", fmt::format("fixed {} Hz, {} bodies, {} s ({:.2f} ms worst frame)", rate, c_BodyCount, c_Duration, fixed.worstFrameMs), fixed.totalMs, fixed.steps);
+		MGN_CORE_INFO("    {} steps, {:.3f} ms per step, {:.2f} s dropped in {} frames.", fixed.steps, fixed.totalMs / static_cast<double>(fixed.steps), stats.droppedSeconds, stats.clampedFrames);
+	}
+
+	JobSystem::Shutdown();
+}
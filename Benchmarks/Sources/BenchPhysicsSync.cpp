@@ -0,0 +1,69 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Components/Physicalisable.hpp"
+#include "Imagine/Layers/PhysicsLayer.hpp"
+#include "Imagine/Physics/PhysicsTypeHelpers.hpp"
+
+#include <Jolt/Core/Memory.h>
+
+MGN_BENCHMARK(PhysicsSync) {
+	constexpr uint32_t count = 50'000;
+
+	JPH::RegisterDefaultAllocator();
+	JobSystem::Initialize();
+
+	PhysicsLayer layer;
+	layer.OnAttach();
+	JPH::BodyInterface &lockingInterface = layer.GetPhysicsSystem().GetBodyInterface();
+
+	{
+		// Spheres far enough from each other to never collide, all of them falling.
+		Scene scene;
+		scene.Prepare(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			const EntityID id = scene.CreateEntity();
+			scene.SetLocalPosition(id, Vec3(static_cast<Real>(i % 250) * 2, 100, static_cast<Real>(i / 250) * 2));
+			scene.AddComponent<Physicalisable>(id)->Shape = ColliderShapes::Sphere{0.5};
+		}
+		scene.CacheTransforms();
+		PhysicsLayer::SetSimulating(false);
+		layer.Synchronize(scene);
+
+		// Paused, with no entity moved.
+		const double pausedBefore = Bench::Measure(10, [&]() {
+			scene.Query<Physicalisable>().Each([&](const EntityID id, Physicalisable &comp) {
+				const TransformR trs = scene.GetTransform(id);
+				lockingInterface.SetPositionAndRotation(comp.BodyID, Convert(trs.LocalPosition), Convert(trs.LocalRotation), comp.GetActivation());
+			});
+		});
+		Bench::Report("PhysicsSync", fmt::format("paused, per body locks, {} bodies", count), pausedBefore, count);
+
+		const double pausedAfter = Bench::Measure(10, [&]() { layer.Synchronize(scene); });
+		Bench::Report("PhysicsSync", fmt::format("paused, batched (x{:.2f})", pausedBefore / pausedAfter), pausedAfter, count);
+
+		// Simulating, with every body active.
+		PhysicsLayer::SetSimulating(true);
+		layer.Simulate(1.0 / 60.0);
+
+		const double simulatingBefore = Bench::Measure(10, [&]() {
+			scene.Query<Physicalisable>().Each([&](const EntityID id, Physicalisable &comp) {
+				scene.SetLocalPosition(id, Convert(lockingInterface.GetPosition(comp.BodyID)));
+				scene.SetLocalRotation(id, Convert(lockingInterface.GetRotation(comp.BodyID)));
+				lockingInterface.AddLinearAndAngularVelocity(comp.BodyID, JPH::Vec3::sZero(), JPH::Vec3::sZero());
+			});
+			scene.CacheTransforms();
+		});
+		Bench::Report("PhysicsSync", fmt::format("simulating, per body locks, {} bodies", count), simulatingBefore, count);
+
+		const double simulatingAfter = Bench::Measure(10, [&]() { layer.Synchronize(scene); });
+		Bench::Report("PhysicsSync", fmt::format("simulating, batched (x{:.2f})", simulatingBefore / simulatingAfter), simulatingAfter, count);
+
+		PhysicsLayer::SetSimulating(false);
+	}
+
+	layer.OnDetach();
+	JobSystem::Shutdown();
+}
@@ -0,0 +1,65 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Benchmark.hpp"
+
+namespace {
+	struct BenchVelocity {
+		Vec3 linear{0};
+		Vec3 angular{0};
+	};
+} // namespace
+
+MGN_BENCHMARK(SceneLoad) {
+	constexpr uint32_t count = 50'000;
+
+	const std::filesystem::path root = std::filesystem::temp_directory_path() / "imagine_bench_scene";
+	const std::filesystem::path readablePath = root / "readable";
+	const std::filesystem::path binaryPath = root / "scene.mgnb";
+	std::filesystem::remove_all(root);
+
+	{
+		Scene scene;
+		scene.RegisterType<BenchVelocity>();
+		scene.Prepare(count);
+		std::vector<EntityID> entities;
+		entities.reserve(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			const EntityID parent = i < 100 ? EntityID{EntityID::NullID} : entities[i / 100 - 1];
+			const EntityID id = scene.CreateEntity(parent);
+			scene.SetLocalPosition(id, Vec3(static_cast<Real>(i), 0, 0));
+			if (i % 2 == 0) scene.AddComponent<BenchVelocity>(id, BenchVelocity{Vec3(1), Vec3(0)});
+			entities.push_back(id);
+		}
+		SceneSerializer::SerializeReadable(&scene, readablePath);
+	}
+
+	const double convert = Bench::Measure(1, [&]() {
+		SceneSerializer::ConvertReadableToBinary(readablePath, binaryPath);
+	});
+	Bench::Report("SceneLoad", fmt::format("{} entities, readable to binary", count), convert, count);
+
+	const double readable = Bench::Measure(1, [&]() {
+		Scene *scene = SceneSerializer::DeserializeReadable(readablePath);
+		Bench::DoNotOptimize(scene);
+		delete scene;
+	});
+	Bench::Report("SceneLoad", fmt::format("{} entities, readable", count), readable, count);
+
+	const double binary = Bench::Measure(10, [&]() {
+		Scene *scene = SceneSerializer::DeserializeBinary(binaryPath);
+		Bench::DoNotOptimize(scene);
+		delete scene;
+	});
+	Bench::Report("SceneLoad", fmt::format("{} entities, binary (x{:.1f})", count, readable / binary), binary, count);
+
+	const double mapped = Bench::Measure(10, [&]() {
+		BinarySceneFile file{binaryPath};
+		const BinarySceneComponent *component = file.FindComponent(UUIDFromType<BenchVelocity>());
+		Bench::DoNotOptimize(component ? file.GetComponentData(*component).At<BenchVelocity>(0) : BenchVelocity{});
+	});
+	Bench::Report("SceneLoad", fmt::format("{} entities, mapped in place", count), mapped, count);
+
+	std::filesystem::remove_all(root);
+}
@@ -0,0 +1,85 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Components/Physicalisable.hpp"
+#include "Imagine/Layers/PhysicsLayer.hpp"
+#include "Imagine/Physics/ShapeCache.hpp"
+
+#include <Jolt/Core/Memory.h>
+
+namespace {
+	constexpr uint32_t c_BodyCount = 10'000;
+
+	/// Bytes allocated through the Jolt allocator, the frees aren't subtracted.
+	std::atomic<uint64_t> s_AllocatedBytes{0};
+	JPH::AllocateFunction s_Allocate = nullptr;
+	JPH::AlignedAllocateFunction s_AlignedAllocate = nullptr;
+
+	void *CountingAllocate(const size_t size) {
+		s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		return s_Allocate(size);
+	}
+
+	void *CountingAlignedAllocate(const size_t size, const size_t alignment) {
+		s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+		return s_AlignedAllocate(size, alignment);
+	}
+
+	struct RunResult {
+		double ms{0.0};
+		uint64_t allocatedBytes{0};
+		uint64_t shapeBytes{0};
+	};
+
+	/// Create the crates with 'getShape', then destroy them.
+	template<typename Func>
+	RunResult Run(JPH::BodyInterface &bodies, Func &&getShape) {
+		std::vector<JPH::BodyID> ids;
+		ids.reserve(c_BodyCount);
+
+		RunResult result;
+		const uint64_t before = s_AllocatedBytes.load();
+		const auto start = std::chrono::high_resolution_clock::now();
+		for (uint32_t i = 0; i < c_BodyCount; ++i) {
+			const JPH::ShapeRefC shape = getShape();
+			const JPH::RVec3 position(static_cast<float>(i % 100) * 2.0f, 0.0f, static_cast<float>(i / 100) * 2.0f);
+			const JPH::BodyCreationSettings settings{shape, position, JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, PhysicalLayers::MOVING};
+			ids.push_back(bodies.CreateAndAddBody(settings, JPH::EActivation::DontActivate));
+			result.shapeBytes += shape->GetStats().mSizeBytes;
+		}
+		result.ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		result.allocatedBytes = s_AllocatedBytes.load() - before;
+
+		bodies.RemoveBodies(ids.data(), static_cast<int>(ids.size()));
+		bodies.DestroyBodies(ids.data(), static_cast<int>(ids.size()));
+		return result;
+	}
+} // namespace
+
+MGN_BENCHMARK(ShapeCache) {
+	JPH::RegisterDefaultAllocator();
+	s_Allocate = JPH::Allocate;
+	s_AlignedAllocate = JPH::AlignedAllocate;
+	JPH::Allocate = &CountingAllocate;
+	JPH::AlignedAllocate = &CountingAlignedAllocate;
+
+	PhysicsLayer layer;
+	layer.OnAttach();
+	JPH::BodyInterface &bodies = layer.GetPhysicsSystem().GetBodyInterfaceNoLock();
+
+	const Physicalisable::ShapeVariant crate = ColliderShapes::Box{Vec3(1, 1, 1)};
+	const RunResult unique = Run(bodies, [&crate]() { return std::visit([](const auto &args) { return ColliderShapes::CreateShape(args); }, crate); });
+	Bench::Report("ShapeCache", fmt::format("{} crates, one shape each", c_BodyCount), unique.ms, c_BodyCount);
+	MGN_CORE_INFO("    {:.2f} MB allocated by Jolt, {:.2f} MB of shapes.", static_cast<double>(unique.allocatedBytes) / (1024.0 * 1024.0), static_cast<double>(unique.shapeBytes) / (1024.0 * 1024.0));
+
+	const RunResult cached = Run(bodies, [&crate]() { return ShapeCache::GetShape(crate); });
+	const ShapeCacheStats stats = ShapeCache::GetStats();
+	Bench::Report("ShapeCache", fmt::format("{} crates, shared shape (x{:.2f})", c_BodyCount, unique.ms / cached.ms), cached.ms, c_BodyCount);
+	MGN_CORE_INFO("    {:.2f} MB allocated by Jolt, {} shapes of {} bytes in the cache, {} hits.", static_cast<double>(cached.allocatedBytes) / (1024.0 * 1024.0), stats.shapes, stats.bytes, stats.hits);
+
+	layer.OnDetach();
+	JPH::Allocate = s_Allocate;
+	JPH::AlignedAllocate = s_AlignedAllocate;
+}
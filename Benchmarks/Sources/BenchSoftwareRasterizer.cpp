@@ -0,0 +1,75 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Rendering/CPU/CPUModel.hpp"
+#include "Imagine/Rendering/Camera.hpp"
+#include "Imagine/Rendering/Renderer.hpp"
+
+#if defined(MGN_RENDERER_CPU)
+
+MGN_BENCHMARK(SoftwareRasterizer) {
+	const std::filesystem::path source = std::filesystem::path(MGN_BENCHMARKS_ENGINE_ASSETS) / "Models" / "Sponza" / "Sponza.gltf";
+	if (!std::filesystem::exists(source)) {
+		MGN_CORE_WARNING("Skipping the software rasterizer benchmark, '{}' is missing.", source.string());
+		return;
+	}
+
+	// The importer references the default materials.
+	CPUMaterial::InitDefaultMaterials(NULL_ASSET_HANDLE, NULL_ASSET_HANDLE);
+	const Ref<CPUModel> model = CPUModel::ImportModel(source);
+	if (!model) {
+		MGN_CORE_ERROR("Failed to import '{}'.", source.string());
+		return;
+	}
+
+	ApplicationParameters params{};
+	params.Renderer = RendererParameters{};
+	params.Renderer->Width = 1920;
+	params.Renderer->Height = 1080;
+	const Scope<Renderer> renderer{Renderer::Create(params)};
+
+	// Every surface of the model, drawn without culling so each frame rasterizes the whole scene.
+	DrawContext ctx;
+	uint64_t triangles = 0;
+	for (const Ref<CPUMesh> &mesh: model->Meshes) {
+		mesh->gpu = renderer->LoadMesh(*mesh);
+	}
+	for (const CPUModel::Node &node: model->Nodes) {
+		for (const Weak<CPUMesh> &weak: node.meshes) {
+			const Ref<CPUMesh> mesh = weak.lock();
+			if (!mesh || !mesh->gpu) continue;
+			ctx.OpaqueSurfaces.emplace_back(node.worldMatrix, mesh->gpu.get());
+			if (!mesh->Lods.empty()) triangles += mesh->Lods.front().count / 3;
+		}
+	}
+
+	// Standing in the atrium, looking down the nave.
+	Camera camera;
+	camera.position = {0, 2, 0};
+	camera.pitch = 0;
+	camera.yaw = 90;
+	Camera *previousCamera = Camera::s_MainCamera;
+	Camera::s_MainCamera = &camera;
+
+	const uint32_t hardware = std::max(1u, std::thread::hardware_concurrency());
+	double reference = 0;
+	for (const uint32_t threads: {1u, 2u, 4u, 8u, 16u, 32u}) {
+		if (threads > hardware) break;
+		JobSystem::Initialize(threads - 1);
+		const double ms = Bench::Measure(5, [&]() {
+			if (renderer->BeginDraw({}, {})) {
+				renderer->Draw(ctx);
+				renderer->EndDraw();
+			}
+		});
+		if (threads == 1) reference = ms;
+		Bench::Report("SoftwareRasterizer", fmt::format("{} threads, 1920x1080, {:.1f} Mtri/s (x{:.2f})", threads, static_cast<double>(triangles) / (ms * 1000.0), reference / ms), ms, triangles);
+		JobSystem::Shutdown();
+	}
+
+	Camera::s_MainCamera = previousCamera;
+}
+
+#endif
@@ -0,0 +1,51 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Benchmark.hpp"
+
+MGN_BENCHMARK(TransformCache) {
+	constexpr uint32_t count = 100'000;
+	constexpr uint32_t childrenPerNode = 8;
+
+	JobSystem::Initialize();
+
+	// Wide and shallow hierarchy, each entity has up to 8 children.
+	Scene scene;
+	scene.Prepare(count);
+	std::vector<EntityID> entities;
+	entities.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		const EntityID parent = i < childrenPerNode ? EntityID::NullID : entities[i / childrenPerNode - 1];
+		const EntityID id = scene.CreateEntity(parent);
+		scene.SetLocalPosition(id, Vec3(1, 0, 0));
+		entities.push_back(id);
+	}
+	scene.CacheTransforms();
+
+	const double full = Bench::Measure(10, [&]() {
+		for (const EntityID id: entities) {
+			scene.MarkTransformDirty(id);
+		}
+		scene.CacheTransforms();
+	});
+	Bench::Report("TransformCache", fmt::format("{} entities, all dirty", count), full, count);
+
+	const double staticScene = Bench::Measure(100, [&]() {
+		scene.CacheTransforms();
+	});
+	Bench::Report("TransformCache", fmt::format("{} entities, static", count), staticScene, count);
+
+	for (const uint32_t dirty: {10u, 1000u}) {
+		const double ms = Bench::Measure(10, [&]() {
+			// The last entities are all leaves, so the dirty set doesn't grow with the subtrees.
+			for (uint32_t i = 0; i < dirty; ++i) {
+				scene.MarkTransformDirty(entities[count - 1 - i * 7]);
+			}
+			scene.CacheTransforms();
+		});
+		Bench::Report("TransformCache", fmt::format("{} entities, {} dirty leaves", count, dirty), ms, dirty);
+	}
+
+	JobSystem::Shutdown();
+}
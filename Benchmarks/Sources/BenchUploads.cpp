@@ -0,0 +1,184 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Rendering/StagingRing.hpp"
+
+namespace {
+	/// Stand-in for the GPU: a thread executing the copies of the submitted batches and signalling their value.
+	/// Each batch also costs a fixed latency, the order of a submission and of the signal of its semaphore.
+	class CopyEngine {
+	public:
+		static inline constexpr std::chrono::microseconds c_SubmitLatency{100};
+
+		struct Copy {
+			const std::byte *source;
+			std::byte *destination;
+			uint64_t size;
+		};
+
+	public:
+		CopyEngine() :
+			m_Thread([this]() { Run(); }) {}
+		~CopyEngine() {
+			{
+				std::lock_guard lock(m_Mutex);
+				m_Stop = true;
+			}
+			m_Condition.notify_all();
+			m_Thread.join();
+		}
+
+		void Submit(std::vector<Copy> copies, const uint64_t value) {
+			{
+				std::lock_guard lock(m_Mutex);
+				m_Batches.push_back({std::move(copies), value});
+			}
+			m_Condition.notify_all();
+		}
+
+		[[nodiscard]] uint64_t GetCompleted() const { return m_Completed.load(std::memory_order_acquire); }
+
+		void Wait(const uint64_t value) {
+			std::unique_lock lock(m_Mutex);
+			m_Done.wait(lock, [&]() { return GetCompleted() >= value; });
+		}
+
+	private:
+		struct Batch {
+			std::vector<Copy> copies;
+			uint64_t value;
+		};
+
+		void Run() {
+			while (true) {
+				Batch batch;
+				{
+					std::unique_lock lock(m_Mutex);
+					m_Condition.wait(lock, [&]() { return m_Stop || !m_Batches.empty(); });
+					if (m_Batches.empty()) return;
+					batch = std::move(m_Batches.front());
+					m_Batches.pop_front();
+				}
+				const auto end = std::chrono::high_resolution_clock::now() + c_SubmitLatency;
+				while (std::chrono::high_resolution_clock::now() < end) {}
+				for (const Copy &copy: batch.copies) {
+					std::memcpy(copy.destination, copy.source, copy.size);
+				}
+				{
+					std::lock_guard lock(m_Mutex);
+					m_Completed.store(batch.value, std::memory_order_release);
+				}
+				m_Done.notify_all();
+			}
+		}
+
+	private:
+		std::mutex m_Mutex;
+		std::condition_variable m_Condition;
+		std::condition_variable m_Done;
+		std::deque<Batch> m_Batches;
+		std::atomic<uint64_t> m_Completed{0};
+		bool m_Stop{false};
+		std::thread m_Thread;
+	};
+
+	/// Sizes of the uploads of a scene load: small meshes, big meshes and textures, 1 MiB on average.
+	std::vector<uint64_t> MakeUploads(const uint32_t count) {
+		constexpr uint64_t sizes[] = {16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024, 2 * 1024 * 1024, 2688 * 1024};
+		std::vector<uint64_t> uploads(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			uploads[i] = sizes[(i * 7) % std::size(sizes)];
+		}
+		return uploads;
+	}
+
+	void ReportUploads(const std::string &label, const double milliseconds, const uint64_t bytes, const uint64_t uploads, const UploadStats &stats) {
+		Bench::Report("Uploads", label, milliseconds, uploads);
+		MGN_CORE_INFO("    {:.1f} MB/s, {} batches, {} stalls for {:.2f} ms.", static_cast<double>(bytes) / (1024.0 * 1024.0) / (milliseconds / 1000.0), stats.batches, stats.stalls, stats.stallMilliseconds);
+	}
+} // namespace
+
+MGN_BENCHMARK(Uploads) {
+	constexpr uint32_t count = 256;
+	constexpr uint32_t uploadsPerFrame = 16;
+
+	const std::vector<uint64_t> uploads = MakeUploads(count);
+	const uint64_t total = std::accumulate(uploads.begin(), uploads.end(), uint64_t{0});
+	std::vector<std::byte> source(*std::max_element(uploads.begin(), uploads.end()), std::byte{0x2a});
+	std::vector<std::byte> destination(total);
+
+	// One staging buffer per upload, submitted and waited right away.
+	{
+		CopyEngine engine;
+		UploadStats stats{};
+		const double ms = Bench::Measure(3, [&]() {
+			stats = {};
+			uint64_t offset = 0;
+			for (const uint64_t size: uploads) {
+				std::vector<std::byte> staging(size);
+				std::memcpy(staging.data(), source.data(), size);
+				engine.Submit({{staging.data(), destination.data() + offset, size}}, ++stats.batches);
+
+				const auto start = std::chrono::high_resolution_clock::now();
+				engine.Wait(stats.batches);
+				stats.stallMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+				++stats.stalls;
+				offset += size;
+			}
+		});
+		ReportUploads(fmt::format("immediate submit, {} uploads", count), ms, total, count, stats);
+	}
+
+	// A persistent staging ring, the uploads of a frame submitted as one batch.
+	for (const uint64_t capacity: {uint64_t{8} * 1024 * 1024, uint64_t{32} * 1024 * 1024, uint64_t{64} * 1024 * 1024}) {
+		std::vector<std::byte> staging(capacity);
+		CopyEngine engine;
+		UploadStats stats{};
+		uint64_t value = 0;
+
+		const double ms = Bench::Measure(3, [&]() {
+			engine.Wait(value);
+			StagingRing ring{capacity};
+			stats = {};
+			std::vector<CopyEngine::Copy> copies;
+			uint64_t offset = 0;
+
+			const auto flush = [&]() {
+				if (!ring.Close(value + 1)) return;
+				engine.Submit(std::move(copies), ++value);
+				copies.clear();
+				++stats.batches;
+			};
+
+			for (uint32_t i = 0; i < count; ++i) {
+				const uint64_t size = uploads[i];
+				std::optional<uint64_t> allocation = ring.Allocate(size);
+				if (!allocation) {
+					const auto start = std::chrono::high_resolution_clock::now();
+					++stats.stalls;
+					flush();
+					while (!allocation) {
+						ring.Retire(engine.GetCompleted());
+						allocation = ring.Allocate(size);
+						if (!allocation) engine.Wait(ring.GetOldestValue().value());
+					}
+					stats.stallMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+				}
+
+				std::memcpy(staging.data() + allocation.value(), source.data(), size);
+				copies.push_back({staging.data() + allocation.value(), destination.data() + offset, size});
+				offset += size;
+
+				if ((i + 1) % uploadsPerFrame == 0) {
+					flush();
+					ring.Retire(engine.GetCompleted());
+				}
+			}
+			flush();
+			engine.Wait(value);
+		});
+		ReportUploads(fmt::format("staging ring of {} MiB, {} uploads per batch", capacity / (1024 * 1024), uploadsPerFrame), ms, total, count, stats);
+	}
+}
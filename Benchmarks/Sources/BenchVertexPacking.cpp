@@ -0,0 +1,45 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Benchmark.hpp"
+#include "Imagine/Rendering/VertexPacker.hpp"
+
+MGN_BENCHMARK(VertexPacking) {
+	constexpr uint32_t count = 1'000'000;
+
+	// A large imported mesh: unit normals and tangents, UVs in [0, 1], no vertex color.
+	std::vector<Vertex> vertices(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		const float a = static_cast<float>(i) * 0.001f;
+		Vertex &vertex = vertices[i];
+		vertex.position = {std::cos(a) * 50.0f, static_cast<float>(i % 1000) * 0.01f, std::sin(a) * 50.0f};
+		vertex.normal = {std::cos(a), 0, std::sin(a)};
+		vertex.tangent = {-std::sin(a), 0, std::cos(a), 0};
+		vertex.bitangent = {0, 1, 0, 0};
+		vertex.uv_x = static_cast<float>(i % 1024) / 1024.0f;
+		vertex.uv_y = static_cast<float>(i / 1024 % 1024) / 1024.0f;
+	}
+
+	const uint64_t fullSize = VertexPacker::GetVertexSize(VertexLayout::Full) * count;
+	for (const VertexLayout layout: {VertexLayout::Full, VertexLayout::Compact, VertexLayout::Quantized}) {
+		PackedVertices packed;
+		const double pack = Bench::Measure(5, [&]() {
+			packed = VertexPacker::Pack(vertices, layout);
+			Bench::DoNotOptimize(packed.vertices.data());
+		});
+
+		// The copy to the staging buffer is the CPU side of the upload.
+		std::vector<std::byte> staging(packed.GetSize());
+		const double upload = Bench::Measure(5, [&]() {
+			std::memcpy(staging.data(), packed.vertices.data(), packed.vertices.size());
+			std::memcpy(staging.data() + packed.vertices.size(), packed.colors.data(), packed.colors.size() * sizeof(uint32_t));
+			Bench::DoNotOptimize(staging.data());
+		});
+
+		const std::string name = VertexLayoutToString(layout);
+		Bench::Report("VertexPacking", fmt::format("pack {} vertices to {}", count, name), pack, count);
+		Bench::Report("VertexPacking", fmt::format("copy of {} to the staging buffer", name), upload, count);
+		MGN_CORE_INFO("    {}: {} bytes per vertex, {:.2f} MB ({:.0f}% of Full).", name, VertexPacker::GetVertexSize(layout), static_cast<double>(packed.GetSize()) / (1024.0 * 1024.0), 100.0 * static_cast<double>(packed.GetSize()) / static_cast<double>(fullSize));
+	}
+}
@@ -0,0 +1,45 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Benchmark.hpp"
+
+namespace Imagine::Bench {
+
+	std::vector<BenchmarkEntry> &GetBenchmarks() {
+		static std::vector<BenchmarkEntry> s_Benchmarks;
+		return s_Benchmarks;
+	}
+
+	int RegisterBenchmark(const char *name, const BenchmarkFunction function) {
+		GetBenchmarks().push_back({name, function});
+		return static_cast<int>(GetBenchmarks().size());
+	}
+
+	void Report(const char *benchmark, const std::string &label, const double milliseconds, const uint64_t items) {
+		const double nsPerItem = items ? (milliseconds * 1'000'000.0) / static_cast<double>(items) : 0.0;
+		std::printf("%-28s %-48s %12.3f ms %10.2f ns/item\n", benchmark, label.c_str(), milliseconds, nsPerItem);
+		std::fflush(stdout);
+	}
+
+} // namespace Imagine::Bench
+
+/// Usage: MGN_Benchmarks [filter...]
+/// Only the benchmarks whose name contains one of the filters are run. All of them are run without filter.
+int main(const int argc, char **argv) {
+	Imagine::Log::Init({std::nullopt, Imagine::c_DefaultLogPattern, true});
+
+	for (const Imagine::Bench::BenchmarkEntry &entry: Imagine::Bench::GetBenchmarks()) {
+		bool selected = argc <= 1;
+		for (int i = 1; i < argc && !selected; ++i) {
+			selected = std::string_view{entry.name}.find(argv[i]) != std::string_view::npos;
+		}
+		if (!selected) continue;
+
+		std::printf("== %s ==\n", entry.name);
+		entry.function();
+	}
+
+	Imagine::Log::Shutdown();
+	return 0;
+}
@@ -0,0 +1,60 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#pragma once
+
+#include <Imagine/Core.hpp>
+
+using namespace Imagine::Literal;
+using namespace Imagine;
+
+namespace Imagine::Bench {
+
+	using BenchmarkFunction = void (*)();
+
+	struct BenchmarkEntry {
+		const char *name;
+		BenchmarkFunction function;
+	};
+
+	/// All the benchmarks registered with MGN_BENCHMARK, in registration order.
+	std::vector<BenchmarkEntry> &GetBenchmarks();
+	int RegisterBenchmark(const char *name, BenchmarkFunction function);
+
+	/// Print one result line: the benchmark, the case, the time and the time per item.
+	void Report(const char *benchmark, const std::string &label, double milliseconds, uint64_t items);
+
+	/// Prevent the compiler from optimizing away a value computed by the benchmark.
+	template<typename T>
+	inline void DoNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void *s_Sink;
+		s_Sink = &value;
+#endif
+	}
+
+	/**
+	 * Run the function 'iterations' times and return the best time in milliseconds.
+	 * The best time is less sensitive to the scheduler than the average when the machine is busy.
+	 */
+	template<typename Func>
+	double Measure(const uint32_t iterations, Func &&func) {
+		double best = std::numeric_limits<double>::max();
+		for (uint32_t i = 0; i < iterations; ++i) {
+			const auto start = std::chrono::high_resolution_clock::now();
+			func();
+			const auto end = std::chrono::high_resolution_clock::now();
+			best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+		}
+		return best;
+	}
+
+} // namespace Imagine::Bench
+
+#define MGN_BENCHMARK(name)                                                                             \
+	static void MGN_Benchmark_##name();                                                                 \
+	static const int s_MGN_Benchmark_##name = ::Imagine::Bench::RegisterBenchmark(#name, &MGN_Benchmark_##name); \
+	static void MGN_Benchmark_##name()
@@ -6,8 +6,12 @@
 
 #include "Imagine/Core/Profiling.hpp"
 #include "ApplicationParameters.hpp"
+#include "Imagine/Application/FrameCapture.hpp"
 #include "Imagine/Events/ApplicationEvent.hpp"
 #include "Imagine/Layers/LayerStack.hpp"
+#include "Imagine/Rendering/DrawExtractor.hpp"
+#include "Imagine/Rendering/DrawSort.hpp"
+#include "Imagine/Rendering/FrustumCuller.hpp"
 #include "Imagine/Rendering/Renderer.hpp"
 #include "Window.hpp"
 
@@ -61,6 +65,10 @@ namespace Imagine {
 		void Stop();
 		void Run();
 		double Time() const;
+		/// The culling stats of the last drawn frame.
+		const CullingStats &GetCullingStats() const { return m_FrustumCuller.GetStats(); }
+		/// The stage timings of the last frame.
+		const FrameTimings &GetFrameTimings() const { return m_FrameTimings; }
 
 	private:
 		bool OnWindowClose(WindowCloseEvent &e);
@@ -80,6 +88,14 @@ namespace Imagine {
 
 	private:
 		LayerStack m_LayerStack;
+		DrawExtractor m_DrawExtractor;
+		FrustumCuller m_FrustumCuller;
+		DrawSorter m_DrawSorter;
+		/// Draw lists of the scenes and of the physics debug, reset every frame.
+		DrawContext m_SceneContext;
+		DrawContext m_PhysicsContext;
+		FrameTimings m_FrameTimings;
+		Scope<FrameCapture> m_Capture{nullptr};
 
 	private:
 		std::chrono::high_resolution_clock::time_point m_Start;
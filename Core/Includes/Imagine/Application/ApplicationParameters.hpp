@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "Imagine/Application/CaptureParameters.hpp"
 #include "Imagine/Application/WindowParameters.hpp"
 #include "Imagine/Core/Macros.hpp"
 #include "Imagine/Rendering/RendererParameters.hpp"
@@ -16,6 +17,12 @@ namespace Imagine {
 		uint32_t AppVersion;
 		std::optional<WindowParameters> Window;
 		std::optional<RendererParameters> Renderer;
+		/// Number of worker threads of the JobSystem. Default to one less than the number of cores.
+		std::optional<uint32_t> WorkerThreads;
+		/// Draw the local axes of every entity of the scenes. Debug pass adding three lines per entity.
+		bool DrawGizmos{false};
+		/// Headless deterministic run writing the last frame and the frame timings, the application stops once it's done.
+		std::optional<CaptureParameters> Capture;
 
 		[[nodiscard]] uint32_t GetMajor() const;
 		[[nodiscard]] uint32_t GetMinor() const;
@@ -0,0 +1,37 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Math/Core.hpp"
+
+namespace Imagine {
+
+	/// A point of the camera path, reached at 'Time' seconds.
+	struct CameraKey {
+		Real Time{0};
+		Vec3 Position{0};
+		/// Vertical rotation, in degrees.
+		float Pitch{0};
+		/// Horizontal rotation, in degrees.
+		float Yaw{0};
+	};
+
+	/**
+	 * Run a fixed number of frames with a fixed time step and camera path, then write the last frame and the frame timings.
+	 * The frame only depends on the parameters, so the image can be compared against a reference.
+	 */
+	struct CaptureParameters {
+		uint32_t FrameCount{60};
+		/// Delta time given to every frame, in seconds.
+		double TimeStep{1.0 / 60.0};
+		/// The keys are interpolated linearly and must be sorted by time. An empty path leaves the camera where it is.
+		std::vector<CameraKey> CameraPath{};
+		/// Written as a PNG.
+		std::filesystem::path ImagePath{"Capture.png"};
+		/// Per stage frame timings, as JSON.
+		std::filesystem::path TimingsPath{"Capture.json"};
+	};
+
+} // namespace Imagine
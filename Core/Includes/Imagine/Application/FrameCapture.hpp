@@ -0,0 +1,69 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Application/CaptureParameters.hpp"
+#include "Imagine/Core/TimeStep.hpp"
+#include "Imagine/Math/Image.hpp"
+
+namespace Imagine {
+	class Camera;
+	class Renderer;
+
+	/// Time spent in each stage of a frame, in milliseconds.
+	struct FrameTimings {
+		double extraction{0};
+		double culling{0};
+		double raster{0};
+		double present{0};
+		double frame{0};
+	};
+
+	/// Add the time spent in the scope to one of the stages of a FrameTimings.
+	class StageTimer {
+	public:
+		explicit StageTimer(double &stage) :
+			m_Stage(stage), m_Start(std::chrono::high_resolution_clock::now()) {}
+		~StageTimer() { m_Stage += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - m_Start).count(); }
+
+	private:
+		double &m_Stage;
+		std::chrono::high_resolution_clock::time_point m_Start;
+	};
+
+	/**
+	 * Drive the application for a deterministic headless run.
+	 * The capture gives the time step and the camera of each frame, records the timings of the frames,
+	 * and writes the last frame and the timings once all the frames are done.
+	 */
+	class FrameCapture {
+	public:
+		explicit FrameCapture(CaptureParameters parameters);
+
+	public:
+		[[nodiscard]] TimeStep GetTimeStep() const { return {m_Parameters.TimeStep}; }
+		/// Place the camera where the path is at the given frame.
+		void PlaceCamera(uint64_t frame, Camera &camera) const;
+
+		void Record(const FrameTimings &timings);
+		[[nodiscard]] bool IsDone() const { return m_Frames.size() >= m_Parameters.FrameCount; }
+		[[nodiscard]] const std::vector<FrameTimings> &GetFrames() const { return m_Frames; }
+
+		/// Read back the last frame of the renderer and write it with the timings.
+		/// @return false if the image or the timings couldn't be written.
+		bool Write(Renderer &renderer) const;
+
+	public:
+		/// @return The camera key interpolated at 'time', clamped to the first and last keys.
+		[[nodiscard]] static CameraKey Evaluate(const std::vector<CameraKey> &path, Real time);
+		/// @return The timings of every frame and their mean, min and max per stage, as JSON.
+		[[nodiscard]] std::string TimingsToJson(uint32_t width, uint32_t height) const;
+
+	private:
+		CaptureParameters m_Parameters;
+		std::vector<FrameTimings> m_Frames;
+	};
+
+} // namespace Imagine
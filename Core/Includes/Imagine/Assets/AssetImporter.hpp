@@ -19,6 +19,9 @@ namespace Imagine
 		static std::vector<AssetType> GetPossibleAssetTypes(const Path& path);
 		static bool HasAssetType(const Path& path, AssetType type);
 		static Ref<Asset> ImportAsset(const AssetMetadata& metadata);
+
+		/// Set the import function of a type. Must not be called while assets are being streamed.
+		static void RegisterImporter(AssetType type, AssetImportFunction importer);
 	private:
 		static std::unordered_map<AssetType, AssetImportFunction> AssetLoaders;
 		static std::unordered_map<AssetType, AssetDetectorFunction> AssetDetectors;
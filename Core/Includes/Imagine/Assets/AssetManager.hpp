@@ -33,6 +33,31 @@ namespace Imagine
 			return nullptr;
 		}
 
+		inline static Ref<AssetRequest> RequestAsset(AssetHandle handle, AssetLoadPriority priority = AssetLoadPriority::Normal)
+		{
+			MGN_PROFILE_FUNCTION();
+			return Project::GetActive()->GetAssetManager()->RequestAsset(handle, priority);
+		}
+
+		/// Non-blocking version of GetAsset: return nullptr and load the asset in the background if it's not loaded yet.
+		inline static Ref<Asset> TryGetAsset(AssetHandle handle, AssetLoadPriority priority = AssetLoadPriority::Normal)
+		{
+			MGN_PROFILE_FUNCTION();
+			return Project::GetActive()->GetAssetManager()->TryGetAsset(handle, priority);
+		}
+
+		inline static void UpdateRequests()
+		{
+			MGN_PROFILE_FUNCTION();
+			Project::GetActive()->GetAssetManager()->UpdateRequests();
+		}
+
+		inline static bool IsAssetLoaded(AssetHandle handle)
+		{
+			MGN_PROFILE_FUNCTION();
+			return Project::GetActive()->GetAssetManager()->IsAssetLoaded(handle);
+		}
+
 		inline static bool IsAssetHandleValid(AssetHandle handle)
 		{
 			MGN_PROFILE_FUNCTION();
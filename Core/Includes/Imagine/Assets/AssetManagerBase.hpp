@@ -7,6 +7,7 @@
 #include "Imagine/Assets/Asset.hpp"
 #include "Imagine/Assets/AssetHandle.hpp"
 #include "Imagine/Assets/AssetMetadata.hpp"
+#include "Imagine/Assets/AssetRequest.hpp"
 #include "Imagine/Core/SmartPointers.hpp"
 
 namespace Imagine {
@@ -31,5 +32,12 @@ namespace Imagine {
 		virtual void UnloadAsset(AssetHandle handle) = 0;
 		virtual bool AddAsset(Ref<Asset> asset) = 0;
 		virtual bool RemoveAsset(AssetHandle handle) = 0;
+
+		/// Start loading the asset in the background. Requests of the same handle share the same AssetRequest.
+		virtual Ref<AssetRequest> RequestAsset(AssetHandle handle, AssetLoadPriority priority) = 0;
+		/// @return The asset if it is loaded. Otherwise, request it and return nullptr without blocking.
+		virtual Ref<Asset> TryGetAsset(AssetHandle handle, AssetLoadPriority priority) = 0;
+		/// Make the assets loaded in the background available. Must be called on the main thread.
+		virtual void UpdateRequests() = 0;
 	};
 } // namespace Imagine
@@ -0,0 +1,70 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Assets/Asset.hpp"
+#include "Imagine/Assets/AssetHandle.hpp"
+#include "Imagine/Core/SmartPointers.hpp"
+
+namespace Imagine {
+
+	enum class AssetLoadState : uint8_t {
+		Pending,
+		Loading,
+		Ready,
+		Failed,
+	};
+
+	enum class AssetLoadPriority : uint8_t {
+		Low,
+		Normal,
+		High,
+	};
+
+	const char *AssetLoadStateToString(AssetLoadState state);
+
+	class FileAssetManager;
+
+	/**
+	 * Shared state of an asynchronous asset load.
+	 * The asset manager keeps a single request per handle, every caller asking for the same asset gets the same request.
+	 */
+	class AssetRequest {
+		friend FileAssetManager;
+
+	public:
+		explicit AssetRequest(const AssetHandle handle, const AssetLoadPriority priority) :
+			m_Handle(handle), m_Priority(priority) {}
+
+	public:
+		[[nodiscard]] AssetHandle GetHandle() const { return m_Handle; }
+		[[nodiscard]] AssetLoadState GetState() const { return m_State.load(std::memory_order_acquire); }
+		[[nodiscard]] AssetLoadPriority GetPriority() const { return m_Priority.load(std::memory_order_relaxed); }
+
+		[[nodiscard]] bool IsReady() const { return GetState() == AssetLoadState::Ready; }
+		[[nodiscard]] bool IsDone() const {
+			const AssetLoadState state = GetState();
+			return state == AssetLoadState::Ready || state == AssetLoadState::Failed;
+		}
+
+		/// @return The loaded asset, or nullptr while the request isn't ready.
+		[[nodiscard]] Ref<Asset> GetAsset() const { return IsReady() ? m_Asset : nullptr; }
+
+		/// Block the calling thread until the request is ready or failed.
+		void Wait() const;
+
+	private:
+		void Complete(Ref<Asset> asset);
+
+	private:
+		AssetHandle m_Handle;
+		std::atomic<AssetLoadPriority> m_Priority;
+		std::atomic<AssetLoadState> m_State{AssetLoadState::Pending};
+		Ref<Asset> m_Asset{nullptr};
+		mutable std::mutex m_Mutex;
+		mutable std::condition_variable m_Condition;
+	};
+
+} // namespace Imagine
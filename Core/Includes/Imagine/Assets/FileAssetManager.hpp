@@ -24,6 +24,15 @@ namespace Imagine {
 	class FileAssetManager final : public AssetManagerBase {
 		friend ProjectLayer;
 		friend FileAssetManagerSerializer;
+	public:
+		static inline constexpr uint32_t c_DefaultStreamingWorkerCount = 2;
+
+	public:
+		FileAssetManager() = default;
+		virtual ~FileAssetManager() override;
+		FileAssetManager(const FileAssetManager &) = delete;
+		FileAssetManager &operator=(const FileAssetManager &) = delete;
+
 	public:
 		[[nodiscard]] virtual bool IsAssetHandleValid(AssetHandle handle) const override;
 		[[nodiscard]] virtual bool IsAssetLoaded(AssetHandle handle) const override;
@@ -34,6 +43,10 @@ namespace Imagine {
 		virtual bool AddAsset(Ref<Asset> asset) override;
 		virtual bool RemoveAsset(AssetHandle handle) override;
 
+		virtual Ref<AssetRequest> RequestAsset(AssetHandle handle, AssetLoadPriority priority = AssetLoadPriority::Normal) override;
+		[[nodiscard]] virtual Ref<Asset> TryGetAsset(AssetHandle handle, AssetLoadPriority priority = AssetLoadPriority::Normal) override;
+		virtual void UpdateRequests() override;
+
 		[[nodiscard]] virtual const AssetMetadata &GetMetadata(AssetHandle handle) const;
 
 	public:
@@ -42,6 +55,9 @@ namespace Imagine {
 
 		Ref<Asset> ImportAsset(const Path &assetPath, AssetType hint = AssetType::None);
 		Ref<Asset> GetOrCreateAsset(const Path &assetPath, AssetType hint = AssetType::None);
+		/// Add the file to the registry without importing it, so it can be loaded later with 'RequestAsset'.
+		/// @return The handle of the asset (the existing one if the path is already registered) or NULL_ASSET_HANDLE if the file cannot be imported.
+		AssetHandle RegisterAssetPath(const Path &assetPath, AssetType hint = AssetType::None);
 
 		void SetPath(AssetHandle handle, Path newPath);
 		[[nodiscard]] Path GetFilePath(AssetHandle) const;
@@ -51,16 +67,63 @@ namespace Imagine {
 
 	public:
 		Ref<Asset> GetLoadedAsset(AssetHandle handle) const;
+		[[nodiscard]] uint64_t GetRegistrySize() const { return m_AssetRegistry.size(); }
+		[[nodiscard]] uint64_t GetRequestCount() const { return m_Requests.size(); }
+
+		/// Number of threads importing the requested assets. Only taken into account before the first request.
+		void SetStreamingWorkerCount(uint32_t count);
 
 		template<typename T, typename... Args>
 		Ref<T> CreateMemoryAsset(Args &&...args);
 
 		template<typename T, typename... Args>
 		Ref<T> CreateAsset(Path path, Args &&...args);
+	private:
+		/// Add the metadata to the registry and the path index. Return false if the handle is already registered.
+		bool Register(const AssetMetadata &metadata);
+		void Unregister(AssetRegistryIterator it);
+		[[nodiscard]] std::optional<AssetHandle> FindHandle(const Path &path) const;
+		[[nodiscard]] Ref<Asset> FindLoadedAsset(AssetHandle handle) const;
+
+		void StartStreaming();
+		void StopStreaming();
+		void StreamingLoop();
+
+	private:
+		struct QueuedRequest {
+			Ref<AssetRequest> request;
+			AssetMetadata metadata;
+			AssetLoadPriority priority{AssetLoadPriority::Normal};
+			uint64_t sequence{0};
+
+			/// Ordering of the priority queue: highest priority first, then first requested.
+			bool operator<(const QueuedRequest &other) const {
+				return priority != other.priority ? priority < other.priority : sequence > other.sequence;
+			}
+		};
+
 	private:
 		AssetMap m_LoadedAssets;
 		AssetMap m_MemoryAssets;
 		AssetRegistry m_AssetRegistry;
+		/// 'Path::normalized()' of every registered asset to its handle.
+		std::unordered_map<std::string, AssetHandle> m_PathIndex;
+
+		/// Requests not yet moved to the loaded assets, and the failed ones so they aren't imported again every frame.
+		std::unordered_map<AssetHandle, Ref<AssetRequest>> m_Requests;
+
+		// Shared with the streaming workers, guarded by m_StreamingMutex.
+		std::mutex m_StreamingMutex;
+		std::condition_variable m_StreamingCondition;
+		std::priority_queue<QueuedRequest> m_StreamingQueue;
+		std::vector<Ref<AssetRequest>> m_CompletedRequests;
+		/// Assets added by the importers running on a streaming worker (i.e. the meshes of a model).
+		std::vector<Ref<Asset>> m_StreamedMemoryAssets;
+		uint64_t m_StreamingSequence{0};
+		bool m_StreamingRunning{false};
+
+		std::vector<std::thread> m_StreamingWorkers;
+		uint32_t m_StreamingWorkerCount{c_DefaultStreamingWorkerCount};
 	};
 
 
@@ -80,7 +143,7 @@ namespace Imagine {
 		metadata.Type = T::GetStaticType();
 		Ref<T> asset = CreateRef<T>(std::forward<Args>(args)...);
 		asset->Handle = metadata.Handle;
-		m_AssetRegistry.emplace(metadata.Handle, metadata);
+		Register(metadata);
 		m_LoadedAssets.emplace(metadata.Handle, asset);
 		// TODO: Save asset manager.
 		return asset;
@@ -0,0 +1,44 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Core/SmartPointers.hpp"
+#include "Imagine/Rendering/CPU/CPUModel.hpp"
+
+namespace Imagine {
+
+	/**
+	 * Cooked version of an imported model, so the next loads skip Assimp and the decoding of the textures.
+	 * The file stores the meshes (vertices, indices and lods), the decoded pixels of the textures,
+	 * the material instances, the file shaders and the node hierarchy of the model.
+	 *
+	 * A cooked file is only used if its key matches the key of the source:
+	 * the xxHash64 of the source file, seeded with the import settings and the cache version.
+	 * The external files referenced by the source (i.e. the textures and buffers of a .gltf) aren't part of the key.
+	 */
+	class ModelCache {
+	public:
+		static inline constexpr uint32_t c_Magic = 0x4D4E474D; // "MGNM"
+		/// 2: the meshes are optimized and hold their simplified LODs.
+		/// 3: the meshes store their vertex layout.
+		static inline constexpr uint32_t c_Version = 3;
+		static inline constexpr const char *const c_Extension = ".mgnmodel";
+
+	public:
+		/// @return The key of the source file for the given import settings, or 0 if the file cannot be read.
+		[[nodiscard]] static uint64_t ComputeKey(const std::filesystem::path &sourcePath, uint32_t importSettings);
+		/// @return The cooked file of the source in the cache directory of the active project.
+		[[nodiscard]] static std::filesystem::path GetCachePath(const std::filesystem::path &sourcePath);
+
+		static bool Write(const CPUModel &model, uint64_t key, const std::filesystem::path &cachePath);
+		/**
+		 * Load the cooked model if it exists and was cooked with the same key.
+		 * Every asset of the model gets a new handle, like a model imported from the source.
+		 * @return The model or nullptr if the cooked file is missing, outdated or corrupted.
+		 */
+		[[nodiscard]] static Ref<CPUModel> Read(const std::filesystem::path &cachePath, uint64_t key);
+	};
+
+} // namespace Imagine
@@ -33,11 +33,19 @@ namespace Imagine {
 		struct Sphere {Real Radius {0.5};};
 		struct Capsule {Real Height {1}; Real Radius{0.5};};
 		struct Cylinder {Real Height {1}; Real Radius{0.5}; };
-
-		const JPH::Shape* CreateShape(Box box);
-		const JPH::Shape* CreateShape(Sphere sphere);
-		const JPH::Shape* CreateShape(Capsule capsule);
-		const JPH::Shape* CreateShape(Cylinder cylinder);
+		/// The convex hull of the vertices of a CPUMesh, usable by the dynamic bodies.
+		struct ConvexHull {AssetHandle MeshHandle{NULL_ASSET_HANDLE};};
+		/// The triangles of a CPUMesh, only usable by the static and kinematic bodies.
+		struct Mesh {AssetHandle MeshHandle{NULL_ASSET_HANDLE};};
+
+		/// Create a new shape, see ShapeCache to share them.
+		JPH::ShapeRefC CreateShape(Box box);
+		JPH::ShapeRefC CreateShape(Sphere sphere);
+		JPH::ShapeRefC CreateShape(Capsule capsule);
+		JPH::ShapeRefC CreateShape(Cylinder cylinder);
+		/// @return Null if the mesh isn't loaded or the shape couldn't be built.
+		JPH::ShapeRefC CreateShape(ConvexHull hull);
+		JPH::ShapeRefC CreateShape(Mesh mesh);
 	}
 
 	struct Physicalisable {
@@ -45,16 +53,20 @@ namespace Imagine {
 		using ShapeVariant = std::variant<ColliderShapes::Box,
 								  ColliderShapes::Sphere,
 								  ColliderShapes::Capsule,
-								  ColliderShapes::Cylinder
+								  ColliderShapes::Cylinder,
+								  ColliderShapes::ConvexHull,
+								  ColliderShapes::Mesh
 		>;
 		enum Type : int {
 			Box,
 			Sphere,
 			Capsule,
 			Cylinder,
+			ConvexHull,
+			Mesh,
 		};
-		static inline const std::array<std::string, 5> TypeNames {"Box","Sphere","Capsule","Cylinder"};
-		static inline constexpr char TypeNamesCombo[] = "Box\0Sphere\0Capsule\0Cylinder";
+		static inline const std::array<std::string, 6> TypeNames {"Box","Sphere","Capsule","Cylinder","Convex Hull","Mesh"};
+		static inline constexpr char TypeNamesCombo[] = "Box\0Sphere\0Capsule\0Cylinder\0Convex Hull\0Mesh";
 	public:
 		Physicalisable() = default;
 		~Physicalisable();
@@ -83,7 +95,8 @@ namespace Imagine {
 		void SetGravityFactor(const Real gravityFactor) {GravityFactor = gravityFactor;}
 		void SetIsAwake(const bool isAwake) {IsAwake = isAwake;}
 	public:
-		const JPH::Shape* GetShape();
+		/// @return The shape shared by every component with the same parameters, or null if it can't be built yet.
+		JPH::ShapeRefC GetShape() const;
 	public:
 		ShapeVariant Shape;
 		RigidbodyType RBType{RB_Dynamic};
@@ -125,6 +138,12 @@ namespace Imagine {
 					case Physicalisable::Cylinder:
 						pShape->emplace<ColliderShapes::Cylinder>();
 						break;
+					case Physicalisable::ConvexHull:
+						pShape->emplace<ColliderShapes::ConvexHull>();
+						break;
+					case Physicalisable::Mesh:
+						pShape->emplace<ColliderShapes::Mesh>();
+						break;
 				}
 			}
 
@@ -155,6 +174,18 @@ namespace Imagine {
 					changed |= ImGuiLib::DragReal("Height##Cylinder", &shp.Height, 0.1, 0.1, REAL_MAX, "%.1f");
 				}
 					break;
+				case Physicalisable::ConvexHull:
+				{
+					ColliderShapes::ConvexHull& shp = std::get<ColliderShapes::ConvexHull>(*pShape);
+					changed |= ImGuiLib::DrawAssetField<CPUMesh>("Mesh##ConvexHull", &shp.MeshHandle);
+				}
+					break;
+				case Physicalisable::Mesh:
+				{
+					ColliderShapes::Mesh& shp = std::get<ColliderShapes::Mesh>(*pShape);
+					changed |= ImGuiLib::DrawAssetField<CPUMesh>("Mesh##Mesh", &shp.MeshHandle);
+				}
+					break;
 			}
 			ImGui::PopID();
 #endif
@@ -16,11 +16,13 @@ namespace Imagine {
 
 	struct Renderable {
 		Renderable() = default;
-		virtual ~Renderable() = default;
+		~Renderable() = default;
 		Renderable(const AssetHandle handle) : cpuMeshOrModel(handle) {}
 
 		AssetHandle cpuMeshOrModel{NULL_ASSET_HANDLE};
 	};
+	/// Written as raw bytes by the scene serializers.
+	static_assert(std::is_trivially_copyable_v<Renderable>);
 
 	namespace ThirdParty::ImGuiLib {
 
@@ -34,6 +34,8 @@
 #include "Imagine/Scene/Entity.hpp"
 #include "Imagine/Scene/Scene.hpp"
 #include "Imagine/Scene/SceneManager.hpp"
+#include "Imagine/Scene/SceneSerializer.hpp"
+#include "Imagine/Scene/BinaryScene.hpp"
 
 #include "Imagine/Project/Project.hpp"
 
@@ -0,0 +1,263 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Core/BufferView.hpp"
+#include "Imagine/Core/Macros.hpp"
+#include "Imagine/Core/UUID.hpp"
+
+namespace Imagine {
+
+	/**
+	 * This is an archetype (or chunk) based component storage.
+	 * Every entity that has the exact same set of components (its signature) lives in the same archetype.
+	 * An archetype stores its entities in fixed-size chunks, each chunk being laid out as a Structure of Arrays:
+	 * one column for the entity IDs, then one contiguous column per component.
+	 *
+	 * Iterating on several components at once is then a linear walk through the chunks of the matching archetypes
+	 * instead of one hash lookup and one sparse->dense hop per component per entity like with the RawSparseSet.
+	 * The price to pay is that adding or removing a component moves the entity (and all its components) to another archetype.
+	 *
+	 * Like the RawSparseSet, the components are only known at runtime by an ID, a size, and optional
+	 * constructor/destructor/copy functions.
+	 * When an entity changes archetype, its components are relocated with a memcpy,
+	 * which is the same assumption the RawHeapArray already does when it reallocates.
+	 */
+	class ArchetypeStorage {
+	public:
+		using ComponentIndex = uint32_t;
+		using ArchetypeIndex = uint32_t;
+
+		static inline constexpr uint32_t c_MaxComponents = 256;
+		static inline constexpr uint32_t c_MaxQueryComponents = 16;
+		static inline constexpr uint32_t c_ChunkByteSize = 16 * 1024;
+		static inline constexpr uint32_t c_ColumnAlignment = 64;
+		static inline constexpr uint32_t c_OverheadResize = 64;
+		static inline constexpr uint32_t c_NullIndex = std::numeric_limits<uint32_t>::max();
+
+		using Signature = std::bitset<c_MaxComponents>;
+
+		/// Struct holding what is needed to manipulate a component we only know at runtime.
+		struct ComponentInfo {
+			UUID id{NULL_UUID};
+			uint32_t size{0};
+			void (*constructor)(void *, uint32_t) = nullptr;
+			void (*destructor)(void *, uint32_t) = nullptr;
+			void (*copy_constructor)(void *, uint32_t, ConstBufferView view) = nullptr;
+		};
+
+		/// A fixed-size bloc of memory holding the columns of an archetype.
+		class Chunk {
+		public:
+			Chunk() = default;
+			explicit Chunk(uint32_t byteSize);
+			~Chunk();
+			Chunk(const Chunk &o);
+			Chunk &operator=(const Chunk &o);
+			Chunk(Chunk &&o) noexcept;
+			Chunk &operator=(Chunk &&o) noexcept;
+
+			void swap(Chunk &o) noexcept;
+
+		public:
+			[[nodiscard]] uint8_t *Get() { return m_Data; }
+			[[nodiscard]] const uint8_t *Get() const { return m_Data; }
+			[[nodiscard]] uint32_t ByteSize() const { return m_ByteSize; }
+
+		private:
+			uint8_t *m_Data{nullptr};
+			uint32_t m_ByteSize{0};
+		};
+
+		struct Archetype {
+			Signature signature{};
+			/// The component indices of the archetype in ascending order.
+			std::vector<ComponentIndex> components{};
+			/// The byte offset of each component column inside a chunk. Same order as 'components'.
+			std::vector<uint32_t> offsets{};
+			/// The size of one element of each column. Same order as 'components'.
+			std::vector<uint32_t> sizes{};
+			std::vector<Chunk> chunks{};
+			uint32_t chunkCapacity{0};
+			uint32_t chunkByteSize{0};
+			uint32_t count{0};
+
+			std::unordered_map<ComponentIndex, ArchetypeIndex> addEdges{};
+			std::unordered_map<ComponentIndex, ArchetypeIndex> removeEdges{};
+
+			/// @return The column of the component in this archetype or c_NullIndex if the archetype doesn't have it.
+			[[nodiscard]] uint32_t GetColumn(ComponentIndex component) const;
+			[[nodiscard]] uint32_t GetChunkCount(uint32_t chunk) const;
+
+			[[nodiscard]] uint32_t *GetEntities(uint32_t chunk);
+			[[nodiscard]] const uint32_t *GetEntities(uint32_t chunk) const;
+
+			[[nodiscard]] void *GetColumnData(uint32_t column, uint32_t chunk);
+			[[nodiscard]] const void *GetColumnData(uint32_t column, uint32_t chunk) const;
+
+			[[nodiscard]] void *GetElement(uint32_t column, uint32_t row);
+			[[nodiscard]] const void *GetElement(uint32_t column, uint32_t row) const;
+		};
+
+		/// The view of one chunk given to the user when iterating.
+		/// The columns are given in the order of the query.
+		struct ChunkView {
+			const uint32_t *entities{nullptr};
+			void *const *columns{nullptr};
+			uint32_t count{0};
+
+			template<typename T>
+			[[nodiscard]] T *Column(const uint32_t index) const {
+				return reinterpret_cast<T *>(columns[index]);
+			}
+		};
+
+		struct EntityLocation {
+			ArchetypeIndex archetype{c_NullIndex};
+			uint32_t row{0};
+		};
+
+	public:
+		ArchetypeStorage() = default;
+		~ArchetypeStorage();
+		ArchetypeStorage(const ArchetypeStorage &o);
+		ArchetypeStorage &operator=(const ArchetypeStorage &o);
+		ArchetypeStorage(ArchetypeStorage &&o) noexcept;
+		ArchetypeStorage &operator=(ArchetypeStorage &&o) noexcept;
+
+		void swap(ArchetypeStorage &o) noexcept;
+
+	public:
+		/**
+		 * Register a component so it can be added to the entities.
+		 * Registering the same ID twice will return the already registered component index.
+		 * @return The index of the component inside the storage.
+		 */
+		ComponentIndex RegisterComponent(UUID id, uint32_t size, void (*constructor)(void *, uint32_t) = nullptr, void (*destructor)(void *, uint32_t) = nullptr, void (*copy_constructor)(void *, uint32_t, ConstBufferView view) = nullptr);
+
+		[[nodiscard]] bool IsRegistered(UUID id) const;
+		[[nodiscard]] ComponentIndex GetComponentIndex(UUID id) const;
+		[[nodiscard]] const ComponentInfo &GetComponentInfo(ComponentIndex component) const;
+
+	public:
+		/**
+		 * Add a component to the entity and initialize it with the constructor if it has been given.
+		 * @return A pointer to the component or nullptr if it already existed or isn't registered.
+		 */
+		void *Add(uint32_t entity, UUID componentId);
+
+		/**
+		 * Add a component to the entity and initialize it with the view using the copy constructor if it has been given.
+		 * Copy a maximum of memory otherwise.
+		 * @return A pointer to the component or nullptr if it already existed or isn't registered.
+		 */
+		void *Add(uint32_t entity, UUID componentId, ConstBufferView view);
+
+		[[nodiscard]] bool Has(uint32_t entity, UUID componentId) const;
+		[[nodiscard]] bool Exist(uint32_t entity) const;
+
+		[[nodiscard]] void *TryGet(uint32_t entity, UUID componentId);
+		[[nodiscard]] const void *TryGet(uint32_t entity, UUID componentId) const;
+
+		/// Remove the component from the entity. The entity will be moved to the archetype without the component.
+		/// @return Whether the component existed.
+		bool Remove(uint32_t entity, UUID componentId);
+
+		/// Destroy all the components of the entity.
+		void RemoveEntity(uint32_t entity);
+
+		/// Destroy all the components of all the entities. The registered components are kept.
+		void Clear();
+
+		void Reserve(uint32_t entityCapacity);
+
+		/// @return The number of entities having the component.
+		[[nodiscard]] uint32_t Count(UUID componentId) const;
+
+		[[nodiscard]] uint32_t GetArchetypeCount() const { return static_cast<uint32_t>(m_Archetypes.size()); }
+		[[nodiscard]] Archetype &GetArchetype(const ArchetypeIndex index) { return m_Archetypes[index]; }
+		[[nodiscard]] const Archetype &GetArchetype(const ArchetypeIndex index) const { return m_Archetypes[index]; }
+		[[nodiscard]] EntityLocation GetLocation(uint32_t entity) const;
+
+	public:
+		/**
+		 * Iterate on every chunk of every archetype containing all the components of the query.
+		 * The function is called with a ChunkView whose columns are in the order of the query.
+		 * @param query The component indices that the archetype must contain.
+		 * @param func A callable taking a 'const ChunkView&'.
+		 */
+		template<typename Func>
+		void ForEachChunk(std::span<const ComponentIndex> query, Func &&func);
+
+		template<typename Func>
+		void ForEachChunk(std::span<const ComponentIndex> query, Func &&func) const;
+
+	private:
+		[[nodiscard]] Signature MakeSignature(std::span<const ComponentIndex> query) const;
+		ArchetypeIndex FindOrCreateArchetype(const Signature &signature);
+		ArchetypeIndex GetAddTarget(ArchetypeIndex from, ComponentIndex component);
+		ArchetypeIndex GetRemoveTarget(ArchetypeIndex from, ComponentIndex component);
+
+		/// Allocate a row at the end of the archetype for the entity. The components are left uninitialized.
+		uint32_t PushRow(ArchetypeIndex archetype, uint32_t entity);
+
+		/// Remove a row, filling the hole with the last row of the archetype.
+		/// The destructors are called only if 'destruct' is true. Otherwise, the memory is considered relocated.
+		void RemoveRow(ArchetypeIndex archetype, uint32_t row, bool destruct);
+
+		/// Move the entity to the target archetype, relocating the components both archetypes share.
+		/// @return The row of the entity in the new archetype.
+		uint32_t MoveEntity(uint32_t entity, ArchetypeIndex to);
+
+		void *AddUninitialized(uint32_t entity, ComponentIndex component);
+		void CopyConstructColumns(const ArchetypeStorage &source);
+
+	private:
+		std::vector<ComponentInfo> m_Components;
+		std::unordered_map<UUID, ComponentIndex> m_ComponentLookup;
+
+		std::vector<Archetype> m_Archetypes;
+		std::unordered_map<Signature, ArchetypeIndex> m_ArchetypeLookup;
+		/// The archetype containing only the component, the first one an entity goes into.
+		std::vector<ArchetypeIndex> m_RootArchetypes;
+
+		std::vector<EntityLocation> m_Locations;
+	};
+
+
+	template<typename Func>
+	void ArchetypeStorage::ForEachChunk(std::span<const ComponentIndex> query, Func &&func) {
+		MGN_CORE_MASSERT(query.size() <= c_MaxQueryComponents, "The query has {} components but only {} are supported.", query.size(), c_MaxQueryComponents);
+		for (const ComponentIndex component: query) {
+			if (component == c_NullIndex) return;
+		}
+
+		const Signature signature = MakeSignature(query);
+		std::array<uint32_t, c_MaxQueryComponents> columns{};
+		std::array<void *, c_MaxQueryComponents> pointers{};
+
+		for (Archetype &archetype: m_Archetypes) {
+			if (archetype.count == 0) continue;
+			if ((archetype.signature & signature) != signature) continue;
+
+			for (uint32_t i = 0; i < query.size(); ++i) {
+				columns[i] = archetype.GetColumn(query[i]);
+			}
+
+			for (uint32_t chunk = 0; chunk * archetype.chunkCapacity < archetype.count; ++chunk) {
+				for (uint32_t i = 0; i < query.size(); ++i) {
+					pointers[i] = archetype.GetColumnData(columns[i], chunk);
+				}
+				const ChunkView view{archetype.GetEntities(chunk), pointers.data(), archetype.GetChunkCount(chunk)};
+				func(view);
+			}
+		}
+	}
+
+	template<typename Func>
+	void ArchetypeStorage::ForEachChunk(std::span<const ComponentIndex> query, Func &&func) const {
+		const_cast<ArchetypeStorage *>(this)->ForEachChunk(query, std::forward<Func>(func));
+	}
+} // namespace Imagine
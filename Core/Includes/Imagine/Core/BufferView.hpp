@@ -140,6 +140,12 @@ namespace Imagine {
 			return {vector.data(), vector.size() * sizeof(T)};
 		}
 
+		template<typename T>
+		inline static ConstBufferView Make(const std::span<const T> span) {
+			if (span.empty()) return {};
+			return {span.data(), span.size() * sizeof(T)};
+		}
+
 	public:
 		ConstBufferView();
 		ConstBufferView(const void *buffer, uint64_t size);
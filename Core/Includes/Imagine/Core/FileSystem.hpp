@@ -50,6 +50,8 @@ namespace Imagine {
 		Scripts,
 		Cache,
 		External,
+		/// The SPIR-V of the engine shaders, compiled by the build next to the executable.
+		EngineShaders,
 	};
 
 	inline static constexpr std::string FileSourceToString(const FileSource source) {
@@ -66,6 +68,8 @@ namespace Imagine {
 				return "Cache";
 			case FileSource::External:
 				return "External";
+			case FileSource::EngineShaders:
+				return "EngineShaders";
 		}
 		return "Unknown";
 	}
@@ -76,6 +80,7 @@ namespace Imagine {
 		if(sourceStr == "Scripts") return FileSource::Scripts;
 		if(sourceStr == "Cache") return FileSource::Cache;
 		if(sourceStr == "External") return FileSource::External;
+		if(sourceStr == "EngineShaders") return FileSource::EngineShaders;
 		return FileSource::None;
 	}
 
@@ -85,6 +90,7 @@ namespace Imagine {
 		if(sourceStr == "Scripts") {source = FileSource::Scripts; return true;}
 		if(sourceStr == "Cache") {source = FileSource::Cache; return true;}
 		if(sourceStr == "External") {source = FileSource::External; return true;}
+		if(sourceStr == "EngineShaders") {source = FileSource::EngineShaders; return true;}
 		if(sourceStr == "None") {source = FileSource::None; return true;}
 		return false;
 	}
@@ -110,6 +116,8 @@ namespace Imagine {
 		[[nodiscard]] inline bool empty() const { return path.empty() || source == FileSource::None; }
 		[[nodiscard]] std::string string() const;
 		[[nodiscard]] std::string id() const;
+		/// Source and lexically normalized path, usable as a key. Unlike 'equivalent', it doesn't touch the file system.
+		[[nodiscard]] std::string normalized() const;
 		[[nodiscard]] bool equivalent(const Path &rhs) const;
 
 	public:
@@ -0,0 +1,128 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Core/JobSystem.hpp"
+
+namespace Imagine {
+
+	/**
+	 * Growable array storing its elements in a ScratchAllocator.
+	 * Growing copies the elements in a new allocation of the allocator, the previous one is only reclaimed when the allocator is reset.
+	 * The elements are copied with memcpy and never destroyed, so they must be trivially copyable.
+	 *
+	 * The array must be cleared with 'Release' before its allocator is reset.
+	 */
+	template<typename T>
+	class FrameArray {
+		static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "The frame array never calls the constructors and destructors.");
+
+	public:
+		using value_type = T;
+		using iterator = T *;
+		using const_iterator = const T *;
+
+	public:
+		FrameArray() = default;
+		explicit FrameArray(ScratchAllocator *allocator) :
+			m_Allocator(allocator) {}
+		~FrameArray() = default;
+		FrameArray(const FrameArray &) = delete;
+		FrameArray &operator=(const FrameArray &) = delete;
+		FrameArray(FrameArray &&other) noexcept :
+			m_Allocator(std::exchange(other.m_Allocator, nullptr)), m_Data(std::exchange(other.m_Data, nullptr)), m_Count(std::exchange(other.m_Count, 0)), m_Capacity(std::exchange(other.m_Capacity, 0)) {}
+		FrameArray &operator=(FrameArray &&other) noexcept {
+			std::swap(m_Allocator, other.m_Allocator);
+			std::swap(m_Data, other.m_Data);
+			std::swap(m_Count, other.m_Count);
+			std::swap(m_Capacity, other.m_Capacity);
+			return *this;
+		}
+
+	public:
+		[[nodiscard]] uint32_t size() const { return m_Count; }
+		[[nodiscard]] uint32_t capacity() const { return m_Capacity; }
+		[[nodiscard]] bool empty() const { return m_Count == 0; }
+
+		[[nodiscard]] T *data() { return m_Data; }
+		[[nodiscard]] const T *data() const { return m_Data; }
+
+		[[nodiscard]] iterator begin() { return m_Data; }
+		[[nodiscard]] iterator end() { return m_Data + m_Count; }
+		[[nodiscard]] const_iterator begin() const { return m_Data; }
+		[[nodiscard]] const_iterator end() const { return m_Data + m_Count; }
+
+		[[nodiscard]] T &operator[](const uint32_t index) {
+			MGN_CORE_CASSERT(index < m_Count, "Index {} out of range ({}).", index, m_Count);
+			return m_Data[index];
+		}
+		[[nodiscard]] const T &operator[](const uint32_t index) const {
+			MGN_CORE_CASSERT(index < m_Count, "Index {} out of range ({}).", index, m_Count);
+			return m_Data[index];
+		}
+		[[nodiscard]] T &back() { return (*this)[m_Count - 1]; }
+		[[nodiscard]] const T &back() const { return (*this)[m_Count - 1]; }
+
+	public:
+		void reserve(const uint32_t capacity) {
+			if (capacity <= m_Capacity) return;
+			MGN_CORE_CASSERT(m_Allocator, "The frame array has no allocator.");
+			T *data = m_Allocator->Allocate<T>(capacity);
+			if (m_Count) std::memcpy(data, m_Data, sizeof(T) * m_Count);
+			m_Data = data;
+			m_Capacity = capacity;
+		}
+
+		/// Shrink the array, or grow it with value initialized elements.
+		void resize(const uint32_t count) {
+			if (count > m_Count) {
+				reserve(count);
+				std::uninitialized_value_construct(m_Data + m_Count, m_Data + count);
+			}
+			m_Count = count;
+		}
+
+		void push_back(const T &value) {
+			Grow(m_Count + 1);
+			m_Data[m_Count++] = value;
+		}
+
+		template<typename... Args>
+		T &emplace_back(Args &&...args) {
+			Grow(m_Count + 1);
+			return *std::construct_at(m_Data + m_Count++, std::forward<Args>(args)...);
+		}
+
+		void Append(const std::span<const T> values) {
+			if (values.empty()) return;
+			Grow(m_Count + static_cast<uint32_t>(values.size()));
+			std::memcpy(m_Data + m_Count, values.data(), sizeof(T) * values.size());
+			m_Count += static_cast<uint32_t>(values.size());
+		}
+
+		/// Remove the elements but keep the storage.
+		void clear() { m_Count = 0; }
+
+		/// Drop the storage. Must be called before the allocator is reset.
+		void Release() {
+			m_Data = nullptr;
+			m_Count = 0;
+			m_Capacity = 0;
+		}
+
+	private:
+		void Grow(const uint32_t minimumCapacity) {
+			if (minimumCapacity <= m_Capacity) return;
+			reserve(std::max(minimumCapacity, std::max(m_Capacity * 2, 16u)));
+		}
+
+	private:
+		ScratchAllocator *m_Allocator{nullptr};
+		T *m_Data{nullptr};
+		uint32_t m_Count{0};
+		uint32_t m_Capacity{0};
+	};
+
+} // namespace Imagine
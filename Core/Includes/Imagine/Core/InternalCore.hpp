@@ -31,6 +31,8 @@
 #include "Imagine/Core/HeapArray.hpp"
 #include "Imagine/Core/RawSparseSet.hpp"
 #include "Imagine/Core/SparseSet.hpp"
+#include "Imagine/Core/ArchetypeStorage.hpp"
+#include "Imagine/Core/JobSystem.hpp"
 
 #include "Imagine/Math/Core.hpp"
 #include "Imagine/Math/Types.hpp"
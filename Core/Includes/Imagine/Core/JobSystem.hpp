@@ -0,0 +1,149 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Core/Macros.hpp"
+
+namespace Imagine {
+
+	/// Linear allocator owned by one thread of the job system.
+	/// Everything allocated is released at once with 'Reset', no destructor is called.
+	class ScratchAllocator {
+	public:
+		static inline constexpr uint64_t c_DefaultByteSize = 1024 * 1024;
+
+	public:
+		explicit ScratchAllocator(uint64_t byteSize = c_DefaultByteSize);
+		~ScratchAllocator();
+		ScratchAllocator(const ScratchAllocator &) = delete;
+		ScratchAllocator &operator=(const ScratchAllocator &) = delete;
+
+	public:
+		/// @return A pointer to 'size' bytes aligned on 'alignment'. Grows the allocator if needed.
+		void *Allocate(uint64_t size, uint64_t alignment = alignof(std::max_align_t));
+
+		template<typename T>
+		T *Allocate(const uint64_t count) {
+			static_assert(std::is_trivially_destructible_v<T>, "The scratch allocator never calls the destructors.");
+			return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		/// Release every allocation. The memory is kept for the next uses.
+		void Reset();
+
+		[[nodiscard]] uint64_t GetUsedSize() const { return m_Offset + m_RetiredSize; }
+		/// @return The number of allocations since the last reset.
+		[[nodiscard]] uint64_t GetAllocationCount() const { return m_AllocationCount; }
+		/// @return The number of blocks requested to the heap since the last reset, zero once the allocator is large enough.
+		[[nodiscard]] uint64_t GetHeapAllocationCount() const { return m_HeapAllocationCount; }
+
+	private:
+		std::vector<uint8_t *> m_Retired;
+		uint64_t m_RetiredSize{0};
+		uint8_t *m_Data{nullptr};
+		uint64_t m_ByteSize{0};
+		uint64_t m_Offset{0};
+		uint64_t m_AllocationCount{0};
+		uint64_t m_HeapAllocationCount{0};
+	};
+
+	/// Counter tracking the jobs of a batch. The batch is done once it reaches zero.
+	struct JobCounter {
+		std::atomic<uint32_t> pending{0};
+
+		[[nodiscard]] bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+	};
+
+	/**
+	 * Engine wide pool of worker threads.
+	 * Each thread (the workers and the thread that initialized the system) owns a deque of jobs.
+	 * A thread pushes and pops its own jobs at the back, and idle threads steal from the front of the others.
+	 * Waiting on a counter doesn't block the thread: it keeps executing jobs until the counter reaches zero.
+	 *
+	 * When the job system isn't initialized, everything runs on the calling thread.
+	 */
+	class JobSystem {
+	public:
+		using JobFunction = void (*)(void *data, uint32_t begin, uint32_t end);
+
+		struct Job {
+			JobFunction function{nullptr};
+			void *data{nullptr};
+			uint32_t begin{0};
+			uint32_t end{0};
+			JobCounter *counter{nullptr};
+		};
+
+		static inline constexpr uint32_t c_DefaultGrainSize = 256;
+		static inline constexpr uint32_t c_InvalidThreadIndex = std::numeric_limits<uint32_t>::max();
+
+	public:
+		/// Start 'workerCount' workers. The calling thread becomes the thread 0 of the job system.
+		static void Initialize(uint32_t workerCount = GetDefaultWorkerCount());
+		static void Shutdown();
+		[[nodiscard]] static bool IsInitialized();
+
+		[[nodiscard]] static uint32_t GetDefaultWorkerCount();
+		[[nodiscard]] static uint32_t GetWorkerCount();
+		/// @return The number of threads able to execute jobs. (The workers and the main thread)
+		[[nodiscard]] static uint32_t GetThreadCount();
+		/// @return The index of the current thread in the job system or c_InvalidThreadIndex if it isn't one of its threads.
+		[[nodiscard]] static uint32_t GetThreadIndex();
+
+	public:
+		/// Push the jobs to the deque of the current thread. The counter of each job (if any) is incremented.
+		static void Submit(const Job *jobs, uint32_t count);
+
+		/// Execute jobs until the counter reaches zero.
+		static void Wait(JobCounter &counter);
+
+		/**
+		 * Split the range [0, count) in batches of 'grainSize' elements and call 'func(begin, end)' on each of them in parallel.
+		 * Return once every batch has been processed. The calling thread takes part in the work.
+		 */
+		template<typename Func>
+		static void ParallelFor(uint32_t count, uint32_t grainSize, Func &&func);
+
+		template<typename Func>
+		static void ParallelFor(const uint32_t count, Func &&func) {
+			ParallelFor(count, c_DefaultGrainSize, std::forward<Func>(func));
+		}
+
+	private:
+		static inline constexpr uint32_t c_MaxBatchJobs = 256;
+	};
+
+	template<typename Func>
+	void JobSystem::ParallelFor(const uint32_t count, uint32_t grainSize, Func &&func) {
+		if (count == 0) return;
+		grainSize = std::max(grainSize, 1u);
+
+		if (!IsInitialized() || GetWorkerCount() == 0 || count <= grainSize) {
+			func(0u, count);
+			return;
+		}
+
+		using FuncType = std::remove_reference_t<Func>;
+		const JobFunction function = [](void *data, const uint32_t begin, const uint32_t end) {
+			(*static_cast<FuncType *>(data))(begin, end);
+		};
+
+		JobCounter counter{};
+		std::array<Job, c_MaxBatchJobs> jobs{};
+		uint32_t jobCount = 0;
+		for (uint32_t begin = 0; begin < count; begin += grainSize) {
+			jobs[jobCount++] = Job{function, (void *) &func, begin, std::min(begin + grainSize, count), &counter};
+			if (jobCount == jobs.size()) {
+				Submit(jobs.data(), jobCount);
+				jobCount = 0;
+			}
+		}
+		if (jobCount) {
+			Submit(jobs.data(), jobCount);
+		}
+		Wait(counter);
+	}
+
+} // namespace Imagine
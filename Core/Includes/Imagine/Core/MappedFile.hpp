@@ -0,0 +1,46 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Core/BufferView.hpp"
+
+namespace Imagine {
+
+	/**
+	 * Read-only memory mapping of a whole file.
+	 * The pages are loaded by the OS on access, opening a big file costs nothing until it is read.
+	 */
+	class MappedFile {
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::filesystem::path &filePath);
+		~MappedFile();
+
+		MappedFile(const MappedFile &) = delete;
+		MappedFile &operator=(const MappedFile &) = delete;
+		MappedFile(MappedFile &&other) noexcept;
+		MappedFile &operator=(MappedFile &&other) noexcept;
+
+		void swap(MappedFile &other) noexcept;
+
+	public:
+		bool Open(const std::filesystem::path &filePath);
+		void Close();
+
+		[[nodiscard]] bool IsValid() const { return m_Data != nullptr; }
+		[[nodiscard]] const uint8_t *Get() const { return m_Data; }
+		[[nodiscard]] uint64_t Size() const { return m_Size; }
+		[[nodiscard]] ConstBufferView GetView() const { return ConstBufferView{m_Data, 0, m_Size}; }
+
+	private:
+		const uint8_t *m_Data{nullptr};
+		uint64_t m_Size{0};
+#ifdef _WIN32
+		void *m_File{nullptr};
+		void *m_Mapping{nullptr};
+#endif
+	};
+
+} // namespace Imagine
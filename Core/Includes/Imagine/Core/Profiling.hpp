@@ -14,6 +14,7 @@
 #define MGN_FRAME_END() //FrameMarkEnd(s_MainFrame)
 #define MGN_PROFILE_SCOPE(name) ZoneScopedN(name)
 #define MGN_PROFILE_FUNCTION() ZoneScoped
+#define MGN_PROFILE_PLOT(name, value) TracyPlot(name, static_cast<int64_t>(value))
 
 #else
 
@@ -23,5 +24,6 @@
 #define MGN_FRAME_END()
 #define MGN_PROFILE_SCOPE(name)
 #define MGN_PROFILE_FUNCTION()
+#define MGN_PROFILE_PLOT(name, value)
 
 #endif
\ No newline at end of file
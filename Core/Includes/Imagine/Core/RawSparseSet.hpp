@@ -362,6 +362,43 @@ namespace Imagine {
 			}
 		}
 
+		/**
+		 * Replace the whole content of the set by 'count' elements, in dense order.
+		 * The elements are copied with the copy constructor if any, or with a single memcpy.
+		 * @param ids The id of each element. They must be unique.
+		 * @param data 'count' elements of 'GetDataSize()' bytes, one after the other.
+		 * @param count The number of elements.
+		 */
+		virtual void Assign(const UnsignedInteger *ids, const void *data, const UnsignedInteger count) {
+			Clear();
+			if (count == 0) return;
+
+			const UnsignedInteger dataSize = GetDataSize();
+			dense.redimension(count);
+			elements.redimension(count);
+			memcpy(&dense[0], ids, sizeof(UnsignedInteger) * count);
+			if (copy_constructor) {
+				const auto *bytes = static_cast<const uint8_t *>(data);
+				for (UnsignedInteger i = 0; i < count; ++i) {
+					copy_constructor(elements.get(i), dataSize, ConstBufferView{bytes + static_cast<uint64_t>(i) * dataSize, dataSize});
+				}
+			}
+			else {
+				memcpy(elements.get(0), data, static_cast<uint64_t>(dataSize) * count);
+			}
+
+			UnsignedInteger maxId = 0;
+			for (UnsignedInteger i = 0; i < count; ++i) {
+				maxId = std::max(maxId, ids[i]);
+			}
+			if (sparse.size() <= maxId) {
+				sparse.resize(maxId + c_OverheadResize);
+			}
+			for (UnsignedInteger i = 0; i < count; ++i) {
+				sparse[ids[i]] = i;
+			}
+		}
+
 		virtual void Reserve(const UnsignedInteger capacity) {
 			sparse.reserve(capacity);
 			dense.reserve(capacity);
@@ -440,6 +477,24 @@ namespace Imagine {
 			return elements.get_const_view(sparse[id]);
 		}
 
+		/// Non-virtual access to the element of an existing ID so hot loops (like Scene::View) can be inlined.
+		[[nodiscard]] void *GetUnchecked(const UnsignedInteger id) {
+			return elements.get(sparse[id]);
+		}
+
+		[[nodiscard]] const void *GetUnchecked(const UnsignedInteger id) const {
+			return elements.get(sparse[id]);
+		}
+
+		/// Non-virtual access to the element at a position of the dense array.
+		[[nodiscard]] void *GetAtIndex(const UnsignedInteger index) {
+			return elements.get(index);
+		}
+
+		[[nodiscard]] const void *GetAtIndex(const UnsignedInteger index) const {
+			return elements.get(index);
+		}
+
 		UnsignedInteger GetIndex(const UnsignedInteger id) const {
 			MGN_CORE_MASSERT(dense[sparse[id]] == id, "ID '{}' is not valid.", id);
 			return sparse[id];
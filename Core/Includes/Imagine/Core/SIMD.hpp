@@ -0,0 +1,276 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MGN_SIMD_SSE 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define MGN_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Imagine::SIMD {
+
+	/// Number of lanes of a Float4.
+	static inline constexpr uint32_t c_Width = 4;
+
+	/**
+	 * Four floats processed at once, with SSE on x86, NEON on ARM64 and a scalar fallback elsewhere.
+	 * The comparisons return a mask where every bit of a lane is set when the comparison is true.
+	 */
+	struct Float4 {
+#if MGN_SIMD_SSE
+		__m128 value;
+#elif MGN_SIMD_NEON
+		float32x4_t value;
+#else
+		float value[c_Width];
+#endif
+	};
+
+	/// Four 32-bit integers, the bit patterns the floats are converted and packed to.
+	struct Int4 {
+#if MGN_SIMD_SSE
+		__m128i value;
+#elif MGN_SIMD_NEON
+		int32x4_t value;
+#else
+		int32_t value[c_Width];
+#endif
+	};
+
+#if MGN_SIMD_SSE
+
+	inline Float4 Load(const float *aligned) { return {_mm_load_ps(aligned)}; }
+	inline Float4 LoadUnaligned(const float *data) { return {_mm_loadu_ps(data)}; }
+	inline void Store(float *aligned, const Float4 v) { _mm_store_ps(aligned, v.value); }
+	inline void StoreUnaligned(float *data, const Float4 v) { _mm_storeu_ps(data, v.value); }
+	inline Float4 Set(const float v) { return {_mm_set1_ps(v)}; }
+	inline Float4 Set(const float x, const float y, const float z, const float w) { return {_mm_setr_ps(x, y, z, w)}; }
+	inline Float4 operator+(const Float4 a, const Float4 b) { return {_mm_add_ps(a.value, b.value)}; }
+	inline Float4 operator-(const Float4 a, const Float4 b) { return {_mm_sub_ps(a.value, b.value)}; }
+	inline Float4 operator*(const Float4 a, const Float4 b) { return {_mm_mul_ps(a.value, b.value)}; }
+	inline Float4 operator/(const Float4 a, const Float4 b) { return {_mm_div_ps(a.value, b.value)}; }
+	inline Float4 Min(const Float4 a, const Float4 b) { return {_mm_min_ps(a.value, b.value)}; }
+	inline Float4 Max(const Float4 a, const Float4 b) { return {_mm_max_ps(a.value, b.value)}; }
+	inline Float4 Abs(const Float4 a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.value)}; }
+	inline Float4 Sqrt(const Float4 a) { return {_mm_sqrt_ps(a.value)}; }
+	inline Float4 Less(const Float4 a, const Float4 b) { return {_mm_cmplt_ps(a.value, b.value)}; }
+	inline Float4 LessEqual(const Float4 a, const Float4 b) { return {_mm_cmple_ps(a.value, b.value)}; }
+	inline Float4 Or(const Float4 a, const Float4 b) { return {_mm_or_ps(a.value, b.value)}; }
+	inline Float4 And(const Float4 a, const Float4 b) { return {_mm_and_ps(a.value, b.value)}; }
+	/// Take the lanes of 'a' where the mask is set, and the lanes of 'b' elsewhere.
+	inline Float4 Select(const Float4 mask, const Float4 a, const Float4 b) { return {_mm_or_ps(_mm_and_ps(mask.value, a.value), _mm_andnot_ps(mask.value, b.value))}; }
+	/// @return The sign bit of each lane packed in the 4 lower bits.
+	inline uint32_t MoveMask(const Float4 mask) { return static_cast<uint32_t>(_mm_movemask_ps(mask.value)); }
+	/// The magnitude of 'magnitude' with the sign of 'sign'.
+	inline Float4 CopySign(const Float4 magnitude, const Float4 sign) {
+		const __m128 mask = _mm_set1_ps(-0.0f);
+		return {_mm_or_ps(_mm_andnot_ps(mask, magnitude.value), _mm_and_ps(mask, sign.value))};
+	}
+	/// Transpose the 4x4 matrix whose rows are a, b, c and d.
+	inline void Transpose(Float4 &a, Float4 &b, Float4 &c, Float4 &d) { _MM_TRANSPOSE4_PS(a.value, b.value, c.value, d.value); }
+
+	inline Int4 SetInt(const int32_t v) { return {_mm_set1_epi32(v)}; }
+	inline void StoreUnaligned(uint32_t *data, const Int4 v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(data), v.value); }
+	/// Round to the nearest integer, the ties to even.
+	inline Int4 RoundToInt(const Float4 a) { return {_mm_cvtps_epi32(a.value)}; }
+	inline Int4 AsInt(const Float4 a) { return {_mm_castps_si128(a.value)}; }
+	inline Float4 AsFloat(const Int4 a) { return {_mm_castsi128_ps(a.value)}; }
+	inline Int4 operator+(const Int4 a, const Int4 b) { return {_mm_add_epi32(a.value, b.value)}; }
+	inline Int4 operator-(const Int4 a, const Int4 b) { return {_mm_sub_epi32(a.value, b.value)}; }
+	inline Int4 operator&(const Int4 a, const Int4 b) { return {_mm_and_si128(a.value, b.value)}; }
+	inline Int4 operator|(const Int4 a, const Int4 b) { return {_mm_or_si128(a.value, b.value)}; }
+	template<int N>
+	inline Int4 ShiftLeft(const Int4 a) { return {_mm_slli_epi32(a.value, N)}; }
+	/// Logical shift, the upper bits are filled with zeros.
+	template<int N>
+	inline Int4 ShiftRight(const Int4 a) { return {_mm_srli_epi32(a.value, N)}; }
+	/// Signed comparison.
+	inline Int4 Greater(const Int4 a, const Int4 b) { return {_mm_cmpgt_epi32(a.value, b.value)}; }
+	inline Int4 Select(const Int4 mask, const Int4 a, const Int4 b) { return {_mm_or_si128(_mm_and_si128(mask.value, a.value), _mm_andnot_si128(mask.value, b.value))}; }
+
+#elif MGN_SIMD_NEON
+
+	inline Float4 Load(const float *aligned) { return {vld1q_f32(aligned)}; }
+	inline Float4 LoadUnaligned(const float *data) { return {vld1q_f32(data)}; }
+	inline void Store(float *aligned, const Float4 v) { vst1q_f32(aligned, v.value); }
+	inline void StoreUnaligned(float *data, const Float4 v) { vst1q_f32(data, v.value); }
+	inline Float4 Set(const float v) { return {vdupq_n_f32(v)}; }
+	inline Float4 Set(const float x, const float y, const float z, const float w) {
+		const float values[c_Width] = {x, y, z, w};
+		return {vld1q_f32(values)};
+	}
+	inline Float4 operator+(const Float4 a, const Float4 b) { return {vaddq_f32(a.value, b.value)}; }
+	inline Float4 operator-(const Float4 a, const Float4 b) { return {vsubq_f32(a.value, b.value)}; }
+	inline Float4 operator*(const Float4 a, const Float4 b) { return {vmulq_f32(a.value, b.value)}; }
+	inline Float4 operator/(const Float4 a, const Float4 b) { return {vdivq_f32(a.value, b.value)}; }
+	inline Float4 Min(const Float4 a, const Float4 b) { return {vminq_f32(a.value, b.value)}; }
+	inline Float4 Max(const Float4 a, const Float4 b) { return {vmaxq_f32(a.value, b.value)}; }
+	inline Float4 Abs(const Float4 a) { return {vabsq_f32(a.value)}; }
+	inline Float4 Sqrt(const Float4 a) { return {vsqrtq_f32(a.value)}; }
+	inline Float4 Less(const Float4 a, const Float4 b) { return {vreinterpretq_f32_u32(vcltq_f32(a.value, b.value))}; }
+	inline Float4 LessEqual(const Float4 a, const Float4 b) { return {vreinterpretq_f32_u32(vcleq_f32(a.value, b.value))}; }
+	inline Float4 Or(const Float4 a, const Float4 b) { return {vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a.value), vreinterpretq_u32_f32(b.value)))}; }
+	inline Float4 And(const Float4 a, const Float4 b) { return {vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.value), vreinterpretq_u32_f32(b.value)))}; }
+	/// Take the lanes of 'a' where the mask is set, and the lanes of 'b' elsewhere.
+	inline Float4 Select(const Float4 mask, const Float4 a, const Float4 b) { return {vbslq_f32(vreinterpretq_u32_f32(mask.value), a.value, b.value)}; }
+	/// @return The sign bit of each lane packed in the 4 lower bits.
+	inline uint32_t MoveMask(const Float4 mask) {
+		const uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(mask.value), 31);
+		return vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1) | (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3);
+	}
+	/// The magnitude of 'magnitude' with the sign of 'sign'.
+	inline Float4 CopySign(const Float4 magnitude, const Float4 sign) { return {vbslq_f32(vdupq_n_u32(0x80000000u), sign.value, magnitude.value)}; }
+	/// Transpose the 4x4 matrix whose rows are a, b, c and d.
+	inline void Transpose(Float4 &a, Float4 &b, Float4 &c, Float4 &d) {
+		const float32x4x2_t ab = vtrnq_f32(a.value, b.value);
+		const float32x4x2_t cd = vtrnq_f32(c.value, d.value);
+		a.value = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+		b.value = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+		c.value = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+		d.value = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+	}
+
+	inline Int4 SetInt(const int32_t v) { return {vdupq_n_s32(v)}; }
+	inline void StoreUnaligned(uint32_t *data, const Int4 v) { vst1q_u32(data, vreinterpretq_u32_s32(v.value)); }
+	/// Round to the nearest integer, the ties to even.
+	inline Int4 RoundToInt(const Float4 a) { return {vcvtnq_s32_f32(a.value)}; }
+	inline Int4 AsInt(const Float4 a) { return {vreinterpretq_s32_f32(a.value)}; }
+	inline Float4 AsFloat(const Int4 a) { return {vreinterpretq_f32_s32(a.value)}; }
+	inline Int4 operator+(const Int4 a, const Int4 b) { return {vaddq_s32(a.value, b.value)}; }
+	inline Int4 operator-(const Int4 a, const Int4 b) { return {vsubq_s32(a.value, b.value)}; }
+	inline Int4 operator&(const Int4 a, const Int4 b) { return {vandq_s32(a.value, b.value)}; }
+	inline Int4 operator|(const Int4 a, const Int4 b) { return {vorrq_s32(a.value, b.value)}; }
+	template<int N>
+	inline Int4 ShiftLeft(const Int4 a) { return {vshlq_n_s32(a.value, N)}; }
+	/// Logical shift, the upper bits are filled with zeros.
+	template<int N>
+	inline Int4 ShiftRight(const Int4 a) { return {vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a.value), N))}; }
+	/// Signed comparison.
+	inline Int4 Greater(const Int4 a, const Int4 b) { return {vreinterpretq_s32_u32(vcgtq_s32(a.value, b.value))}; }
+	inline Int4 Select(const Int4 mask, const Int4 a, const Int4 b) { return {vbslq_s32(vreinterpretq_u32_s32(mask.value), a.value, b.value)}; }
+
+#else
+
+	namespace Internal {
+		template<typename Func>
+		inline Float4 Map(const Float4 a, const Float4 b, Func &&func) {
+			Float4 result;
+			for (uint32_t i = 0; i < c_Width; ++i) result.value[i] = func(a.value[i], b.value[i]);
+			return result;
+		}
+
+		inline float MaskLane(const bool set) {
+			const uint32_t bits = set ? 0xFFFFFFFFu : 0u;
+			float lane;
+			std::memcpy(&lane, &bits, sizeof(float));
+			return lane;
+		}
+
+		inline uint32_t LaneBits(const float lane) {
+			uint32_t bits;
+			std::memcpy(&bits, &lane, sizeof(float));
+			return bits;
+		}
+	} // namespace Internal
+
+	inline Float4 Load(const float *aligned) { return {{aligned[0], aligned[1], aligned[2], aligned[3]}}; }
+	inline Float4 LoadUnaligned(const float *data) { return Load(data); }
+	inline void Store(float *aligned, const Float4 v) { for (uint32_t i = 0; i < c_Width; ++i) aligned[i] = v.value[i]; }
+	inline void StoreUnaligned(float *data, const Float4 v) { Store(data, v); }
+	inline Float4 Set(const float v) { return {{v, v, v, v}}; }
+	inline Float4 Set(const float x, const float y, const float z, const float w) { return {{x, y, z, w}}; }
+	inline Float4 operator+(const Float4 a, const Float4 b) { return Internal::Map(a, b, [](float x, float y) { return x + y; }); }
+	inline Float4 operator-(const Float4 a, const Float4 b) { return Internal::Map(a, b, [](float x, float y) { return x - y; }); }
+	inline Float4 operator*(const Float4 a, const Float4 b) { return Internal::Map(a, b, [](float x, float y) { return x * y; }); }
+	inline Float4 operator/(const Float4 a, const Float4 b) { return Internal::Map(a, b, [](float x, float y) { return x / y; }); }
+	inline Float4 Min(const Float4 a, const Float4 b) { return Internal::Map(a, b, [](float x, float y) { return y < x ? y : x; }); }
+	inline Float4 Max(const Float4 a, const Float4 b) { return Internal::Map(a, b, [](float x, float y) { return x < y ? y : x; }); }
+	inline Float4 Abs(const Float4 a) { return Internal::Map(a, a, [](float x, float) { return std::abs(x); }); }
+	inline Float4 Sqrt(const Float4 a) { return Internal::Map(a, a, [](float x, float) { return std::sqrt(x); }); }
+	inline Float4 Less(const Float4 a, const Float4 b) { return Internal::Map(a, b, [](float x, float y) { return Internal::MaskLane(x < y); }); }
+	inline Float4 LessEqual(const Float4 a, const Float4 b) { return Internal::Map(a, b, [](float x, float y) { return Internal::MaskLane(x <= y); }); }
+	inline Float4 Or(const Float4 a, const Float4 b) { return Internal::Map(a, b, [](float x, float y) { return Internal::MaskLane((Internal::LaneBits(x) | Internal::LaneBits(y)) != 0); }); }
+	inline Float4 And(const Float4 a, const Float4 b) { return Internal::Map(a, b, [](float x, float y) { return Internal::MaskLane((Internal::LaneBits(x) & Internal::LaneBits(y)) != 0); }); }
+	/// Take the lanes of 'a' where the mask is set, and the lanes of 'b' elsewhere.
+	inline Float4 Select(const Float4 mask, const Float4 a, const Float4 b) {
+		Float4 result;
+		for (uint32_t i = 0; i < c_Width; ++i) result.value[i] = Internal::LaneBits(mask.value[i]) ? a.value[i] : b.value[i];
+		return result;
+	}
+	/// @return The sign bit of each lane packed in the 4 lower bits.
+	inline uint32_t MoveMask(const Float4 mask) {
+		uint32_t result = 0;
+		for (uint32_t i = 0; i < c_Width; ++i) result |= (Internal::LaneBits(mask.value[i]) >> 31) << i;
+		return result;
+	}
+	/// The magnitude of 'magnitude' with the sign of 'sign'.
+	inline Float4 CopySign(const Float4 magnitude, const Float4 sign) { return Internal::Map(magnitude, sign, [](float x, float y) { return std::copysign(x, y); }); }
+	/// Transpose the 4x4 matrix whose rows are a, b, c and d.
+	inline void Transpose(Float4 &a, Float4 &b, Float4 &c, Float4 &d) {
+		Float4 *rows[c_Width] = {&a, &b, &c, &d};
+		for (uint32_t i = 0; i < c_Width; ++i) {
+			for (uint32_t j = i + 1; j < c_Width; ++j) std::swap(rows[i]->value[j], rows[j]->value[i]);
+		}
+	}
+
+	namespace Internal {
+		template<typename Func>
+		inline Int4 MapInt(const Int4 a, const Int4 b, Func &&func) {
+			Int4 result;
+			for (uint32_t i = 0; i < c_Width; ++i) result.value[i] = static_cast<int32_t>(func(static_cast<uint32_t>(a.value[i]), static_cast<uint32_t>(b.value[i])));
+			return result;
+		}
+	} // namespace Internal
+
+	inline Int4 SetInt(const int32_t v) { return {{v, v, v, v}}; }
+	inline void StoreUnaligned(uint32_t *data, const Int4 v) { for (uint32_t i = 0; i < c_Width; ++i) data[i] = static_cast<uint32_t>(v.value[i]); }
+	/// Round to the nearest integer, the ties to even.
+	inline Int4 RoundToInt(const Float4 a) {
+		Int4 result;
+		for (uint32_t i = 0; i < c_Width; ++i) result.value[i] = static_cast<int32_t>(std::nearbyint(a.value[i]));
+		return result;
+	}
+	inline Int4 AsInt(const Float4 a) {
+		Int4 result;
+		std::memcpy(result.value, a.value, sizeof(result.value));
+		return result;
+	}
+	inline Float4 AsFloat(const Int4 a) {
+		Float4 result;
+		std::memcpy(result.value, a.value, sizeof(result.value));
+		return result;
+	}
+	// The arithmetic wraps around like the vector instructions.
+	inline Int4 operator+(const Int4 a, const Int4 b) { return Internal::MapInt(a, b, [](uint32_t x, uint32_t y) { return x + y; }); }
+	inline Int4 operator-(const Int4 a, const Int4 b) { return Internal::MapInt(a, b, [](uint32_t x, uint32_t y) { return x - y; }); }
+	inline Int4 operator&(const Int4 a, const Int4 b) { return Internal::MapInt(a, b, [](uint32_t x, uint32_t y) { return x & y; }); }
+	inline Int4 operator|(const Int4 a, const Int4 b) { return Internal::MapInt(a, b, [](uint32_t x, uint32_t y) { return x | y; }); }
+	template<int N>
+	inline Int4 ShiftLeft(const Int4 a) { return Internal::MapInt(a, a, [](uint32_t x, uint32_t) { return x << N; }); }
+	/// Logical shift, the upper bits are filled with zeros.
+	template<int N>
+	inline Int4 ShiftRight(const Int4 a) { return Internal::MapInt(a, a, [](uint32_t x, uint32_t) { return x >> N; }); }
+	/// Signed comparison.
+	inline Int4 Greater(const Int4 a, const Int4 b) {
+		Int4 result;
+		for (uint32_t i = 0; i < c_Width; ++i) result.value[i] = a.value[i] > b.value[i] ? -1 : 0;
+		return result;
+	}
+	inline Int4 Select(const Int4 mask, const Int4 a, const Int4 b) { return (mask & a) | Internal::MapInt(mask, b, [](uint32_t m, uint32_t y) { return ~m & y; }); }
+
+#endif
+
+	/// Multiply and add, 'a * b + c'.
+	inline Float4 MulAdd(const Float4 a, const Float4 b, const Float4 c) { return a * b + c; }
+
+} // namespace Imagine::SIMD
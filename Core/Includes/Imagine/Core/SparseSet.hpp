@@ -256,7 +256,7 @@ namespace Imagine {
 				const UnsignedInteger swapIndex = last_index;
 				const UnsignedInteger swapId = dense[swapIndex];
 
-				MemoryHelper::c_swap_memory<T>(elements[index], elements[swapIndex]);
+				std::swap(elements[index], elements[swapIndex]);
 				MemoryHelper::c_swap_memory<UnsignedInteger>(dense[index], dense[swapIndex]);
 				MemoryHelper::c_swap_memory<UnsignedInteger>(sparse[id], sparse[swapId]);
 
@@ -297,6 +297,34 @@ namespace Imagine {
 			}
 		}
 
+		/**
+		 * Replace the whole content of the set by 'count' elements, in dense order.
+		 * Way cheaper than creating them one by one as each array is filled at once.
+		 * @param ids The id of each element. They must be unique.
+		 * @param data The elements.
+		 * @param count The number of elements.
+		 */
+		virtual void Assign(const UnsignedInteger *ids, std::vector<T> &&data, const UnsignedInteger count) {
+			dense.assign(ids, ids + count);
+			elements = std::move(data);
+			elements.resize(count);
+
+			UnsignedInteger maxId = 0;
+			for (UnsignedInteger i = 0; i < count; ++i) {
+				maxId = std::max(maxId, ids[i]);
+			}
+			if (count && sparse.size() <= maxId) {
+				sparse.resize(maxId + c_OverheadResize);
+			}
+			for (UnsignedInteger i = 0; i < count; ++i) {
+				sparse[ids[i]] = i;
+			}
+		}
+
+		void Assign(const UnsignedInteger *ids, const T *data, const UnsignedInteger count) {
+			Assign(ids, std::vector<T>(data, data + count), count);
+		}
+
 		virtual void Reserve(const UnsignedInteger capacity) {
 			sparse.reserve(capacity);
 			dense.reserve(capacity);
@@ -480,6 +508,23 @@ namespace Imagine {
 			}
 		}
 
+		using SparseSet<T, UnsignedInteger, CallDestructorT>::Assign;
+		virtual void Assign(const UnsignedInteger *ids, std::vector<T> &&data, const UnsignedInteger count) override {
+			SparseSet<T, UnsignedInteger, CallDestructorT>::Assign(ids, std::move(data), count);
+
+			// Every id below the highest one that isn't used goes back to the free list.
+			IDs = 0;
+			for (UnsignedInteger i = 0; i < count; ++i) {
+				IDs = std::max<UnsignedInteger>(IDs, ids[i] + 1);
+			}
+			FreeList.clear();
+			for (UnsignedInteger id = 0; id < IDs; ++id) {
+				if (!SparseSet<T, UnsignedInteger, CallDestructorT>::Exist(id)) {
+					FreeList.push_back(id);
+				}
+			}
+		}
+
 	protected:
 		HeapArray<UnsignedInteger> FreeList{SparseSet<T, UnsignedInteger, CallDestructorT>::c_OverheadResize};
 		UnsignedInteger IDs{0};
@@ -8,23 +8,60 @@
 #include "Imagine/Layers/Layer.hpp"
 #include "Imagine/ThirdParty/JoltPhysics.hpp"
 
-#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Core/TempAllocator.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsSystem.h>
+#include <unordered_set>
 
 #include "Imagine/Core/SmartPointers.hpp"
+#include "Imagine/Core/UUID.hpp"
+#include "Imagine/Physics/FixedTimestep.hpp"
+#include "Imagine/Physics/JoltJobSystem.hpp"
 #include "Imagine/Physics/ObjectLayerPairFilter.hpp"
 #include "Imagine/Physics/ObjectVsBroadPhaseLayerFilter.hpp"
 #include "Imagine/Physics/PhysicsListener.hpp"
+#include "Imagine/Physics/PhysicsRecording.hpp"
+#include "Imagine/Scene/Entity.hpp"
 
 namespace Imagine {
 
 	class Scene;
 
+	struct PhysicsStepStats {
+		/// Steps run by the last frame.
+		uint32_t steps{0};
+		/// Cost of the steps of the last frame.
+		double stepsMs{0.0};
+		double maxStepMs{0.0};
+	};
+
+	struct PhysicsReplayStats {
+		uint64_t frames{0};
+		uint64_t steps{0};
+		/// Cost of every step of the replay.
+		double stepsMs{0.0};
+		double maxStepMs{0.0};
+		/// The replay ended on the state the recording ended on, bit for bit.
+		bool identical{false};
+	};
+
+	/**
+	 * Own the Jolt physics system and keep it in sync with the scenes.
+	 *
+	 * The simulation runs at the fixed rate of its FixedTimestep, a frame doing as many steps as the time elapsed allows.
+	 * The bodies active before the last step of a frame save their transform, the entities then get the transform
+	 * interpolated between it and the current one, using the fraction of a step left in the accumulator.
+	 * The rendering is thus up to one step behind the simulation but moves smoothly.
+	 *
+	 * The bodies are only accessed from the main thread or from the sync jobs, while no step runs, so the layer uses the no-lock body interface.
+	 * While simulating, only the bodies active this frame or before the last step write their transform, straight into the transform cache.
+	 * While paused, only the bodies whose entity moved are teleported.
+	 *
+	 * A simulated run can be recorded then replayed without the scenes, see PhysicsRecording.
+	 */
 	class PhysicsLayer final : public Layer {
 	public:
-		PhysicsLayer();
+		explicit PhysicsLayer(const FixedTimestepSettings &settings = {});
 		virtual ~PhysicsLayer() override;
 		virtual void OnAttach() override;
 		virtual void OnDetach() override;
@@ -34,6 +71,37 @@ namespace Imagine {
 	public:
 		static void PushDeletion(JPH::BodyID body_id);
 		static bool IsSimulating();
+		static void SetSimulating(bool simulate);
+
+		/// Advance the simulation by the time of a frame, running the fixed steps it contains.
+		/// @return The number of steps run.
+		uint32_t Simulate(double seconds);
+
+		/// Bring the bodies and the entities of the scene in sync, in the direction given by 'IsSimulating'.
+		/// The first paused sync puts the entities back on their body, the interpolated pose isn't pushed to the bodies.
+		void Synchronize(Scene &scene);
+
+		void SetTimestepSettings(const FixedTimestepSettings &settings) { m_Timestep.SetSettings(settings); }
+		[[nodiscard]] const FixedTimestep &GetTimestep() const { return m_Timestep; }
+		[[nodiscard]] const PhysicsStepStats &GetStepStats() const { return m_StepStats; }
+		[[nodiscard]] JPH::PhysicsSystem &GetPhysicsSystem() { return *m_PhysicsSystem; }
+
+		/// Save the bodies, the state of the simulation and the Physicalisable components of the scenes, the pending deletions done first.
+		/// The snapshot is a dump of the memory of Jolt, only to be restored by the same build.
+		[[nodiscard]] std::vector<uint8_t> SaveSnapshot(std::span<const std::shared_ptr<Scene>> scenes);
+		/// Rebuild the physics system from a snapshot, recreating the bodies with the same IDs and giving the components back to the entities still in the scenes.
+		/// @return false if the snapshot is invalid, the physics system is then left empty.
+		bool RestoreSnapshot(std::span<const uint8_t> snapshot, std::span<const std::shared_ptr<Scene>> scenes);
+		/// @return A hash of the state of the bodies and the contacts, the same for two runs that simulated the same.
+		[[nodiscard]] uint64_t HashState() const;
+
+		/// Snapshot the world and record what each simulated frame gives it, until 'StopRecording' or the simulation stops.
+		void StartRecording(std::span<const std::shared_ptr<Scene>> scenes);
+		/// @return The recording, nothing if none was running.
+		std::optional<PhysicsRecording> StopRecording();
+		[[nodiscard]] bool IsRecording() const { return m_Recording.has_value(); }
+		/// Restore the snapshot of the recording and simulate its frames, without any scene.
+		PhysicsReplayStats Replay(const PhysicsRecording &recording);
 
 	private:
 		void OnUpdate(AppUpdateEvent &event);
@@ -41,7 +109,22 @@ namespace Imagine {
 		void OnImGui(ImGuiEvent &event);
 
 	private:
-		void Update(Scene* scene, TimeStep ts);
+		/// Create an empty physics system, replacing the current one and its bodies.
+		void CreatePhysicsSystem();
+		/// Remove and destroy the bodies of the destroyed components.
+		void FlushDeletions();
+		/// Create the missing bodies and move the bodies to their entity.
+		void SyncToBodies(Scene &scene);
+		/// Move the entities to their body and apply the velocities of the components.
+		void SyncFromBodies(Scene &scene);
+		/// Move the entities to the current transform of their body, without interpolation.
+		void SnapToBodies(Scene &scene);
+		void CreateOrRefreshBody(EntityID id, Scene &scene);
+		/// Save the transform of the active bodies before they are stepped, the interpolation starts from it.
+		void SavePreviousStates();
+		/// Flag the bodies active after the steps of the frame, the ones to sync.
+		void GatherActiveBodies();
+		void PrepareSyncJobs();
 
 	public:
 		/// This is the max amount of rigid bodies that you can add to the physics system. If you try to add more you'll get an error.
@@ -64,10 +147,9 @@ namespace Imagine {
 		/// pre-allocating 10 MB to avoid having to do allocations during the physics update.
 		JPH::TempAllocatorImpl m_TempAllocator{10 * 1024 * 1024};
 
-		/// We need a job system that will execute physics jobs on multiple threads. Typically
-		/// you would implement the JobSystem interface yourself and let Jolt Physics run on top
-		/// of your own job scheduler. JobSystemThreadPool is an example implementation.
-		JPH::JobSystemThreadPool m_JobSystem{JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, static_cast<int>(std::thread::hardware_concurrency() - 1)};
+		/// We need a job system that will execute physics jobs on multiple threads.
+		/// Jolt runs on top of the engine JobSystem so both share the same worker threads.
+		JoltJobSystem m_JobSystem{JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers};
 	private:
 		Scope<JPH::PhysicsSystem> m_PhysicsSystem;
 
@@ -94,6 +176,49 @@ namespace Imagine {
 		LoggerContactListener m_ContactListener;
 
 		JPH::BodyInterface* m_BodyInterface = nullptr;
+
+		FixedTimestep m_Timestep;
+		PhysicsStepStats m_StepStats;
+
+		struct BodyState {
+			JPH::BodyID id;
+			JPH::RVec3 position;
+			JPH::Quat rotation;
+			/// The step following the save, the state is only valid to interpolate up to it.
+			uint64_t step{0};
+			/// The last frame the body was active in.
+			uint64_t activeFrame{0};
+		};
+		/// The saved transforms and activity, indexed by the index of the BodyID.
+		std::vector<BodyState> m_BodyStates;
+		JPH::BodyIDVector m_ActiveBodies;
+		uint64_t m_StepIndex{0};
+		uint64_t m_SyncFrame{0};
+		bool m_WasSimulating{false};
+		/// The scenes whose entities were last written with an interpolated transform.
+		std::unordered_set<UUID> m_InterpolatedScenes;
+
+		struct BodyMove {
+			JPH::BodyID id;
+			JPH::RVec3 position;
+			JPH::Quat rotation;
+			JPH::EActivation activation;
+		};
+		struct BodyVelocity {
+			JPH::BodyID id;
+			JPH::Vec3 linear;
+			JPH::Vec3 angular;
+		};
+		/// What the sync jobs can't do concurrently, applied on the main thread afterward. One per thread of the JobSystem.
+		struct SyncJob {
+			/// Bodies to create or refresh when paused, entities to flag dirty when simulating.
+			std::vector<EntityID> entities;
+			std::vector<BodyMove> moves;
+			std::vector<BodyVelocity> velocities;
+		};
+		std::vector<SyncJob> m_SyncJobs;
+
+		std::optional<PhysicsRecording> m_Recording;
 	private:
 		static inline bool s_Simulate{false};
 		static inline std::vector<JPH::BodyID> s_BodyToDelete{};
@@ -0,0 +1,64 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Core/Macros.hpp"
+
+namespace Imagine {
+
+	struct FixedTimestepSettings {
+		/// Number of physics steps per simulated second.
+		uint32_t Rate{60};
+		/// The most steps a frame can run, the time above is dropped so a hitch doesn't snowball into longer frames.
+		uint32_t MaxSubSteps{4};
+		/// Collision steps done by each physics step, needed for the fast bodies at low rates.
+		uint32_t CollisionSteps{1};
+	};
+
+	struct FixedTimestepStats {
+		uint64_t steps{0};
+		/// Frames that hit 'MaxSubSteps' and lost some time.
+		uint64_t clampedFrames{0};
+		double droppedSeconds{0.0};
+	};
+
+	/**
+	 * Accumulate the variable frame time and convert it into a number of fixed steps.
+	 *
+	 * The time not consumed by a step stays in the accumulator for the next frame.
+	 * The fraction of a step remaining is the interpolation factor between the last two states of the simulation,
+	 * rendering them blended keeps the motion smooth when the frame rate and the step rate differ.
+	 */
+	class FixedTimestep {
+	public:
+		FixedTimestep() = default;
+		explicit FixedTimestep(const FixedTimestepSettings &settings);
+
+		void SetSettings(const FixedTimestepSettings &settings);
+		[[nodiscard]] const FixedTimestepSettings &GetSettings() const { return m_Settings; }
+
+		/// Add the time of a frame.
+		/// @return The number of steps to run this frame, at most 'MaxSubSteps'.
+		uint32_t Advance(double seconds);
+
+		/// Empty the accumulator, when the simulation is (re)started.
+		void Reset();
+
+		/// Restore the time left from a previous run, a snapshot of the simulation for instance. Clamped to less than a step.
+		void SetAccumulator(double seconds);
+
+		[[nodiscard]] double GetStep() const { return 1.0 / static_cast<double>(m_Settings.Rate); }
+		[[nodiscard]] double GetAccumulator() const { return m_Accumulator; }
+		/// @return The fraction of a step left in the accumulator, in [0, 1).
+		[[nodiscard]] double GetAlpha() const { return m_Accumulator * static_cast<double>(m_Settings.Rate); }
+		[[nodiscard]] const FixedTimestepStats &GetStats() const { return m_Stats; }
+
+	private:
+		FixedTimestepSettings m_Settings;
+		double m_Accumulator{0.0};
+		FixedTimestepStats m_Stats;
+	};
+
+} // namespace Imagine
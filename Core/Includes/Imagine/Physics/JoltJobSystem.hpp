@@ -0,0 +1,44 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Core/Macros.hpp"
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+namespace Imagine {
+
+	/**
+	 * Jolt job system running its jobs on the engine JobSystem workers.
+	 * This way the physics doesn't spawn its own threads and compete with the engine for the cores.
+	 * If the engine JobSystem isn't initialized or has no worker, the jobs are executed on the thread queuing them.
+	 */
+	class JoltJobSystem final : public JPH::JobSystemWithBarrier {
+	public:
+		JoltJobSystem(JPH::uint maxJobs, JPH::uint maxBarriers);
+		virtual ~JoltJobSystem() override = default;
+
+		// See JPH::JobSystem
+		virtual int GetMaxConcurrency() const override;
+		virtual JPH::JobHandle CreateJob(const char *inName, JPH::ColorArg inColor, const JobFunction &inJobFunction, JPH::uint32 inNumDependencies = 0) override;
+
+	protected:
+		// See JPH::JobSystem
+		virtual void QueueJob(Job *inJob) override;
+		virtual void QueueJobs(Job **inJobs, JPH::uint inNumJobs) override;
+		virtual void FreeJob(Job *inJob) override;
+
+	private:
+		static void RunJob(Job *job);
+		static void ExecuteJob(void *data, uint32_t begin, uint32_t end);
+
+	private:
+		using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+		AvailableJobs m_Jobs;
+	};
+
+} // namespace Imagine
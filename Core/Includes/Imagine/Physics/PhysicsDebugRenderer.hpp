@@ -14,14 +14,17 @@
 #include "Imagine/Physics/PhysicsTypeHelpers.hpp"
 #include "Imagine/Rendering/CPU/CPUMaterialInstance.hpp"
 #include "Imagine/Rendering/CPU/CPUMesh.hpp"
+#include "Imagine/Rendering/DebugDrawBuffer.hpp"
 #include "Imagine/Rendering/RenderObject.hpp"
 
 namespace Imagine {
 
 	class PhysicsDebugRenderer final : public JPH::DebugRendererSimple {
 	public:
-		inline static std::vector<Imagine::Vertex> s_Vertices{};
-		inline static std::vector<LineObject> s_Lines{};
+		/// The triangles of the frame, as triplets of vertices. Filled from the job threads of Jolt.
+		inline static DebugDrawBuffer s_Triangles{};
+		/// The lines of the frame, as pairs of vertices. Filled from the job threads of Jolt.
+		inline static DebugDrawBuffer s_Lines{};
 	public:
 		virtual void DrawLine(JPH::RVec3Arg inFrom, JPH::RVec3Arg inTo, JPH::ColorArg inColor) override;
 		virtual void DrawTriangle(JPH::RVec3Arg inV1, JPH::RVec3Arg inV2, JPH::RVec3Arg inV3, JPH::ColorArg inColor, ECastShadow inCastShadow) override;
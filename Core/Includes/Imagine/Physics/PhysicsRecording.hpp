@@ -0,0 +1,75 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Math/Core.hpp"
+
+namespace Imagine {
+
+	/**
+	 * Layout of the recording file.
+	 * The file starts with a 'PhysicsRecordingHeader', then come the snapshot, the frames, the deletions and the impulses.
+	 */
+	static inline constexpr uint32_t c_PhysicsRecordingMagic = 0x524E474D; // "MGNR"
+	static inline constexpr uint32_t c_PhysicsRecordingVersion = 1;
+
+	struct PhysicsRecordingHeader {
+		uint32_t magic{c_PhysicsRecordingMagic};
+		uint32_t version{c_PhysicsRecordingVersion};
+		uint64_t snapshotSize{0};
+		uint64_t frameCount{0};
+		uint64_t deletionCount{0};
+		uint64_t impulseCount{0};
+		uint64_t finalHash{0};
+	};
+
+	/// What the physics world received during a frame.
+	struct PhysicsRecordedFrame {
+		/// The time given to 'PhysicsLayer::Simulate'.
+		double deltaTime{0};
+		/// The bodies destroyed before the steps, from 'firstDeletion' in 'PhysicsRecording::deletions'.
+		uint32_t firstDeletion{0};
+		uint32_t deletionCount{0};
+		/// The velocities added after the steps, from 'firstImpulse' in 'PhysicsRecording::impulses'.
+		uint32_t firstImpulse{0};
+		uint32_t impulseCount{0};
+	};
+
+	struct PhysicsRecordedImpulse {
+		/// The index and sequence number of the BodyID.
+		uint32_t body{0};
+		glm::fvec3 linear{0};
+		glm::fvec3 angular{0};
+	};
+
+	static_assert(std::is_trivially_copyable_v<PhysicsRecordingHeader>);
+	static_assert(std::is_trivially_copyable_v<PhysicsRecordedFrame>);
+	static_assert(std::is_trivially_copyable_v<PhysicsRecordedImpulse>);
+
+	/**
+	 * A simulated session of the physics world, to replay without the scenes, the scripts nor the window.
+	 *
+	 * It starts from a snapshot of the world, then gives each frame the time it lasted and what the layer did to the bodies.
+	 * Jolt being deterministic, replaying it in the same build reaches the same state bit for bit, checked with 'finalHash'.
+	 */
+	struct PhysicsRecording {
+		static inline constexpr const char *c_DefaultPath = "PhysicsRecording.bin";
+
+		/// Made by 'PhysicsLayer::SaveSnapshot'.
+		std::vector<uint8_t> snapshot;
+		std::vector<PhysicsRecordedFrame> frames;
+		/// The index and sequence number of the BodyIDs destroyed.
+		std::vector<uint32_t> deletions;
+		std::vector<PhysicsRecordedImpulse> impulses;
+		/// 'PhysicsLayer::HashState' at the end of the recording.
+		uint64_t finalHash{0};
+
+		/// @return false if the file couldn't be written.
+		bool Write(const std::filesystem::path &filePath) const;
+		/// @return Nothing if the file can't be read or isn't a valid recording.
+		static std::optional<PhysicsRecording> Read(const std::filesystem::path &filePath);
+	};
+
+} // namespace Imagine
@@ -0,0 +1,43 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Components/Physicalisable.hpp"
+
+namespace Imagine {
+
+	struct ShapeCacheStats {
+		uint32_t shapes{0};
+		uint64_t hits{0};
+		uint64_t misses{0};
+		/// Memory used by the cached shapes, as reported by Jolt.
+		uint64_t bytes{0};
+		uint64_t triangles{0};
+	};
+
+	/**
+	 * Share the collision shapes between the bodies having the same shape parameters.
+	 *
+	 * The shapes are immutable and reference counted in Jolt, so a thousand identical crates can use a single box.
+	 * The primitives are keyed by their dimensions, the convex hulls and the meshes by the handle of their CPUMesh,
+	 * their shape being rebuilt once the CPUMesh is unloaded or reloaded.
+	 * A shape stays alive while a body uses it or until the cache is cleared or purged, the cache must be cleared before Jolt is shut down.
+	 * Thread safe.
+	 */
+	class ShapeCache {
+	public:
+		/// @return The shared shape, null if it can't be built. (e.g. its mesh isn't loaded yet)
+		static JPH::ShapeRefC GetShape(const Physicalisable::ShapeVariant &shape);
+
+		/// Release the shapes used by no body anymore.
+		/// @return The number of shapes released.
+		static uint32_t Purge();
+		/// Release every shape, the bodies keep theirs alive.
+		static void Clear();
+
+		[[nodiscard]] static ShapeCacheStats GetStats();
+	};
+
+} // namespace Imagine
@@ -38,6 +38,8 @@ namespace Imagine {
 		std::vector<Vertex> Vertices;
 		std::vector<uint32_t> Indices;
 		std::vector<LOD> Lods;
+		/// Layout of the vertices once uploaded to the GPU.
+		VertexLayout Layout{VertexLayout::Full};
 		BoundingBox aabb;
 		Ref<GPUMesh> gpu{nullptr};
 	};
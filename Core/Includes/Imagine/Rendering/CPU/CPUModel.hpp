@@ -39,7 +39,10 @@ namespace Imagine {
 		static Ref<CPUModel> LoadModel(const Path &filePath, Scene* coreScene, EntityID parent = EntityID::NullID);
 		static Ref<CPUModel> LoadModel(const std::filesystem::path &filePath, Scene* coreScene, EntityID parent = EntityID::NullID);
 		static Ref<CPUModel> LoadModel(const Path &filePath);
+		/// Load the cooked model from the cache of the project if it's up to date, otherwise import it and cook it.
 		static Ref<CPUModel> LoadModel(const std::filesystem::path &filePath);
+		/// Import the model with Assimp, without going through the cooked cache.
+		static Ref<CPUModel> ImportModel(const std::filesystem::path &filePath);
 	public:
 		void LoadInScene(Scene* coreScene, EntityID parent = EntityID::NullID);
 	public:
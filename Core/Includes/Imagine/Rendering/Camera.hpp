@@ -12,6 +12,10 @@ namespace Imagine {
 	class Camera {
 	public:
 		static Camera* s_MainCamera;
+		/// The perspective of the renderers, in degrees for the vertical field of view.
+		static inline constexpr float c_FieldOfView = 70.0f;
+		static inline constexpr float c_NearPlane = 0.1f;
+		static inline constexpr float c_FarPlane = 10000.0f;
 	public:
 		Vec3 velocity{0};
 		Vec3 position{-7, 6, 0};
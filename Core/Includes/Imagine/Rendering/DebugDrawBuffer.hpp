@@ -0,0 +1,51 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Rendering/MeshParameters.hpp"
+
+namespace Imagine {
+
+	/**
+	 * Vertices of the debug geometry of a frame, appended from any thread.
+	 *
+	 * The storage is allocated once and never moves while appending, so 'Append' is a single atomic add.
+	 * When a frame asks for more than the capacity, the extra vertices are dropped and 'Reset' grows the buffer
+	 * to fit them, so the next frames have room. The vertices are given as is to the renderer, which copies them
+	 * once to the GPU.
+	 */
+	class DebugDrawBuffer {
+	public:
+		static inline constexpr uint32_t c_DefaultCapacity = 16 * 1024;
+
+	public:
+		explicit DebugDrawBuffer(uint32_t capacity = c_DefaultCapacity);
+		DebugDrawBuffer(const DebugDrawBuffer &) = delete;
+		DebugDrawBuffer &operator=(const DebugDrawBuffer &) = delete;
+
+	public:
+		/// Reserve 'count' consecutive vertices. Lock free, callable from any thread as long as no 'Reset' runs.
+		/// @return The vertices to fill, null if the buffer is full.
+		[[nodiscard]] Vertex *Append(uint32_t count);
+
+		/// @return The vertices appended since the last reset. Not to be called while appending.
+		[[nodiscard]] std::span<const Vertex> GetVertices() const;
+
+		/// Drop the vertices of the frame, and grow to fit every vertex it requested.
+		void Reset();
+
+		[[nodiscard]] uint32_t GetCapacity() const { return static_cast<uint32_t>(m_Vertices.size()); }
+		/// @return The vertices requested since the last reset, the dropped ones included.
+		[[nodiscard]] uint64_t GetRequestedCount() const { return m_Count.load(std::memory_order_relaxed); }
+		/// @return The vertices dropped since the creation of the buffer.
+		[[nodiscard]] uint64_t GetDroppedCount() const { return m_Dropped; }
+
+	private:
+		std::vector<Vertex> m_Vertices;
+		std::atomic<uint64_t> m_Count{0};
+		uint64_t m_Dropped{0};
+	};
+
+} // namespace Imagine
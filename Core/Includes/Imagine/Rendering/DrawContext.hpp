@@ -3,22 +3,70 @@
 //
 
 #pragma once
+#include "Imagine/Core/FrameArray.hpp"
 #include "Imagine/Rendering/RenderObject.hpp"
 
 
 namespace Imagine {
 
+	/**
+	 * Everything drawn in a frame.
+	 *
+	 * The lists live in a linear arena owned by the context: 'Reset' releases the whole frame at once
+	 * and reserves the sizes of the previous frame, so a steady frame doesn't touch the heap.
+	 * The surfaces only point to their mesh. Meshes that aren't kept alive elsewhere are given to 'Retain',
+	 * which holds them until the next reset.
+	 */
 	class DrawContext {
 	public:
-		std::vector<RenderObject> OpaqueSurfaces;
-		std::vector<LineObject> OpaqueLines;
-		std::vector<PointObject> OpaquePoints;
-
-		void Clear() {
-			OpaqueSurfaces.clear();
-			OpaqueLines.clear();
-			OpaquePoints.clear();
-		}
+		static inline constexpr uint64_t c_DefaultArenaSize = 64 * 1024;
+
+	public:
+		explicit DrawContext(uint64_t arenaSize = c_DefaultArenaSize);
+		~DrawContext();
+		DrawContext(const DrawContext &) = delete;
+		DrawContext &operator=(const DrawContext &) = delete;
+		DrawContext(DrawContext &&) noexcept = default;
+		DrawContext &operator=(DrawContext &&) noexcept = default;
+
+	public:
+		FrameArray<RenderObject> OpaqueSurfaces;
+		/// Vertices of the lines, drawn as a line list through 'LineIndices' (two indices per segment).
+		FrameArray<Vertex> LineVertices;
+		FrameArray<uint32_t> LineIndices;
+		FrameArray<Vertex> PointVertices;
+		/// Debug lines as pairs of vertices, and debug triangles as triplets, drawn unindexed with the default materials.
+		/// They aren't copied in the context, the memory belongs to the caller (e.g. a DebugDrawBuffer) and must live until the draw.
+		std::span<const Vertex> DebugLines;
+		std::span<const Vertex> DebugTriangles;
+
+	public:
+		void AddLine(const Vertex &from, const Vertex &to);
+		/// Add the segments joining each point to the next one.
+		void AddLineStrip(std::span<const Vertex> points);
+		/// Add the segments given as pairs of vertices.
+		void AddLines(std::span<const Vertex> segments);
+		void AddPoint(const Vertex &point);
+
+		/// Keep the mesh alive until the next 'Reset'.
+		/// @return The handle to store in a RenderObject.
+		GPUMesh *Retain(Ref<GPUMesh> mesh);
+
+		/// Remove everything drawn, the memory is kept.
+		void Clear();
+		/// Start a new frame. Release the arena and the retained meshes, and reserve the sizes of the previous frame.
+		void Reset();
+
+		/// @return The number of allocations made in the arena since the last reset.
+		[[nodiscard]] uint64_t GetAllocationCount() const { return m_Arena->GetAllocationCount(); }
+		/// @return The number of blocks the arena requested to the heap since the last reset.
+		[[nodiscard]] uint64_t GetHeapAllocationCount() const { return m_Arena->GetHeapAllocationCount(); }
+		[[nodiscard]] uint64_t GetUsedSize() const { return m_Arena->GetUsedSize(); }
+
+	private:
+		/// Owned through a pointer so the lists keep a valid allocator when the context is moved.
+		Scope<ScratchAllocator> m_Arena;
+		std::vector<Ref<GPUMesh>> m_Retained;
 	};
 
 } // namespace Imagine
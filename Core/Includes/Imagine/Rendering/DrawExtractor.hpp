@@ -0,0 +1,81 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Assets/AssetHandle.hpp"
+#include "Imagine/Rendering/DrawContext.hpp"
+#include "Imagine/Scene/Entity.hpp"
+
+namespace Imagine {
+	class Scene;
+	struct CPUMesh;
+
+	/**
+	 * Build the draw lists of the scenes.
+	 *
+	 * The renderables are split on the JobSystem and every thread fills its own DrawContext,
+	 * which are appended to the output in thread order once every renderable is processed.
+	 * The surfaces of each asset (the GPU meshes of a model and their node transform) are resolved once on the main thread
+	 * and kept between frames, so the parallel part only reads them.
+	 * An asset resolved while some of its meshes or material instances were still loading is resolved again the next frame.
+	 * The renderables whose asset isn't resolved yet are handled on the main thread after the parallel part.
+	 *
+	 * The extractor keeps the GPU meshes of the resolved assets alive, the surfaces it emits only point to them.
+	 * A dropped asset is kept one more extraction, so the surfaces of the previous frame stay valid.
+	 */
+	class DrawExtractor {
+	public:
+		/// Minimum number of renderables processed by a job.
+		static inline constexpr uint32_t c_GrainSize = 1024;
+		static inline constexpr float c_GizmoLength = 1.0f;
+
+	public:
+		/// Append the surfaces of every Renderable of the scene to 'ctx'. The transforms of the scene must be cached.
+		void ExtractRenderables(const Scene &scene, DrawContext &ctx);
+
+		/// Debug pass appending the local axes of every entity to 'ctx' as lines.
+		static void ExtractGizmos(const Scene &scene, DrawContext &ctx);
+
+		/// Use these surfaces for the asset instead of resolving it through the asset manager. They're kept until 'Clear'.
+		/// The meshes of the surfaces aren't owned, they must outlive the extractor.
+		void SetSurfaces(AssetHandle handle, std::vector<RenderObject> surfaces);
+		/// Forget every resolved asset.
+		void Clear();
+
+		[[nodiscard]] uint64_t GetResolvedCount() const { return m_Resolved.size(); }
+
+	private:
+		struct ResolvedAsset {
+			/// The surfaces of the asset, relative to the entity.
+			std::vector<RenderObject> surfaces;
+			/// Keep the meshes of the surfaces alive.
+			std::vector<Ref<GPUMesh>> meshes;
+			/// Set with 'SetSurfaces', never dropped by the validation of the resolved assets.
+			bool pinned{false};
+			/// False if a mesh or a material instance of the asset wasn't loaded yet, the asset is then dropped by the next validation.
+			bool complete{true};
+		};
+
+		struct Miss {
+			EntityID entity;
+			AssetHandle handle;
+		};
+
+		/// Drop the resolved assets that were unloaded since the last frame, and the incomplete ones.
+		void ValidateResolved();
+		/// Resolve the surfaces of the asset through the asset manager. Return nullptr if the asset isn't ready yet.
+		const ResolvedAsset *Resolve(AssetHandle handle);
+		static void AddSurface(ResolvedAsset &asset, const Mat4 &transform, CPUMesh &mesh);
+		static void Emit(const ResolvedAsset &asset, const Mat4 &world, DrawContext &ctx);
+
+	private:
+		std::unordered_map<AssetHandle, ResolvedAsset> m_Resolved;
+		/// Meshes of the assets dropped by the last validation.
+		std::vector<Ref<GPUMesh>> m_Released;
+		std::vector<DrawContext> m_ThreadContexts;
+		std::vector<std::vector<Miss>> m_ThreadMisses;
+	};
+
+} // namespace Imagine
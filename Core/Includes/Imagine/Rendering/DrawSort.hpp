@@ -0,0 +1,72 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Assets/AssetHandle.hpp"
+#include "Imagine/Rendering/DrawContext.hpp"
+
+namespace Imagine {
+
+	/**
+	 * 64 bits key ordering the draws so the renderer changes its state as little as possible.
+	 * From the most to the least significant bits: the pass, the pipeline, the material instance, the mesh, the LOD and the depth.
+	 * The LODs of a mesh are different draws, keeping them apart keeps each one a single instance batch.
+	 * The identifiers are hashed down to their bits, a collision only costs a redundant bind.
+	 */
+	struct DrawSortKey {
+		static inline constexpr uint32_t c_PassBits = 4;
+		static inline constexpr uint32_t c_PipelineBits = 12;
+		static inline constexpr uint32_t c_MaterialBits = 16;
+		static inline constexpr uint32_t c_MeshBits = 16;
+		static inline constexpr uint32_t c_LodBits = 4;
+		static inline constexpr uint32_t c_DepthBits = 12;
+
+		static inline constexpr uint32_t c_DepthShift = 0;
+		static inline constexpr uint32_t c_LodShift = c_DepthShift + c_DepthBits;
+		static inline constexpr uint32_t c_MeshShift = c_LodShift + c_LodBits;
+		static inline constexpr uint32_t c_MaterialShift = c_MeshShift + c_MeshBits;
+		static inline constexpr uint32_t c_PipelineShift = c_MaterialShift + c_MaterialBits;
+		static inline constexpr uint32_t c_PassShift = c_PipelineShift + c_PipelineBits;
+		static inline constexpr uint64_t c_DepthMask = (uint64_t{1} << c_DepthBits) - 1;
+		static inline constexpr uint64_t c_LodMask = (uint64_t{1} << c_LodBits) - 1;
+		static_assert(c_PassShift + c_PassBits == 64, "The fields must fill the key.");
+
+		enum Pass : uint32_t {
+			Opaque = 0,
+		};
+
+		/// @return The key of a draw without its LOD and its depth.
+		[[nodiscard]] static uint64_t Make(uint32_t pass, AssetHandle pipeline, AssetHandle material, const void *mesh);
+		/// @return The key with the depth replaced by the distance to the camera, the closest draws first.
+		/// 'distance' only has to grow with the distance, its square works too.
+		[[nodiscard]] static uint64_t WithDepth(uint64_t key, float distance);
+		/// @return The key with the LOD replaced, the LODs above the bits of the field share the last value.
+		[[nodiscard]] static uint64_t WithLod(uint64_t key, uint32_t lod);
+		/// @return The 'bits' most significant bits of a hash of 'value'.
+		[[nodiscard]] static uint64_t Fold(uint64_t value, uint32_t bits);
+	};
+
+	/**
+	 * Sort the surfaces of a DrawContext by their key with a radix sort.
+	 * The keys and the indices of the surfaces are sorted 8 bits at a time, skipping the digits every key shares,
+	 * then the surfaces are moved once to their place. Equal keys keep their order.
+	 */
+	class DrawSorter {
+	public:
+		void Sort(DrawContext &ctx);
+
+	private:
+		struct Entry {
+			uint64_t key;
+			uint32_t index;
+		};
+
+	private:
+		std::vector<Entry> m_Entries;
+		std::vector<Entry> m_Swap;
+		std::vector<RenderObject> m_Sorted;
+	};
+
+} // namespace Imagine
@@ -0,0 +1,84 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Core/Math.hpp"
+#include "Imagine/Rendering/DrawContext.hpp"
+
+namespace Imagine {
+
+	/// The planes of a camera frustum in world space, their normal pointing inside.
+	struct Frustum {
+		enum Plane : uint32_t {
+			Left,
+			Right,
+			Bottom,
+			Top,
+			Near,
+			Far,
+			Count,
+		};
+
+		/// Extract the planes of a view projection matrix using a [0, 1] depth range.
+		static Frustum FromViewProjection(const Mat4 &viewProjection);
+
+		/// Test a box given by its center and half extents. Scalar version of the batched test of the FrustumCuller.
+		[[nodiscard]] bool Intersects(const glm::fvec3 &center, const glm::fvec3 &extents) const;
+
+		std::array<glm::fvec4, Plane::Count> planes{};
+	};
+
+	struct CullingStats {
+		static inline constexpr uint32_t c_MaxLods = 8;
+
+		uint32_t tested{0};
+		uint32_t visible{0};
+		uint32_t culled{0};
+		/// Visible surfaces per selected LOD. The last entry also counts the coarser LODs.
+		std::array<uint32_t, c_MaxLods> lods{};
+	};
+
+	/**
+	 * Remove the surfaces outside of the camera frustum from a DrawContext and select the LOD of the others.
+	 *
+	 * The world bounds of the surfaces are tested 4 at a time against the frustum planes using SIMD,
+	 * and the batches are split on the JobSystem. The visible surfaces keep their order.
+	 * The LOD is chosen from the size of the bounding sphere on screen, as a fraction of the viewport height.
+	 * The distance to the camera of the visible surfaces is written in the depth of their sort key.
+	 */
+	class FrustumCuller {
+	public:
+		/// Minimum number of surfaces processed by a job.
+		static inline constexpr uint32_t c_GrainSize = 1024;
+		static inline constexpr float c_DefaultLodScreenSize = 0.25f;
+
+	public:
+		/// Cull the surfaces of 'ctx' and add the result to the stats. The lines and points are kept.
+		void Cull(const Mat4 &view, const Mat4 &projection, DrawContext &ctx);
+
+		void ResetStats();
+		/// Send the stats to the profiler.
+		void ReportStats() const;
+		[[nodiscard]] const CullingStats &GetStats() const { return m_Stats; }
+
+		/// @return The LOD to use for a surface covering 'screenSize' of the viewport height.
+		[[nodiscard]] static uint32_t SelectLod(float screenSize, uint32_t lodCount, float lodScreenSize);
+
+	public:
+		/// Screen size under which a surface switches to its second LOD. Each next LOD is used when the size halves again.
+		float LodScreenSize{c_DefaultLodScreenSize};
+
+	private:
+		void CullBatch(const Frustum &frustum, const glm::fvec3 &eye, float projectionScale, std::span<const RenderObject> surfaces, uint32_t first);
+
+	private:
+		/// The LOD selected for each surface, or 'c_Culled'.
+		std::vector<uint8_t> m_Lods;
+		/// The squared distance between the camera and each surface.
+		std::vector<float> m_Distances;
+		CullingStats m_Stats;
+	};
+
+} // namespace Imagine
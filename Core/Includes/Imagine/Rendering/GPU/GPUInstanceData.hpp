@@ -0,0 +1,15 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Math/Core.hpp"
+namespace Imagine {
+	/// Transform of one instance of a draw, read by the vertex shader at 'gl_InstanceIndex'.
+	struct GPUInstanceData {
+		glm::mat4 worldMatrix;
+		/// Inverse transpose of the world matrix, only its upper 3x3 is used.
+		glm::mat4 normalMatrix;
+	};
+}
@@ -7,9 +7,29 @@
 #include "Imagine/Math/Core.hpp"
 #include "Imagine/Rendering/Light.hpp"
 namespace Imagine {
+/// Every light of the frame, in world space. The renderers assign them to the clusters of their view, see LightClusters.
 struct GPULightData {
-	static inline constexpr int MaxLight{32};
-	Imagine::Light lights[MaxLight];
-	int lightCount{0};
+	std::vector<Imagine::Light> lights;
 };
+
+/// Layout of the cluster grid as read by the shaders, at the start of the light buffer.
+struct GPUClusterGrid {
+	/// Tiles on x, tiles on y, depth slices and the number of directional lights at the start of the lights.
+	glm::uvec4 size{0};
+	/// Multiply a pixel position to get its tile: tiles on x / width and tiles on y / height.
+	glm::vec4 tileScale{0};
+	/// The slice of a depth is 'log(depth) * scale + bias'. Holds the scale, the bias, the near and the far plane.
+	glm::vec4 slice{0};
+};
+
+/// The range of the light indices of a cluster.
+struct GPULightCluster {
+	uint32_t offset{0};
+	uint32_t count{0};
+};
+
+// The std430 layouts of 'LightData', 'LightClusters' and 'LightIndices' in pbr_structures.glsl, the SPIR-V of pbr.frag is built from it.
+static_assert(sizeof(GPUClusterGrid) == 48 && sizeof(GPUClusterGrid) % 16 == 0, "The lights follow the grid, aligned on a vec4.");
+static_assert(sizeof(Light) == 48 && offsetof(Light, position) == 32 && offsetof(Light, type) == 44, "'Light' must match its GLSL struct.");
+static_assert(sizeof(GPULightCluster) == 8, "A cluster is read as an uvec2.");
 }
@@ -12,5 +12,7 @@ namespace Imagine {
 		GPUMesh& operator=(const GPUMesh&) = delete;
 		virtual ~GPUMesh() = default;
 		virtual uint64_t GetID() = 0;
+		/// @return false while the data of the mesh is still being uploaded to the GPU.
+		virtual bool IsReady() const { return true; }
 	};
 }
\ No newline at end of file
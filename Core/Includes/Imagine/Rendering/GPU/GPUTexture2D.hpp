@@ -12,5 +12,7 @@ namespace Imagine {
 		GPUTexture2D& operator=(const GPUTexture2D&) = delete;
 		virtual ~GPUTexture2D() = default;
 		virtual uint64_t GetID() = 0;
+		/// @return false while the data of the texture is still being uploaded to the GPU.
+		virtual bool IsReady() const { return true; }
 	};
 }
\ No newline at end of file
@@ -0,0 +1,49 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Rendering/DrawContext.hpp"
+#include "Imagine/Rendering/GPU/GPUInstanceData.hpp"
+
+namespace Imagine {
+
+	/// Consecutive surfaces drawing the same LOD of the same mesh, drawn with a single instanced call.
+	struct InstanceBatch {
+		GPUMesh *mesh{nullptr};
+		uint32_t lod{0};
+		/// Index of the first surface of the batch, which is also its first instance.
+		uint32_t first{0};
+		uint32_t count{0};
+	};
+
+	/**
+	 * Merge the draws of a sorted DrawContext into instanced draws.
+	 * The material instance comes from the LOD of the mesh, so the surfaces of a batch share the whole state of the draw.
+	 * The sort key keeps the surfaces of a same mesh LOD next to each other, a hash collision only splits a batch.
+	 *
+	 * The instances are written in the order of the surfaces, 'InstanceBatch::first' is the instance of the first surface.
+	 * The normal matrices are computed 4 at a time using SIMD and the batches are split on the JobSystem.
+	 */
+	class InstanceBatcher {
+	public:
+		/// Minimum number of surfaces processed by a job.
+		static inline constexpr uint32_t c_GrainSize = 1024;
+
+	public:
+		/// Group the consecutive surfaces drawing the same mesh LOD.
+		void Build(std::span<const RenderObject> surfaces);
+		[[nodiscard]] const std::vector<InstanceBatch> &GetBatches() const { return m_Batches; }
+
+		/// Write the transforms of every surface to 'instances', which must hold 'surfaces.size()' entries.
+		static void WriteInstances(std::span<const RenderObject> surfaces, GPUInstanceData *instances);
+
+	private:
+		static void WriteBatch(std::span<const RenderObject> surfaces, uint32_t first, GPUInstanceData *instances);
+
+	private:
+		std::vector<InstanceBatch> m_Batches;
+	};
+
+} // namespace Imagine
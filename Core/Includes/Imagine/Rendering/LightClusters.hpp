@@ -0,0 +1,109 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Core/Math.hpp"
+#include "Imagine/Rendering/Camera.hpp"
+#include "Imagine/Rendering/GPU/GPULightData.hpp"
+
+namespace Imagine {
+
+	struct LightClusterSettings {
+		uint32_t TilesX{16};
+		uint32_t TilesY{9};
+		uint32_t Slices{24};
+		/// The depth range covered by the slices, the one of the projection.
+		float NearPlane{Camera::c_NearPlane};
+		float FarPlane{Camera::c_FarPlane};
+		/// The lights past this count in a cluster are dropped, it bounds the cost of a pixel.
+		uint32_t MaxLightsPerCluster{128};
+	};
+
+	struct LightClusterStats {
+		uint32_t lights{0};
+		uint32_t directionalLights{0};
+		/// Point and spot lights outside of the view.
+		uint32_t culledLights{0};
+		uint32_t indices{0};
+		/// Light indices above the capacity of their cluster.
+		uint32_t droppedIndices{0};
+		uint32_t occupiedClusters{0};
+		uint32_t maxLightsInCluster{0};
+	};
+
+	/**
+	 * Assign the lights of a frame to a grid of clusters dividing the view frustum, so a pixel only shades the lights around it.
+	 *
+	 * The screen is split in tiles and the depth in slices growing exponentially, each cluster having its box in view space.
+	 * The directional lights reach everything, they're moved to the start of the lights and aren't assigned.
+	 * The point and spot lights are bounded by the sphere of their range: the projection of the sphere gives the candidate clusters,
+	 * which are tested against the sphere 4 at a time using SIMD. The lights are split on the JobSystem.
+	 * The light indices of a cluster are sorted, so the result doesn't depend on the number of threads.
+	 *
+	 * The depth of a point is the distance along the view axis, the w of its clip position with a perspective projection.
+	 */
+	class LightClusters {
+	public:
+		/// Number of lights processed by a job.
+		static inline constexpr uint32_t c_GrainSize = 64;
+		/// Returned for the points outside of the grid, which must be lit by every light.
+		static inline constexpr uint32_t c_OutsideGrid = ~0u;
+
+	public:
+		void SetSettings(const LightClusterSettings &settings);
+		[[nodiscard]] const LightClusterSettings &GetSettings() const { return m_Settings; }
+
+		/// Cluster the lights for a view of 'width' by 'height' pixels and replace the stats.
+		void Build(std::span<const Light> lights, const Mat4 &view, const Mat4 &projection, uint32_t width, uint32_t height);
+
+		/// @return The index of the cluster containing a clip space position, or 'c_OutsideGrid'.
+		[[nodiscard]] uint32_t GetClusterIndex(const glm::fvec4 &clip) const;
+
+		/// Send the stats to the profiler.
+		void ReportStats() const;
+		[[nodiscard]] const LightClusterStats &GetStats() const { return m_Stats; }
+
+		[[nodiscard]] const GPUClusterGrid &GetGrid() const { return m_Grid; }
+		[[nodiscard]] uint32_t GetClusterCount() const { return m_Settings.TilesX * m_Settings.TilesY * m_Settings.Slices; }
+		/// The lights with the directional ones first, the indices refer to them.
+		[[nodiscard]] std::span<const Light> GetLights() const { return m_Lights; }
+		[[nodiscard]] std::span<const GPULightCluster> GetClusters() const { return m_Clusters; }
+		[[nodiscard]] std::span<const uint32_t> GetIndices() const { return m_Indices; }
+		/// @return The indices of the lights of a cluster, the directional lights excluded.
+		[[nodiscard]] std::span<const uint32_t> GetClusterLights(uint32_t cluster) const;
+
+	private:
+		struct Hit {
+			uint32_t cluster;
+			uint32_t light;
+		};
+
+		void BuildBounds(const glm::fmat4 &projection);
+		/// @return False when the light is outside of the grid.
+		bool AssignLight(const Light &light, uint32_t index, const glm::fmat4 &view, const glm::fmat4 &projection, std::vector<Hit> &hits) const;
+		[[nodiscard]] uint32_t GetSlice(float depth) const;
+		[[nodiscard]] uint32_t GetRowStride() const { return (m_Settings.TilesX + c_RowAlignment - 1) / c_RowAlignment * c_RowAlignment; }
+
+	private:
+		/// The clusters of a row are tested by groups of SIMD::c_Width.
+		static inline constexpr uint32_t c_RowAlignment = 4;
+
+		LightClusterSettings m_Settings;
+		GPUClusterGrid m_Grid;
+		std::vector<Light> m_Lights;
+		std::vector<GPULightCluster> m_Clusters;
+		std::vector<uint32_t> m_Indices;
+
+		/// View space boxes of the clusters, one array per bound and axis, each row of tiles padded to the SIMD width.
+		std::array<std::vector<float>, 6> m_Bounds;
+		/// The projection the boxes were built for, they're rebuilt when it or the settings change.
+		glm::fmat4 m_BoundsProjection{0};
+		bool m_BoundsDirty{true};
+		std::vector<std::vector<Hit>> m_JobHits;
+		std::vector<uint32_t> m_Counts;
+		LightClusterStats m_Stats;
+	};
+
+} // namespace Imagine
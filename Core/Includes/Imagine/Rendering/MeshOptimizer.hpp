@@ -0,0 +1,61 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Rendering/CPU/CPUMesh.hpp"
+
+namespace Imagine {
+
+	/// Efficiency of an index buffer on the GPU, as measured by meshoptimizer.
+	struct MeshStatistics {
+		/// Average cache miss ratio: vertices transformed per triangle, 0.5 at best and 3 at worst.
+		float acmr{0};
+		/// Average transformed vertex ratio: vertices transformed per vertex of the mesh, 1 at best.
+		float atvr{0};
+		/// Bytes fetched from the vertex buffer over its size, 1 at best.
+		float overfetch{0};
+	};
+
+	struct MeshOptimizationReport {
+		MeshStatistics before{};
+		MeshStatistics after{};
+		uint32_t verticesBefore{0};
+		uint32_t verticesAfter{0};
+		/// Triangles of each LOD, from the full mesh.
+		std::vector<uint32_t> lodTriangles;
+	};
+
+	struct MeshOptimizerSettings {
+		/// LODs generated on top of the full mesh. The simplification stops early once it can't reduce the mesh anymore.
+		uint32_t lodCount{3};
+		/// Fraction of the triangles of a LOD kept in the next one.
+		float lodReduction{0.5f};
+		/// Largest deformation allowed for a LOD, relative to the size of the mesh.
+		float lodError{0.05f};
+		/// How much the vertex cache efficiency can degrade to reduce the overdraw, 1.05 is 5%.
+		float overdrawThreshold{1.05f};
+	};
+
+	/**
+	 * Import time optimization of the meshes.
+	 *
+	 * The vertices are deduplicated, the triangles are ordered for the post transform cache and then for the overdraw,
+	 * and simplified versions of the mesh are appended to the index buffer as the next LODs.
+	 * The vertices are finally reordered in the order the triangles use them, for the vertex fetch.
+	 */
+	class MeshOptimizer {
+	public:
+		/// Size of the post transform cache the statistics are measured with.
+		static inline constexpr uint32_t c_CacheSize = 16;
+
+	public:
+		/// Optimize the mesh in place and replace its LODs. The material instance of the first LOD is kept for all.
+		static MeshOptimizationReport Optimize(CPUMesh &mesh, const MeshOptimizerSettings &settings = {});
+
+		/// @return The statistics of the first LOD of the mesh, or of all its indices if it has no LOD.
+		[[nodiscard]] static MeshStatistics Analyze(const CPUMesh &mesh);
+	};
+
+} // namespace Imagine
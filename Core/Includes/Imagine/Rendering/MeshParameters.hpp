@@ -29,6 +29,32 @@ namespace Imagine {
 		return false;
 	}
 
+	/// How the vertices of a mesh are stored on the GPU, see VertexPacker.
+	enum class VertexLayout : uint8_t {
+		/// The Vertex as is.
+		Full,
+		/// A CompactVertex of 24 bytes.
+		Compact,
+		/// A QuantizedVertex of 16 bytes.
+		Quantized,
+	};
+	static inline constexpr uint32_t c_VertexLayoutCount = 3;
+
+	static inline constexpr std::string VertexLayoutToString(const VertexLayout val) {
+		switch (val) {
+			case VertexLayout::Full: return "Full";
+			case VertexLayout::Compact: return "Compact";
+			case VertexLayout::Quantized: return "Quantized";
+		}
+		return "Unknown";
+	}
+	static inline constexpr bool TryVertexLayoutFromString(const std::string& str, VertexLayout& val) {
+		if(str == "Full") {val = VertexLayout::Full; return true;}
+		if(str == "Compact") {val = VertexLayout::Compact; return true;}
+		if(str == "Quantized") {val = VertexLayout::Quantized; return true;}
+		return false;
+	}
+
 	// Explicitly write the type for the glm types.
 	struct Vertex {
 		static inline Vertex PC(glm::fvec3 position, glm::fvec4 color) {
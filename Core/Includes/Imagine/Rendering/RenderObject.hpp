@@ -4,29 +4,26 @@
 
 #pragma once
 #include "Imagine/Core/Math.hpp"
+#include "Imagine/Math/BoundingBox.hpp"
 #include "Imagine/Rendering/GPU/GPUMesh.hpp"
 #include "Imagine/Rendering/MeshParameters.hpp"
 
 namespace Imagine {
 
+	/// A surface of the frame. The mesh isn't owned, it must outlive the DrawContext frame (see DrawContext::Retain).
 	struct RenderObject {
 		RenderObject() = default;
-		virtual ~RenderObject() = default;
-		RenderObject(const Mat4& trs, std::shared_ptr<GPUMesh> m) : transform(trs), mesh(std::move(m)) {}
+		RenderObject(const Mat4& trs, GPUMesh* m) : transform(trs), mesh(m) {}
 		Mat4 transform{};
-		std::shared_ptr<GPUMesh> mesh{nullptr};
+		GPUMesh* mesh{nullptr};
 		//MaterialInstance *material{nullptr};
-	};
-
-	struct LineObject {
-		// Mat4 transform;
-		std::vector<Vertex> points;
-		float width = 1.0f;
-	};
-
-	struct PointObject {
-		// Mat4 transform;
-		Vertex point;
+		/// Local bounds of the mesh. An invalid box is never culled.
+		BoundingBox bounds{};
+		/// The entry of the mesh LODs to draw, set by the culling.
+		uint32_t lod{0};
+		uint32_t lodCount{1};
+		/// Order of the surface in the frame, see DrawSortKey.
+		uint64_t sortKey{0};
 	};
 
 } // namespace Imagine
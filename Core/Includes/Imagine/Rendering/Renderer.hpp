@@ -9,6 +9,7 @@
 #include "Imagine/Core/SmartPointers.hpp"
 #include "Imagine/Rendering/DrawContext.hpp"
 #include "Imagine/Rendering/RendererParameters.hpp"
+#include "Imagine/Rendering/StagingRing.hpp"
 #include "Imagine/Scene/Entity.hpp"
 
 #include "Imagine/Rendering/CPU/CPUMaterial.hpp"
@@ -35,6 +36,20 @@ namespace Imagine {
 		Vulkan,
 	};
 
+	/// Commands recorded by the renderer since the beginning of the frame.
+	struct DrawStats {
+		uint64_t draws{0};
+		/// Surfaces drawn, a draw can hold many instances.
+		uint64_t instances{0};
+		uint64_t pipelineBinds{0};
+		uint64_t descriptorSetBinds{0};
+		uint64_t indexBufferBinds{0};
+		/// Lookups of the material instance of a draw in the asset manager.
+		uint64_t materialLookups{0};
+		/// GPU buffers created during the frame, none in a steady frame.
+		uint64_t bufferAllocations{0};
+	};
+
 	class Renderer {
 	public:
 		static Renderer *Create(ApplicationParameters appParams);
@@ -81,6 +96,15 @@ namespace Imagine {
 		virtual Ref<GPUTexture2D> LoadTexture2D(const CPUTexture2D& tex2d) = 0;
 		virtual Ref<GPUTexture3D> LoadTexture3D(const CPUTexture3D& tex3d) = 0;
 
+		/// Copy the last drawn frame into a RGBA8 image.
+		/// @return false if no frame was drawn yet, or a frame is being drawn.
+		virtual bool ReadColor(Image<uint8_t>& image) = 0;
+
+		/// @return The commands recorded since the beginning of the frame.
+		virtual const DrawStats& GetDrawStats() const = 0;
+		/// @return The totals of the uploads since the creation of the renderer.
+		virtual const UploadStats& GetUploadStats() const = 0;
+
 		virtual void SendImGuiCommands() = 0;
 		virtual void PrepareShutdown() = 0;
 	};
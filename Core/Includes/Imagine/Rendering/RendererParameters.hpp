@@ -16,5 +16,8 @@ namespace Imagine {
 	struct RendererParameters {
 		uint16_t NbrFrameInFlight = 2;
 		bool EnableDebug = c_DefaultDebugRendering;
+		/// Size of the frames drawn without a window, by the headless renderers.
+		uint32_t Width{1920};
+		uint32_t Height{1080};
 	};
 } // namespace Imagine
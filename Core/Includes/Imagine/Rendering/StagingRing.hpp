@@ -0,0 +1,70 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+namespace Imagine {
+
+	/// Totals of the uploads made since the creation of the renderer.
+	struct UploadStats {
+		uint64_t bytes{0};
+		uint64_t uploads{0};
+		/// Submissions to the GPU, each one holds every upload recorded since the previous one.
+		uint64_t batches{0};
+		/// Times an upload waited for the GPU to free some staging memory.
+		uint64_t stalls{0};
+		double stallMilliseconds{0};
+	};
+
+	/**
+	 * Allocator of the staging memory of the uploads, as offsets in a circular range of 'capacity' bytes.
+	 *
+	 * The allocations are grouped in batches: 'Close' gives every allocation made since the previous close
+	 * the value the GPU signals once the batch is done, and 'Retire' frees the batches up to a completed value.
+	 * The batches are freed in the order they were closed, the values must increase.
+	 */
+	class StagingRing {
+	public:
+		StagingRing() = default;
+		explicit StagingRing(uint64_t capacity);
+
+	public:
+		/// Drop every allocation and use a range of 'capacity' bytes.
+		void Reset(uint64_t capacity);
+
+		/// @return The offset of 'size' bytes aligned on 'alignment' (a power of two), or nothing if the range is too full.
+		[[nodiscard]] std::optional<uint64_t> Allocate(uint64_t size, uint64_t alignment = 16);
+
+		/// Give the allocations made since the previous close to the batch signalled by 'value'.
+		/// @return false if there was nothing to close.
+		bool Close(uint64_t value);
+
+		/// Free the batches whose value is lower or equal to 'completedValue'.
+		void Retire(uint64_t completedValue);
+
+		[[nodiscard]] uint64_t GetCapacity() const { return m_Capacity; }
+		/// @return The bytes in use, including the padding of the alignments and of the wrap at the end of the range.
+		[[nodiscard]] uint64_t GetUsedSize() const { return m_Used; }
+		/// @return true if some allocations are not closed yet.
+		[[nodiscard]] bool HasOpenBatch() const { return m_OpenSize != 0; }
+		/// @return The value of the oldest batch still in use, the one to wait for to free memory.
+		[[nodiscard]] std::optional<uint64_t> GetOldestValue() const;
+
+	private:
+		struct Batch {
+			uint64_t end{0};
+			uint64_t size{0};
+			uint64_t value{0};
+		};
+
+	private:
+		uint64_t m_Capacity{0};
+		uint64_t m_Head{0};
+		uint64_t m_Tail{0};
+		uint64_t m_Used{0};
+		uint64_t m_OpenSize{0};
+		std::deque<Batch> m_Batches;
+	};
+
+} // namespace Imagine
@@ -0,0 +1,65 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Rendering/MeshParameters.hpp"
+
+namespace Imagine {
+
+	/// Full precision position, octahedral normal and tangent in snorm16 and half float UVs.
+	struct CompactVertex {
+		glm::fvec3 position{0, 0, 0};
+		/// Octahedral normal, two snorm16.
+		uint32_t normal{0};
+		/// Octahedral tangent, two snorm16. The lowest bit is set when the bitangent is flipped.
+		uint32_t tangent{0};
+		/// Two half floats.
+		uint32_t uv{0};
+	};
+
+	/// Position in unorm16 within the bounds of the mesh, octahedral normal and tangent in snorm8 and half float UVs.
+	struct QuantizedVertex {
+		/// X and Y of the position, two unorm16.
+		uint32_t positionXY{0};
+		/// Z of the position in unorm16, followed by the octahedral normal in two snorm8.
+		uint32_t positionZNormal{0};
+		/// Octahedral tangent in two snorm8. The bit 16 is set when the bitangent is flipped.
+		uint32_t tangent{0};
+		/// Two half floats.
+		uint32_t uv{0};
+	};
+
+	struct PackedVertices {
+		[[nodiscard]] uint64_t GetSize() const { return vertices.size() + colors.size() * sizeof(uint32_t); }
+
+		VertexLayout layout{VertexLayout::Full};
+		uint64_t count{0};
+		std::vector<std::byte> vertices;
+		/// One unorm8x4 color per vertex for the compact layouts. Empty when every vertex is white.
+		std::vector<uint32_t> colors;
+		/// Bounds of the quantized positions: 'position = positionOffset + unorm * positionScale'.
+		glm::fvec3 positionOffset{0, 0, 0};
+		glm::fvec3 positionScale{1, 1, 1};
+	};
+
+	/**
+	 * Conversion of the vertices to the layout they're uploaded with.
+	 *
+	 * The compact layouts drop the bitangent, rebuilt in the shader from the normal, the tangent and a sign bit,
+	 * and move the color to a separate stream that is only stored when the mesh isn't white.
+	 * The vertices are converted by groups of SIMD::c_Width.
+	 */
+	class VertexPacker {
+	public:
+		/// @return The size of a vertex in the layout, without its color.
+		[[nodiscard]] static uint64_t GetVertexSize(VertexLayout layout);
+
+		[[nodiscard]] static PackedVertices Pack(std::span<const Vertex> vertices, VertexLayout layout);
+
+		/// Decode the vertices as the shaders do. The tangent and bitangent come out normalized.
+		[[nodiscard]] static std::vector<Vertex> Unpack(const PackedVertices &packed);
+	};
+
+} // namespace Imagine
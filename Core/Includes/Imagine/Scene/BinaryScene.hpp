@@ -0,0 +1,119 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Core/BufferView.hpp"
+#include "Imagine/Core/MappedFile.hpp"
+#include "Imagine/Core/UUID.hpp"
+#include "Imagine/Scene/Entity.hpp"
+#include "Imagine/Scene/Relationship.hpp"
+
+namespace Imagine {
+
+	/**
+	 * Layout of the binary scene file.
+	 * The file starts with a 'BinarySceneHeader', then comes the table of 'BinarySceneComponent',
+	 * then every array, each aligned on 'c_BinarySceneAlignment' bytes.
+	 * The arrays are the raw dense arrays of the sparse sets, so loading is a bulk copy of each of them.
+	 */
+	static inline constexpr uint32_t c_BinarySceneMagic = 0x534E474D; // "MGNS"
+	static inline constexpr uint32_t c_BinarySceneVersion = 1;
+	static inline constexpr uint64_t c_BinarySceneAlignment = 16;
+	/// The ids are indices in the sparse arrays allocated at load, the highest one is bounded.
+	static inline constexpr uint32_t c_BinarySceneMaxEntityId = 1u << 24;
+
+	/// An array stored in the file. The offset is from the beginning of the file.
+	struct BinarySceneArray {
+		uint64_t offset{0};
+		uint32_t count{0};
+		uint32_t stride{0};
+
+		[[nodiscard]] uint64_t ByteSize() const { return static_cast<uint64_t>(count) * stride; }
+	};
+
+	struct BinarySceneComponent {
+		UUID::Array64 id{};
+		uint64_t size{0};
+		/// The name of the component, as chars.
+		BinarySceneArray name;
+		/// The entity id of each component, as uint32_t.
+		BinarySceneArray ids;
+		/// The components, as 'size' bytes each.
+		BinarySceneArray data;
+		uint8_t hasConstructor{0};
+		uint8_t hasDestructor{0};
+		uint8_t hasCopyConstructor{0};
+		uint8_t padding[5]{};
+	};
+
+	struct BinarySceneHeader {
+		uint32_t magic{c_BinarySceneMagic};
+		uint32_t version{c_BinarySceneVersion};
+		UUID::Array64 handle{};
+
+		BinarySceneArray entityIds;
+		BinarySceneArray entities;
+		/// Offset of each name in 'names', one per entity plus the end of the last name.
+		BinarySceneArray nameOffsets;
+		BinarySceneArray names;
+		BinarySceneArray roots;
+		BinarySceneArray parentIds;
+		BinarySceneArray parents;
+		BinarySceneArray childIds;
+		BinarySceneArray children;
+		BinarySceneArray siblingIds;
+		BinarySceneArray siblings;
+		BinarySceneArray components;
+	};
+
+	static_assert(std::is_trivially_copyable_v<Entity>);
+	static_assert(std::is_trivially_copyable_v<BinarySceneHeader>);
+	static_assert(std::is_trivially_copyable_v<BinarySceneComponent>);
+
+	/**
+	 * Memory mapped binary scene.
+	 * Everything is read in place: the arrays point directly in the mapping and stay valid as long as the file is open.
+	 * It is the zero-copy path for trivially copyable components; 'SceneSerializer::DeserializeBinary' builds a Scene from it.
+	 */
+	class BinarySceneFile {
+	public:
+		BinarySceneFile() = default;
+		explicit BinarySceneFile(const std::filesystem::path &filePath);
+
+	public:
+		/**
+		 * Map the file and validate the header and every array. Return false if the file isn't a valid binary scene.
+		 * Every id must be an entity of the file, listed once per array, and the relationships must form a forest reached from the roots.
+		 */
+		bool Open(const std::filesystem::path &filePath);
+		void Close();
+
+		[[nodiscard]] bool IsValid() const { return m_Header != nullptr; }
+		[[nodiscard]] const BinarySceneHeader &GetHeader() const { return *m_Header; }
+		[[nodiscard]] UUID GetHandle() const { return UUID{m_Header->handle[0], m_Header->handle[1]}; }
+
+		template<typename T>
+		[[nodiscard]] std::span<const T> GetArray(const BinarySceneArray &array) const {
+			return {reinterpret_cast<const T *>(m_File.Get() + array.offset), array.count};
+		}
+
+		[[nodiscard]] std::span<const BinarySceneComponent> GetComponents() const { return GetArray<BinarySceneComponent>(m_Header->components); }
+		[[nodiscard]] const BinarySceneComponent *FindComponent(UUID id) const;
+		[[nodiscard]] std::string_view GetComponentName(const BinarySceneComponent &component) const;
+		/// The dense array of the component, in the same order as 'GetArray<uint32_t>(component.ids)'.
+		[[nodiscard]] ConstBufferView GetComponentData(const BinarySceneComponent &component) const;
+
+		[[nodiscard]] std::string_view GetName(uint32_t entityIndex) const;
+
+	private:
+		[[nodiscard]] bool IsInFile(const BinarySceneArray &array, uint64_t stride) const;
+		[[nodiscard]] bool IsValidHierarchy() const;
+
+	private:
+		MappedFile m_File;
+		const BinarySceneHeader *m_Header{nullptr};
+	};
+
+} // namespace Imagine
@@ -5,8 +5,10 @@
 #pragma once
 #include "Entity.hpp"
 #include "Imagine/Assets/Asset.hpp"
+#include "Imagine/Core/ArchetypeStorage.hpp"
 #include "Imagine/Core/Buffer.hpp"
 #include "Imagine/Core/BufferView.hpp"
+#include "Imagine/Core/JobSystem.hpp"
 #include "Imagine/Core/RawSparseSet.hpp"
 #include "Imagine/Core/SparseSet.hpp"
 #include "Imagine/Core/TypeHelper.hpp"
@@ -29,6 +31,14 @@ namespace Imagine {
 		static constexpr uint64_t c_EntityPrepareCount = 1024;
 		using Ref = std::shared_ptr<Scene>;
 
+		/// How the custom components of the scene are stored in memory.
+		enum class ComponentStorage {
+			/// One RawSparseSet per component type. Adding and removing components is cheap.
+			SparseSet,
+			/// Entities with the same components share fixed-size SoA chunks. Iterating on several components is cheap.
+			Archetype,
+		};
+
 		/// Struct holding the component metadata.
 		struct Metadata {
 			std::string name;
@@ -41,6 +51,7 @@ namespace Imagine {
 
 	public:
 		Scene();
+		explicit Scene(ComponentStorage storage);
 		~Scene();
 
 		/// The copy constructor WILL keep the same ID. Be mindful.
@@ -57,8 +68,13 @@ namespace Imagine {
 		// CRD (CRUD without the update)
 		EntityID CreateEntity();
 		EntityID CreateEntity(EntityID parentId);
+		/// A write through the mutable access must be followed by 'MarkTransformDirty', prefer the 'SetLocal' setters.
 		Entity &GetEntity(EntityID id);
 		const Entity &GetEntity(EntityID id) const;
+		/// Set the local transform of the entity and flag it as dirty.
+		void SetLocalPosition(EntityID id, const Vec3 &position);
+		void SetLocalRotation(EntityID id, const Quat &rotation);
+		void SetLocalScale(EntityID id, const Vec3 &scale);
 		bool Exist(EntityID id) const;
 		void DestroyEntity(EntityID id);
 		void Clear();
@@ -163,10 +179,28 @@ namespace Imagine {
 		void AddChild(EntityID parent, EntityID orphan);
 
 	public:
+		/**
+		 * Update the world transform of every entity flagged as dirty, and of all their descendants.
+		 * The hierarchy is kept flattened by depth (parents before children) and each depth level is computed in parallel.
+		 * Returns right away when no local transform changed since the last call.
+		 */
 		void CacheTransforms();
+		/// Flag the local transform of the entity as modified so the next 'CacheTransforms' recompute its subtree.
+		void MarkTransformDirty(EntityID id);
+		[[nodiscard]] bool IsTransformDirty(EntityID id) const;
+		/**
+		 * Set the local position and rotation of an entity and, if it's a root without children, its cached world transform right away.
+		 * Can be called concurrently on different entities, it doesn't touch the dirty flags.
+		 * @return False when the world transform couldn't be written, the caller must then 'MarkTransformDirty' the entity.
+		 */
+		bool WriteRootTransform(EntityID id, const Vec3 &position, const Quat &rotation);
 		Mat4 GetWorldTransform(EntityID id) const;
 		TransformR GetTransform(EntityID id) const;
 
+	private:
+		void RebuildHierarchyOrder();
+		[[nodiscard]] uint32_t GetHierarchyIndex(EntityID id) const;
+
 	public:
 		void SendImGuiCommands();
 
@@ -178,6 +212,7 @@ namespace Imagine {
 		/// Will iterate recursively on all the entity and will pass some data from parent to children.
 		/// As recusivity imply, this function is as resource intensive as the hierarchy go down.
 		void ForEach(std::function<void(Scene *scene, EntityID entity)> func);
+		void ForEach(std::function<void(const Scene *scene, EntityID entity)> func) const;
 
 		/// Iterate on all the entity with a function.
 		/// Will iterate recursively on all the entity and will pass some data from parent to children.
@@ -197,6 +232,33 @@ namespace Imagine {
 		template<typename T>
 		void ForEachWithComponent(std::function<void(const Scene *scene, EntityID entityId, const T &component)>) const;
 
+		/**
+		 * Typed view on every entity having all the components 'Ts'.
+		 * With sparse sets, the smallest set drives the iteration and the others are only tested for membership.
+		 * With archetypes, only the chunks of the matching archetypes are visited.
+		 * Use 'const T' to get read-only components.
+		 * Adding or removing one of the viewed components while iterating is not supported.
+		 */
+		template<typename... Ts>
+		class View;
+
+		template<typename... Ts>
+		[[nodiscard]] View<Ts...> Query();
+
+		template<typename... Ts>
+		[[nodiscard]] View<const Ts...> Query() const;
+
+		/**
+		 * Call 'func(EntityID, T&)' on every component T, splitting the work on the JobSystem.
+		 * The sparse set dense array is split in batches of 'grainSize' components, the archetypes are split by chunk.
+		 * The function is called concurrently and must not add or remove entities or components.
+		 */
+		template<typename T, typename Func>
+		void ParallelForEachWithComponent(Func &&func, uint32_t grainSize = JobSystem::c_DefaultGrainSize);
+
+		template<typename T, typename Func>
+		void ParallelForEachWithComponent(Func &&func, uint32_t grainSize = JobSystem::c_DefaultGrainSize) const;
+
 		template<typename T>
 		[[nodiscard]] uint64_t CountComponents() const {
 			return CountComponents(UUIDFromType<T>());
@@ -324,6 +386,7 @@ namespace Imagine {
 			for (auto &[uuid, comps]: m_CustomComponents) {
 				comps.Reserve(capacity);
 			}
+			m_Archetypes.Reserve(capacity);
 		}
 
 		void Prepare(const uint32_t additional_capacity) {
@@ -331,14 +394,20 @@ namespace Imagine {
 			for (auto &[uuid, comps]: m_CustomComponents) {
 				comps.Prepare(additional_capacity);
 			}
+			m_Archetypes.Reserve(m_SparseEntities.Count() + additional_capacity);
 		}
 
 	public:
 		UUID GetID() const { return Handle.GetID(); }
+		[[nodiscard]] ComponentStorage GetComponentStorage() const { return m_ComponentStorage; }
 
 	private:
 		AutoIdSparseSet<Entity, uint32_t> m_SparseEntities;
+		ComponentStorage m_ComponentStorage{ComponentStorage::SparseSet};
+		/// Used when the scene is in 'ComponentStorage::SparseSet' mode.
 		std::unordered_map<UUID, RawSparseSet<uint32_t>> m_CustomComponents;
+		/// Used when the scene is in 'ComponentStorage::Archetype' mode.
+		ArchetypeStorage m_Archetypes;
 		std::unordered_map<UUID, Metadata> m_CustomComponentsMetadata;
 		std::unordered_map<UUID, ImGuiFunction> m_CustomComponentsImGui;
 
@@ -347,7 +416,24 @@ namespace Imagine {
 		SparseSet<Child, uint32_t> m_Children;
 		SparseSet<Sibling, uint32_t> m_Siblings;
 		SparseSet<std::string, uint32_t> m_Names;
-		SparseSet<TransformR, uint32_t> m_WorldTransform;
+
+		static inline constexpr uint32_t c_InvalidHierarchyIndex = std::numeric_limits<uint32_t>::max();
+		static inline constexpr uint32_t c_TransformGrainSize = 512;
+		/// Every entity of the hierarchy, sorted by depth. A parent is always before its children.
+		std::vector<EntityID> m_HierarchyOrder;
+		/// Index in 'm_HierarchyOrder' of the parent of each element of 'm_HierarchyOrder'.
+		std::vector<uint32_t> m_HierarchyParents;
+		/// Start of each depth level in 'm_HierarchyOrder', followed by the total count.
+		std::vector<uint32_t> m_HierarchyLevels;
+		/// Index in 'm_HierarchyOrder' of each entity, indexed by entity id.
+		std::vector<uint32_t> m_HierarchyIndices;
+		/// World transform of each element of 'm_HierarchyOrder'.
+		std::vector<TransformR> m_WorldTransforms;
+		/// An entity is dirty when its stamp equals 'm_TransformStamp'. Indexed by entity id.
+		std::vector<uint32_t> m_TransformStamps;
+		uint32_t m_TransformStamp{1};
+		bool m_HasDirtyTransforms{false};
+		bool m_HierarchyChanged{false};
 
 	private:
 		// Dedicated to ImGui Rendering.
@@ -385,6 +471,17 @@ namespace Imagine {
 	template<typename T>
 	void Scene::ForEachWithComponent(std::function<void(Scene *scene, EntityID entityId, T &component)> func) {
 		const auto id = UUIDFromType<T>();
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			const ArchetypeStorage::ComponentIndex query[1]{m_Archetypes.GetComponentIndex(id)};
+			m_Archetypes.ForEachChunk(query, [this, &func](const ArchetypeStorage::ChunkView &view) {
+				T *components = view.Column<T>(0);
+				for (uint32_t i = 0; i < view.count; ++i) {
+					func(this, EntityID{view.entities[i]}, components[i]);
+				}
+			});
+			return;
+		}
+
 		if (!m_CustomComponents.contains(id)) return;
 
 		auto &components = m_CustomComponents.at(id);
@@ -401,6 +498,17 @@ namespace Imagine {
 	template<typename T>
 	void Scene::ForEachWithComponent(std::function<void(const Scene *scene, EntityID entityId, const T &component)> func) const {
 		const auto id = UUIDFromType<T>();
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			const ArchetypeStorage::ComponentIndex query[1]{m_Archetypes.GetComponentIndex(id)};
+			m_Archetypes.ForEachChunk(query, [this, &func](const ArchetypeStorage::ChunkView &view) {
+				const T *components = view.Column<T>(0);
+				for (uint32_t i = 0; i < view.count; ++i) {
+					func(this, EntityID{view.entities[i]}, components[i]);
+				}
+			});
+			return;
+		}
+
 		if (!m_CustomComponents.contains(id)) return;
 
 		auto &components = m_CustomComponents.at(id);
@@ -424,4 +532,282 @@ namespace Imagine {
 			ForEach<T>(childId, childData, func);
 		}
 	}
+
+	template<typename T, typename Func>
+	void Scene::ParallelForEachWithComponent(Func &&func, const uint32_t grainSize) {
+		const auto id = UUIDFromType<std::remove_const_t<T>>();
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			struct ChunkRange {
+				const uint32_t *entities;
+				T *components;
+				uint32_t count;
+			};
+			const ArchetypeStorage::ComponentIndex query[1]{m_Archetypes.GetComponentIndex(id)};
+			std::vector<ChunkRange> chunks;
+			m_Archetypes.ForEachChunk(query, [&chunks](const ArchetypeStorage::ChunkView &view) {
+				chunks.push_back({view.entities, view.Column<T>(0), view.count});
+			});
+			JobSystem::ParallelFor(static_cast<uint32_t>(chunks.size()), 1, [&chunks, &func](const uint32_t begin, const uint32_t end) {
+				for (uint32_t c = begin; c < end; ++c) {
+					const ChunkRange &chunk = chunks[c];
+					for (uint32_t i = 0; i < chunk.count; ++i) {
+						func(EntityID{chunk.entities[i]}, chunk.components[i]);
+					}
+				}
+			});
+			return;
+		}
+
+		const auto it = m_CustomComponents.find(id);
+		if (it == m_CustomComponents.end()) return;
+
+		RawSparseSet<uint32_t> &components = it->second;
+		JobSystem::ParallelFor(components.Count(), grainSize, [&components, &func](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				func(EntityID{components.GetID(i)}, *static_cast<T *>(components.GetAtIndex(i)));
+			}
+		});
+	}
+
+	template<typename T, typename Func>
+	void Scene::ParallelForEachWithComponent(Func &&func, const uint32_t grainSize) const {
+		// Only const components are given to the function, the scene itself is never modified.
+		const_cast<Scene *>(this)->ParallelForEachWithComponent<const T>(std::forward<Func>(func), grainSize);
+	}
+
+	template<typename... Ts>
+	class Scene::View {
+		static_assert(sizeof...(Ts) > 0, "A view needs at least one component.");
+		static_assert(sizeof...(Ts) <= ArchetypeStorage::c_MaxQueryComponents, "Too many components in the view.");
+
+	public:
+		static inline constexpr uint32_t c_Count = sizeof...(Ts);
+		using Sequence = std::index_sequence_for<Ts...>;
+		using value_type = std::tuple<EntityID, Ts &...>;
+
+		class Iterator {
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = View::value_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = value_type;
+
+		public:
+			Iterator() = default;
+			Iterator(View *view, const bool end) : m_View(view) {
+				if (!m_View->m_Valid) return;
+				if (m_View->m_Scene->m_ComponentStorage == ComponentStorage::Archetype) {
+					m_Archetype = end ? m_View->m_Scene->m_Archetypes.GetArchetypeCount() : 0;
+					if (!end) SeekArchetype();
+				}
+				else {
+					m_Index = end ? m_View->m_Sets[m_View->m_Lead]->Count() : 0;
+					if (!end) SeekSparse();
+				}
+			}
+
+			Iterator &operator++() {
+				++m_Index;
+				if (m_View->m_Scene->m_ComponentStorage == ComponentStorage::Archetype) {
+					SeekArchetype();
+				}
+				else {
+					SeekSparse();
+				}
+				return *this;
+			}
+
+			Iterator operator++(int) {
+				Iterator res{*this};
+				++(*this);
+				return res;
+			}
+
+			reference operator*() const { return Dereference(Sequence{}); }
+
+			bool operator==(const Iterator &o) const { return m_Archetype == o.m_Archetype && m_Chunk == o.m_Chunk && m_Index == o.m_Index; }
+			bool operator!=(const Iterator &o) const { return !(*this == o); }
+
+		private:
+			template<std::size_t... I>
+			reference Dereference(std::index_sequence<I...>) const {
+				if (m_View->m_Scene->m_ComponentStorage == ComponentStorage::Archetype) {
+					return reference{EntityID{m_Entities[m_Index]}, static_cast<Ts *>(m_Columns[I])[m_Index]...};
+				}
+				const uint32_t id = m_View->m_Sets[m_View->m_Lead]->GetID(m_Index);
+				return reference{EntityID{id}, *static_cast<Ts *>(m_View->m_Sets[I]->GetUnchecked(id))...};
+			}
+
+			void SeekSparse() {
+				const RawSparseSet<uint32_t> *lead = m_View->m_Sets[m_View->m_Lead];
+				while (m_Index < lead->Count() && !m_View->ContainsID(lead->GetID(m_Index))) {
+					++m_Index;
+				}
+			}
+
+			/// Move to the next valid row, going through the chunks and then the matching archetypes.
+			void SeekArchetype() {
+				ArchetypeStorage &storage = m_View->m_Scene->m_Archetypes;
+				while (m_Archetype < storage.GetArchetypeCount()) {
+					ArchetypeStorage::Archetype &archetype = storage.GetArchetype(m_Archetype);
+					if (!m_Entities) {
+						if ((m_Chunk == 0 && !LoadColumns(archetype)) || m_Chunk * archetype.chunkCapacity >= archetype.count) {
+							NextArchetype();
+							continue;
+						}
+						m_Entities = archetype.GetEntities(m_Chunk);
+						for (uint32_t i = 0; i < c_Count; ++i) {
+							m_Columns[i] = archetype.GetColumnData(m_ColumnIndices[i], m_Chunk);
+						}
+					}
+
+					if (m_Index < archetype.GetChunkCount(m_Chunk)) return;
+
+					++m_Chunk;
+					m_Index = 0;
+					m_Entities = nullptr;
+				}
+				m_Chunk = 0;
+				m_Index = 0;
+				m_Entities = nullptr;
+			}
+
+			bool LoadColumns(const ArchetypeStorage::Archetype &archetype) {
+				for (uint32_t i = 0; i < c_Count; ++i) {
+					m_ColumnIndices[i] = archetype.GetColumn(m_View->m_Indices[i]);
+					if (m_ColumnIndices[i] == ArchetypeStorage::c_NullIndex) return false;
+				}
+				return true;
+			}
+
+			void NextArchetype() {
+				++m_Archetype;
+				m_Chunk = 0;
+				m_Index = 0;
+				m_Entities = nullptr;
+			}
+
+		private:
+			View *m_View{nullptr};
+			uint32_t m_Archetype{0};
+			uint32_t m_Chunk{0};
+			/// The index in the lead sparse set or the row inside the current chunk.
+			uint32_t m_Index{0};
+			const uint32_t *m_Entities{nullptr};
+			std::array<uint32_t, c_Count> m_ColumnIndices{};
+			std::array<void *, c_Count> m_Columns{};
+		};
+
+	public:
+		explicit View(Scene *scene) : m_Scene(scene) {
+			if (m_Scene->m_ComponentStorage == ComponentStorage::Archetype) {
+				m_Indices = {m_Scene->m_Archetypes.GetComponentIndex(UUIDFromType<std::remove_const_t<Ts>>())...};
+				m_Valid = std::ranges::none_of(m_Indices, [](const ArchetypeStorage::ComponentIndex index) { return index == ArchetypeStorage::c_NullIndex; });
+				return;
+			}
+
+			m_Sets = {FindSet(UUIDFromType<std::remove_const_t<Ts>>())...};
+			m_Valid = std::ranges::none_of(m_Sets, [](const RawSparseSet<uint32_t> *set) { return set == nullptr; });
+			if (!m_Valid) return;
+			for (uint32_t i = 1; i < c_Count; ++i) {
+				if (m_Sets[i]->Count() < m_Sets[m_Lead]->Count()) m_Lead = i;
+			}
+		}
+
+		Iterator begin() { return Iterator{this, false}; }
+		Iterator end() { return Iterator{this, true}; }
+
+		/// @return Whether the entity has all the components of the view.
+		[[nodiscard]] bool Contains(const EntityID entity) const {
+			if (!m_Valid) return false;
+			if (m_Scene->m_ComponentStorage == ComponentStorage::Archetype) {
+				const ArchetypeStorage::EntityLocation location = m_Scene->m_Archetypes.GetLocation(entity.id);
+				if (location.archetype == ArchetypeStorage::c_NullIndex) return false;
+				const ArchetypeStorage::Archetype &archetype = m_Scene->m_Archetypes.GetArchetype(location.archetype);
+				return std::ranges::all_of(m_Indices, [&archetype](const ArchetypeStorage::ComponentIndex index) { return archetype.signature.test(index); });
+			}
+			return std::ranges::all_of(m_Sets, [entity](const RawSparseSet<uint32_t> *set) { return set->Exist(entity.id); });
+		}
+
+		/// @return An upper bound of the number of entities in the view.
+		[[nodiscard]] uint32_t SizeHint() const {
+			if (!m_Valid) return 0;
+			if (m_Scene->m_ComponentStorage == ComponentStorage::Archetype) {
+				uint32_t count = std::numeric_limits<uint32_t>::max();
+				for (const ArchetypeStorage::ComponentIndex index: m_Indices) {
+					count = std::min(count, m_Scene->m_Archetypes.Count(m_Scene->m_Archetypes.GetComponentInfo(index).id));
+				}
+				return count;
+			}
+			return m_Sets[m_Lead]->Count();
+		}
+
+		/**
+		 * Call the function on every entity of the view. Faster than the range-for as the archetype path works chunk by chunk.
+		 * @param func A callable taking '(EntityID, Ts&...)'.
+		 */
+		template<typename Func>
+		void Each(Func &&func) {
+			if (!m_Valid) return;
+			if (m_Scene->m_ComponentStorage == ComponentStorage::Archetype) {
+				EachArchetype(func, Sequence{});
+			}
+			else {
+				EachSparse(func, Sequence{});
+			}
+		}
+
+	private:
+		RawSparseSet<uint32_t> *FindSet(const UUID id) {
+			const auto it = m_Scene->m_CustomComponents.find(id);
+			return it == m_Scene->m_CustomComponents.end() ? nullptr : &it->second;
+		}
+
+		[[nodiscard]] bool ContainsID(const uint32_t id) const {
+			for (const RawSparseSet<uint32_t> *set: m_Sets) {
+				if (!set->Exist(id)) return false;
+			}
+			return true;
+		}
+
+		template<typename Func, std::size_t... I>
+		void EachSparse(Func &func, std::index_sequence<I...>) {
+			RawSparseSet<uint32_t> *lead = m_Sets[m_Lead];
+			const uint32_t count = lead->Count();
+			for (uint32_t i = 0; i < count; ++i) {
+				const uint32_t id = lead->GetID(i);
+				if (!ContainsID(id)) continue;
+				func(EntityID{id}, *static_cast<Ts *>(m_Sets[I]->GetUnchecked(id))...);
+			}
+		}
+
+		template<typename Func, std::size_t... I>
+		void EachArchetype(Func &func, std::index_sequence<I...>) {
+			m_Scene->m_Archetypes.ForEachChunk(m_Indices, [&func](const ArchetypeStorage::ChunkView &view) {
+				const std::tuple<Ts *...> columns{view.Column<Ts>(I)...};
+				for (uint32_t row = 0; row < view.count; ++row) {
+					func(EntityID{view.entities[row]}, std::get<I>(columns)[row]...);
+				}
+			});
+		}
+
+	private:
+		Scene *m_Scene{nullptr};
+		bool m_Valid{false};
+		uint32_t m_Lead{0};
+		std::array<RawSparseSet<uint32_t> *, c_Count> m_Sets{};
+		std::array<ArchetypeStorage::ComponentIndex, c_Count> m_Indices{};
+	};
+
+	template<typename... Ts>
+	Scene::View<Ts...> Scene::Query() {
+		return View<Ts...>{this};
+	}
+
+	template<typename... Ts>
+	Scene::View<const Ts...> Scene::Query() const {
+		// The view only hands out const components, the scene itself is never modified.
+		return View<const Ts...>{const_cast<Scene *>(this)};
+	}
 } // namespace Imagine
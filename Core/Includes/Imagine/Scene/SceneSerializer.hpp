@@ -15,6 +15,14 @@ namespace Imagine {
 	public:
 		static void SerializeReadable(Scene* scene, const std::filesystem::path& folderPath);
 		static Scene* DeserializeReadable(const std::filesystem::path& folderPath);
+
+		/// Write the scene in a single binary file. (See BinaryScene.hpp for the layout)
+		static bool SerializeBinary(const Scene* scene, const std::filesystem::path& filePath);
+		/// Map the binary file and bulk copy each of its arrays in a new scene.
+		static Scene* DeserializeBinary(const std::filesystem::path& filePath);
+
+		/// Load a scene saved with 'SerializeReadable' and write it with 'SerializeBinary'.
+		static bool ConvertReadableToBinary(const std::filesystem::path& folderPath, const std::filesystem::path& filePath);
 	};
 
 } // namespace Imagine
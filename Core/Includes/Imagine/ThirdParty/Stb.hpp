@@ -16,6 +16,7 @@ namespace Imagine::ThirdParty {
 			Imagine::Image<uint8_t> LoadFromMemory(ConstBufferView memoryImage, int desired_channels = 0);
 			Imagine::Image<uint16_t> Load16FromMemory(ConstBufferView memoryImage, int desired_channels = 0);
 			Imagine::Image<float> LoadFloatFromMemory(ConstBufferView memoryImage, int desired_channels = 0);
+			bool WritePng(const char *path, const Imagine::Image<uint8_t> &image);
 		} // namespace Image
 		namespace Perlin {
 			float Noise3(float x, float y, float z, int x_wrap, int y_wrap, int z_wrap);
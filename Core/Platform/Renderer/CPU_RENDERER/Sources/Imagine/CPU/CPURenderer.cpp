@@ -1,25 +1,150 @@
-
 //
 // Created by Sayama on 23/05/2025.
 //
 
 #include "Imagine/CPU/CPURenderer.hpp"
 
+#include "Imagine/Application/Window.hpp"
+#include "Imagine/Rendering/Camera.hpp"
+
 
 using namespace Imagine;
 
 namespace Imagine::CPU {
 	CPURenderer::CPURenderer(const ApplicationParameters &appParams) :
-		Renderer() {}
+		Renderer(), m_AppParams(appParams) {
+		Resize();
+	}
 	CPURenderer::~CPURenderer() {}
 
+	bool CPURenderer::BeginDraw(const Imagine::GPUSceneData &sceneData, const Imagine::GPULightData &lightData) {
+		MGN_PROFILE_FUNCTION();
+		Resize();
+		if (m_Rasterizer.GetWidth() == 0 || m_Rasterizer.GetHeight() == 0) {
+			return false;
+		}
+
+		m_MainDrawContext.Reset();
+		m_DrawStats = {};
+		m_SceneData = sceneData;
+
+		{
+			MGN_PROFILE_SCOPE("Setup Scene Data");
+			//TODO: Remove when I properly send the scene data from the application.
+			m_SceneData.view = GetViewMatrix();
+			m_SceneData.proj = GetProjectionMatrix();
+			m_SceneData.viewproj = m_SceneData.proj * m_SceneData.view;
+
+			// Same default lighting parameters as the Vulkan renderer.
+			m_SceneData.cameraPosition = glm::vec4(Camera::s_MainCamera ? Camera::s_MainCamera->position : glm::vec3(0), 1);
+			m_SceneData.ambientColor = glm::vec4(.1f);
+			m_SceneData.sunlightColor = glm::vec4(1.f);
+			m_SceneData.sunlightDirection = glm::vec4(0, 1, 0.5, 1.f);
+		}
+
+		m_LightClusters.Build(lightData.lights, GetViewMatrix(), GetProjectionMatrix(), m_Rasterizer.GetWidth(), m_Rasterizer.GetHeight());
+		m_LightClusters.ReportStats();
+
+		m_Rasterizer.Clear(m_ClearColor);
+		return true;
+	}
+
+	void CPURenderer::EndDraw() {
+	}
+
+	void CPURenderer::Present() {
+	}
+
 	void CPURenderer::Draw() {
-		MGN_CORE_CASSERT(false, "CPU Renderer not implemented.");
+		MGN_PROFILE_FUNCTION();
+		Draw(m_MainDrawContext);
+	}
+
+	void CPURenderer::Draw(const DrawContext &ctx) {
+		MGN_PROFILE_FUNCTION();
+		m_Rasterizer.Draw(ctx, m_SceneData, m_LightClusters);
+		// The rasterizer has no state to bind, every surface is a draw.
+		m_DrawStats.draws += ctx.OpaqueSurfaces.size();
+		m_DrawStats.instances += ctx.OpaqueSurfaces.size();
+	}
+
+	bool CPURenderer::Resize() {
+		// The headless window has no framebuffer, the size of the parameters is used instead.
+		Window *window = Window::Get();
+		if (window && window->GetFramebufferWidth() > 0 && window->GetFramebufferHeight() > 0) {
+			m_Rasterizer.Resize(window->GetFramebufferWidth(), window->GetFramebufferHeight());
+		}
+		else {
+			const RendererParameters params = m_AppParams.Renderer.value_or(RendererParameters{});
+			m_Rasterizer.Resize(params.Width, params.Height);
+		}
+		return true;
+	}
+
+	DrawContext &CPURenderer::GetDrawContext() {
+		return m_MainDrawContext;
+	}
+
+	Mat4 CPURenderer::GetViewMatrix() const {
+		return Camera::s_MainCamera ? Mat4(Camera::s_MainCamera->GetViewMatrix()) : Math::Identity<Mat4>();
 	}
+
+	Mat4 CPURenderer::GetProjectionMatrix() const {
+		const Real aspect = m_Rasterizer.GetHeight() ? (Real) m_Rasterizer.GetWidth() / (Real) m_Rasterizer.GetHeight() : Real(1);
+		Mat4 proj = glm::perspective(glm::radians(Real(Camera::c_FieldOfView)), aspect, Real(Camera::c_NearPlane), Real(Camera::c_FarPlane));
+		// Inverse Y to have up toward up
+		proj[1][1] *= -1;
+		return proj;
+	}
+
+	Mat4 CPURenderer::GetViewProjectMatrix() const {
+		return GetProjectionMatrix() * GetViewMatrix();
+	}
+
+	Rect<> CPURenderer::GetViewport() const {
+		Window *window = Window::Get();
+		if (window && window->GetWindowWidth() > 0 && window->GetWindowHeight() > 0) {
+			return window->GetWindowRect();
+		}
+		return {0, 0, (Real) m_Rasterizer.GetWidth(), (Real) m_Rasterizer.GetHeight()};
+	}
+
+	Vec3 CPURenderer::GetWorldPoint(const Vec2 screenPoint) const {
+		const auto viewportSize = GetViewport().GetSize();
+		const Vec2 normalizeMousePos = Vec2{(screenPoint.x / viewportSize.x) * 2_r - 1_r, (screenPoint.y / viewportSize.y) * 2_r - 1_r};
+		const Vec4 result = glm::inverse(GetViewProjectMatrix()) * Vec4{normalizeMousePos.x, normalizeMousePos.y, 0, 1};
+		return Vec3(result / result.w);
+	}
+
+	Ref<GPUMesh> CPURenderer::LoadMesh(const CPUMesh &mesh) {
+		MGN_PROFILE_FUNCTION();
+		return CreateRef<RasterMesh>(mesh);
+	}
+
+	Ref<GPUMaterial> CPURenderer::LoadMaterial(const CPUMaterial &material) {
+		return CreateRef<RasterMaterial>();
+	}
+
+	Ref<GPUMaterialInstance> CPURenderer::LoadMaterialInstance(const CPUMaterialInstance &instance) {
+		return CreateRef<RasterMaterialInstance>();
+	}
+
+	Ref<GPUTexture2D> CPURenderer::LoadTexture2D(const CPUTexture2D &tex2d) {
+		return CreateRef<RasterTexture2D>(tex2d.image.width, tex2d.image.height);
+	}
+
+	Ref<GPUTexture3D> CPURenderer::LoadTexture3D(const CPUTexture3D &tex3d) {
+		return CreateRef<RasterTexture3D>();
+	}
+
+	bool CPURenderer::ReadColor(Image<uint8_t> &image) {
+		m_Rasterizer.ReadColor(image);
+		return true;
+	}
+
 	void CPURenderer::SendImGuiCommands() {
-		MGN_CORE_CASSERT(false, "CPU Renderer not implemented.");
 	}
+
 	void CPURenderer::PrepareShutdown() {
-		MGN_CORE_CASSERT(false, "CPU Renderer not implemented.");
 	}
 } // namespace Imagine::CPU
@@ -4,12 +4,16 @@
 
 #pragma once
 
+#include "Imagine/CPU/Rasterizer.hpp"
 #include "Imagine/Rendering/Renderer.hpp"
 
 namespace Imagine::CPU {
+	/**
+	 * Renderer drawing on the CPU with the tiled Rasterizer.
+	 * It renders at the size of the window when there is one, or at the size given in the RendererParameters.
+	 */
 	class CPURenderer final : public Renderer {
 	public:
-		CPURenderer();
 		CPURenderer(const ApplicationParameters &appParams);
 		virtual ~CPURenderer() override;
 
@@ -17,8 +21,49 @@ namespace Imagine::CPU {
 		static RendererAPI GetStaticAPI() { return RendererAPI::CPU; }
 
 	public:
+		virtual bool BeginDraw(const Imagine::GPUSceneData &sceneData, const Imagine::GPULightData &lightData) override;
+		virtual void EndDraw() override;
+		virtual void Present() override;
 		virtual void Draw() override;
+		virtual void Draw(const DrawContext &ctx) override;
+		virtual bool Resize() override;
+
+		virtual DrawContext &GetDrawContext() override;
+
+		virtual Mat4 GetViewMatrix() const override;
+		virtual Mat4 GetProjectionMatrix() const override;
+		virtual Mat4 GetViewProjectMatrix() const override;
+
+		virtual Rect<> GetViewport() const override;
+
+		virtual Vec3 GetWorldPoint(const Vec2 screenPoint) const override;
+
+		virtual Ref<GPUMesh> LoadMesh(const CPUMesh &mesh) override;
+		virtual Ref<GPUMaterial> LoadMaterial(const CPUMaterial &material) override;
+		virtual Ref<GPUMaterialInstance> LoadMaterialInstance(const CPUMaterialInstance &instance) override;
+		virtual Ref<GPUTexture2D> LoadTexture2D(const CPUTexture2D &tex2d) override;
+		virtual Ref<GPUTexture3D> LoadTexture3D(const CPUTexture3D &tex3d) override;
+
+		virtual bool ReadColor(Image<uint8_t> &image) override;
+		virtual const DrawStats &GetDrawStats() const override { return m_DrawStats; }
+		virtual const UploadStats &GetUploadStats() const override { return m_UploadStats; }
+
 		virtual void SendImGuiCommands() override;
 		virtual void PrepareShutdown() override;
+
+	public:
+		[[nodiscard]] const Rasterizer &GetRasterizer() const { return m_Rasterizer; }
+		[[nodiscard]] Rasterizer &GetRasterizer() { return m_Rasterizer; }
+
+	private:
+		ApplicationParameters m_AppParams;
+		Rasterizer m_Rasterizer;
+		DrawContext m_MainDrawContext;
+		DrawStats m_DrawStats{};
+		/// The meshes and textures are read in place, nothing is uploaded.
+		UploadStats m_UploadStats{};
+		GPUSceneData m_SceneData{};
+		LightClusters m_LightClusters;
+		glm::fvec4 m_ClearColor{0, 0, 0, 1};
 	};
 } // namespace Imagine::CPU
@@ -0,0 +1,65 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/Rendering/CPU/CPUMesh.hpp"
+#include "Imagine/Rendering/GPU/GPUMaterial.hpp"
+#include "Imagine/Rendering/GPU/GPUMaterialInstance.hpp"
+#include "Imagine/Rendering/GPU/GPUMesh.hpp"
+#include "Imagine/Rendering/GPU/GPUTexture2D.hpp"
+#include "Imagine/Rendering/GPU/GPUTexture3D.hpp"
+
+namespace Imagine::CPU {
+
+	/// Copy of the geometry of a CPUMesh, read by the rasterizer.
+	class RasterMesh final : public GPUMesh {
+	public:
+		explicit RasterMesh(const CPUMesh &mesh) :
+			name(mesh.Name), vertices(mesh.Vertices), indices(mesh.Indices), lods(mesh.Lods) {
+			if (lods.empty()) lods.emplace_back(0, static_cast<uint32_t>(indices.size()));
+		}
+		virtual ~RasterMesh() override = default;
+
+		virtual uint64_t GetID() override { return reinterpret_cast<uint64_t>(vertices.data()); }
+
+		std::string name;
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		std::vector<LOD> lods;
+	};
+
+	/// The software renderer only uses the vertex colors for now, the materials and textures are placeholders.
+	class RasterMaterial final : public GPUMaterial {
+	public:
+		RasterMaterial() = default;
+		virtual ~RasterMaterial() override = default;
+		virtual uint64_t GetID() override { return reinterpret_cast<uint64_t>(this); }
+	};
+
+	class RasterMaterialInstance final : public GPUMaterialInstance {
+	public:
+		RasterMaterialInstance() = default;
+		virtual ~RasterMaterialInstance() override = default;
+		virtual uint64_t GetID() override { return reinterpret_cast<uint64_t>(this); }
+	};
+
+	class RasterTexture2D final : public GPUTexture2D {
+	public:
+		RasterTexture2D(const uint32_t width, const uint32_t height) : width(width), height(height) {}
+		virtual ~RasterTexture2D() override = default;
+		virtual uint64_t GetID() override { return reinterpret_cast<uint64_t>(this); }
+
+		uint32_t width;
+		uint32_t height;
+	};
+
+	class RasterTexture3D final : public GPUTexture3D {
+	public:
+		RasterTexture3D() = default;
+		virtual ~RasterTexture3D() override = default;
+		virtual uint64_t GetID() override { return reinterpret_cast<uint64_t>(this); }
+	};
+
+} // namespace Imagine::CPU
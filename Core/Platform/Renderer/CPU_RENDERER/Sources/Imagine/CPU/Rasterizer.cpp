@@ -0,0 +1,479 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Imagine/CPU/Rasterizer.hpp"
+
+#include "Imagine/Core/JobSystem.hpp"
+#include "Imagine/Core/SIMD.hpp"
+
+namespace Imagine::CPU {
+
+	namespace {
+		/// Same attenuation as the point and spot lights of 'pbr.frag'.
+		float Attenuation(const Light &light, const float distance) {
+			const float range = std::max(glm::length(glm::fvec3(light.direction)), static_cast<float>(Math::Epsilon));
+			const float intensity = std::max(light.color.w, 0.0f) / (1.0f + 0.09f * distance + 0.032f * distance * distance);
+			return intensity * std::clamp((1.0f - distance / range) * 10.0f, 0.0f, 1.0f);
+		}
+
+		/// The light received by a point, as in 'pbr.frag' without the specular.
+		glm::fvec3 Lambert(const Light &light, const glm::fvec3 &position, const glm::fvec3 &normal) {
+			glm::fvec3 direction;
+			float intensity;
+			if (light.type == LIGHT_DIRECTIONAL) {
+				direction = -glm::normalize(glm::fvec3(light.direction));
+				intensity = std::max(light.color.w, 0.0f);
+			}
+			else {
+				const glm::fvec3 toLight = light.position - position;
+				const float distance = glm::length(toLight);
+				if (distance <= static_cast<float>(Math::Epsilon)) return glm::fvec3{0};
+				direction = toLight / distance;
+				if (light.type == LIGHT_SPOT && glm::dot(direction, -glm::normalize(glm::fvec3(light.direction))) <= std::cos(light.direction.w)) return glm::fvec3{0};
+				intensity = Attenuation(light, distance);
+			}
+			return glm::fvec3(light.color) * intensity * std::max(glm::dot(normal, direction), 0.0f);
+		}
+
+		uint32_t GetFirstTile(const int32_t min) { return static_cast<uint32_t>(min) / Rasterizer::c_TileSize; }
+	} // namespace
+
+	void Rasterizer::Resize(const uint32_t width, const uint32_t height) {
+		if (width == m_Width && height == m_Height) return;
+		m_Width = width;
+		m_Height = height;
+		m_Stride = (width + SIMD::c_Width - 1) / SIMD::c_Width * SIMD::c_Width;
+		m_TilesX = (width + c_TileSize - 1) / c_TileSize;
+		m_TilesY = (height + c_TileSize - 1) / c_TileSize;
+		m_Color.assign(static_cast<size_t>(m_Stride) * height, 0);
+		m_Depth.assign(static_cast<size_t>(m_Stride) * height, 1.0f);
+	}
+
+	void Rasterizer::Clear(const glm::fvec4 &color, const float depth) {
+		MGN_PROFILE_FUNCTION();
+		std::fill(m_Color.begin(), m_Color.end(), Pack(color));
+		std::fill(m_Depth.begin(), m_Depth.end(), depth);
+	}
+
+	void Rasterizer::Draw(const DrawContext &ctx, const GPUSceneData &sceneData, const LightClusters &lights) {
+		MGN_PROFILE_FUNCTION();
+		if (m_Width == 0 || m_Height == 0) return;
+		const glm::fmat4 viewProjection{sceneData.viewproj};
+
+		uint64_t vertexCount = 0;
+		uint64_t triangleCount = 0;
+		{
+			MGN_PROFILE_SCOPE("Gather Surfaces");
+			m_Surfaces.clear();
+			for (const RenderObject &object: ctx.OpaqueSurfaces) {
+				const RasterMesh *mesh = static_cast<const RasterMesh *>(object.mesh);
+				if (!mesh || mesh->vertices.empty()) continue;
+				const LOD &lod = mesh->lods[std::min<size_t>(object.lod, mesh->lods.size() - 1)];
+				if (lod.count < 3) continue;
+
+				const glm::fmat4 world{object.transform};
+				m_Surfaces.push_back({mesh, lod, world, viewProjection * world, glm::transpose(glm::inverse(glm::fmat3(world))), vertexCount, triangleCount});
+				vertexCount += mesh->vertices.size();
+				triangleCount += lod.count / 3;
+			}
+		}
+
+		// The debug triangles are set up and binned after the ones of the surfaces, unlit.
+		m_ViewProjection = viewProjection;
+		m_SurfaceTriangleCount = triangleCount;
+		m_DebugTriangles = ctx.DebugTriangles;
+		triangleCount += ctx.DebugTriangles.size() / 3;
+
+		if (triangleCount != 0) {
+			m_Stats.submittedTriangles += triangleCount;
+
+			{
+				MGN_PROFILE_SCOPE("Shade Vertices");
+				m_Vertices.resize(vertexCount);
+				JobSystem::ParallelFor(static_cast<uint32_t>(vertexCount), c_VertexGrainSize, [&](const uint32_t begin, const uint32_t end) {
+					ShadeVertices(sceneData, lights, begin, end);
+				});
+			}
+
+			const uint32_t tileCount = GetTileCount();
+			{
+				MGN_PROFILE_SCOPE("Setup Triangles");
+				m_ChunkTriangles.resize(c_ChunkCount);
+				m_ChunkTileOffsets.assign(static_cast<size_t>(c_ChunkCount) * tileCount, 0);
+				JobSystem::ParallelFor(c_ChunkCount, 1, [&](const uint32_t begin, const uint32_t end) {
+					for (uint32_t chunk = begin; chunk < end; ++chunk) {
+						SetupChunk(chunk, triangleCount * chunk / c_ChunkCount, triangleCount * (chunk + 1) / c_ChunkCount);
+					}
+				});
+			}
+
+			{
+				MGN_PROFILE_SCOPE("Bin Triangles");
+				// Turn the counts into write offsets, the chunks of a tile being stored one after the other.
+				m_TileOffsets.resize(tileCount + 1);
+				uint32_t binCount = 0;
+				for (uint32_t tile = 0; tile < tileCount; ++tile) {
+					m_TileOffsets[tile] = binCount;
+					for (uint32_t chunk = 0; chunk < c_ChunkCount; ++chunk) {
+						uint32_t &offset = m_ChunkTileOffsets[chunk * tileCount + tile];
+						const uint32_t count = offset;
+						offset = binCount;
+						binCount += count;
+					}
+				}
+				m_TileOffsets[tileCount] = binCount;
+
+				m_ChunkBases.resize(c_ChunkCount);
+				uint32_t triangles = 0;
+				for (uint32_t chunk = 0; chunk < c_ChunkCount; ++chunk) {
+					m_ChunkBases[chunk] = triangles;
+					triangles += static_cast<uint32_t>(m_ChunkTriangles[chunk].size());
+				}
+				m_Triangles.resize(triangles);
+				m_Bins.resize(binCount);
+
+				JobSystem::ParallelFor(c_ChunkCount, 1, [&](const uint32_t begin, const uint32_t end) {
+					for (uint32_t chunk = begin; chunk < end; ++chunk) {
+						const std::vector<Triangle> &chunkTriangles = m_ChunkTriangles[chunk];
+						uint32_t *offsets = &m_ChunkTileOffsets[chunk * tileCount];
+						for (uint32_t i = 0; i < chunkTriangles.size(); ++i) {
+							const Triangle &triangle = chunkTriangles[i];
+							const uint32_t index = m_ChunkBases[chunk] + i;
+							m_Triangles[index] = triangle;
+							for (uint32_t y = GetFirstTile(triangle.minY); y <= GetFirstTile(triangle.maxY); ++y) {
+								for (uint32_t x = GetFirstTile(triangle.minX); x <= GetFirstTile(triangle.maxX); ++x) {
+									m_Bins[offsets[y * m_TilesX + x]++] = index;
+								}
+							}
+						}
+					}
+				});
+
+				m_Stats.rasterizedTriangles += triangles;
+				m_Stats.binnedTriangles += binCount;
+			}
+
+			{
+				MGN_PROFILE_SCOPE("Rasterize Tiles");
+				JobSystem::ParallelFor(tileCount, 1, [&](const uint32_t begin, const uint32_t end) {
+					for (uint32_t tile = begin; tile < end; ++tile) {
+						RasterizeTile(tile);
+					}
+				});
+			}
+		}
+
+		m_DebugTriangles = {};
+
+		DrawLines(ctx.LineVertices, ctx.LineIndices, viewProjection);
+		for (size_t i = 1; i < ctx.DebugLines.size(); i += 2) {
+			DrawLine(ctx.DebugLines[i - 1], ctx.DebugLines[i], viewProjection);
+		}
+		DrawPoints(ctx.PointVertices, viewProjection);
+	}
+
+	void Rasterizer::ShadeVertices(const GPUSceneData &sceneData, const LightClusters &lights, const uint64_t begin, const uint64_t end) {
+		const glm::fvec3 sunDirection{sceneData.sunlightDirection};
+		const glm::fvec3 ambient{sceneData.ambientColor};
+		const glm::fvec3 sun = glm::fvec3(sceneData.sunlightColor) * sceneData.sunlightDirection.w;
+		const std::span<const Light> allLights = lights.GetLights();
+		const uint32_t directionalCount = lights.GetGrid().size.w;
+
+		// The first surface owning a vertex of the range.
+		auto surface = std::upper_bound(m_Surfaces.begin(), m_Surfaces.end(), begin, [](const uint64_t vertex, const Surface &s) { return vertex < s.firstVertex; }) - 1;
+		for (uint64_t index = begin; index < end; ++index) {
+			while (index >= surface->firstVertex + surface->mesh->vertices.size()) ++surface;
+			const Vertex &vertex = surface->mesh->vertices[index - surface->firstVertex];
+			const glm::fvec3 position{surface->world * glm::fvec4(vertex.position, 1)};
+			const glm::fvec3 normal = glm::normalize(surface->normal * vertex.normal);
+			const glm::fvec3 albedo{vertex.color};
+			const glm::fvec4 clip = surface->clip * glm::fvec4(vertex.position, 1);
+
+			// Lambert lighting evaluated per vertex, the sun being shaded as in 'mesh.frag'.
+			glm::fvec3 light = sun * std::max(glm::dot(normal, sunDirection), 0.1f) + ambient;
+			for (uint32_t i = 0; i < directionalCount; ++i) {
+				light += Lambert(allLights[i], position, normal);
+			}
+			// The vertices outside of the view still light the pixels of their triangles, they're lit by every light.
+			const uint32_t cluster = lights.GetClusterIndex(clip);
+			if (cluster == LightClusters::c_OutsideGrid) {
+				for (uint32_t i = directionalCount; i < allLights.size(); ++i) {
+					light += Lambert(allLights[i], position, normal);
+				}
+			}
+			else {
+				for (const uint32_t i: lights.GetClusterLights(cluster)) {
+					light += Lambert(allLights[i], position, normal);
+				}
+			}
+
+			m_Vertices[index] = {clip, albedo * light};
+		}
+	}
+
+	void Rasterizer::SetupChunk(const uint32_t chunk, const uint64_t begin, const uint64_t end) {
+		std::vector<Triangle> &triangles = m_ChunkTriangles[chunk];
+		triangles.clear();
+		if (begin == end) return;
+
+		const uint64_t surfaceEnd = std::min(end, m_SurfaceTriangleCount);
+		if (begin < surfaceEnd) {
+			auto surface = std::upper_bound(m_Surfaces.begin(), m_Surfaces.end(), begin, [](const uint64_t triangle, const Surface &s) { return triangle < s.firstTriangle; }) - 1;
+			for (uint64_t index = begin; index < surfaceEnd; ++index) {
+				while (index >= surface->firstTriangle + surface->lod.count / 3) ++surface;
+				const uint32_t *indices = &surface->mesh->indices[surface->lod.index + (index - surface->firstTriangle) * 3];
+				const ShadedVertex *vertices = &m_Vertices[surface->firstVertex];
+				ClipAndSetup(vertices[indices[0]], vertices[indices[1]], vertices[indices[2]], chunk);
+			}
+		}
+
+		for (uint64_t index = std::max(begin, m_SurfaceTriangleCount); index < end; ++index) {
+			const Vertex *vertices = &m_DebugTriangles[(index - m_SurfaceTriangleCount) * 3];
+			ShadedVertex shaded[3];
+			for (uint32_t i = 0; i < 3; ++i) {
+				shaded[i] = {m_ViewProjection * glm::fvec4(vertices[i].position, 1), glm::fvec3(vertices[i].color)};
+			}
+			ClipAndSetup(shaded[0], shaded[1], shaded[2], chunk);
+		}
+	}
+
+	void Rasterizer::ClipAndSetup(const ShadedVertex &v0, const ShadedVertex &v1, const ShadedVertex &v2, const uint32_t chunk) {
+		const glm::fvec4 &a = v0.clip;
+		const glm::fvec4 &b = v1.clip;
+		const glm::fvec4 &c = v2.clip;
+
+		// Entirely outside one of the planes of the clip space.
+		if ((a.x < -a.w && b.x < -b.w && c.x < -c.w) || (a.x > a.w && b.x > b.w && c.x > c.w)) return;
+		if ((a.y < -a.w && b.y < -b.w && c.y < -c.w) || (a.y > a.w && b.y > b.w && c.y > c.w)) return;
+		if ((a.z < 0 && b.z < 0 && c.z < 0) || (a.z > a.w && b.z > b.w && c.z > c.w)) return;
+
+		if (a.z >= 0 && b.z >= 0 && c.z >= 0) {
+			Setup(v0, v1, v2, chunk);
+			return;
+		}
+
+		// Clip against the near plane 'z = 0', the polygon having up to 4 vertices.
+		const ShadedVertex *input[3] = {&v0, &v1, &v2};
+		ShadedVertex polygon[4];
+		uint32_t count = 0;
+		for (uint32_t i = 0; i < 3; ++i) {
+			const ShadedVertex &current = *input[i];
+			const ShadedVertex &next = *input[(i + 1) % 3];
+			if (current.clip.z >= 0) polygon[count++] = current;
+			if ((current.clip.z >= 0) != (next.clip.z >= 0)) {
+				const float t = current.clip.z / (current.clip.z - next.clip.z);
+				polygon[count++] = {glm::mix(current.clip, next.clip, t), glm::mix(current.color, next.color, t)};
+			}
+		}
+
+		for (uint32_t i = 2; i < count; ++i) {
+			Setup(polygon[0], polygon[i - 1], polygon[i], chunk);
+		}
+	}
+
+	void Rasterizer::Setup(const ShadedVertex &v0, const ShadedVertex &v1, const ShadedVertex &v2, const uint32_t chunk) {
+		const ShadedVertex *vertices[3] = {&v0, &v1, &v2};
+		float x[3], y[3], z[3], invW[3];
+		for (uint32_t i = 0; i < 3; ++i) {
+			const glm::fvec4 &clip = vertices[i]->clip;
+			if (clip.w <= 0) return;
+			invW[i] = 1.0f / clip.w;
+			x[i] = (clip.x * invW[i] * 0.5f + 0.5f) * static_cast<float>(m_Width);
+			y[i] = (clip.y * invW[i] * 0.5f + 0.5f) * static_cast<float>(m_Height);
+			z[i] = clip.z * invW[i];
+		}
+
+		float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+		if (!(std::abs(area) > 0)) return;
+		// Both windings are drawn, the edge functions being oriented so the inside is positive.
+		if (area < 0) {
+			std::swap(vertices[1], vertices[2]);
+			std::swap(x[1], x[2]);
+			std::swap(y[1], y[2]);
+			std::swap(z[1], z[2]);
+			std::swap(invW[1], invW[2]);
+			area = -area;
+		}
+
+		const float width = static_cast<float>(m_Width);
+		const float height = static_cast<float>(m_Height);
+		const float minX = std::clamp(std::floor(std::min({x[0], x[1], x[2]})), 0.0f, width - 1);
+		const float maxX = std::clamp(std::ceil(std::max({x[0], x[1], x[2]})), 0.0f, width - 1);
+		const float minY = std::clamp(std::floor(std::min({y[0], y[1], y[2]})), 0.0f, height - 1);
+		const float maxY = std::clamp(std::ceil(std::max({y[0], y[1], y[2]})), 0.0f, height - 1);
+
+		Triangle triangle;
+		for (uint32_t k = 0; k < 3; ++k) {
+			const uint32_t i = (k + 1) % 3;
+			const uint32_t j = (k + 2) % 3;
+			triangle.a[k] = y[i] - y[j];
+			triangle.b[k] = x[j] - x[i];
+			triangle.c[k] = x[i] * y[j] - x[j] * y[i];
+			triangle.owns[k] = triangle.a[k] > 0 || (triangle.a[k] == 0 && triangle.b[k] > 0);
+		}
+		triangle.invArea = 1.0f / area;
+		triangle.z = z[0];
+		triangle.dz1 = z[1] - z[0];
+		triangle.dz2 = z[2] - z[0];
+		// The colors are interpolated divided by w, then multiplied back per pixel to be perspective correct.
+		triangle.invW = invW[0];
+		triangle.dInvW1 = invW[1] - invW[0];
+		triangle.dInvW2 = invW[2] - invW[0];
+		triangle.color = vertices[0]->color * invW[0];
+		triangle.dColor1 = vertices[1]->color * invW[1] - triangle.color;
+		triangle.dColor2 = vertices[2]->color * invW[2] - triangle.color;
+		triangle.minX = static_cast<int32_t>(minX);
+		triangle.minY = static_cast<int32_t>(minY);
+		triangle.maxX = static_cast<int32_t>(maxX);
+		triangle.maxY = static_cast<int32_t>(maxY);
+
+		const uint32_t tileCount = GetTileCount();
+		uint32_t *counts = &m_ChunkTileOffsets[chunk * tileCount];
+		for (uint32_t ty = GetFirstTile(triangle.minY); ty <= GetFirstTile(triangle.maxY); ++ty) {
+			for (uint32_t tx = GetFirstTile(triangle.minX); tx <= GetFirstTile(triangle.maxX); ++tx) {
+				++counts[ty * m_TilesX + tx];
+			}
+		}
+		m_ChunkTriangles[chunk].push_back(triangle);
+	}
+
+	void Rasterizer::RasterizeTile(const uint32_t tile) {
+		const int32_t tileX = static_cast<int32_t>((tile % m_TilesX) * c_TileSize);
+		const int32_t tileY = static_cast<int32_t>((tile / m_TilesX) * c_TileSize);
+		for (uint32_t i = m_TileOffsets[tile]; i < m_TileOffsets[tile + 1]; ++i) {
+			RasterizeTriangle(m_Triangles[m_Bins[i]], tileX, tileY);
+		}
+	}
+
+	void Rasterizer::RasterizeTriangle(const Triangle &triangle, const int32_t tileX, const int32_t tileY) {
+		// The columns are processed by groups of 4, aligned on the SIMD width so a group never crosses a tile.
+		const int32_t startX = std::max(triangle.minX, tileX) & ~static_cast<int32_t>(SIMD::c_Width - 1);
+		const int32_t endX = std::min<int32_t>(triangle.maxX, tileX + c_TileSize - 1);
+		const int32_t startY = std::max(triangle.minY, tileY);
+		const int32_t endY = std::min<int32_t>(triangle.maxY, tileY + c_TileSize - 1);
+
+		const SIMD::Float4 zero = SIMD::Set(0);
+		const SIMD::Float4 lanes = SIMD::Set(0.5f, 1.5f, 2.5f, 3.5f);
+		const SIMD::Float4 invArea = SIMD::Set(triangle.invArea);
+		SIMD::Float4 a[3];
+		for (uint32_t k = 0; k < 3; ++k) a[k] = SIMD::Set(triangle.a[k]);
+
+		alignas(16) float r[SIMD::c_Width];
+		alignas(16) float g[SIMD::c_Width];
+		alignas(16) float b[SIMD::c_Width];
+
+		for (int32_t y = startY; y <= endY; ++y) {
+			const float centerY = static_cast<float>(y) + 0.5f;
+			float *depthRow = &m_Depth[static_cast<size_t>(y) * m_Stride];
+			uint32_t *colorRow = &m_Color[static_cast<size_t>(y) * m_Stride];
+			for (int32_t x = startX; x <= endX; x += SIMD::c_Width) {
+				const SIMD::Float4 centerX = SIMD::Set(static_cast<float>(x)) + lanes;
+
+				SIMD::Float4 edges[3];
+				SIMD::Float4 inside = SIMD::LessEqual(zero, zero);
+				for (uint32_t k = 0; k < 3; ++k) {
+					edges[k] = SIMD::MulAdd(a[k], centerX, SIMD::Set(triangle.b[k] * centerY + triangle.c[k]));
+					// A pixel on an edge belongs to the triangle owning that edge.
+					inside = SIMD::And(inside, triangle.owns[k] ? SIMD::LessEqual(zero, edges[k]) : SIMD::Less(zero, edges[k]));
+				}
+				if (SIMD::MoveMask(inside) == 0) continue;
+
+				const SIMD::Float4 l1 = edges[1] * invArea;
+				const SIMD::Float4 l2 = edges[2] * invArea;
+				const SIMD::Float4 z = SIMD::MulAdd(l1, SIMD::Set(triangle.dz1), SIMD::MulAdd(l2, SIMD::Set(triangle.dz2), SIMD::Set(triangle.z)));
+				const SIMD::Float4 depth = SIMD::LoadUnaligned(depthRow + x);
+				const SIMD::Float4 pass = SIMD::And(inside, SIMD::Less(z, depth));
+				const uint32_t mask = SIMD::MoveMask(pass);
+				if (mask == 0) continue;
+				SIMD::StoreUnaligned(depthRow + x, SIMD::Select(pass, z, depth));
+
+				const SIMD::Float4 w = SIMD::Set(1) / SIMD::MulAdd(l1, SIMD::Set(triangle.dInvW1), SIMD::MulAdd(l2, SIMD::Set(triangle.dInvW2), SIMD::Set(triangle.invW)));
+				SIMD::Store(r, SIMD::MulAdd(l1, SIMD::Set(triangle.dColor1.r), SIMD::MulAdd(l2, SIMD::Set(triangle.dColor2.r), SIMD::Set(triangle.color.r))) * w);
+				SIMD::Store(g, SIMD::MulAdd(l1, SIMD::Set(triangle.dColor1.g), SIMD::MulAdd(l2, SIMD::Set(triangle.dColor2.g), SIMD::Set(triangle.color.g))) * w);
+				SIMD::Store(b, SIMD::MulAdd(l1, SIMD::Set(triangle.dColor1.b), SIMD::MulAdd(l2, SIMD::Set(triangle.dColor2.b), SIMD::Set(triangle.color.b))) * w);
+				for (uint32_t lane = 0; lane < SIMD::c_Width; ++lane) {
+					if ((mask >> lane) & 1) colorRow[x + lane] = Pack({r[lane], g[lane], b[lane], 1});
+				}
+			}
+		}
+	}
+
+	void Rasterizer::DrawLines(const std::span<const Vertex> vertices, const std::span<const uint32_t> indices, const glm::fmat4 &viewProjection) {
+		MGN_PROFILE_FUNCTION();
+		for (size_t i = 1; i < indices.size(); i += 2) {
+			DrawLine(vertices[indices[i - 1]], vertices[indices[i]], viewProjection);
+		}
+	}
+
+	void Rasterizer::DrawLine(const Vertex &from, const Vertex &to, const glm::fmat4 &viewProjection) {
+		glm::fvec4 p0 = viewProjection * glm::fvec4(from.position, 1);
+		glm::fvec4 p1 = viewProjection * glm::fvec4(to.position, 1);
+
+		// Clip the segment against the 6 planes of the clip space.
+		float t0 = 0, t1 = 1;
+		bool visible = true;
+		const auto distances = [](const glm::fvec4 &p) {
+			return std::array<float, 6>{p.w + p.x, p.w - p.x, p.w + p.y, p.w - p.y, p.z, p.w - p.z};
+		};
+		const std::array<float, 6> d0 = distances(p0);
+		const std::array<float, 6> d1 = distances(p1);
+		for (uint32_t plane = 0; plane < 6 && visible; ++plane) {
+			if (d0[plane] < 0 && d1[plane] < 0) visible = false;
+			else if (d0[plane] < 0) t0 = std::max(t0, d0[plane] / (d0[plane] - d1[plane]));
+			else if (d1[plane] < 0) t1 = std::min(t1, d0[plane] / (d0[plane] - d1[plane]));
+		}
+		if (!visible || t0 > t1) return;
+
+		const glm::fvec4 c0 = glm::mix(from.color, to.color, t0);
+		const glm::fvec4 c1 = glm::mix(from.color, to.color, t1);
+		const glm::fvec4 clip0 = glm::mix(p0, p1, t0);
+		const glm::fvec4 clip1 = glm::mix(p0, p1, t1);
+		const glm::fvec3 s0{(clip0.x / clip0.w * 0.5f + 0.5f) * m_Width, (clip0.y / clip0.w * 0.5f + 0.5f) * m_Height, clip0.z / clip0.w};
+		const glm::fvec3 s1{(clip1.x / clip1.w * 0.5f + 0.5f) * m_Width, (clip1.y / clip1.w * 0.5f + 0.5f) * m_Height, clip1.z / clip1.w};
+
+		const uint32_t steps = static_cast<uint32_t>(std::ceil(std::max(std::abs(s1.x - s0.x), std::abs(s1.y - s0.y)))) + 1;
+		for (uint32_t step = 0; step < steps; ++step) {
+			const float t = steps > 1 ? static_cast<float>(step) / static_cast<float>(steps - 1) : 0;
+			const glm::fvec3 p = glm::mix(s0, s1, t);
+			WritePixel(static_cast<int32_t>(p.x), static_cast<int32_t>(p.y), p.z, glm::mix(c0, c1, t));
+		}
+	}
+
+	void Rasterizer::DrawPoints(const std::span<const Vertex> points, const glm::fmat4 &viewProjection) {
+		MGN_PROFILE_FUNCTION();
+		for (const Vertex &point: points) {
+			const glm::fvec4 clip = viewProjection * glm::fvec4(point.position, 1);
+			if (clip.w <= 0 || clip.z < 0 || clip.z > clip.w) continue;
+			const float x = (clip.x / clip.w * 0.5f + 0.5f) * m_Width;
+			const float y = (clip.y / clip.w * 0.5f + 0.5f) * m_Height;
+			if (x < 0 || y < 0) continue;
+			WritePixel(static_cast<int32_t>(x), static_cast<int32_t>(y), clip.z / clip.w, point.color);
+		}
+	}
+
+	void Rasterizer::WritePixel(const int32_t x, const int32_t y, const float depth, const glm::fvec4 &color) {
+		if (x < 0 || y < 0 || x >= static_cast<int32_t>(m_Width) || y >= static_cast<int32_t>(m_Height)) return;
+		const size_t index = static_cast<size_t>(y) * m_Stride + x;
+		if (!(depth < m_Depth[index])) return;
+		m_Depth[index] = depth;
+		m_Color[index] = Pack(color);
+	}
+
+	void Rasterizer::ReadColor(Image<uint8_t> &image) const {
+		MGN_PROFILE_FUNCTION();
+		if (image.width != m_Width || image.height != m_Height || image.channels != 4) {
+			image.Allocate(m_Width, m_Height, 4);
+		}
+		for (uint32_t y = 0; y < m_Height; ++y) {
+			std::memcpy(&image(0, y, 0), &m_Color[static_cast<size_t>(y) * m_Stride], m_Width * sizeof(uint32_t));
+		}
+	}
+
+	uint32_t Rasterizer::Pack(const glm::fvec4 &color) {
+		const glm::uvec4 bytes{glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f};
+		// Stored as R, G, B, A in memory.
+		return bytes.r | (bytes.g << 8) | (bytes.b << 16) | (bytes.a << 24);
+	}
+
+} // namespace Imagine::CPU
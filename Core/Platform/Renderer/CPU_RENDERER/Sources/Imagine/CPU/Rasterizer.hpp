@@ -0,0 +1,129 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#pragma once
+
+#include "Imagine/CPU/RasterTypes.hpp"
+#include "Imagine/Math/Image.hpp"
+#include "Imagine/Rendering/DrawContext.hpp"
+#include "Imagine/Rendering/GPU/GPUSceneData.hpp"
+#include "Imagine/Rendering/LightClusters.hpp"
+
+namespace Imagine::CPU {
+
+	struct RasterStats {
+		/// Triangles of the drawn LODs.
+		uint64_t submittedTriangles{0};
+		/// Triangles left after the clipping, some being split by the near plane.
+		uint64_t rasterizedTriangles{0};
+		/// Sum of the number of tiles overlapped by each triangle.
+		uint64_t binnedTriangles{0};
+	};
+
+	/**
+	 * Tiled software rasterizer writing into a RGBA8 color buffer and a float depth buffer.
+	 *
+	 * A draw goes through three parallel passes on the JobSystem:
+	 *  - the vertices are transformed and lit (Lambert lighting, per vertex) by the lights of their cluster,
+	 *  - the triangles are clipped against the near plane, set up and binned into the tiles they overlap,
+	 *  - each tile rasterizes and depth tests its triangles, 4 pixels at a time with SIMD edge functions.
+	 * The triangles are split in a fixed number of chunks, and every tile sees its triangles in submission order,
+	 * so the result doesn't depend on the number of threads.
+	 */
+	class Rasterizer {
+	public:
+		static inline constexpr uint32_t c_TileSize = 64;
+		/// Number of slices the triangles are split in for the setup and the binning.
+		static inline constexpr uint32_t c_ChunkCount = 64;
+		static inline constexpr uint32_t c_VertexGrainSize = 4096;
+
+	public:
+		void Resize(uint32_t width, uint32_t height);
+		void Clear(const glm::fvec4 &color, float depth = 1.0f);
+
+		/// Rasterize the surfaces, lines, points and debug geometry of the context. The LOD of each surface is the one selected by the culling.
+		void Draw(const DrawContext &ctx, const GPUSceneData &sceneData, const LightClusters &lights);
+
+		/// Copy the color buffer into a RGBA8 image.
+		void ReadColor(Image<uint8_t> &image) const;
+
+		[[nodiscard]] uint32_t GetWidth() const { return m_Width; }
+		[[nodiscard]] uint32_t GetHeight() const { return m_Height; }
+		[[nodiscard]] const RasterStats &GetStats() const { return m_Stats; }
+		void ResetStats() { m_Stats = {}; }
+
+	private:
+		struct ShadedVertex {
+			glm::fvec4 clip;
+			glm::fvec3 color;
+		};
+
+		struct Surface {
+			const RasterMesh *mesh;
+			LOD lod;
+			glm::fmat4 world;
+			glm::fmat4 clip;
+			glm::fmat3 normal;
+			uint64_t firstVertex;
+			uint64_t firstTriangle;
+		};
+
+		/// A triangle set up for the rasterization, with its attributes as deltas from the first vertex.
+		struct Triangle {
+			/// Edge functions 'a * x + b * y + c', one per vertex, positive inside.
+			float a[3], b[3], c[3];
+			/// Which edges own the pixels exactly on them, so a pixel shared by two triangles is only drawn once.
+			bool owns[3];
+			float invArea;
+			float z, dz1, dz2;
+			float invW, dInvW1, dInvW2;
+			glm::fvec3 color, dColor1, dColor2;
+			int32_t minX, minY, maxX, maxY;
+		};
+
+	private:
+		void ShadeVertices(const GPUSceneData &sceneData, const LightClusters &lights, uint64_t begin, uint64_t end);
+		void SetupChunk(uint32_t chunk, uint64_t begin, uint64_t end);
+		void ClipAndSetup(const ShadedVertex &v0, const ShadedVertex &v1, const ShadedVertex &v2, uint32_t chunk);
+		void Setup(const ShadedVertex &v0, const ShadedVertex &v1, const ShadedVertex &v2, uint32_t chunk);
+		void RasterizeTile(uint32_t tile);
+		void RasterizeTriangle(const Triangle &triangle, int32_t tileX, int32_t tileY);
+		/// Draw the segments given by each pair of indices.
+		void DrawLines(std::span<const Vertex> vertices, std::span<const uint32_t> indices, const glm::fmat4 &viewProjection);
+		void DrawLine(const Vertex &from, const Vertex &to, const glm::fmat4 &viewProjection);
+		void DrawPoints(std::span<const Vertex> points, const glm::fmat4 &viewProjection);
+		void WritePixel(int32_t x, int32_t y, float depth, const glm::fvec4 &color);
+
+		[[nodiscard]] uint32_t GetTileCount() const { return m_TilesX * m_TilesY; }
+		[[nodiscard]] static uint32_t Pack(const glm::fvec4 &color);
+
+	private:
+		uint32_t m_Width{0};
+		uint32_t m_Height{0};
+		/// Width of a row of the buffers, padded to the SIMD width.
+		uint32_t m_Stride{0};
+		uint32_t m_TilesX{0};
+		uint32_t m_TilesY{0};
+		std::vector<uint32_t> m_Color;
+		std::vector<float> m_Depth;
+
+		std::vector<Surface> m_Surfaces;
+		/// The triangles of the surfaces come first, then the debug triangles of the context being drawn.
+		uint64_t m_SurfaceTriangleCount{0};
+		std::span<const Vertex> m_DebugTriangles;
+		glm::fmat4 m_ViewProjection{1};
+		std::vector<ShadedVertex> m_Vertices;
+		std::vector<std::vector<Triangle>> m_ChunkTriangles;
+		/// Per chunk and per tile, the number of triangles then the write offset in the bins.
+		std::vector<uint32_t> m_ChunkTileOffsets;
+		std::vector<uint32_t> m_ChunkBases;
+		std::vector<Triangle> m_Triangles;
+		/// The triangles of each tile, from 'm_TileOffsets[tile]' to 'm_TileOffsets[tile + 1]'.
+		std::vector<uint32_t> m_Bins;
+		std::vector<uint32_t> m_TileOffsets;
+
+		RasterStats m_Stats;
+	};
+
+} // namespace Imagine::CPU
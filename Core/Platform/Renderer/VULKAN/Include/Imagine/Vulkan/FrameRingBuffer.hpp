@@ -0,0 +1,96 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include <vk_mem_alloc.h>
+#include "Imagine/Vulkan/Vulkan.hpp"
+
+namespace Imagine::Vulkan {
+
+	/**
+	 * Persistently mapped buffer the data of a frame is pushed to: the uniforms, the storage buffers, the instances and the lines.
+	 * Each frame in flight owns one, so a frame only waits for its own fence before reusing the memory.
+	 *
+	 * The allocations are linear and every one is aligned for the uniform and storage offsets,
+	 * so they can be bound with dynamic offsets on a descriptor set written once per frame.
+	 * When a frame doesn't fit, the rest of its data goes in an overflow block and the buffer grows at the next reset.
+	 */
+	class FrameRingBuffer {
+	public:
+		static inline constexpr VkDeviceSize c_DefaultSize = 4 * 1024 * 1024;
+		static inline constexpr VkBufferUsageFlags c_Usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+
+		struct Allocation {
+			void *data{nullptr};
+			VkBuffer buffer{VK_NULL_HANDLE};
+			VkDeviceSize offset{0};
+			/// Device address of the allocation, 'offset' included.
+			VkDeviceAddress address{0};
+		};
+
+	public:
+		FrameRingBuffer() = default;
+		~FrameRingBuffer() = default;
+		FrameRingBuffer(const FrameRingBuffer &) = delete;
+		FrameRingBuffer &operator=(const FrameRingBuffer &) = delete;
+		FrameRingBuffer(FrameRingBuffer &&other) noexcept;
+		FrameRingBuffer &operator=(FrameRingBuffer &&other) noexcept;
+
+	public:
+		/// @param alignment Alignment of every allocation, at least the minimum uniform and storage buffer offset alignment of the device.
+		void Init(VkDevice device, VmaAllocator allocator, VkDeviceSize size, VkDeviceSize alignment);
+		void Destroy();
+
+		/// Start a new frame. The GPU must be done with the previous frame using the buffer.
+		/// The overflow blocks are released and the buffer grows to hold them next time.
+		void Reset();
+
+		/// @return 'size' bytes of the frame, in the main buffer unless it is full.
+		[[nodiscard]] Allocation Allocate(VkDeviceSize size);
+
+		template<typename T>
+		[[nodiscard]] Allocation Push(const T &value) {
+			Allocation allocation = Allocate(sizeof(T));
+			std::memcpy(allocation.data, &value, sizeof(T));
+			return allocation;
+		}
+
+		/// @return The main buffer, the one the frame descriptors point to.
+		[[nodiscard]] VkBuffer GetBuffer() const { return m_Main.buffer; }
+		[[nodiscard]] VkDeviceSize GetSize() const { return m_Main.size; }
+		/// @return The bytes allocated since the last reset, overflow included.
+		[[nodiscard]] VkDeviceSize GetUsedSize() const { return m_Offset + m_OverflowSize; }
+		/// @return The number of buffers created since the creation of the ring. Nothing is created in a frame that fits.
+		[[nodiscard]] uint64_t GetBlockAllocationCount() const { return m_BlockAllocations; }
+
+	private:
+		struct Block {
+			VkBuffer buffer{VK_NULL_HANDLE};
+			VmaAllocation allocation{nullptr};
+			std::byte *data{nullptr};
+			VkDeviceAddress address{0};
+			VkDeviceSize size{0};
+		};
+
+		[[nodiscard]] Block CreateBlock(VkDeviceSize size);
+		void DestroyBlock(Block &block);
+		[[nodiscard]] VkDeviceSize Align(const VkDeviceSize value) const { return (value + m_Alignment - 1) & ~(m_Alignment - 1); }
+
+	private:
+		VkDevice m_Device{VK_NULL_HANDLE};
+		VmaAllocator m_Allocator{nullptr};
+		VkDeviceSize m_Alignment{256};
+
+		Block m_Main{};
+		VkDeviceSize m_Offset{0};
+
+		std::vector<Block> m_Overflow;
+		VkDeviceSize m_OverflowOffset{0};
+		VkDeviceSize m_OverflowSize{0};
+
+		uint64_t m_BlockAllocations{0};
+	};
+
+} // namespace Imagine::Vulkan
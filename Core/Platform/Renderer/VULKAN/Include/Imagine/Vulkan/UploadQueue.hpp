@@ -0,0 +1,115 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#pragma once
+
+#include <vk_mem_alloc.h>
+#include "Imagine/Rendering/StagingRing.hpp"
+#include "Imagine/Vulkan/Vulkan.hpp"
+
+namespace Imagine::Vulkan {
+
+	/**
+	 * Batched uploads of the meshes and textures to the GPU.
+	 *
+	 * The data is copied in a persistently mapped staging buffer used as a ring, and the copies are recorded
+	 * in the command buffer of the current batch instead of being submitted and waited one by one.
+	 * 'Flush' submits the batch, which signals a timeline semaphore with the value returned by the uploads it holds:
+	 * a resource is ready once the semaphore reached its value, and the frame waits for the last value submitted.
+	 *
+	 * An upload only blocks when the staging buffer is full, waiting for the oldest batch. That time is counted as a stall.
+	 * An upload larger than the staging buffer gets its own staging buffer, released once its batch is done.
+	 */
+	class UploadQueue {
+	public:
+		static inline constexpr VkDeviceSize c_DefaultSize = 64 * 1024 * 1024;
+		/// Alignment of the staging offsets, enough for the texel size of every uncompressed format.
+		static inline constexpr VkDeviceSize c_Alignment = 16;
+
+	public:
+		UploadQueue() = default;
+		~UploadQueue() = default;
+		UploadQueue(const UploadQueue &) = delete;
+		UploadQueue &operator=(const UploadQueue &) = delete;
+
+	public:
+		/// The batches are submitted to 'queue', which must support the transfers and the blits of the mipmaps.
+		/// 'queueMutex' is locked for each submit, every other user of the queue must lock it too.
+		void Init(VkDevice device, VmaAllocator allocator, VkQueue queue, std::mutex &queueMutex, uint32_t queueFamily, VkDeviceSize size = c_DefaultSize);
+		/// Wait for every batch submitted and release the queue.
+		void Destroy();
+
+		/// Copy 'size' bytes of 'data' at 'dstOffset' in 'dst'.
+		/// @return The value of the batch holding the copy.
+		uint64_t UploadBuffer(VkBuffer dst, VkDeviceSize dstOffset, const void *data, VkDeviceSize size);
+
+		/// Copy 'data' in the first mip of 'image' and generate the other 'mipLevels' with linear blits.
+		/// The image ends in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+		/// @return The value of the batch holding the copy.
+		uint64_t UploadImage(VkImage image, VkExtent3D extent, uint32_t mipLevels, const void *data, VkDeviceSize size);
+
+		/// Submit the uploads recorded since the previous flush.
+		/// @return The last value submitted.
+		uint64_t Flush();
+
+		/// @return true once the batch 'value' is done on the GPU.
+		[[nodiscard]] bool IsComplete(uint64_t value);
+		/// Submit the batch 'value' if needed and wait for it.
+		void Wait(uint64_t value);
+
+		[[nodiscard]] VkSemaphore GetSemaphore() const { return m_Semaphore; }
+		[[nodiscard]] uint64_t GetSubmittedValue() const { return m_Submitted; }
+		[[nodiscard]] const UploadStats &GetStats() const { return m_Stats; }
+
+	private:
+		struct Batch {
+			VkCommandBuffer cmd{VK_NULL_HANDLE};
+			uint64_t value{0};
+		};
+
+		struct DedicatedStaging {
+			VkBuffer buffer{VK_NULL_HANDLE};
+			VmaAllocation allocation{nullptr};
+			uint64_t value{0};
+		};
+
+		/// @return The command buffer of the current batch, begun if it wasn't.
+		VkCommandBuffer GetCommandBuffer();
+		/// Copy 'data' in the staging memory, waiting for the GPU if there is no room.
+		/// @return The buffer and the offset to copy from.
+		std::pair<VkBuffer, VkDeviceSize> Stage(const void *data, VkDeviceSize size);
+		/// Submit the current batch, if any.
+		void Submit();
+		void WaitValue(uint64_t value);
+		void Retire();
+
+	private:
+		VkDevice m_Device{VK_NULL_HANDLE};
+		VmaAllocator m_Allocator{nullptr};
+		VkQueue m_Queue{VK_NULL_HANDLE};
+		std::mutex *m_QueueMutex{nullptr};
+
+		VkBuffer m_Staging{VK_NULL_HANDLE};
+		VmaAllocation m_StagingAllocation{nullptr};
+		std::byte *m_StagingData{nullptr};
+		StagingRing m_Ring;
+		std::vector<DedicatedStaging> m_Dedicated;
+
+		VkCommandPool m_CommandPool{VK_NULL_HANDLE};
+		/// The batch being recorded, if any.
+		Batch m_Current{};
+		/// The batches submitted, from the oldest.
+		std::deque<Batch> m_InFlight;
+		std::vector<VkCommandBuffer> m_FreeCommandBuffers;
+
+		VkSemaphore m_Semaphore{VK_NULL_HANDLE};
+		uint64_t m_Submitted{0};
+		/// Cache of the semaphore value, to answer 'IsComplete' without asking the driver.
+		std::atomic<uint64_t> m_Completed{0};
+
+		UploadStats m_Stats{};
+		std::mutex m_Mutex;
+	};
+
+} // namespace Imagine::Vulkan
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "Imagine/Vulkan/Descriptors.hpp"
+#include "Imagine/Vulkan/FrameRingBuffer.hpp"
 #include "Imagine/Vulkan/Vulkan.hpp"
 #include "Imagine/Vulkan/VulkanDeleter.hpp"
 #include "Imagine/Vulkan/VulkanImage.hpp"
@@ -25,6 +26,9 @@ namespace Imagine::Vulkan {
 
 		Deleter m_DeletionQueue = {};
 		DescriptorAllocatorGrowable m_FrameDescriptors;
+		FrameRingBuffer m_Ring;
+		/// Scene data, lights, light clusters and light indices of the frame, written once in 'BeginDraw' and bound with 'm_GlobalOffsets'.
 		VkDescriptorSet m_GlobalDescriptor{nullptr};
+		std::array<uint32_t, 4> m_GlobalOffsets{};
 	};
 } // namespace Imagine::Vulkan
@@ -18,6 +18,8 @@ namespace Imagine::Vulkan {
 		VmaAllocation allocation{nullptr};
 		VkExtent3D imageExtent{0, 0, 0};
 		VkFormat imageFormat{VK_FORMAT_UNDEFINED};
+		/// Value of the upload queue once the image is filled, 0 if it isn't uploaded.
+		uint64_t uploadValue{0};
 	};
 
 	struct VulkanTexture2D final : public GPUTexture2D {
@@ -27,6 +29,7 @@ namespace Imagine::Vulkan {
 		VulkanTexture2D& operator=(const VulkanTexture2D&) = delete;
 
 		virtual uint64_t GetID() override;
+		virtual bool IsReady() const override;
 
 		AllocatedImage image;
 		VkSampler sampler{nullptr};
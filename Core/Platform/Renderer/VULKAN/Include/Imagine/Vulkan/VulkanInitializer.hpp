@@ -237,8 +237,9 @@ namespace Imagine::Vulkan {
 		std::optional<std::shared_ptr<AutoDeleteMeshAsset>> LoadCPUMesh(VulkanRenderer *engine, const CPUMesh& mesh);
 		std::optional<std::vector<std::shared_ptr<AutoDeleteMeshAsset>>> LoadMeshes(VulkanRenderer *engine, const std::filesystem::path &filePath);
 
-		std::shared_ptr<AutoDeleteMeshAsset> LoadLines(VulkanRenderer* renderer, std::span<LineObject> lines);
-		ManualDeleteMeshAsset LoadManualLines(VulkanRenderer *renderer, std::span<LineObject> lines);
+		/// Upload the lines of a DrawContext, drawn as a line list.
+		std::shared_ptr<AutoDeleteMeshAsset> LoadLines(VulkanRenderer* renderer, std::span<const Vertex> vertices, std::span<const uint32_t> indices);
+		ManualDeleteMeshAsset LoadManualLines(VulkanRenderer *renderer, std::span<const Vertex> vertices, std::span<const uint32_t> indices);
 		std::shared_ptr<AutoDeleteMeshAsset> LoadPoints(VulkanRenderer* renderer, std::span<Vertex> points);
 
 	} // namespace Initializer
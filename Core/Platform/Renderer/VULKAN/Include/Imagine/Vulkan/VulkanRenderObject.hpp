@@ -14,7 +14,7 @@ namespace Imagine::Vulkan {
 
 	struct VulkanRenderObject final : public RenderObject {
 		VulkanRenderObject() = default;
-		virtual ~VulkanRenderObject() = default;
+		~VulkanRenderObject() = default;
 
 		AutoDeleteMeshAsset* GetVulkanMesh();
 	};
@@ -5,6 +5,8 @@
 #pragma once
 
 #include "Imagine/Core/Size.hpp"
+#include "Imagine/Rendering/InstanceBatcher.hpp"
+#include "Imagine/Rendering/LightClusters.hpp"
 #include "Imagine/Rendering/Renderer.hpp"
 #include "Imagine/Scene/Scene.hpp"
 #include "Imagine/Vulkan/Vulkan.hpp"
@@ -15,6 +17,7 @@
 #include "Imagine/Vulkan/VulkanImage.hpp"
 #include "Imagine/Vulkan/VulkanMaterial.hpp"
 #include "Imagine/Vulkan/VulkanTypes.hpp"
+#include "Imagine/Vulkan/UploadQueue.hpp"
 
 namespace Imagine::Vulkan {
 	class VulkanRenderer final : public Renderer {
@@ -70,12 +73,16 @@ namespace Imagine::Vulkan {
 
 	public:
 		AllocatedImage CreateImage(VkExtent3D size, VkFormat format, VkImageUsageFlags usage, bool mipmapped = false);
+		/// Create the image and queue the upload of its data, the image is ready once 'uploadValue' is complete.
 		AllocatedImage CreateImage(const void *data, VkExtent3D size, VkFormat format, VkImageUsageFlags usage, bool mipmapped = false);
-		void GenerateMipmaps(VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels);
 		void DestroyImage(const AllocatedImage &img);
 
 	public:
+		/// Create the buffers of a mesh and queue the upload of its data, the buffers are ready once 'uploadValue' is complete.
 		GPUMeshBuffers UploadMesh(ConstBufferView indices, ConstBufferView vertices);
+		/// Same as above for vertices in any layout. The color buffer is only created when the mesh has colors.
+		GPUMeshBuffers UploadMesh(ConstBufferView indices, const PackedVertices &vertices);
+		[[nodiscard]] bool IsUploadComplete(uint64_t value) { return m_Uploads.IsComplete(value); }
 
 	public:
 		void PushDeletion(Deleter::VkType data) {
@@ -155,6 +162,10 @@ namespace Imagine::Vulkan {
 		virtual Ref<GPUTexture2D> LoadTexture2D(const CPUTexture2D &tex2d) override;
 		virtual Ref<GPUTexture3D> LoadTexture3D(const CPUTexture3D &tex3d) override;
 
+		virtual bool ReadColor(Image<uint8_t> &image) override;
+		virtual const DrawStats &GetDrawStats() const override { return m_DrawStats; }
+		virtual const UploadStats &GetUploadStats() const override { return m_Uploads.GetStats(); }
+
 		void DrawBackground(VkCommandBuffer cmd);
 
 		void ImmediateSubmit(std::function<void(VkCommandBuffer cmd)> &&function);
@@ -175,6 +186,8 @@ namespace Imagine::Vulkan {
 		std::vector<ComputeEffect> m_BackgroundEffects;
 		int m_CurrentBackgroundEffect{0};
 		bool m_IsDrawing{false};
+		/// A frame went through EndDraw, the draw image holds it.
+		bool m_HasDrawnFrame{false};
 	private:
 		VkInstance m_Instance{nullptr}; // Vulkan library handle
 		VkDebugUtilsMessengerEXT m_DebugMessenger{nullptr}; // Vulkan debug output handle
@@ -194,6 +207,8 @@ namespace Imagine::Vulkan {
 		uint32_t m_FrameIndex{0};
 		VkQueue m_GraphicsQueue{nullptr};
 		uint32_t m_GraphicsQueueFamily{0};
+		/// Vulkan requires the accesses to a queue to be synchronized, the uploads can submit from another thread.
+		std::mutex m_QueueMutex;
 
 		VmaAllocator m_Allocator{nullptr};
 
@@ -215,7 +230,7 @@ namespace Imagine::Vulkan {
 		bool m_ViewportFocused = false;
 
 		GPUSceneData m_SceneData;
-		GPULightData m_LightData;
+		LightClusters m_LightClusters;
 		VkDescriptorSetLayout m_GpuSceneDataDescriptorLayout{nullptr};
 
 		// immediate submit structures
@@ -257,6 +272,25 @@ namespace Imagine::Vulkan {
 		bool m_ResizeRequested{false};
 
 		DrawContext m_MainDrawContext;
+		InstanceBatcher m_InstanceBatcher;
+		DrawStats m_DrawStats{};
+
+		UploadQueue m_Uploads;
+		/// Upload totals at the last refresh of the rates shown in the ImGui panel.
+		struct UploadSample {
+			std::chrono::high_resolution_clock::time_point time{};
+			uint64_t bytes{0};
+			double stallMilliseconds{0};
+			double megabytesPerSecond{0};
+			double stallMillisecondsPerSecond{0};
+		} m_UploadSample;
+		/// Meshes uploaded with each vertex layout and the size of their vertices.
+		struct VertexLayoutStats {
+			uint64_t meshes{0};
+			uint64_t vertices{0};
+			uint64_t bytes{0};
+		};
+		std::array<VertexLayoutStats, c_VertexLayoutCount> m_VertexLayoutStats{};
 
 		Mat4 ViewMatrixCached;
 		Mat4 ProjectionMatrixCached;
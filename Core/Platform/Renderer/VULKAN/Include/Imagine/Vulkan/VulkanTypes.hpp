@@ -9,7 +9,9 @@
 #include "Imagine/Rendering/CPU/CPUMesh.hpp"
 #include "Imagine/Rendering/GPU/GPUMesh.hpp"
 #include "Imagine/Rendering/MeshParameters.hpp"
+#include "Imagine/Rendering/VertexPacker.hpp"
 #include "Imagine/Rendering/Light.hpp"
+#include "Imagine/Rendering/GPU/GPUInstanceData.hpp"
 #include "Imagine/Rendering/GPU/GPULightData.hpp"
 #include "Imagine/Rendering/GPU/GPUSceneData.hpp"
 #include "Imagine/Vulkan/Vulkan.hpp"
@@ -40,13 +42,27 @@ namespace Imagine::Vulkan {
 		AllocatedBuffer indexBuffer;
 		AllocatedBuffer vertexBuffer;
 		VkDeviceAddress vertexBufferAddress;
+		/// Optional unorm8x4 color per vertex of the compact layouts.
+		AllocatedBuffer colorBuffer;
+		VkDeviceAddress colorBufferAddress{0};
+		VertexLayout layout{VertexLayout::Full};
+		glm::vec3 positionOffset{0, 0, 0};
+		glm::vec3 positionScale{1, 1, 1};
+		/// Value of the upload queue once the buffers are filled.
+		uint64_t uploadValue{0};
 	};
 
 	// push constants for our mesh object draws
+	// The transforms are read from the instance buffer (an array of GPUInstanceData) at 'gl_InstanceIndex'.
+	// The vertices are decoded according to 'vertexLayout', see 'EngineAssets/vertex_layouts.glsl'.
 	struct GPUDrawPushConstants {
-		glm::mat4 worldMatrix;
-		glm::mat4 normalMatrix;
 		VkDeviceAddress vertexBuffer;
+		VkDeviceAddress instanceBuffer;
+		VkDeviceAddress colorBuffer{0};
+		uint32_t vertexLayout{static_cast<uint32_t>(VertexLayout::Full)};
+		uint32_t hasColors{0};
+		glm::vec4 positionOffset{0, 0, 0, 0};
+		glm::vec4 positionScale{1, 1, 1, 0};
 	};
 
 	struct GeoSurface {
@@ -61,6 +77,7 @@ namespace Imagine::Vulkan {
 		AutoDeleteMeshAsset &operator=(const AutoDeleteMeshAsset &) = delete;
 
 		virtual uint64_t GetID() override {return this->meshBuffers.vertexBufferAddress;}
+		virtual bool IsReady() const override;
 
 		std::string name;
 		std::vector<LOD> lods{};
@@ -77,6 +94,7 @@ namespace Imagine::Vulkan {
 		void swap(ManualDeleteMeshAsset& other) noexcept;
 
 		virtual uint64_t GetID() override {return this->meshBuffers.vertexBufferAddress;}
+		virtual bool IsReady() const override;
 
 		std::string name;
 		std::vector<LOD> lods{};
@@ -0,0 +1,114 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Vulkan/FrameRingBuffer.hpp"
+#include "Imagine/Vulkan/VulkanMacros.hpp"
+
+#include <bit>
+
+namespace Imagine::Vulkan {
+
+	FrameRingBuffer::FrameRingBuffer(FrameRingBuffer &&other) noexcept :
+		m_Device(other.m_Device), m_Allocator(other.m_Allocator), m_Alignment(other.m_Alignment), m_Main(std::exchange(other.m_Main, {})), m_Offset(std::exchange(other.m_Offset, 0)),
+		m_Overflow(std::move(other.m_Overflow)), m_OverflowOffset(std::exchange(other.m_OverflowOffset, 0)), m_OverflowSize(std::exchange(other.m_OverflowSize, 0)), m_BlockAllocations(other.m_BlockAllocations) {}
+
+	FrameRingBuffer &FrameRingBuffer::operator=(FrameRingBuffer &&other) noexcept {
+		std::swap(m_Device, other.m_Device);
+		std::swap(m_Allocator, other.m_Allocator);
+		std::swap(m_Alignment, other.m_Alignment);
+		std::swap(m_Main, other.m_Main);
+		std::swap(m_Offset, other.m_Offset);
+		std::swap(m_Overflow, other.m_Overflow);
+		std::swap(m_OverflowOffset, other.m_OverflowOffset);
+		std::swap(m_OverflowSize, other.m_OverflowSize);
+		std::swap(m_BlockAllocations, other.m_BlockAllocations);
+		return *this;
+	}
+
+	void FrameRingBuffer::Init(const VkDevice device, const VmaAllocator allocator, const VkDeviceSize size, const VkDeviceSize alignment) {
+		MGN_CORE_CASSERT(std::has_single_bit(alignment), "The alignment {} is not a power of two.", alignment);
+		m_Device = device;
+		m_Allocator = allocator;
+		m_Alignment = alignment;
+		m_Main = CreateBlock(Align(size));
+		m_Offset = 0;
+	}
+
+	void FrameRingBuffer::Destroy() {
+		for (Block &block: m_Overflow) {
+			DestroyBlock(block);
+		}
+		m_Overflow.clear();
+		DestroyBlock(m_Main);
+		m_Offset = 0;
+		m_OverflowOffset = 0;
+		m_OverflowSize = 0;
+	}
+
+	void FrameRingBuffer::Reset() {
+		if (!m_Overflow.empty()) {
+			const VkDeviceSize size = std::bit_ceil(m_Offset + m_OverflowSize);
+			MGN_CORE_WARNING("[Vulkan] The frame ring buffer overflowed by {} bytes, it grows from {} to {} bytes.", m_OverflowSize, m_Main.size, size);
+			for (Block &block: m_Overflow) {
+				DestroyBlock(block);
+			}
+			m_Overflow.clear();
+			DestroyBlock(m_Main);
+			m_Main = CreateBlock(size);
+		}
+		m_Offset = 0;
+		m_OverflowOffset = 0;
+		m_OverflowSize = 0;
+	}
+
+	FrameRingBuffer::Allocation FrameRingBuffer::Allocate(const VkDeviceSize size) {
+		const VkDeviceSize aligned = Align(std::max<VkDeviceSize>(size, 1));
+
+		if (m_Offset + aligned <= m_Main.size) {
+			const Allocation allocation{m_Main.data + m_Offset, m_Main.buffer, m_Offset, m_Main.address + m_Offset};
+			m_Offset += aligned;
+			return allocation;
+		}
+
+		if (m_Overflow.empty() || m_OverflowOffset + aligned > m_Overflow.back().size) {
+			m_Overflow.push_back(CreateBlock(std::max(aligned, m_Main.size)));
+			m_OverflowOffset = 0;
+		}
+		const Block &block = m_Overflow.back();
+		const Allocation allocation{block.data + m_OverflowOffset, block.buffer, m_OverflowOffset, block.address + m_OverflowOffset};
+		m_OverflowOffset += aligned;
+		m_OverflowSize += aligned;
+		return allocation;
+	}
+
+	FrameRingBuffer::Block FrameRingBuffer::CreateBlock(const VkDeviceSize size) {
+		VkBufferCreateInfo bufferInfo = {.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+		bufferInfo.size = size;
+		bufferInfo.usage = c_Usage;
+
+		VmaAllocationCreateInfo vmaallocInfo = {};
+		vmaallocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+		vmaallocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+		Block block;
+		VmaAllocationInfo info{};
+		VK_CHECK(vmaCreateBuffer(m_Allocator, &bufferInfo, &vmaallocInfo, &block.buffer, &block.allocation, &info));
+		block.data = static_cast<std::byte *>(info.pMappedData);
+		block.size = size;
+
+		VkBufferDeviceAddressInfo addressInfo{.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO, .buffer = block.buffer};
+		block.address = vkGetBufferDeviceAddress(m_Device, &addressInfo);
+
+		++m_BlockAllocations;
+		return block;
+	}
+
+	void FrameRingBuffer::DestroyBlock(Block &block) {
+		if (block.buffer) {
+			vmaDestroyBuffer(m_Allocator, block.buffer, block.allocation);
+		}
+		block = Block{};
+	}
+
+} // namespace Imagine::Vulkan
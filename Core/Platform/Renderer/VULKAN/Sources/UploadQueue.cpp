@@ -0,0 +1,262 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Vulkan/UploadQueue.hpp"
+#include "Imagine/Vulkan/VulkanInitializer.hpp"
+#include "Imagine/Vulkan/VulkanMacros.hpp"
+#include "Imagine/Vulkan/VulkanUtils.hpp"
+
+namespace Imagine::Vulkan {
+
+	void UploadQueue::Init(const VkDevice device, const VmaAllocator allocator, const VkQueue queue, std::mutex &queueMutex, const uint32_t queueFamily, const VkDeviceSize size) {
+		m_Device = device;
+		m_Allocator = allocator;
+		m_Queue = queue;
+		m_QueueMutex = &queueMutex;
+
+		VkBufferCreateInfo bufferInfo = {.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+		bufferInfo.size = size;
+		bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+		VmaAllocationCreateInfo vmaallocInfo = {};
+		vmaallocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+		vmaallocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+		VmaAllocationInfo info{};
+		VK_CHECK(vmaCreateBuffer(m_Allocator, &bufferInfo, &vmaallocInfo, &m_Staging, &m_StagingAllocation, &info));
+		m_StagingData = static_cast<std::byte *>(info.pMappedData);
+		m_Ring.Reset(size);
+
+		const VkCommandPoolCreateInfo commandPoolInfo = Initializer::CommandPoolCreateInfo(queueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+		VK_CHECK(vkCreateCommandPool(m_Device, &commandPoolInfo, nullptr, &m_CommandPool));
+
+		VkSemaphoreTypeCreateInfo typeInfo{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO};
+		typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+		typeInfo.initialValue = 0;
+		VkSemaphoreCreateInfo semaphoreInfo = Initializer::SemaphoreCreateInfo();
+		semaphoreInfo.pNext = &typeInfo;
+		VK_CHECK(vkCreateSemaphore(m_Device, &semaphoreInfo, nullptr, &m_Semaphore));
+
+		m_Submitted = 0;
+		m_Completed = 0;
+	}
+
+	void UploadQueue::Destroy() {
+		std::lock_guard lock(m_Mutex);
+		if (m_Current.cmd) {
+			// Nothing refers to the uploads that were never submitted anymore.
+			VK_CHECK(vkEndCommandBuffer(m_Current.cmd));
+			m_FreeCommandBuffers.push_back(m_Current.cmd);
+			m_Current = {};
+		}
+		WaitValue(m_Submitted);
+		Retire();
+
+		vkDestroyCommandPool(m_Device, m_CommandPool, nullptr);
+		vkDestroySemaphore(m_Device, m_Semaphore, nullptr);
+		vmaDestroyBuffer(m_Allocator, m_Staging, m_StagingAllocation);
+		m_FreeCommandBuffers.clear();
+		m_CommandPool = VK_NULL_HANDLE;
+		m_Semaphore = VK_NULL_HANDLE;
+		m_Staging = VK_NULL_HANDLE;
+		m_StagingAllocation = nullptr;
+		m_StagingData = nullptr;
+		m_Ring.Reset(0);
+	}
+
+	uint64_t UploadQueue::UploadBuffer(const VkBuffer dst, const VkDeviceSize dstOffset, const void *data, const VkDeviceSize size) {
+		MGN_PROFILE_FUNCTION();
+		std::lock_guard lock(m_Mutex);
+		const auto [src, srcOffset] = Stage(data, size);
+
+		VkBufferCopy copy{};
+		copy.srcOffset = srcOffset;
+		copy.dstOffset = dstOffset;
+		copy.size = size;
+		vkCmdCopyBuffer(GetCommandBuffer(), src, dst, 1, &copy);
+
+		return m_Current.value;
+	}
+
+	uint64_t UploadQueue::UploadImage(const VkImage image, const VkExtent3D extent, const uint32_t mipLevels, const void *data, const VkDeviceSize size) {
+		MGN_PROFILE_FUNCTION();
+		std::lock_guard lock(m_Mutex);
+		const auto [src, srcOffset] = Stage(data, size);
+		const VkCommandBuffer cmd = GetCommandBuffer();
+
+		Utils::TransitionImage(cmd, image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+		VkBufferImageCopy copyRegion = {};
+		copyRegion.bufferOffset = srcOffset;
+		copyRegion.bufferRowLength = 0;
+		copyRegion.bufferImageHeight = 0;
+
+		copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		copyRegion.imageSubresource.mipLevel = 0;
+		copyRegion.imageSubresource.baseArrayLayer = 0;
+		copyRegion.imageSubresource.layerCount = 1;
+		copyRegion.imageExtent = extent;
+
+		vkCmdCopyBufferToImage(cmd, src, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+
+		if (mipLevels > 1) {
+			Utils::GenerateMipmaps(cmd, image, static_cast<int32_t>(extent.width), static_cast<int32_t>(extent.height), mipLevels);
+		}
+		else {
+			Utils::TransitionImage(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		}
+
+		return m_Current.value;
+	}
+
+	uint64_t UploadQueue::Flush() {
+		MGN_PROFILE_FUNCTION();
+		std::lock_guard lock(m_Mutex);
+		Submit();
+		return m_Submitted;
+	}
+
+	bool UploadQueue::IsComplete(const uint64_t value) {
+		if (value <= m_Completed.load(std::memory_order_acquire)) return true;
+
+		uint64_t completed = 0;
+		VK_CHECK(vkGetSemaphoreCounterValue(m_Device, m_Semaphore, &completed));
+		uint64_t cached = m_Completed.load(std::memory_order_relaxed);
+		while (cached < completed && !m_Completed.compare_exchange_weak(cached, completed, std::memory_order_release, std::memory_order_relaxed)) {}
+		return value <= completed;
+	}
+
+	void UploadQueue::Wait(const uint64_t value) {
+		MGN_PROFILE_FUNCTION();
+		if (IsComplete(value)) return;
+		std::lock_guard lock(m_Mutex);
+		if (m_Current.cmd && value >= m_Current.value) {
+			Submit();
+		}
+		WaitValue(std::min(value, m_Submitted));
+		Retire();
+	}
+
+	VkCommandBuffer UploadQueue::GetCommandBuffer() {
+		if (m_Current.cmd) return m_Current.cmd;
+
+		Retire();
+		if (m_FreeCommandBuffers.empty()) {
+			VkCommandBuffer cmd;
+			const VkCommandBufferAllocateInfo cmdAllocInfo = Initializer::CommandBufferAllocateInfo(m_CommandPool, 1);
+			VK_CHECK(vkAllocateCommandBuffers(m_Device, &cmdAllocInfo, &cmd));
+			m_FreeCommandBuffers.push_back(cmd);
+		}
+
+		m_Current.cmd = m_FreeCommandBuffers.back();
+		m_Current.value = m_Submitted + 1;
+		m_FreeCommandBuffers.pop_back();
+
+		VK_CHECK(vkResetCommandBuffer(m_Current.cmd, 0));
+		const VkCommandBufferBeginInfo cmdBeginInfo = Initializer::CommandBufferBeginInfo(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+		VK_CHECK(vkBeginCommandBuffer(m_Current.cmd, &cmdBeginInfo));
+		return m_Current.cmd;
+	}
+
+	std::pair<VkBuffer, VkDeviceSize> UploadQueue::Stage(const void *data, const VkDeviceSize size) {
+		++m_Stats.uploads;
+		m_Stats.bytes += size;
+
+		if (size > m_Ring.GetCapacity()) {
+			MGN_CORE_WARNING("[Vulkan] The upload of {} bytes doesn't fit in the staging buffer of {} bytes, it gets its own.", size, m_Ring.GetCapacity());
+			VkBufferCreateInfo bufferInfo = {.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+			bufferInfo.size = size;
+			bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+			VmaAllocationCreateInfo vmaallocInfo = {};
+			vmaallocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+			vmaallocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+			DedicatedStaging staging{};
+			VmaAllocationInfo info{};
+			VK_CHECK(vmaCreateBuffer(m_Allocator, &bufferInfo, &vmaallocInfo, &staging.buffer, &staging.allocation, &info));
+			std::memcpy(info.pMappedData, data, size);
+
+			GetCommandBuffer();
+			staging.value = m_Current.value;
+			m_Dedicated.push_back(staging);
+			return {staging.buffer, 0};
+		}
+
+		std::optional<uint64_t> offset = m_Ring.Allocate(size, c_Alignment);
+		if (!offset) {
+			MGN_PROFILE_SCOPE("Upload Stall");
+			const auto start = std::chrono::high_resolution_clock::now();
+			++m_Stats.stalls;
+
+			// The uploads recorded so far hold the memory the next ones are waiting for.
+			Submit();
+
+			while (!offset) {
+				Retire();
+				offset = m_Ring.Allocate(size, c_Alignment);
+				if (offset) break;
+				const std::optional<uint64_t> oldest = m_Ring.GetOldestValue();
+				MGN_CORE_CASSERT(oldest.has_value(), "The staging ring is full without any batch in flight.");
+				WaitValue(oldest.value());
+			}
+
+			m_Stats.stallMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		}
+
+		std::memcpy(m_StagingData + offset.value(), data, size);
+		return {m_Staging, offset.value()};
+	}
+
+	void UploadQueue::Submit() {
+		if (!m_Current.cmd) return;
+
+		VK_CHECK(vkEndCommandBuffer(m_Current.cmd));
+
+		VkCommandBufferSubmitInfo cmdinfo = Initializer::CommandBufferSubmitInfo(m_Current.cmd);
+		VkSemaphoreSubmitInfo signalInfo = Initializer::SemaphoreSubmitInfo(VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_Semaphore);
+		signalInfo.value = m_Current.value;
+		const VkSubmitInfo2 submit = Initializer::SubmitInfo(&cmdinfo, &signalInfo, nullptr);
+		{
+			std::lock_guard queueLock(*m_QueueMutex);
+			VK_CHECK(vkQueueSubmit2(m_Queue, 1, &submit, VK_NULL_HANDLE));
+		}
+
+		m_Ring.Close(m_Current.value);
+		m_Submitted = m_Current.value;
+		m_InFlight.push_back(m_Current);
+		m_Current = {};
+		++m_Stats.batches;
+	}
+
+	void UploadQueue::WaitValue(const uint64_t value) {
+		if (value <= m_Completed.load(std::memory_order_acquire)) return;
+
+		VkSemaphoreWaitInfo waitInfo{.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO};
+		waitInfo.semaphoreCount = 1;
+		waitInfo.pSemaphores = &m_Semaphore;
+		waitInfo.pValues = &value;
+		VK_CHECK(vkWaitSemaphores(m_Device, &waitInfo, UINT64_MAX));
+		IsComplete(value);
+	}
+
+	void UploadQueue::Retire() {
+		IsComplete(m_Submitted);
+		const uint64_t completed = m_Completed.load(std::memory_order_acquire);
+
+		while (!m_InFlight.empty() && m_InFlight.front().value <= completed) {
+			m_FreeCommandBuffers.push_back(m_InFlight.front().cmd);
+			m_InFlight.pop_front();
+		}
+
+		m_Ring.Retire(completed);
+
+		std::erase_if(m_Dedicated, [this, completed](const DedicatedStaging &staging) {
+			if (staging.value > completed) return false;
+			vmaDestroyBuffer(m_Allocator, staging.buffer, staging.allocation);
+			return true;
+		});
+	}
+
+} // namespace Imagine::Vulkan
@@ -27,6 +27,10 @@ namespace Imagine::Vulkan {
 		return reinterpret_cast<uint64_t>(image.imageView);
 	}
 
+	bool VulkanTexture2D::IsReady() const {
+		return VulkanRenderer::Get()->IsUploadComplete(image.uploadValue);
+	}
+
 	VulkanTexture3D::VulkanTexture3D() = default;
 	VulkanTexture3D::~VulkanTexture3D() {
 		dynamic_cast<VulkanRenderer*>(Renderer::Get())->PushFrameDeletion(image.allocation, image.image);
@@ -21,23 +21,9 @@ namespace Imagine::Vulkan {
 	namespace Initializer {
 		constexpr bool c_OverrideColorVertex = true;
 
-		std::shared_ptr<AutoDeleteMeshAsset> LoadLines(VulkanRenderer *renderer, std::span<LineObject> lines) {
-			std::vector<uint32_t> indices;
-			std::vector<Vertex> vertices;
-
+		std::shared_ptr<AutoDeleteMeshAsset> LoadLines(VulkanRenderer *renderer, std::span<const Vertex> vertices, std::span<const uint32_t> indices) {
 			std::shared_ptr<AutoDeleteMeshAsset> mesh = std::make_shared<AutoDeleteMeshAsset>();
 
-			for (const LineObject &line: lines) {
-				if (line.points.size() < 2) continue;
-				const uint32_t offset = vertices.size();
-				vertices.push_back(line.points.at(0));
-				for (uint32_t i = 1; i < line.points.size(); ++i) {
-					vertices.push_back(line.points.at(i));
-					indices.push_back(offset + (i - 1));
-					indices.push_back(offset + i);
-				}
-			}
-
 			LOD surface;
 			surface.index = 0;
 			surface.count = indices.size();
@@ -50,24 +36,9 @@ namespace Imagine::Vulkan {
 			return mesh;
 		}
 
-		ManualDeleteMeshAsset LoadManualLines(VulkanRenderer *renderer, std::span<LineObject> lines) {
+		ManualDeleteMeshAsset LoadManualLines(VulkanRenderer *renderer, std::span<const Vertex> vertices, std::span<const uint32_t> indices) {
 			ManualDeleteMeshAsset mesh;
 
-			std::vector<uint32_t> indices;
-			std::vector<Vertex> vertices;
-
-
-			for (const LineObject &line: lines) {
-				if (line.points.size() < 2) continue;
-				const uint32_t offset = vertices.size();
-				vertices.push_back(line.points.at(0));
-				for (uint32_t i = 1; i < line.points.size(); ++i) {
-					vertices.push_back(line.points.at(i));
-					indices.push_back(offset + (i - 1));
-					indices.push_back(offset + i);
-				}
-			}
-
 			LOD surface;
 			surface.index = 0;
 			surface.count = indices.size();
@@ -113,11 +84,9 @@ namespace Imagine::Vulkan {
 
 			std::shared_ptr<AutoDeleteMeshAsset> mesh = std::make_shared<AutoDeleteMeshAsset>();
 
-			LOD surface = cpuMesh.Lods.front();
-
-			mesh->lods.push_back(surface);
+			mesh->lods = cpuMesh.Lods;
 
-			mesh->meshBuffers = engine->UploadMesh(ConstBufferView::Make(cpuMesh.Indices), ConstBufferView::Make(cpuMesh.Vertices));
+			mesh->meshBuffers = engine->UploadMesh(ConstBufferView::Make(cpuMesh.Indices), VertexPacker::Pack(cpuMesh.Vertices, cpuMesh.Layout));
 
 			return mesh;
 		}
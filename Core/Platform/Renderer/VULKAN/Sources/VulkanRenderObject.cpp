@@ -8,6 +8,6 @@ using namespace Imagine;
 
 namespace Imagine::Vulkan {
 	AutoDeleteMeshAsset *VulkanRenderObject::GetVulkanMesh() {
-		return dynamic_cast<AutoDeleteMeshAsset *>(RenderObject::mesh.get());
+		return dynamic_cast<AutoDeleteMeshAsset *>(RenderObject::mesh);
 	}
 } // namespace Imagine::Vulkan
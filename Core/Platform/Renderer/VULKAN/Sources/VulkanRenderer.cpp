@@ -15,6 +15,7 @@
 #include "Imagine/Vulkan/VulkanMacros.hpp"
 #include "Imagine/Vulkan/VulkanRenderer.hpp"
 
+#include <glm/gtc/packing.hpp>
 #include <vk_mem_alloc.h>
 
 #include "Imagine/Vulkan/VulkanUtils.hpp"
@@ -145,7 +146,7 @@ namespace Imagine::Vulkan {
 	}
 
 	Mat4 VulkanRenderer::GetProjectionMatrix() const {
-		Mat4 proj = glm::perspective(glm::radians(Real(70)), (Real) m_DrawExtent.width / (Real) m_DrawExtent.height, Real(0.1), Real(10000.));
+		Mat4 proj = glm::perspective(glm::radians(Real(Camera::c_FieldOfView)), (Real) m_DrawExtent.width / (Real) m_DrawExtent.height, Real(Camera::c_NearPlane), Real(Camera::c_FarPlane));
 		// Inverse Y to have up toward up
 		proj[1][1] *= -1;
 		return proj;
@@ -227,6 +228,7 @@ namespace Imagine::Vulkan {
 		VkPhysicalDeviceVulkan12Features features12{.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES};
 		features12.bufferDeviceAddress = true;
 		features12.descriptorIndexing = true;
+		features12.timelineSemaphore = true;
 
 		// VkPhysicalDeviceVulkan11Features features11{.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES};
 
@@ -380,6 +382,13 @@ namespace Imagine::Vulkan {
 
 		VK_CHECK(vkCreateFence(m_Device, &fenceCreateInfo, nullptr, &m_ImmFence));
 		m_MainDeletionQueue.push(m_ImmFence);
+
+		// The uploads go through the graphics queue, the mipmaps are generated with blits.
+		m_Uploads.Init(m_Device, m_Allocator, m_GraphicsQueue, m_QueueMutex, m_GraphicsQueueFamily);
+		m_UploadSample.time = std::chrono::high_resolution_clock::now();
+		m_MainDeletionQueue.push([this]() {
+			m_Uploads.Destroy();
+		});
 	}
 
 	void VulkanRenderer::InitializeDescriptors() {
@@ -390,6 +399,8 @@ namespace Imagine::Vulkan {
 					{VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 3},
 					{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3},
 					{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 3},
+					{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 3},
+					{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1},
 					{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4},
 			};
 
@@ -398,10 +409,28 @@ namespace Imagine::Vulkan {
 			m_MainDeletionQueue.push(m_Frames[i].m_FrameDescriptors);
 		}
 
+		{
+			// Every allocation of the frame rings can be bound as a uniform or a storage buffer.
+			VkPhysicalDeviceProperties properties;
+			vkGetPhysicalDeviceProperties(m_PhysicalDevice, &properties);
+			const VkDeviceSize alignment = std::max<VkDeviceSize>({properties.limits.minUniformBufferOffsetAlignment, properties.limits.minStorageBufferOffsetAlignment, 16});
+
+			for (VulkanFrameData &frame: m_Frames) {
+				frame.m_Ring.Init(m_Device, m_Allocator, FrameRingBuffer::c_DefaultSize, alignment);
+			}
+			m_MainDeletionQueue.push([this]() {
+				for (VulkanFrameData &frame: m_Frames) {
+					frame.m_Ring.Destroy();
+				}
+			});
+		}
+
 		// create a descriptor pool that will hold 10 sets with 1 image each
 		std::vector<DescriptorAllocatorGrowable::PoolSizeRatio> sizes = {
 				{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1},
 				{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1},
+				{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1},
+				{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1},
 				{VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1},
 				{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1},
 		};
@@ -440,8 +469,12 @@ namespace Imagine::Vulkan {
 
 		{
 			DescriptorLayoutBuilder builder;
-			builder.AddBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
-			builder.AddBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+			// The data lives in the frame ring, the set is written once per frame and bound with the offsets of the data.
+			builder.AddBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+			// The lights, the range of lights of each cluster and the light indices the ranges refer to.
+			builder.AddBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
+			builder.AddBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
+			builder.AddBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
 			m_GpuSceneDataDescriptorLayout = builder.Build(m_Device, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT);
 			m_MainDeletionQueue.push(m_GpuSceneDataDescriptorLayout);
 		}
@@ -504,8 +537,8 @@ namespace Imagine::Vulkan {
 		// layout code
 		VkShaderModule gradientShader;
 		// TODO: Replace by a real shader loading pipeline with glslc and spirv cache loading.
-		if (!Utils::LoadShaderModule("EngineAssets/gradient.comp.spv", m_Device, &gradientShader)) {
-			MGN_CORE_ERROR("[Vulkan] Error when building the compute shader '{}'", "EngineAssets/gradient.comp.spv");
+		if (!Utils::LoadShaderModule("EngineShaders/gradient.comp.spv", m_Device, &gradientShader)) {
+			MGN_CORE_ERROR("[Vulkan] Error when building the compute shader '{}'", "EngineShaders/gradient.comp.spv");
 		}
 
 		VkPipelineShaderStageCreateInfo stageinfo{};
@@ -560,8 +593,8 @@ namespace Imagine::Vulkan {
 		// layout code
 		VkShaderModule skyShader;
 		// TODO: Replace by a real shader loading pipeline with glslc and spirv cache loading.
-		if (!Utils::LoadShaderModule("EngineAssets/sky.comp.spv", m_Device, &skyShader)) {
-			MGN_CORE_ERROR("[Vulkan] Error when building the compute shader '{}'", "EngineAssets/sky.comp.spv");
+		if (!Utils::LoadShaderModule("EngineShaders/sky.comp.spv", m_Device, &skyShader)) {
+			MGN_CORE_ERROR("[Vulkan] Error when building the compute shader '{}'", "EngineShaders/sky.comp.spv");
 		}
 
 		VkPipelineShaderStageCreateInfo stageinfo{};
@@ -591,7 +624,7 @@ namespace Imagine::Vulkan {
 
 	void VulkanRenderer::InitTrianglePipeline() {
 		VkShaderModule triangleVertexShader{nullptr};
-		if (!Utils::LoadShaderModule("EngineAssets/colored_triangle.vert.spv", m_Device, &triangleVertexShader)) {
+		if (!Utils::LoadShaderModule("EngineShaders/colored_triangle.vert.spv", m_Device, &triangleVertexShader)) {
 			MGN_CORE_ERROR("Error when building the triangle vertex shader module");
 		}
 		else {
@@ -599,7 +632,7 @@ namespace Imagine::Vulkan {
 		}
 
 		VkShaderModule triangleFragmentShader{nullptr};
-		if (!Utils::LoadShaderModule("EngineAssets/colored_triangle.frag.spv", m_Device, &triangleFragmentShader)) {
+		if (!Utils::LoadShaderModule("EngineShaders/colored_triangle.frag.spv", m_Device, &triangleFragmentShader)) {
 			MGN_CORE_ERROR("Error when building the triangle fragment shader module");
 		}
 		else {
@@ -635,7 +668,7 @@ namespace Imagine::Vulkan {
 
 	void VulkanRenderer::InitMeshPipeline() {
 		VkShaderModule triangleVertexShader{nullptr};
-		if (!Utils::LoadShaderModule("EngineAssets/colored_triangle_mesh.vert.spv", m_Device, &triangleVertexShader)) {
+		if (!Utils::LoadShaderModule("EngineShaders/colored_triangle_mesh.vert.spv", m_Device, &triangleVertexShader)) {
 			MGN_CORE_ERROR("Error when building the mesh vertex shader module");
 		}
 		else {
@@ -643,7 +676,7 @@ namespace Imagine::Vulkan {
 		}
 
 		VkShaderModule triangleFragmentShader{nullptr};
-		if (!Utils::LoadShaderModule("EngineAssets/tex_image.frag.spv", m_Device, &triangleFragmentShader)) {
+		if (!Utils::LoadShaderModule("EngineShaders/tex_image.frag.spv", m_Device, &triangleFragmentShader)) {
 			MGN_CORE_ERROR("Error when building the mesh fragment shader module");
 		}
 		else {
@@ -729,7 +762,10 @@ namespace Imagine::Vulkan {
 	}
 
 	void VulkanRenderer::ResizeSwapChain() {
-		vkDeviceWaitIdle(m_Device);
+		{
+			std::lock_guard queueLock(m_QueueMutex);
+			vkDeviceWaitIdle(m_Device);
+		}
 
 		DestroySwapChain();
 
@@ -769,12 +805,16 @@ namespace Imagine::Vulkan {
 		submitInfo.commandBufferCount = 1;
 		submitInfo.pCommandBuffers = &commandBuffer;
 
-		vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-		vkQueueWaitIdle(m_GraphicsQueue);
+		{
+			std::lock_guard queueLock(m_QueueMutex);
+			vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+			vkQueueWaitIdle(m_GraphicsQueue);
+		}
 
 		vkFreeCommandBuffers(m_Device, m_ImmCommandPool, 1, &commandBuffer);
 	}
 	AllocatedBuffer VulkanRenderer::CreateBuffer(const uint64_t allocSize, const VkBufferUsageFlags usage, const VmaMemoryUsage memoryUsage) {
+		++m_DrawStats.bufferAllocations;
 		// allocate buffer
 		VkBufferCreateInfo bufferInfo = {.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
 		bufferInfo.pNext = nullptr;
@@ -812,32 +852,30 @@ namespace Imagine::Vulkan {
 		// create index buffer
 		GPUMesh.indexBuffer = CreateBuffer(indexBufferSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
 
-		AllocatedBuffer staging = CreateBuffer(vertexBufferSize + indexBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
-
-		void *data = staging.allocation->GetMappedData();
+		m_Uploads.UploadBuffer(GPUMesh.vertexBuffer.buffer, 0, vertices.Get(), vertexBufferSize);
+		GPUMesh.uploadValue = m_Uploads.UploadBuffer(GPUMesh.indexBuffer.buffer, 0, indices.Get(), indexBufferSize);
 
-		// copy vertex buffer
-		memcpy(data, vertices.Get(), vertexBufferSize);
-		// copy index buffer
-		memcpy((uint8_t *) data + vertexBufferSize, indices.Get(), indexBufferSize);
-
-		ImmediateSubmit([&](VkCommandBuffer cmd) {
-			VkBufferCopy vertexCopy{0};
-			vertexCopy.dstOffset = 0;
-			vertexCopy.srcOffset = 0;
-			vertexCopy.size = vertexBufferSize;
-
-			vkCmdCopyBuffer(cmd, staging.buffer, GPUMesh.vertexBuffer.buffer, 1, &vertexCopy);
+		return GPUMesh;
+	}
 
-			VkBufferCopy indexCopy{0};
-			indexCopy.dstOffset = 0;
-			indexCopy.srcOffset = vertexBufferSize;
-			indexCopy.size = indexBufferSize;
+	GPUMeshBuffers VulkanRenderer::UploadMesh(ConstBufferView indices, const PackedVertices &vertices) {
+		GPUMeshBuffers GPUMesh = UploadMesh(indices, ConstBufferView::Make(vertices.vertices));
+		GPUMesh.layout = vertices.layout;
+		GPUMesh.positionOffset = vertices.positionOffset;
+		GPUMesh.positionScale = vertices.positionScale;
 
-			vkCmdCopyBuffer(cmd, staging.buffer, GPUMesh.indexBuffer.buffer, 1, &indexCopy);
-		});
+		if (!vertices.colors.empty()) {
+			const uint64_t colorBufferSize = vertices.colors.size() * sizeof(uint32_t);
+			GPUMesh.colorBuffer = CreateBuffer(colorBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+			VkBufferDeviceAddressInfo deviceAdressInfo{.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO, .buffer = GPUMesh.colorBuffer.buffer};
+			GPUMesh.colorBufferAddress = vkGetBufferDeviceAddress(m_Device, &deviceAdressInfo);
+			GPUMesh.uploadValue = m_Uploads.UploadBuffer(GPUMesh.colorBuffer.buffer, 0, vertices.colors.data(), colorBufferSize);
+		}
 
-		DestroyBuffer(staging);
+		VertexLayoutStats &stats = m_VertexLayoutStats[static_cast<uint32_t>(vertices.layout)];
+		++stats.meshes;
+		stats.vertices += vertices.count;
+		stats.bytes += vertices.GetSize();
 		return GPUMesh;
 	}
 	VkDescriptorSetLayout VulkanRenderer::GetGPUSceneDescriptorLayout() {
@@ -997,131 +1035,26 @@ namespace Imagine::Vulkan {
 	}
 
 	AllocatedImage VulkanRenderer::CreateImage(const void *data, VkExtent3D size, VkFormat format, VkImageUsageFlags usage, bool mipmapped) {
-		size_t dataSize = size.depth * size.width * size.height * 4;
-		AllocatedBuffer uploadbuffer = CreateBuffer(dataSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-
-		memcpy(uploadbuffer.info.pMappedData, data, dataSize);
-
-		AllocatedImage new_image = CreateImage(size, format, usage | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, mipmapped);
-
-		ImmediateSubmit([&](VkCommandBuffer cmd) {
-			Utils::TransitionImage(cmd, new_image.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-			VkBufferImageCopy copyRegion = {};
-			copyRegion.bufferOffset = 0;
-			copyRegion.bufferRowLength = 0;
-			copyRegion.bufferImageHeight = 0;
+		const size_t dataSize = size.depth * size.width * size.height * 4;
+		const uint32_t mipLevels = mipmapped ? static_cast<uint32_t>(std::floor(std::log2(std::max(size.width, size.height)))) + 1 : 1;
 
-			copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			copyRegion.imageSubresource.mipLevel = 0;
-			copyRegion.imageSubresource.baseArrayLayer = 0;
-			copyRegion.imageSubresource.layerCount = 1;
-			copyRegion.imageExtent = size;
+		if (mipLevels > 1) {
+			// Check if image format supports linear blitting
+			VkFormatProperties formatProperties;
+			vkGetPhysicalDeviceFormatProperties(m_PhysicalDevice, format, &formatProperties);
 
-			// copy the buffer into the image
-			vkCmdCopyBufferToImage(cmd, uploadbuffer.buffer, new_image.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1,
-								   &copyRegion);
-
-			if (!mipmapped) Utils::TransitionImage(cmd, new_image.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		});
-
-		if (mipmapped) {
-			GenerateMipmaps(new_image.image, VK_FORMAT_R8G8B8A8_SRGB, size.width, size.height, static_cast<uint32_t>(std::floor(std::log2(std::max(size.width, size.height)))) + 1);
+			if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT)) {
+				throw std::runtime_error("texture image format does not support linear blitting!");
+				//TODO: Special case of creating the mipmaps through a compute shader or on CPU.
+			}
 		}
 
-		DestroyBuffer(uploadbuffer);
+		AllocatedImage new_image = CreateImage(size, format, usage | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, mipmapped);
+		new_image.uploadValue = m_Uploads.UploadImage(new_image.image, size, mipLevels, data, dataSize);
 
 		return new_image;
 	}
 
-	void VulkanRenderer::GenerateMipmaps(VkImage image, VkFormat imageFormat, const int32_t texWidth, const int32_t texHeight, const uint32_t mipLevels) {
-		// Check if image format supports linear blitting
-		VkFormatProperties formatProperties;
-		vkGetPhysicalDeviceFormatProperties(m_PhysicalDevice, imageFormat, &formatProperties);
-
-		if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT)) {
-			throw std::runtime_error("texture image format does not support linear blitting!");
-			//TODO: Special case of creating the mipmaps through a compute shader or on CPU.
-		}
-
-		VkCommandBuffer commandBuffer = BeginSingleTimeCommands();
-
-		VkImageMemoryBarrier barrier{};
-		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-		barrier.image = image;
-		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		barrier.subresourceRange.baseArrayLayer = 0;
-		barrier.subresourceRange.layerCount = 1;
-		barrier.subresourceRange.levelCount = 1;
-
-		int32_t mipWidth = texWidth;
-		int32_t mipHeight = texHeight;
-
-		for (int64_t i = 1; i < mipLevels; ++i)	{
-			barrier.subresourceRange.baseMipLevel = i - 1;
-			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-			barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-			barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-
-			vkCmdPipelineBarrier(commandBuffer,
-				VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
-				0, nullptr,
-				0, nullptr,
-				1, &barrier);
-
-			VkImageBlit blit{};
-			blit.srcOffsets[0] = { 0, 0, 0 };
-			blit.srcOffsets[1] = { mipWidth, mipHeight, 1 };
-			blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			blit.srcSubresource.mipLevel = i - 1;
-			blit.srcSubresource.baseArrayLayer = 0;
-			blit.srcSubresource.layerCount = 1;
-			blit.dstOffsets[0] = { 0, 0, 0 };
-			blit.dstOffsets[1] = { mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1, 1 };
-			blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			blit.dstSubresource.mipLevel = i;
-			blit.dstSubresource.baseArrayLayer = 0;
-			blit.dstSubresource.layerCount = 1;
-
-			vkCmdBlitImage(commandBuffer,
-				image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-				image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-				1, &blit,
-				VK_FILTER_LINEAR);
-
-			barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-			barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-			vkCmdPipelineBarrier(commandBuffer,
-				VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-				0, nullptr,
-				0, nullptr,
-				1, &barrier);
-
-			if (mipWidth > 1) mipWidth /= 2;
-			if (mipHeight > 1) mipHeight /= 2;
-		}
-
-		// Switching the last mip levels before starting the command buffer.
-		barrier.subresourceRange.baseMipLevel = mipLevels - 1;
-		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-		barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-		vkCmdPipelineBarrier(commandBuffer,
-			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
-			0, nullptr,
-			0, nullptr,
-			1, &barrier);
-		EndSingleTimeCommands(commandBuffer);
-	}
-
 	void VulkanRenderer::DestroyImage(const AllocatedImage &img) {
 		vkDestroyImageView(m_Device, img.imageView, nullptr);
 		vmaDestroyImage(m_Allocator, img.image, img.allocation);
@@ -1177,7 +1110,6 @@ namespace Imagine::Vulkan {
 			m_ResizeRequested = true;
 			return false;
 		}
-		vkDeviceWaitIdle(m_Device);
 		ResizeSwapChain();
 		return m_IsDrawing;
 	}
@@ -1186,9 +1118,9 @@ namespace Imagine::Vulkan {
 		MGN_PROFILE_FUNCTION();
 
 		m_IsDrawing = true;
-		m_MainDrawContext.OpaqueSurfaces.clear();
+		m_MainDrawContext.Reset();
+		m_DrawStats = {};
 
-		m_LightData = lightData;
 		m_SceneData = sceneData;
 
 		// TODO: Preserve aspect ratio
@@ -1222,6 +1154,9 @@ namespace Imagine::Vulkan {
 			MGN_PROFILE_SCOPE("Flush Queue and clear pools");
 			GetCurrentFrame().m_DeletionQueue.flush(m_Device);
 			GetCurrentFrame().m_FrameDescriptors.ClearPools(m_Device);
+			const uint64_t blocks = GetCurrentFrame().m_Ring.GetBlockAllocationCount();
+			GetCurrentFrame().m_Ring.Reset();
+			m_DrawStats.bufferAllocations += GetCurrentFrame().m_Ring.GetBlockAllocationCount() - blocks;
 		}
 
 		{
@@ -1264,6 +1199,41 @@ namespace Imagine::Vulkan {
 			m_SceneData.sunlightDirection = glm::vec4(0, 1, 0.5, 1.f);
 		}
 
+		m_LightClusters.Build(lightData.lights, ViewMatrixCached, ProjectionMatrixCached, m_DrawExtent.width, m_DrawExtent.height);
+		m_LightClusters.ReportStats();
+
+		{
+			MGN_PROFILE_SCOPE("Write Global Descriptor");
+			// The scene and the lights are the same for every draw of the frame, they're pushed and their set is written once.
+			VulkanFrameData &frame = GetCurrentFrame();
+			const std::span<const Light> lights = m_LightClusters.GetLights();
+			const std::span<const GPULightCluster> clusters = m_LightClusters.GetClusters();
+			const std::span<const uint32_t> indices = m_LightClusters.GetIndices();
+			const VkDeviceSize lightsSize = sizeof(GPUClusterGrid) + lights.size_bytes();
+			const VkDeviceSize clustersSize = clusters.size_bytes();
+			// A storage buffer can't be empty.
+			const VkDeviceSize indicesSize = std::max<VkDeviceSize>(indices.size_bytes(), sizeof(uint32_t));
+
+			const FrameRingBuffer::Allocation sceneAllocation = frame.m_Ring.Push(m_SceneData);
+			const FrameRingBuffer::Allocation lightsAllocation = frame.m_Ring.Allocate(lightsSize);
+			std::memcpy(lightsAllocation.data, &m_LightClusters.GetGrid(), sizeof(GPUClusterGrid));
+			if (!lights.empty()) std::memcpy(static_cast<std::byte *>(lightsAllocation.data) + sizeof(GPUClusterGrid), lights.data(), lights.size_bytes());
+			const FrameRingBuffer::Allocation clustersAllocation = frame.m_Ring.Allocate(clustersSize);
+			std::memcpy(clustersAllocation.data, clusters.data(), clustersSize);
+			const FrameRingBuffer::Allocation indicesAllocation = frame.m_Ring.Allocate(indicesSize);
+			if (!indices.empty()) std::memcpy(indicesAllocation.data, indices.data(), indices.size_bytes());
+			frame.m_GlobalOffsets = {static_cast<uint32_t>(sceneAllocation.offset), static_cast<uint32_t>(lightsAllocation.offset), static_cast<uint32_t>(clustersAllocation.offset), static_cast<uint32_t>(indicesAllocation.offset)};
+
+			// The lights can overflow the main buffer of the ring, so each binding points to the buffer of its allocation.
+			frame.m_GlobalDescriptor = frame.m_FrameDescriptors.Allocate(m_Device, m_GpuSceneDataDescriptorLayout);
+			DescriptorWriter writer;
+			writer.WriteBuffer(0, sceneAllocation.buffer, sizeof(GPUSceneData), 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+			writer.WriteBuffer(1, lightsAllocation.buffer, lightsSize, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
+			writer.WriteBuffer(2, clustersAllocation.buffer, clustersSize, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
+			writer.WriteBuffer(3, indicesAllocation.buffer, indicesSize, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
+			writer.UpdateSet(m_Device, frame.m_GlobalDescriptor);
+		}
+
 		return true;
 	}
 	void VulkanRenderer::EndDraw() {
@@ -1288,22 +1258,35 @@ namespace Imagine::Vulkan {
 		// finalize the command buffer (we can no longer add commands, but it can now be executed)
 		VK_CHECK(vkEndCommandBuffer(cmd));
 
+		// Submit the uploads of the frame, the frame waits for them before drawing.
+		const uint64_t uploadValue = m_Uploads.Flush();
+
 		// prepare the submission to the queue.
 		// we want to wait on the _presentSemaphore, as that semaphore is signaled when the swapchain is ready
 		// we will signal the _renderSemaphore, to signal that rendering has finished
 
 		VkCommandBufferSubmitInfo cmdinfo = Initializer::CommandBufferSubmitInfo(cmd);
 
-		VkSemaphoreSubmitInfo waitInfo = Initializer::SemaphoreSubmitInfo(VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, GetCurrentFrame().m_SwapchainSemaphore);
+		VkSemaphoreSubmitInfo waitInfos[2] = {
+				Initializer::SemaphoreSubmitInfo(VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, GetCurrentFrame().m_SwapchainSemaphore),
+				Initializer::SemaphoreSubmitInfo(VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, m_Uploads.GetSemaphore()),
+		};
+		waitInfos[1].value = uploadValue;
 		VkSemaphoreSubmitInfo signalInfo = Initializer::SemaphoreSubmitInfo(VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT, GetCurrentFrame().m_RenderSemaphore);
 
-		VkSubmitInfo2 submit = Initializer::SubmitInfo(&cmdinfo, &signalInfo, &waitInfo);
+		VkSubmitInfo2 submit = Initializer::SubmitInfo(&cmdinfo, &signalInfo, waitInfos);
+		submit.waitSemaphoreInfoCount = 2;
 
 		// submit command buffer to the queue and execute it.
 		//  _renderFence will now block until the graphic commands finish execution
-		VK_CHECK(vkQueueSubmit2(m_GraphicsQueue, 1, &submit, GetCurrentFrame().m_RenderFence));
+		{
+			// The uploads were flushed above, their lock isn't held anymore.
+			std::lock_guard queueLock(m_QueueMutex);
+			VK_CHECK(vkQueueSubmit2(m_GraphicsQueue, 1, &submit, GetCurrentFrame().m_RenderFence));
+		}
+		m_HasDrawnFrame = true;
 
-		m_MainDrawContext.OpaqueSurfaces.clear();
+		m_MainDrawContext.Clear();
 	}
 	void VulkanRenderer::Present() {
 		MGN_PROFILE_FUNCTION();
@@ -1322,7 +1305,11 @@ namespace Imagine::Vulkan {
 
 		presentInfo.pImageIndices = &GetCurrentFrame().m_SwapchainImageIndex;
 
-		VkResult result = vkQueuePresentKHR(m_GraphicsQueue, &presentInfo);
+		VkResult result;
+		{
+			std::lock_guard queueLock(m_QueueMutex);
+			result = vkQueuePresentKHR(m_GraphicsQueue, &presentInfo);
+		}
 		if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || m_ResizeRequested) {
 			ResizeSwapChain();
 		}
@@ -1387,6 +1374,61 @@ namespace Imagine::Vulkan {
 		ImGui::End();
 
 
+		{
+			// The rates are refreshed every second so they stay readable.
+			const UploadStats &stats = m_Uploads.GetStats();
+			const auto now = std::chrono::high_resolution_clock::now();
+			const double elapsed = std::chrono::duration<double>(now - m_UploadSample.time).count();
+			if (elapsed >= 1.0) {
+				m_UploadSample.megabytesPerSecond = static_cast<double>(stats.bytes - m_UploadSample.bytes) / (1024.0 * 1024.0) / elapsed;
+				m_UploadSample.stallMillisecondsPerSecond = (stats.stallMilliseconds - m_UploadSample.stallMilliseconds) / elapsed;
+				m_UploadSample.time = now;
+				m_UploadSample.bytes = stats.bytes;
+				m_UploadSample.stallMilliseconds = stats.stallMilliseconds;
+			}
+
+			if (ImGui::Begin("Uploads")) {
+				ImGui::Text("Bandwidth: %.2f MB/s", m_UploadSample.megabytesPerSecond);
+				ImGui::Text("Stall: %.2f ms/s", m_UploadSample.stallMillisecondsPerSecond);
+				ImGui::Separator();
+				ImGui::Text("Uploaded: %.2f MB", static_cast<double>(stats.bytes) / (1024.0 * 1024.0));
+				ImGui::Text("Uploads: %llu in %llu batches", static_cast<unsigned long long>(stats.uploads), static_cast<unsigned long long>(stats.batches));
+				ImGui::Text("Stalls: %llu (%.2f ms)", static_cast<unsigned long long>(stats.stalls), stats.stallMilliseconds);
+				ImGui::Separator();
+				if (ImGui::BeginTable("VertexLayouts", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+					ImGui::TableSetupColumn("Layout");
+					ImGui::TableSetupColumn("Meshes");
+					ImGui::TableSetupColumn("Vertices (MB)");
+					ImGui::TableSetupColumn("As Full (MB)");
+					ImGui::TableHeadersRow();
+					for (uint32_t i = 0; i < c_VertexLayoutCount; ++i) {
+						const VertexLayoutStats &layout = m_VertexLayoutStats[i];
+						ImGui::TableNextRow();
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(VertexLayoutToString(static_cast<VertexLayout>(i)).c_str());
+						ImGui::TableNextColumn();
+						ImGui::Text("%llu", static_cast<unsigned long long>(layout.meshes));
+						ImGui::TableNextColumn();
+						ImGui::Text("%.2f", static_cast<double>(layout.bytes) / (1024.0 * 1024.0));
+						ImGui::TableNextColumn();
+						ImGui::Text("%.2f", static_cast<double>(layout.vertices * sizeof(Vertex)) / (1024.0 * 1024.0));
+					}
+					ImGui::EndTable();
+				}
+			}
+			ImGui::End();
+		}
+
+		if (ImGui::Begin("Lights")) {
+			const LightClusterStats &stats = m_LightClusters.GetStats();
+			const LightClusterSettings &settings = m_LightClusters.GetSettings();
+			ImGui::Text("Lights: %u (%u directional, %u culled)", stats.lights, stats.directionalLights, stats.culledLights);
+			ImGui::Text("Clusters: %u x %u x %u, %u occupied", settings.TilesX, settings.TilesY, settings.Slices, stats.occupiedClusters);
+			ImGui::Text("Indices: %u (%u dropped)", stats.indices, stats.droppedIndices);
+			ImGui::Text("Max lights in a cluster: %u / %u", stats.maxLightsInCluster, settings.MaxLightsPerCluster);
+		}
+		ImGui::End();
+
 		ImGui::SetNextWindowSize({400, 400}, ImGuiCond_FirstUseEver);
 		if (ImGui::Begin("Rendering")) {
 			const ImVec2 pos = ImGui::GetCursorScreenPos();
@@ -1462,13 +1504,15 @@ namespace Imagine::Vulkan {
 
 				for (uint32_t blockIndex = 0; blockIndex < set.Blocks.size(); ++blockIndex) {
 					const auto &block = set.Blocks[blockIndex];
+					// The set 0 is the global set of the frame, bound with dynamic offsets in the frame ring.
+					const bool global = setIndex == 0;
 					VkDescriptorType bufferType;
 					switch (block.GPUBufferType) {
 						case MaterialBlock::SSBO:
-							bufferType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+							bufferType = global ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
 							break;
 						case MaterialBlock::Uniform:
-							bufferType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+							bufferType = global ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
 							break;
 					}
 
@@ -1639,14 +1683,16 @@ namespace Imagine::Vulkan {
 				if (binding.IsABuffer()) {
 					VkBufferUsageFlagBits usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
 					VkDescriptorType type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+					// Matches the dynamic buffers of the global set 0 in the layout, the set itself is never bound.
+					const bool global = setIndex == 0;
 					switch (binding.GPUBufferType) {
 						case MaterialBlock::SSBO:
 							usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
-							type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+							type = global ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
 							break;
 						case MaterialBlock::Uniform:
 							usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-							type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+							type = global ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
 							break;
 					}
 
@@ -1831,19 +1877,34 @@ namespace Imagine::Vulkan {
 		MGN_PROFILE_FUNCTION();
 		VkCommandBuffer cmd{nullptr};
 		cmd = GetCurrentFrame().m_MainCommandBuffer;
-
-		std::vector<ManualDeleteMeshAsset> lineMeshes;
-		ManualDeleteMeshAsset pointMesh;
-		if (!ctx.OpaqueLines.empty()) {
-			for (const LineObject &line: ctx.OpaqueLines) {
-				lineMeshes.emplace_back(std::move(Initializer::LoadManualLines(this, {(LineObject *) &line, 1})));
-				PushCurrentFrameDeletion(lineMeshes.back().meshBuffers.indexBuffer.allocation, lineMeshes.back().meshBuffers.indexBuffer.buffer);
-				PushCurrentFrameDeletion(lineMeshes.back().meshBuffers.vertexBuffer.allocation, lineMeshes.back().meshBuffers.vertexBuffer.buffer);
-			}
+		FrameRingBuffer &ring = GetCurrentFrame().m_Ring;
+		const uint64_t ringBlocks = ring.GetBlockAllocationCount();
+
+		// Every line of the context is pushed at once from its flat streams to the frame ring.
+		std::optional<FrameRingBuffer::Allocation> lineVertices;
+		std::optional<FrameRingBuffer::Allocation> lineIndices;
+		if (!ctx.LineIndices.empty()) {
+			lineVertices = ring.Allocate(sizeof(Vertex) * ctx.LineVertices.size());
+			std::memcpy(lineVertices->data, ctx.LineVertices.data(), sizeof(Vertex) * ctx.LineVertices.size());
+			lineIndices = ring.Allocate(sizeof(uint32_t) * ctx.LineIndices.size());
+			std::memcpy(lineIndices->data, ctx.LineIndices.data(), sizeof(uint32_t) * ctx.LineIndices.size());
+		}
+		// The debug geometry is copied once from the memory of its owner, and drawn without indices.
+		const uint32_t debugLineCount = static_cast<uint32_t>(ctx.DebugLines.size() & ~size_t{1});
+		const uint32_t debugTriangleCount = static_cast<uint32_t>(ctx.DebugTriangles.size() / 3 * 3);
+		std::optional<FrameRingBuffer::Allocation> debugLines;
+		std::optional<FrameRingBuffer::Allocation> debugTriangles;
+		if (debugLineCount) {
+			debugLines = ring.Allocate(sizeof(Vertex) * debugLineCount);
+			std::memcpy(debugLines->data, ctx.DebugLines.data(), sizeof(Vertex) * debugLineCount);
+		}
+		if (debugTriangleCount) {
+			debugTriangles = ring.Allocate(sizeof(Vertex) * debugTriangleCount);
+			std::memcpy(debugTriangles->data, ctx.DebugTriangles.data(), sizeof(Vertex) * debugTriangleCount);
 		}
 		// TODO: Implement a point renderer when it's ready. Like, by doing a Geometry shader or some things.
-		// if (!ctx.OpaquePoints.empty()) {
-		// 	pointMesh = Initializer::LoadPoints(this, (std::vector<Vertex> &) (ctx.OpaquePoints));
+		// if (!ctx.PointVertices.empty()) {
+		// 	pointMesh = Initializer::LoadPoints(this, ctx.PointVertices);
 		// }
 
 		VkRenderingAttachmentInfo colorAttachment = Initializer::RenderingAttachmentInfo(m_DrawImage.imageView, nullptr, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
@@ -1871,71 +1932,92 @@ namespace Imagine::Vulkan {
 
 		vkCmdSetScissor(cmd, 0, 1, &scissor);
 
-		// allocate a new uniform buffer for the scene data
-		// using CPU_TO_GPU as the `GPUSceneData` type is very small and can probably be cached entirely in VRAM.
-		// better use a dedicated `VMA_MEMORY_USAGE_GPU` for bigger data and do a transfer beforehand.
-		AllocatedBuffer gpuSceneDataBuffer = CreateBuffer(sizeof(GPUSceneData), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-		AllocatedBuffer gpuLightDataBuffer = CreateBuffer(sizeof(GPULightData), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
-
-		// add it to the deletion queue of this frame so it gets deleted once its been used
-		GetCurrentFrame().m_DeletionQueue.push(Deleter::VmaBuffer{m_Allocator, gpuSceneDataBuffer.allocation, gpuSceneDataBuffer.buffer});
-		GetCurrentFrame().m_DeletionQueue.push(Deleter::VmaBuffer{m_Allocator, gpuLightDataBuffer.allocation, gpuLightDataBuffer.buffer});
-
-		// write the buffer
-		GPUSceneData *sceneUniformData = (GPUSceneData *) gpuSceneDataBuffer.allocation->GetMappedData();
-		*sceneUniformData = m_SceneData;
-
-		GPULightData *lightUniformData = (GPULightData *) gpuLightDataBuffer.allocation->GetMappedData();
-		*lightUniformData = m_LightData;
-
-		// create a descriptor set that binds that buffer and update it
-		GetCurrentFrame().m_GlobalDescriptor = GetCurrentFrame().m_FrameDescriptors.Allocate(m_Device, m_GpuSceneDataDescriptorLayout);
-
-		DescriptorWriter writer;
-		writer.WriteBuffer(0, gpuSceneDataBuffer.buffer, sizeof(GPUSceneData), 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
-		writer.WriteBuffer(1, gpuLightDataBuffer.buffer, sizeof(GPULightData), 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
-		writer.UpdateSet(m_Device, GetCurrentFrame().m_GlobalDescriptor);
-
-		for (const RenderObject &draw: ctx.OpaqueSurfaces) {
-
-			AutoDeleteMeshAsset *mesh = dynamic_cast<AutoDeleteMeshAsset *>(draw.mesh.get());
-
-			MGN_CORE_CASSERT(mesh, "The mesh is not a valid vulkan mesh.");
-			// TODO: Do some smart LOD selection instead of the best one everytime
-			const LOD &lod = mesh->lods.front();
-
-			// TODO: Get the real material from the LOD.
-			auto instance = AssetManager::GetAssetAs<CPUMaterialInstance>(lod.materialInstance);
-			instance->LoadInGPU();
-			auto vkInstance = dynamic_cast<VulkanMaterialInstance *>(instance->gpu.get());
-			if (!vkInstance) continue;
-			if (auto vkMat = vkInstance->material.lock()) {
+		// The scene and the lights were pushed to the frame ring by 'BeginDraw', the global set is only bound with their offsets.
+		const VulkanFrameData &frame = GetCurrentFrame();
+
+		// One instance per surface, in the order of the surfaces, and a last one with an identity transform for the lines and the debug geometry.
+		const uint32_t lineInstance = ctx.OpaqueSurfaces.size();
+		const FrameRingBuffer::Allocation instances = ring.Allocate(sizeof(GPUInstanceData) * (lineInstance + 1));
+		GPUInstanceData *instanceData = static_cast<GPUInstanceData *>(instances.data);
+		InstanceBatcher::WriteInstances(ctx.OpaqueSurfaces, instanceData);
+		instanceData[lineInstance] = GPUInstanceData{Math::Identity<glm::fmat4>(), Math::Identity<glm::fmat4>()};
+		const VkDeviceAddress instanceBufferAddress = instances.address;
+
+		// The surfaces sharing a mesh LOD, and therefore a material instance, are drawn at once.
+		m_InstanceBatcher.Build(ctx.OpaqueSurfaces);
+
+		// The surfaces are sorted by state, so only the state that changes from one draw to the next is bound.
+		AssetHandle instanceHandle = NULL_ASSET_HANDLE;
+		VulkanMaterialInstance *vkInstance{nullptr};
+		Ref<VulkanMaterial> vkMat{nullptr};
+		bool lookedUp{false};
+		VkPipeline boundPipeline{VK_NULL_HANDLE};
+		VkPipelineLayout boundLayout{VK_NULL_HANDLE};
+		const VulkanMaterialInstance *boundInstance{nullptr};
+		VkBuffer boundIndexBuffer{VK_NULL_HANDLE};
+
+		for (const InstanceBatch &batch: m_InstanceBatcher.GetBatches()) {
+			MGN_CORE_CASSERT(dynamic_cast<AutoDeleteMeshAsset *>(batch.mesh), "The mesh is not a valid vulkan mesh.");
+			AutoDeleteMeshAsset *mesh = static_cast<AutoDeleteMeshAsset *>(batch.mesh);
+
+			// The LOD is selected by the culling, the surfaces that weren't culled use the best one.
+			const LOD &lod = mesh->lods[std::min<uint64_t>(batch.lod, mesh->lods.size() - 1)];
+
+			if (!lookedUp || lod.materialInstance != instanceHandle) {
+				lookedUp = true;
+				instanceHandle = lod.materialInstance;
+				auto instance = AssetManager::GetAssetAs<CPUMaterialInstance>(lod.materialInstance);
+				instance->LoadInGPU();
+				vkInstance = dynamic_cast<VulkanMaterialInstance *>(instance->gpu.get());
+				vkMat = vkInstance ? vkInstance->material.lock() : nullptr;
+				++m_DrawStats.materialLookups;
+			}
+			if (!vkInstance || !vkMat) continue;
 
+			if (vkMat->pipeline.pipeline != boundPipeline) {
 				vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, vkMat->pipeline.pipeline);
-				vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, vkMat->pipeline.layout, 0, 1, &GetCurrentFrame().m_GlobalDescriptor, 0, nullptr);
+				boundPipeline = vkMat->pipeline.pipeline;
+				++m_DrawStats.pipelineBinds;
+				// Another layout may disturb the sets bound so far, they're bound again.
+				if (vkMat->pipeline.layout != boundLayout) {
+					vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, vkMat->pipeline.layout, 0, 1, &frame.m_GlobalDescriptor, frame.m_GlobalOffsets.size(), frame.m_GlobalOffsets.data());
+					boundLayout = vkMat->pipeline.layout;
+					boundInstance = nullptr;
+					++m_DrawStats.descriptorSetBinds;
+				}
+			}
+
+			if (vkInstance != boundInstance) {
 				for (int i = 1; i < vkMat->materialLayouts.size(); ++i) {
 					vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, vkMat->pipeline.layout, i, 1, &vkInstance->materialSets.at(i), 0, nullptr);
+					++m_DrawStats.descriptorSetBinds;
 				}
+				boundInstance = vkInstance;
+			}
 
+			if (mesh->meshBuffers.indexBuffer.buffer != boundIndexBuffer) {
 				vkCmdBindIndexBuffer(cmd, mesh->meshBuffers.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
-
-				GPUDrawPushConstants pushConstants;
-				pushConstants.vertexBuffer = mesh->meshBuffers.vertexBufferAddress;
-				pushConstants.worldMatrix = draw.transform;
-				pushConstants.normalMatrix = glm::transpose(glm::inverse(pushConstants.worldMatrix));
-				vkCmdPushConstants(cmd, vkMat->pipeline.layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GPUDrawPushConstants), &pushConstants);
-
-				vkCmdDrawIndexed(cmd, lod.count, 1, lod.index, 0, 0);
+				boundIndexBuffer = mesh->meshBuffers.indexBuffer.buffer;
+				++m_DrawStats.indexBufferBinds;
 			}
-		}
 
-		for (uint64_t i = 0; i < lineMeshes.size(); ++i) {
-			ManualDeleteMeshAsset *mesh = &lineMeshes[i];
+			const GPUMeshBuffers &buffers = mesh->meshBuffers;
+			GPUDrawPushConstants pushConstants;
+			pushConstants.vertexBuffer = buffers.vertexBufferAddress;
+			pushConstants.instanceBuffer = instanceBufferAddress;
+			pushConstants.colorBuffer = buffers.colorBufferAddress;
+			pushConstants.vertexLayout = static_cast<uint32_t>(buffers.layout);
+			pushConstants.hasColors = buffers.colorBufferAddress != 0;
+			pushConstants.positionOffset = glm::vec4{buffers.positionOffset, 0};
+			pushConstants.positionScale = glm::vec4{buffers.positionScale, 0};
+			vkCmdPushConstants(cmd, vkMat->pipeline.layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GPUDrawPushConstants), &pushConstants);
 
-			MGN_CORE_CASSERT(mesh, "The mesh is not a valid vulkan mesh.");
-			// TODO: Do some smart LOD selection instead of the best one everytime
-			const LOD &lod = mesh->lods.front();
+			vkCmdDrawIndexed(cmd, lod.count, batch.count, lod.index, 0, batch.first);
+			++m_DrawStats.draws;
+			m_DrawStats.instances += batch.count;
+		}
 
+		if (lineVertices && lineIndices) {
 			// // TODO: Get the real material from the LOD.
 			// const VulkanMaterialInstance *material = m_LineInstance.get();
 			//
@@ -1954,27 +2036,55 @@ namespace Imagine::Vulkan {
 			// 	vkCmdDrawIndexed(cmd, lod.count, 1, lod.index, 0, 0);
 			// }
 			auto vkInstance = m_LineInstance;
-			if (!vkInstance) continue;
-			if (auto vkMat = vkInstance->material.lock()) {
+			if (auto vkMat = vkInstance ? vkInstance->material.lock() : nullptr) {
 
 				vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, vkMat->pipeline.pipeline);
-				vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, vkMat->pipeline.layout, 0, 1, &GetCurrentFrame().m_GlobalDescriptor, 0, nullptr);
+				vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, vkMat->pipeline.layout, 0, 1, &frame.m_GlobalDescriptor, frame.m_GlobalOffsets.size(), frame.m_GlobalOffsets.data());
 				for (int i = 1; i < vkMat->materialLayouts.size(); ++i) {
 					vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, vkMat->pipeline.layout, i, 1, &vkInstance->materialSets.at(i), 0, nullptr);
 				}
 
-				vkCmdBindIndexBuffer(cmd, mesh->meshBuffers.indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
+				vkCmdBindIndexBuffer(cmd, lineIndices->buffer, lineIndices->offset, VK_INDEX_TYPE_UINT32);
 
 				GPUDrawPushConstants pushConstants;
-				pushConstants.vertexBuffer = mesh->meshBuffers.vertexBufferAddress;
-				pushConstants.worldMatrix = Math::Identity<glm::fmat4>();
-				pushConstants.normalMatrix = Math::Identity<glm::fmat4>();
+				pushConstants.vertexBuffer = lineVertices->address;
+				pushConstants.instanceBuffer = instanceBufferAddress;
 				vkCmdPushConstants(cmd, vkMat->pipeline.layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GPUDrawPushConstants), &pushConstants);
 
-				vkCmdDrawIndexed(cmd, lod.count, 1, lod.index, 0, 0);
+				vkCmdDrawIndexed(cmd, ctx.LineIndices.size(), 1, 0, 0, lineInstance);
+				++m_DrawStats.pipelineBinds;
+				m_DrawStats.descriptorSetBinds += std::max<uint64_t>(vkMat->materialLayouts.size(), 1);
+				++m_DrawStats.indexBufferBinds;
+				++m_DrawStats.draws;
+				++m_DrawStats.instances;
 			}
 		}
 
+		// The debug vertices are read in order, with the identity instance of the lines.
+		const auto drawDebug = [&](const Ref<VulkanMaterialInstance> &vkInstance, const FrameRingBuffer::Allocation &vertices, const uint32_t vertexCount) {
+			const Ref<VulkanMaterial> vkMat = vkInstance ? vkInstance->material.lock() : nullptr;
+			if (!vkMat) return;
+
+			vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, vkMat->pipeline.pipeline);
+			vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, vkMat->pipeline.layout, 0, 1, &frame.m_GlobalDescriptor, frame.m_GlobalOffsets.size(), frame.m_GlobalOffsets.data());
+			for (int i = 1; i < vkMat->materialLayouts.size(); ++i) {
+				vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, vkMat->pipeline.layout, i, 1, &vkInstance->materialSets.at(i), 0, nullptr);
+			}
+
+			GPUDrawPushConstants pushConstants;
+			pushConstants.vertexBuffer = vertices.address;
+			pushConstants.instanceBuffer = instanceBufferAddress;
+			vkCmdPushConstants(cmd, vkMat->pipeline.layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(GPUDrawPushConstants), &pushConstants);
+
+			vkCmdDraw(cmd, vertexCount, 1, 0, lineInstance);
+			++m_DrawStats.pipelineBinds;
+			m_DrawStats.descriptorSetBinds += std::max<uint64_t>(vkMat->materialLayouts.size(), 1);
+			++m_DrawStats.draws;
+			++m_DrawStats.instances;
+		};
+		if (debugLines) drawDebug(m_LineInstance, *debugLines, debugLineCount);
+		if (debugTriangles) drawDebug(m_OpaqueInstance, *debugTriangles, debugTriangleCount);
+
 		// if (pointMesh) {
 		//
 		// 	AutoDeleteMeshAsset *mesh = pointMesh.get();
@@ -2000,6 +2110,7 @@ namespace Imagine::Vulkan {
 		// }
 
 		vkCmdEndRendering(cmd);
+		m_DrawStats.bufferAllocations += ring.GetBlockAllocationCount() - ringBlocks;
 	}
 
 	void VulkanRenderer::ImmediateSubmit(std::function<void(VkCommandBuffer cmd)> &&function) {
@@ -2023,7 +2134,10 @@ namespace Imagine::Vulkan {
 
 		// submit command buffer to the queue and execute it.
 		//  _renderFence will now block until the graphic commands finish execution
-		VK_CHECK(vkQueueSubmit2(m_GraphicsQueue, 1, &submit, m_ImmFence));
+		{
+			std::lock_guard queueLock(m_QueueMutex);
+			VK_CHECK(vkQueueSubmit2(m_GraphicsQueue, 1, &submit, m_ImmFence));
+		}
 
 		VK_CHECK(vkWaitForFences(m_Device, 1, &m_ImmFence, true, 9999999999));
 	}
@@ -2097,6 +2211,60 @@ namespace Imagine::Vulkan {
 #endif
 	}
 
+	bool VulkanRenderer::ReadColor(Image<uint8_t> &image) {
+		MGN_PROFILE_FUNCTION();
+		if (m_IsDrawing || !m_HasDrawnFrame || m_DrawExtent.width == 0 || m_DrawExtent.height == 0) {
+			MGN_CORE_ERROR("The Vulkan renderer has no finished frame to read back.");
+			return false;
+		}
+
+		// The draw image holds 4 half floats per pixel, they're copied as is and converted on the CPU.
+		const VkExtent2D extent = m_DrawExtent;
+		const uint64_t valueCount = static_cast<uint64_t>(extent.width) * extent.height * 4;
+		AllocatedBuffer readback = CreateBuffer(valueCount * sizeof(uint16_t), VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU);
+
+		// Submitted on the queue of the frame, the barriers wait for its draws.
+		ImmediateSubmit([&](VkCommandBuffer cmd) {
+			Utils::TransitionImage(cmd, m_DrawImage.image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+
+			VkBufferImageCopy region{};
+			region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			region.imageSubresource.layerCount = 1;
+			region.imageExtent = {extent.width, extent.height, 1};
+			vkCmdCopyImageToBuffer(cmd, m_DrawImage.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readback.buffer, 1, &region);
+
+			// Make the copy visible to the host once the fence is signaled.
+			VkMemoryBarrier2 hostBarrier{.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+			hostBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+			hostBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+			hostBarrier.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+			hostBarrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+			VkDependencyInfo depInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+			depInfo.memoryBarrierCount = 1;
+			depInfo.pMemoryBarriers = &hostBarrier;
+			vkCmdPipelineBarrier2(cmd, &depInfo);
+
+			Utils::TransitionImage(cmd, m_DrawImage.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		});
+		VK_CHECK(vmaInvalidateAllocation(m_Allocator, readback.allocation, 0, VK_WHOLE_SIZE));
+
+		// Same conversion as the blit into the UNORM swapchain.
+		const uint16_t *values = static_cast<const uint16_t *>(readback.info.pMappedData);
+		image.Allocate(extent.width, extent.height, 4);
+		for (uint32_t y = 0; y < extent.height; ++y) {
+			for (uint32_t x = 0; x < extent.width; ++x) {
+				const uint16_t *pixel = &values[(static_cast<uint64_t>(y) * extent.width + x) * 4];
+				for (uint32_t c = 0; c < 4; ++c) {
+					const float value = glm::unpackHalf1x16(pixel[c]);
+					image(x, y, c) = static_cast<uint8_t>((value > 0 ? std::min(value, 1.0f) : 0.0f) * 255.0f + 0.5f);
+				}
+			}
+		}
+
+		DestroyBuffer(readback);
+		return true;
+	}
+
 	DrawContext &VulkanRenderer::GetDrawContext() {
 		return m_MainDrawContext;
 	}
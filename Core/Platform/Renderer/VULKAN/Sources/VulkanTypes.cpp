@@ -13,6 +13,12 @@ namespace Imagine::Vulkan {
 		VulkanRenderer *renderer = reinterpret_cast<VulkanRenderer *>(Renderer::Get());
 		renderer->PushFrameDeletion(meshBuffers.vertexBuffer.allocation, meshBuffers.vertexBuffer.buffer);
 		renderer->PushFrameDeletion(meshBuffers.indexBuffer.allocation, meshBuffers.indexBuffer.buffer);
+		if (meshBuffers.colorBuffer.buffer) {
+			renderer->PushFrameDeletion(meshBuffers.colorBuffer.allocation, meshBuffers.colorBuffer.buffer);
+		}
+	}
+	bool AutoDeleteMeshAsset::IsReady() const {
+		return VulkanRenderer::Get()->IsUploadComplete(meshBuffers.uploadValue);
 	}
 
 	ManualDeleteMeshAsset::ManualDeleteMeshAsset(ManualDeleteMeshAsset && o) noexcept : meshBuffers(std::move(o.meshBuffers)),name(std::move(o.name)), lods(std::move(o.lods))
@@ -23,6 +29,9 @@ namespace Imagine::Vulkan {
 		swap(o);
 		return *this;
 	}
+	bool ManualDeleteMeshAsset::IsReady() const {
+		return VulkanRenderer::Get()->IsUploadComplete(meshBuffers.uploadValue);
+	}
 	void ManualDeleteMeshAsset::swap(ManualDeleteMeshAsset &other) noexcept {
 		std::swap(name, other.name);
 		std::swap(lods, other.lods);
@@ -7,6 +7,7 @@
 #include "Imagine/Assets/AssetManager.hpp"
 #include "Imagine/Components/Renderable.hpp"
 #include "Imagine/Core/Inputs.hpp"
+#include "Imagine/Core/JobSystem.hpp"
 #include "Imagine/Core/Macros.hpp"
 #include "Imagine/Core/Profiling.hpp"
 #include "Imagine/Core/SparseSet.hpp"
@@ -65,6 +66,8 @@ namespace Imagine {
 	Application::Application(const ApplicationParameters &parameters) :
 		m_Parameters(parameters) {
 
+		JobSystem::Initialize(parameters.WorkerThreads.value_or(JobSystem::GetDefaultWorkerCount()));
+
 		SceneManager::Intialize();
 
 		Project::New();
@@ -73,6 +76,11 @@ namespace Imagine {
 		m_LastFrame = m_Start = std::chrono::high_resolution_clock::now();
 		m_DeltaTime = 0.01666666f;
 
+		if (parameters.Capture) {
+			m_Capture = CreateScope<FrameCapture>(parameters.Capture.value());
+			m_DeltaTime = m_Capture->GetTimeStep();
+		}
+
 		if (parameters.Window) {
 			m_Window = Window::Initialize(parameters.AppName, parameters.Window.value());
 			m_Window->SetEventCallback(MGN_BIND_EVENT_FN(Application::OnEvent));
@@ -82,8 +90,8 @@ namespace Imagine {
 			Project::AddOnLoad(CPUShader::TryRegister);
 			Project::AddOnLoad(CPUMaterial::TryRegister);
 
-			auto vert = CPUFileShader::Initialize(ShaderStage::Vertex, Path{FileSource::Engine, "pbr.vert.spv"});
-			auto frag = CPUFileShader::Initialize(ShaderStage::Fragment, Path{FileSource::Engine, "pbr.frag.spv"});
+			auto vert = CPUFileShader::Initialize(ShaderStage::Vertex, Path{FileSource::EngineShaders, "pbr.vert.spv"});
+			auto frag = CPUFileShader::Initialize(ShaderStage::Fragment, Path{FileSource::EngineShaders, "pbr.frag.spv"});
 			CPUShader::TryRegister();
 
 			CPUMaterial::InitDefaultMaterials(vert->Handle, frag->Handle);
@@ -131,6 +139,8 @@ namespace Imagine {
 			m_Window = nullptr;
 			Window::Shutdown();
 		}
+
+		JobSystem::Shutdown();
 	}
 
 	void Application::PushLayer(Layer *layer) {
@@ -151,18 +161,28 @@ namespace Imagine {
 
 	void Application::Run() {
 		{
-			auto model = CPUModel::LoadModel({FileSource::Engine, "Models/Sponza/Sponza.gltf"});
-			Project::GetActive()->GetFileAssetManager()->AddAsset(model, {FileSource::Engine, "Models/Sponza/Sponza.gltf"});
+			// The model is streamed in the background and drawn once it's loaded.
+			const AssetHandle model = Project::GetActive()->GetFileAssetManager()->RegisterAssetPath({FileSource::Engine, "Models/Sponza/Sponza.gltf"}, AssetType::Model);
+			MGN_CORE_CASSERT(model != NULL_ASSET_HANDLE);
 			const auto entityId = SceneManager::GetMainScene()->CreateEntity();
 			Renderable *renderable = SceneManager::GetMainScene()->AddComponent<Renderable>(entityId);
-			renderable->cpuMeshOrModel = model->Handle;
-			MGN_CORE_CASSERT(model);
+			renderable->cpuMeshOrModel = model;
+
+			// A capture must see the same scene on every run, the model is loaded before the first frame.
+			if (m_Capture) {
+				if (const Ref<AssetRequest> request = AssetManager::RequestAsset(model, AssetLoadPriority::High)) {
+					request->Wait();
+				}
+				AssetManager::UpdateRequests();
+			}
 		}
 
 
 		while (!m_ShouldStop) {
 			MGN_FRAME_START();
 			bool canDraw = true;
+			m_FrameTimings = {};
+			const std::chrono::high_resolution_clock::time_point frameStart = std::chrono::high_resolution_clock::now();
 
 			if (m_Window) {
 				MGN_PROFILE_SCOPE("Windows Update");
@@ -170,6 +190,11 @@ namespace Imagine {
 				canDraw = !m_Window->IsMinimized();
 			}
 
+			{
+				MGN_PROFILE_SCOPE("Asset Requests Update");
+				AssetManager::UpdateRequests();
+			}
+
 			{
 				MGN_PROFILE_SCOPE("Event - App Tick");
 				AppTickEvent event{m_DeltaTime};
@@ -195,18 +220,32 @@ namespace Imagine {
 
 			if (canDraw) {
 				MGN_PROFILE_SCOPE("App Draw");
-				Camera::s_MainCamera->Update(m_DeltaTime);
+				if (m_Capture) {
+					m_Capture->PlaceCamera(m_CurrentFrame, *Camera::s_MainCamera);
+				}
+				else {
+					Camera::s_MainCamera->Update(m_DeltaTime);
+				}
 				Draw();
 			}
 
 			{
 				MGN_PROFILE_SCOPE("Delta Time Update");
 				std::chrono::high_resolution_clock::time_point newFrame = std::chrono::high_resolution_clock::now();
-				m_DeltaTime = std::chrono::duration<double, std::chrono::seconds::period>(newFrame - m_LastFrame).count();
+				m_FrameTimings.frame = std::chrono::duration<double, std::milli>(newFrame - frameStart).count();
+				m_DeltaTime = m_Capture ? m_Capture->GetTimeStep().GetSeconds() : std::chrono::duration<double, std::chrono::seconds::period>(newFrame - m_LastFrame).count();
 				m_LastFrame = newFrame;
 				m_CurrentFrame += 1;
 			}
 
+			if (m_Capture) {
+				m_Capture->Record(m_FrameTimings);
+				if (m_Capture->IsDone()) {
+					if (m_Renderer) m_Capture->Write(*m_Renderer);
+					m_ShouldStop = true;
+				}
+			}
+
 			// MGN_CORE_INFO("Frame #{}", m_CurrentFrame);
 			// MGN_CORE_INFO("DeltaTime #{}", m_DeltaTime);
 			// MGN_CORE_INFO("Time #{}", Time());
@@ -288,29 +327,35 @@ namespace Imagine {
 		GPUSceneData sceneData{};
 		GPULightData lightData{};
 
-		std::atomic<int> counter{0};
+		// Every light is sent, the renderers only shade the ones around each pixel.
+		uint64_t lightCount = 0;
+		for (auto &scene: SceneManager::GetLoadedScenes()) {
+			lightCount += scene->CountComponents<Light>();
+		}
+		lightData.lights.reserve(lightCount);
 
+		// Gathered serially, the lights keep the same order from one frame to the next.
 		for (auto &scene: SceneManager::GetLoadedScenes()) {
-			scene->ForEachWithComponent<Light>([this, &lightData, &counter](const Scene *scn, const EntityID id, const Light &comp) {
-				const auto index = counter.fetch_add(1, std::memory_order_relaxed);
-				if (index >= GPULightData::MaxLight) return;
+			const Scene *scn = scene.get();
+			scn->Query<Light>().Each([scn, &lightData](const EntityID id, const Light &comp) {
 				Light light = comp;
 				const auto world = scn->GetWorldTransform(id);
 				const auto normal = glm::transpose(glm::inverse(world));
-				light.position += scn->GetWorldTransform(id) * Vec4(scn->GetEntity(id).LocalPosition, 1);
+				light.position += world * Vec4(scn->GetEntity(id).LocalPosition, 1);
 				const auto w = light.direction.w;
 				const auto len = Math::Magnitude(glm::fvec3(light.direction));
 				light.direction = normal * glm::fvec4(0, -1, 0, 0);
 				light.direction *= len;
 				light.direction.w = w;
-				lightData.lights[index] = light;
+				lightData.lights.push_back(light);
 			});
 		}
 
-		lightData.lightCount = std::min(counter.load(std::memory_order_acquire), GPULightData::MaxLight);
-
 		if (m_Renderer->BeginDraw(sceneData, lightData)) {
-			m_Renderer->Draw();
+			{
+				StageTimer timer{m_FrameTimings.raster};
+				m_Renderer->Draw();
+			}
 
 
 			// TODO: See if I wanna do it this way
@@ -329,72 +374,66 @@ namespace Imagine {
 				MGN_PROFILE_SCOPE("Draw All Scenes");
 
 				auto loadedScene = SceneManager::GetLoadedScenes();
-				DrawContext ctx{};
+				const Mat4 view = m_Renderer->GetViewMatrix();
+				const Mat4 projection = m_Renderer->GetProjectionMatrix();
+				DrawContext &ctx = m_SceneContext;
+				ctx.Reset();
+				m_FrustumCuller.ResetStats();
 				for (const std::shared_ptr<Scene> &scene: loadedScene) {
 					MGN_PROFILE_SCOPE("Draw One Scene");
-					scene->CacheTransforms();
-					ctx.OpaqueSurfaces.reserve(scene->CountComponents<Renderable>());
-					ctx.OpaqueLines.reserve(scene->Count()*3);
-					scene->ForEach([&ctx](const Scene *scene, const EntityID id) {
-						const auto trs = scene->GetTransform(id);
-						const auto pos = trs.GetWorldPosition();
-						ctx.OpaqueLines.push_back({{Vertex::PC(pos, Vec4(1,0,0,1)), Vertex::PC(pos + trs.GetRight(), Vec4(1,0,0,1))}});
-						ctx.OpaqueLines.push_back({{Vertex::PC(pos, Vec4(0,1,0,1)), Vertex::PC(pos + trs.GetUp(), Vec4(0,1,0,1))}});
-						ctx.OpaqueLines.push_back({{Vertex::PC(pos, Vec4(0,0,1,1)), Vertex::PC(pos + trs.GetForward(), Vec4(0,0,1,1))}});
-					});
-					scene->ForEachWithComponent<Renderable>([&ctx](const Scene *scene, const EntityID id, Renderable &renderable) {
-						if (renderable.cpuMeshOrModel == NULL_ASSET_HANDLE) return;
-						Ref<Asset> asset = AssetManager::GetAsset(renderable.cpuMeshOrModel);
-						if (!asset) return;
-						const Mat4 worldMat = scene->GetWorldTransform(id);
-						switch (asset->GetType()) {
-							case AssetType::Model: {
-								auto cpuModel = CastPtr<CPUModel>(asset);
-								if (!cpuModel) return;
-								if (cpuModel->LoadModelInGPU())
-								for (const CPUModel::Node& node: cpuModel->Nodes) {
-									if (node.meshes.empty()) continue;
-									const auto world = worldMat * node.worldMatrix;
-									for (const Weak<CPUMesh> & mesh: node.meshes) {
-										if (const Ref<CPUMesh> lock = mesh.lock()) {
-											if (lock->gpu) ctx.OpaqueSurfaces.emplace_back(world, lock->gpu);
-										}
-									}
-								}
-							}
-								break;
-							case AssetType::Mesh: {
-								auto cpuMesh = CastPtr<CPUMesh>(asset);
-								cpuMesh->LoadMeshInGPU();
-								auto gpuMesh = cpuMesh->gpu;
-								if (!gpuMesh) return;
-								MGN_CORE_MASSERT(worldMat != Mat4(0), "The transform wasn't cached for the entity '{}'", scene->GetName(id));
-								ctx.OpaqueSurfaces.emplace_back(worldMat, gpuMesh);
-							} break;
-							default:
-								return;
-						}
-					});
-					m_Renderer->Draw(ctx);
+					{
+						StageTimer timer{m_FrameTimings.extraction};
+						scene->CacheTransforms();
+						m_DrawExtractor.ExtractRenderables(*scene, ctx);
+					}
+					{
+						StageTimer timer{m_FrameTimings.culling};
+						m_FrustumCuller.Cull(view, projection, ctx);
+						m_DrawSorter.Sort(ctx);
+					}
+					if (m_Parameters.DrawGizmos) {
+						StageTimer timer{m_FrameTimings.extraction};
+						DrawExtractor::ExtractGizmos(*scene, ctx);
+					}
+					{
+						StageTimer timer{m_FrameTimings.raster};
+						m_Renderer->Draw(ctx);
+					}
 					ctx.Clear();
 				}
+				m_FrustumCuller.ReportStats();
 			}
 
 			{
 				MGN_PROFILE_SCOPE("Physics Rendering");
-				DrawContext ctx;
-				if (!PhysicsDebugRenderer::s_Lines.empty()) {
-					ctx.OpaqueLines = std::move(PhysicsDebugRenderer::s_Lines);
-				}
-				if (!PhysicsDebugRenderer::s_Vertices.empty()) {
-					Scope<CPUMesh> mesh = CreateScope<CPUMesh>(std::move(PhysicsDebugRenderer::s_Vertices));
-					mesh->Lods.emplace_back(0, (uint32_t) mesh->Indices.size(), NULL_ASSET_HANDLE);
-					mesh->gpu = m_Renderer->LoadMesh(*mesh);
-					ctx.OpaqueSurfaces.emplace_back(Math::Identity<Mat4>(), mesh->gpu);
+				StageTimer timer{m_FrameTimings.raster};
+				DrawContext &ctx = m_PhysicsContext;
+				ctx.Reset();
+				// The debug geometry is given as is, the renderer copies it once to the GPU.
+				ctx.DebugLines = PhysicsDebugRenderer::s_Lines.GetVertices();
+				ctx.DebugTriangles = PhysicsDebugRenderer::s_Triangles.GetVertices();
+				if (!ctx.DebugLines.empty() || !ctx.DebugTriangles.empty()) {
+					m_Renderer->Draw(ctx);
 				}
-				m_Renderer->Draw(ctx);
+				ctx.Clear();
+				PhysicsDebugRenderer::s_Lines.Reset();
+				PhysicsDebugRenderer::s_Triangles.Reset();
 			}
 
+			MGN_PROFILE_PLOT("Frame Arena Allocations", m_SceneContext.GetAllocationCount() + m_PhysicsContext.GetAllocationCount());
+			MGN_PROFILE_PLOT("Frame Arena Heap Allocations", m_SceneContext.GetHeapAllocationCount() + m_PhysicsContext.GetHeapAllocationCount());
+			MGN_PROFILE_PLOT("Frame Arena Used Size", m_SceneContext.GetUsedSize() + m_PhysicsContext.GetUsedSize());
+
+			const DrawStats &drawStats = m_Renderer->GetDrawStats();
+			MGN_PROFILE_PLOT("Draws", drawStats.draws);
+			MGN_PROFILE_PLOT("Instances", drawStats.instances);
+			MGN_PROFILE_PLOT("Pipeline Binds", drawStats.pipelineBinds);
+			MGN_PROFILE_PLOT("Descriptor Set Binds", drawStats.descriptorSetBinds);
+			MGN_PROFILE_PLOT("Index Buffer Binds", drawStats.indexBufferBinds);
+			MGN_PROFILE_PLOT("Material Lookups", drawStats.materialLookups);
+			MGN_PROFILE_PLOT("Buffer Allocations", drawStats.bufferAllocations);
+
+			StageTimer timer{m_FrameTimings.present};
 			m_Renderer->EndDraw();
 
 #ifdef MGN_IMGUI
@@ -0,0 +1,122 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Application/FrameCapture.hpp"
+
+#include "Imagine/Rendering/Camera.hpp"
+#include "Imagine/Rendering/Renderer.hpp"
+#include "Imagine/ThirdParty/Stb.hpp"
+
+namespace Imagine {
+
+	namespace {
+		struct Stage {
+			const char *name;
+			double FrameTimings::*value;
+		};
+
+		constexpr Stage c_Stages[] = {
+				{"extraction", &FrameTimings::extraction},
+				{"culling", &FrameTimings::culling},
+				{"raster", &FrameTimings::raster},
+				{"present", &FrameTimings::present},
+				{"frame", &FrameTimings::frame},
+		};
+	} // namespace
+
+	FrameCapture::FrameCapture(CaptureParameters parameters) :
+		m_Parameters(std::move(parameters)) {
+		m_Frames.reserve(m_Parameters.FrameCount);
+	}
+
+	void FrameCapture::PlaceCamera(const uint64_t frame, Camera &camera) const {
+		if (m_Parameters.CameraPath.empty()) return;
+		const CameraKey key = Evaluate(m_Parameters.CameraPath, static_cast<Real>(static_cast<double>(frame) * m_Parameters.TimeStep));
+		camera.position = key.Position;
+		camera.pitch = key.Pitch;
+		camera.yaw = key.Yaw;
+		camera.velocity = Vec3{0};
+		camera.pitchVelocity = 0;
+		camera.yawVelocity = 0;
+	}
+
+	void FrameCapture::Record(const FrameTimings &timings) {
+		m_Frames.push_back(timings);
+	}
+
+	bool FrameCapture::Write(Renderer &renderer) const {
+		MGN_PROFILE_FUNCTION();
+		bool success = true;
+
+		Image<uint8_t> image;
+		if (renderer.ReadColor(image) && ThirdParty::Stb::Image::WritePng(m_Parameters.ImagePath.string().c_str(), image)) {
+			MGN_CORE_INFO("Captured frame {} written to '{}'.", m_Frames.size(), m_Parameters.ImagePath.string());
+		}
+		else {
+			MGN_CORE_ERROR("Failed to write the captured frame to '{}'.", m_Parameters.ImagePath.string());
+			success = false;
+		}
+
+		std::ofstream timings(m_Parameters.TimingsPath);
+		if (timings.is_open()) {
+			timings << TimingsToJson(image.width, image.height);
+		}
+		else {
+			MGN_CORE_ERROR("Failed to write the frame timings to '{}'.", m_Parameters.TimingsPath.string());
+			success = false;
+		}
+
+		return success;
+	}
+
+	CameraKey FrameCapture::Evaluate(const std::vector<CameraKey> &path, const Real time) {
+		if (path.empty()) return {};
+		if (time <= path.front().Time) return path.front();
+		if (time >= path.back().Time) return path.back();
+
+		const auto next = std::upper_bound(path.begin(), path.end(), time, [](const Real t, const CameraKey &key) { return t < key.Time; });
+		const CameraKey &from = *(next - 1);
+		const CameraKey &to = *next;
+		const Real duration = to.Time - from.Time;
+		const Real t = duration > 0 ? (time - from.Time) / duration : Real(1);
+
+		CameraKey key;
+		key.Time = time;
+		key.Position = glm::mix(from.Position, to.Position, t);
+		key.Pitch = glm::mix(from.Pitch, to.Pitch, static_cast<float>(t));
+		key.Yaw = glm::mix(from.Yaw, to.Yaw, static_cast<float>(t));
+		return key;
+	}
+
+	std::string FrameCapture::TimingsToJson(const uint32_t width, const uint32_t height) const {
+		std::string json = fmt::format("{{\n\t\"frameCount\": {},\n\t\"timeStep\": {},\n\t\"width\": {},\n\t\"height\": {},\n\t\"stages\": {{", m_Frames.size(), m_Parameters.TimeStep, width, height);
+
+		for (uint32_t i = 0; i < std::size(c_Stages); ++i) {
+			const Stage &stage = c_Stages[i];
+			double total = 0;
+			double min = m_Frames.empty() ? 0 : std::numeric_limits<double>::max();
+			double max = 0;
+			for (const FrameTimings &frame: m_Frames) {
+				const double value = frame.*stage.value;
+				total += value;
+				min = std::min(min, value);
+				max = std::max(max, value);
+			}
+			const double mean = m_Frames.empty() ? 0 : total / static_cast<double>(m_Frames.size());
+			json += fmt::format("{}\n\t\t\"{}\": {{\"mean\": {:.4f}, \"min\": {:.4f}, \"max\": {:.4f}}}", i ? "," : "", stage.name, mean, min, max);
+		}
+
+		json += "\n\t},\n\t\"frames\": [";
+		for (size_t f = 0; f < m_Frames.size(); ++f) {
+			json += f ? ",\n\t\t{" : "\n\t\t{";
+			for (uint32_t i = 0; i < std::size(c_Stages); ++i) {
+				json += fmt::format("{}\"{}\": {:.4f}", i ? ", " : "", c_Stages[i].name, m_Frames[f].*c_Stages[i].value);
+			}
+			json += "}";
+		}
+		json += "\n\t]\n}\n";
+		return json;
+	}
+
+} // namespace Imagine
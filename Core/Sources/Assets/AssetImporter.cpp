@@ -49,6 +49,12 @@ namespace Imagine
 		return asset;
 	}
 
+	void AssetImporter::RegisterImporter(const AssetType type, AssetImportFunction importer)
+	{
+		if(importer) AssetLoaders[type] = std::move(importer);
+		else AssetLoaders.erase(type);
+	}
+
 	AssetType AssetImporter::GetAssetType(const Path &path)
 	{
 		MGN_PROFILE_FUNCTION();
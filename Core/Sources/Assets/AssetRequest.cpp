@@ -0,0 +1,34 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Imagine/Assets/AssetRequest.hpp"
+
+namespace Imagine {
+
+	const char *AssetLoadStateToString(const AssetLoadState state) {
+		switch (state) {
+			case AssetLoadState::Pending: return "Pending";
+			case AssetLoadState::Loading: return "Loading";
+			case AssetLoadState::Ready: return "Ready";
+			case AssetLoadState::Failed: return "Failed";
+		}
+		return "Unknown";
+	}
+
+	void AssetRequest::Wait() const {
+		if (IsDone()) return;
+		std::unique_lock lock(m_Mutex);
+		m_Condition.wait(lock, [this]() { return IsDone(); });
+	}
+
+	void AssetRequest::Complete(Ref<Asset> asset) {
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_Asset = std::move(asset);
+			m_State.store(m_Asset ? AssetLoadState::Ready : AssetLoadState::Failed, std::memory_order_release);
+		}
+		m_Condition.notify_all();
+	}
+
+} // namespace Imagine
@@ -10,6 +10,15 @@
 #include "Imagine/ThirdParty/YamlCpp.hpp"
 
 namespace Imagine {
+	namespace {
+		/// The manager owning the streaming worker running on this thread, if any.
+		thread_local FileAssetManager *t_StreamingManager{nullptr};
+	} // namespace
+
+	FileAssetManager::~FileAssetManager() {
+		StopStreaming();
+	}
+
 	bool FileAssetManager::IsAssetHandleValid(AssetHandle handle) const {
 		MGN_PROFILE_FUNCTION();
 		return handle && (m_AssetRegistry.contains(handle) || m_MemoryAssets.contains(handle));
@@ -21,15 +30,34 @@ namespace Imagine {
 	}
 
 	bool FileAssetManager::IsAssetImported(const Path &path, AssetHandle *handle /* = nullptr*/) const {
-		auto it = std::find_if(m_AssetRegistry.begin(), m_AssetRegistry.end(), [&path](std::pair<AssetHandle, AssetMetadata> assets) {
-			return assets.second.FilePath.equivalent(path);
-		});
+		MGN_PROFILE_FUNCTION();
+		const std::optional<AssetHandle> found = FindHandle(path);
+
+		if (handle && found) {
+			*handle = *found;
+		}
 
-		if (handle && it != m_AssetRegistry.end()) {
-			*handle = it->first;
+		return found.has_value();
+	}
+
+	bool FileAssetManager::Register(const AssetMetadata &metadata) {
+		if (!m_AssetRegistry.emplace(metadata.Handle, metadata).second) return false;
+		// When two handles share a path, the first one registered stays the one found by path.
+		m_PathIndex.emplace(metadata.FilePath.normalized(), metadata.Handle);
+		return true;
+	}
+
+	void FileAssetManager::Unregister(const AssetRegistryIterator it) {
+		const auto index_it = m_PathIndex.find(it->second.FilePath.normalized());
+		if (index_it != m_PathIndex.end() && index_it->second == it->first) {
+			m_PathIndex.erase(index_it);
 		}
+		m_AssetRegistry.erase(it);
+	}
 
-		return it != m_AssetRegistry.end();
+	std::optional<AssetHandle> FileAssetManager::FindHandle(const Path &path) const {
+		const auto it = m_PathIndex.find(path.normalized());
+		return it != m_PathIndex.end() ? it->second : std::optional<AssetHandle>{std::nullopt};
 	}
 
 	Ref<Asset> FileAssetManager::GetAsset(AssetHandle handle) {
@@ -43,6 +71,12 @@ namespace Imagine {
 		if (IsAssetLoaded(handle)) {
 			asset = GetLoadedAsset(handle);
 		}
+		else if (const auto request_it = m_Requests.find(handle); request_it != m_Requests.end()) {
+			// The asset is already being imported in the background, no need to import it twice.
+			request_it->second->Wait();
+			asset = request_it->second->GetAsset();
+			UpdateRequests();
+		}
 		else {
 			const auto &metadata = GetMetadata(handle);
 			asset = AssetImporter::ImportAsset(metadata);
@@ -58,6 +92,9 @@ namespace Imagine {
 	}
 
 	bool FileAssetManager::LoadAsset(AssetHandle handle) {
+		if (m_Requests.contains(handle)) {
+			return GetAsset(handle) != nullptr;
+		}
 		if (!IsAssetLoaded(handle)) {
 			const auto &metadata = GetMetadata(handle);
 			if (auto asset = AssetImporter::ImportAsset(metadata)) {
@@ -98,7 +135,7 @@ namespace Imagine {
 
 		if (asset) {
 			m_LoadedAssets[metadata.Handle] = asset;
-			m_AssetRegistry[metadata.Handle] = metadata;
+			Register(metadata);
 			// TODO: Save asset manager.
 		}
 
@@ -110,23 +147,39 @@ namespace Imagine {
 
 		Ref<Asset> asset = nullptr;
 
-		const auto it = std::find_if(m_AssetRegistry.begin(), m_AssetRegistry.end(), [&assetPath](const std::pair<AssetHandle, AssetMetadata> &assets) {
-			return assets.second.FilePath.equivalent(assetPath);
-		});
+		const std::optional<AssetHandle> handle = FindHandle(assetPath);
 
-		if (it == m_AssetRegistry.end()) {
+		if (!handle) {
 			asset = ImportAsset(assetPath);
 		}
 		else {
-			asset = GetAsset(it->first);
-			if (hint != AssetType::None && hint != asset->GetType()) {
-				MGN_CORE_WARN("Asset '{}'({}) has type '{}', but the expected type is '{}'.", assetPath.string(), it->first.string(), AssetTypeToString(asset->GetType()), AssetTypeToString(hint));
+			asset = GetAsset(*handle);
+			if (asset && hint != AssetType::None && hint != asset->GetType()) {
+				MGN_CORE_WARN("Asset '{}'({}) has type '{}', but the expected type is '{}'.", assetPath.string(), handle->string(), AssetTypeToString(asset->GetType()), AssetTypeToString(hint));
 			}
 		}
 
 		return asset;
 	}
 
+	AssetHandle FileAssetManager::RegisterAssetPath(const Path &assetPath, const AssetType hint /* = AssetType::None*/) {
+		MGN_PROFILE_FUNCTION();
+		if (const std::optional<AssetHandle> handle = FindHandle(assetPath)) {
+			return *handle;
+		}
+
+		if (!FileSystem::Exist(assetPath) || AssetImporter::GetAssetType(assetPath) == AssetType::None) {
+			return NULL_ASSET_HANDLE;
+		}
+
+		AssetMetadata metadata;
+		metadata.FilePath = assetPath;
+		metadata.Type = AssetImporter::HasAssetType(assetPath, hint) ? hint : AssetImporter::GetAssetType(assetPath);
+		Register(metadata);
+		// TODO: Save asset manager.
+		return metadata.Handle;
+	}
+
 	Path FileAssetManager::GetFilePath(const AssetHandle handle) const {
 		return GetMetadata(handle).FilePath;
 	}
@@ -143,11 +196,8 @@ namespace Imagine {
 
 	std::optional<AssetMetadata> FileAssetManager::GetMetadata(const Path &assetPath) const {
 		MGN_PROFILE_FUNCTION();
-		auto it = std::find_if(m_AssetRegistry.begin(), m_AssetRegistry.end(), [&assetPath](std::pair<AssetHandle, AssetMetadata> assets) {
-			return assets.second.FilePath == assetPath;
-		});
-
-		return it != m_AssetRegistry.end() ? it->second : std::optional<AssetMetadata>{std::nullopt};
+		const std::optional<AssetHandle> handle = FindHandle(assetPath);
+		return handle ? GetMetadata(*handle) : std::optional<AssetMetadata>{std::nullopt};
 	}
 
 	void FileAssetManager::SetPath(AssetHandle handle, Path newPath) {
@@ -155,7 +205,10 @@ namespace Imagine {
 
 		auto it = m_AssetRegistry.find(handle);
 		if (it != m_AssetRegistry.end()) {
-			it->second.FilePath = newPath;
+			AssetMetadata metadata = it->second;
+			metadata.FilePath = std::move(newPath);
+			Unregister(it);
+			Register(metadata);
 			// TODO: Save asset manager.
 		}
 	}
@@ -163,6 +216,12 @@ namespace Imagine {
 	bool FileAssetManager::AddAsset(Ref<Asset> asset) {
 		MGN_PROFILE_FUNCTION();
 		if (!asset) return false;
+		if (t_StreamingManager == this) {
+			// Called by an importer on a streaming worker, the asset is added on the main thread by 'UpdateRequests'.
+			std::scoped_lock lock(m_StreamingMutex);
+			m_StreamedMemoryAssets.push_back(std::move(asset));
+			return true;
+		}
 		m_MemoryAssets.emplace(asset->Handle, asset);
 		return true;
 	}
@@ -174,7 +233,7 @@ namespace Imagine {
 		metadata.Handle = asset->Handle;
 		metadata.FilePath = path;
 		metadata.Type = asset->GetType();
-		m_AssetRegistry.emplace(metadata.Handle, metadata);
+		Register(metadata);
 		m_LoadedAssets.emplace(metadata.Handle, asset);
 		// TODO: Save asset manager.
 		return true;
@@ -194,7 +253,7 @@ namespace Imagine {
 		metadata.Type = asset->GetType();
 
 		m_MemoryAssets.erase(it);
-		m_AssetRegistry.emplace(metadata.Handle, metadata);
+		Register(metadata);
 		m_LoadedAssets.emplace(metadata.Handle, asset);
 		// TODO: Save asset manager.
 		return true;
@@ -204,6 +263,8 @@ namespace Imagine {
 		MGN_PROFILE_FUNCTION();
 		if (!IsAssetHandleValid(handle)) return false;
 
+		m_Requests.erase(handle);
+
 		auto loaded_it = m_LoadedAssets.find(handle);
 		if (loaded_it != m_LoadedAssets.end()) {
 			m_LoadedAssets.erase(loaded_it);
@@ -216,7 +277,7 @@ namespace Imagine {
 
 		auto registry_it = m_AssetRegistry.find(handle);
 		if (registry_it != m_AssetRegistry.end()) {
-			m_AssetRegistry.erase(registry_it);
+			Unregister(registry_it);
 		}
 
 		// TODO: Save asset manager.
@@ -227,6 +288,9 @@ namespace Imagine {
 		MGN_PROFILE_FUNCTION();
 		if (!IsAssetHandleValid(handle)) return;
 
+		// A request still loading is dropped, its result is ignored by 'UpdateRequests'.
+		m_Requests.erase(handle);
+
 		auto loaded_it = m_LoadedAssets.find(handle);
 		if (loaded_it != m_LoadedAssets.end()) {
 			if(loaded_it->second->GetType() == AssetType::Model) {
@@ -275,6 +339,172 @@ namespace Imagine {
 		return nullptr;
 	}
 
+	Ref<Asset> FileAssetManager::FindLoadedAsset(const AssetHandle handle) const {
+		if (const auto it = m_LoadedAssets.find(handle); it != m_LoadedAssets.end()) {
+			return it->second;
+		}
+		if (const auto it = m_MemoryAssets.find(handle); it != m_MemoryAssets.end()) {
+			return it->second;
+		}
+		return nullptr;
+	}
+
+	// ===== Streaming =====
+
+	Ref<AssetRequest> FileAssetManager::RequestAsset(const AssetHandle handle, const AssetLoadPriority priority /* = AssetLoadPriority::Normal*/) {
+		MGN_PROFILE_FUNCTION();
+		if (Ref<Asset> asset = FindLoadedAsset(handle)) {
+			Ref<AssetRequest> request = CreateRef<AssetRequest>(handle, priority);
+			request->Complete(std::move(asset));
+			return request;
+		}
+
+		if (const auto it = m_Requests.find(handle); it != m_Requests.end()) {
+			const Ref<AssetRequest> &request = it->second;
+			if (priority > request->GetPriority() && request->GetState() == AssetLoadState::Pending) {
+				// The previous entry stays in the queue, the worker popping it skips it once the request is loading.
+				std::scoped_lock lock(m_StreamingMutex);
+				request->m_Priority.store(priority, std::memory_order_relaxed);
+				m_StreamingQueue.push({request, GetMetadata(handle), priority, m_StreamingSequence++});
+				m_StreamingCondition.notify_one();
+			}
+			return request;
+		}
+
+		Ref<AssetRequest> request = CreateRef<AssetRequest>(handle, priority);
+		const auto registry_it = m_AssetRegistry.find(handle);
+		if (registry_it == m_AssetRegistry.end()) {
+			MGN_CORE_ERROR("Cannot request the asset {0}, it isn't registered.", handle.string());
+			request->Complete(nullptr);
+			return request;
+		}
+
+		StartStreaming();
+		m_Requests.emplace(handle, request);
+		{
+			std::scoped_lock lock(m_StreamingMutex);
+			m_StreamingQueue.push({request, registry_it->second, priority, m_StreamingSequence++});
+		}
+		m_StreamingCondition.notify_one();
+		return request;
+	}
+
+	Ref<Asset> FileAssetManager::TryGetAsset(const AssetHandle handle, const AssetLoadPriority priority /* = AssetLoadPriority::Normal*/) {
+		MGN_PROFILE_FUNCTION();
+		if (Ref<Asset> asset = FindLoadedAsset(handle)) {
+			return asset;
+		}
+		if (!m_AssetRegistry.contains(handle)) return nullptr;
+
+		const Ref<AssetRequest> request = RequestAsset(handle, priority);
+		if (!request->IsReady()) return nullptr;
+
+		UpdateRequests();
+		return request->GetAsset();
+	}
+
+	void FileAssetManager::UpdateRequests() {
+		MGN_PROFILE_FUNCTION();
+		std::vector<Ref<Asset>> memoryAssets;
+		std::vector<Ref<AssetRequest>> completed;
+		{
+			std::scoped_lock lock(m_StreamingMutex);
+			if (m_CompletedRequests.empty() && m_StreamedMemoryAssets.empty()) return;
+			memoryAssets.swap(m_StreamedMemoryAssets);
+			completed.swap(m_CompletedRequests);
+		}
+
+		for (Ref<Asset> &asset: memoryAssets) {
+			AddAsset(std::move(asset));
+		}
+
+		for (const Ref<AssetRequest> &request: completed) {
+			const auto it = m_Requests.find(request->GetHandle());
+			// The asset was unloaded or removed while it was loading.
+			if (it == m_Requests.end() || it->second != request) continue;
+
+			// Failed requests are kept so the asset isn't imported again every frame.
+			if (request->IsReady()) {
+				m_LoadedAssets.emplace(request->GetHandle(), request->m_Asset);
+				m_Requests.erase(it);
+			}
+		}
+	}
+
+	void FileAssetManager::SetStreamingWorkerCount(const uint32_t count) {
+		if (!m_StreamingWorkers.empty()) {
+			MGN_CORE_WARNING("The streaming workers are already running, the new worker count is ignored.");
+			return;
+		}
+		m_StreamingWorkerCount = std::max(count, 1u);
+	}
+
+	void FileAssetManager::StartStreaming() {
+		if (!m_StreamingWorkers.empty()) return;
+
+		{
+			std::scoped_lock lock(m_StreamingMutex);
+			m_StreamingRunning = true;
+		}
+		m_StreamingWorkers.reserve(m_StreamingWorkerCount);
+		for (uint32_t i = 0; i < m_StreamingWorkerCount; ++i) {
+			m_StreamingWorkers.emplace_back(&FileAssetManager::StreamingLoop, this);
+		}
+	}
+
+	void FileAssetManager::StopStreaming() {
+		if (m_StreamingWorkers.empty()) return;
+
+		{
+			std::scoped_lock lock(m_StreamingMutex);
+			m_StreamingRunning = false;
+		}
+		m_StreamingCondition.notify_all();
+		for (std::thread &worker: m_StreamingWorkers) {
+			worker.join();
+		}
+		m_StreamingWorkers.clear();
+
+		// Nobody must be left waiting on a request that will never be loaded.
+		while (!m_StreamingQueue.empty()) {
+			const Ref<AssetRequest> request = m_StreamingQueue.top().request;
+			m_StreamingQueue.pop();
+			if (request->GetState() == AssetLoadState::Pending) {
+				request->Complete(nullptr);
+			}
+		}
+	}
+
+	void FileAssetManager::StreamingLoop() {
+		t_StreamingManager = this;
+		while (true) {
+			QueuedRequest queued;
+			{
+				std::unique_lock lock(m_StreamingMutex);
+				m_StreamingCondition.wait(lock, [this]() { return !m_StreamingRunning || !m_StreamingQueue.empty(); });
+				if (!m_StreamingRunning) break;
+
+				queued = m_StreamingQueue.top();
+				m_StreamingQueue.pop();
+
+				// A request whose priority was raised is queued more than once, only the first entry loads it.
+				AssetLoadState expected = AssetLoadState::Pending;
+				if (!queued.request->m_State.compare_exchange_strong(expected, AssetLoadState::Loading, std::memory_order_acq_rel)) continue;
+			}
+
+			Ref<Asset> asset = AssetImporter::ImportAsset(queued.metadata);
+			if (!asset) {
+				MGN_CORE_ERROR("Could not load the asset {0}", queued.metadata.Handle.string());
+			}
+
+			// The request is completed under the lock so 'UpdateRequests' always finds a ready request in the completed list.
+			std::scoped_lock lock(m_StreamingMutex);
+			m_CompletedRequests.push_back(queued.request);
+			queued.request->Complete(std::move(asset));
+		}
+		t_StreamingManager = nullptr;
+	}
+
 } // namespace Imagine
 
 namespace Imagine {
@@ -310,7 +540,7 @@ namespace Imagine {
 		if (auto assetsNodes = node["Assets"]) {
 			for (auto metadataNode: assetsNodes) {
 				auto metadata = metadataNode.as<AssetMetadata>();
-				manager->m_AssetRegistry[metadata.Handle] = metadata;
+				manager->Register(metadata);
 			}
 			return std::move(manager);
 		}
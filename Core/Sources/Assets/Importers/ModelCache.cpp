@@ -0,0 +1,391 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Imagine/Assets/Importers/ModelCache.hpp"
+
+#include "Imagine/Core/FileSystem.hpp"
+#include "Imagine/Core/Hash.hpp"
+#include "Imagine/Core/MappedFile.hpp"
+#include "Imagine/Rendering/CPU/CPUMaterialInstance.hpp"
+
+namespace Imagine {
+
+	namespace {
+		static_assert(std::is_trivially_copyable_v<Vertex>);
+		static_assert(std::is_trivially_copyable_v<LOD>);
+		static_assert(std::is_trivially_copyable_v<AssetHandle>);
+		static_assert(std::is_trivially_copyable_v<Light>);
+
+		struct ModelCacheHeader {
+			uint32_t magic{ModelCache::c_Magic};
+			uint32_t version{ModelCache::c_Version};
+			uint64_t key{0};
+		};
+
+		/// Everything that changes the content of the cooked file without changing the source.
+		struct ModelCacheSettings {
+			uint32_t version{ModelCache::c_Version};
+			uint32_t importSettings{0};
+			uint32_t vertexSize{sizeof(Vertex)};
+			uint32_t lodSize{sizeof(LOD)};
+		};
+
+		enum class CachedMaterial : uint8_t {
+			DefaultOpaque,
+			DefaultTransparent,
+			Handle,
+		};
+
+		class ModelCacheWriter {
+		public:
+			template<typename T>
+			void Write(const T &value) {
+				static_assert(std::is_trivially_copyable_v<T>);
+				Write(&value, sizeof(T));
+			}
+
+			void Write(const void *data, const uint64_t size) {
+				if (size == 0) return;
+				m_Bytes.insert(m_Bytes.end(), static_cast<const uint8_t *>(data), static_cast<const uint8_t *>(data) + size);
+			}
+
+			template<typename T>
+			void WriteArray(const T *data, const uint64_t count) {
+				static_assert(std::is_trivially_copyable_v<T>);
+				Write<uint64_t>(count);
+				Write(data, sizeof(T) * count);
+			}
+
+			template<typename T>
+			void WriteArray(const std::vector<T> &data) { WriteArray(data.data(), data.size()); }
+
+			void WriteString(const std::string &str) { WriteArray(str.data(), str.size()); }
+
+			[[nodiscard]] ConstBufferView GetView() const { return ConstBufferView{m_Bytes.data(), m_Bytes.size()}; }
+
+		private:
+			std::vector<uint8_t> m_Bytes;
+		};
+
+		/// Read the file sequentially. Every read is bound checked, once a read failed all the following ones fail.
+		class ModelCacheReader {
+		public:
+			explicit ModelCacheReader(const ConstBufferView view) :
+				m_Data(static_cast<const uint8_t *>(view.Get())), m_Size(view.Size()) {}
+
+			[[nodiscard]] bool IsValid() const { return m_Valid; }
+
+			bool Read(void *data, const uint64_t size) {
+				if (!m_Valid || size > m_Size - m_Offset) {
+					m_Valid = false;
+					return false;
+				}
+				if (size) memcpy(data, m_Data + m_Offset, size);
+				m_Offset += size;
+				return true;
+			}
+
+			template<typename T>
+			T Read() {
+				static_assert(std::is_trivially_copyable_v<T>);
+				T value{};
+				Read(&value, sizeof(T));
+				return value;
+			}
+
+			template<typename T>
+			bool ReadArray(std::vector<T> &data) {
+				static_assert(std::is_trivially_copyable_v<T>);
+				const uint64_t count = Read<uint64_t>();
+				if (!m_Valid || count > (m_Size - m_Offset) / std::max<uint64_t>(sizeof(T), 1)) {
+					m_Valid = false;
+					return false;
+				}
+				data.resize(count);
+				return Read(data.data(), sizeof(T) * count);
+			}
+
+			std::string ReadString() {
+				std::vector<char> chars;
+				ReadArray(chars);
+				return {chars.begin(), chars.end()};
+			}
+
+		private:
+			const uint8_t *m_Data;
+			uint64_t m_Size;
+			uint64_t m_Offset{0};
+			bool m_Valid{true};
+		};
+
+		void WriteSetEditions(ModelCacheWriter &writer, const std::map<CPUMaterialInstance::SetFieldPosition, CPUMaterialInstance::MaterialDataBuffer> &editions) {
+			writer.Write<uint64_t>(editions.size());
+			for (const auto &[position, buffer]: editions) {
+				writer.Write(position);
+				writer.Write(buffer);
+			}
+		}
+
+		void WritePushConstantEditions(ModelCacheWriter &writer, const std::map<CPUMaterialInstance::PushConstantFieldPosition, CPUMaterialInstance::MaterialDataBuffer> &editions) {
+			writer.Write<uint64_t>(editions.size());
+			for (const auto &[position, buffer]: editions) {
+				writer.Write(position);
+				writer.Write(buffer);
+			}
+		}
+
+		/// The fields of an instance referencing a texture of the model hold its handle, which is replaced by the new one.
+		void RemapHandle(CPUMaterialInstance::MaterialDataBuffer &buffer, const std::unordered_map<AssetHandle, AssetHandle> &handles) {
+			AssetHandle handle{NULL_ASSET_HANDLE};
+			memcpy(&handle, buffer.data(), sizeof(AssetHandle));
+			if (const auto it = handles.find(handle); it != handles.end()) {
+				memcpy(buffer.data(), &it->second, sizeof(AssetHandle));
+			}
+		}
+	} // namespace
+
+	uint64_t ModelCache::ComputeKey(const std::filesystem::path &sourcePath, const uint32_t importSettings) {
+		MGN_PROFILE_FUNCTION();
+		MappedFile file;
+		if (!file.Open(sourcePath)) return 0;
+
+		const ModelCacheSettings settings{c_Version, importSettings};
+		const uint64_t key = Hasher::xxHash64(file.GetView(), Hasher::xxHash64T(settings));
+		// 0 is kept for the missing files.
+		return key ? key : 1;
+	}
+
+	std::filesystem::path ModelCache::GetCachePath(const std::filesystem::path &sourcePath) {
+		const std::string normalized = std::filesystem::absolute(sourcePath).lexically_normal().generic_string();
+		return FileSystem::GetRootPath(FileSource::Cache) / "Models" / fmt::format("{:016x}{}", Hasher::xxHash64(normalized.c_str()), c_Extension);
+	}
+
+	bool ModelCache::Write(const CPUModel &model, const uint64_t key, const std::filesystem::path &cachePath) {
+		MGN_PROFILE_FUNCTION();
+		ModelCacheWriter writer;
+		writer.Write(ModelCacheHeader{c_Magic, c_Version, key});
+
+		// Shaders, only the file shaders can be cooked.
+		{
+			std::vector<const CPUFileShader *> shaders;
+			for (const Ref<CPUShader> &shader: model.Shaders) {
+				if (const auto *fileShader = dynamic_cast<const CPUFileShader *>(shader.get())) {
+					shaders.push_back(fileShader);
+				}
+				else {
+					MGN_CORE_WARNING("The shader '{}' of the model isn't a file, it won't be cooked.", shader ? shader->GetName() : "null");
+				}
+			}
+			writer.Write<uint64_t>(shaders.size());
+			for (const CPUFileShader *shader: shaders) {
+				writer.Write(shader->Handle);
+				writer.Write(shader->stage);
+				writer.Write(shader->path.source);
+				writer.WriteString(shader->path.path.generic_string());
+			}
+		}
+
+		// Textures, already decoded.
+		writer.Write<uint64_t>(model.Textures.size());
+		for (const Ref<CPUTexture2D> &texture: model.Textures) {
+			const Image<uint8_t> &image = texture->image;
+			writer.Write(texture->Handle);
+			writer.Write(image.width);
+			writer.Write(image.height);
+			writer.Write(image.channels);
+			writer.WriteArray(static_cast<const uint8_t *>(image.source.Get()), image.source.Size());
+		}
+
+		// Material instances.
+		const AssetHandle opaque = CPUMaterial::GetDefaultOpaque() ? CPUMaterial::GetDefaultOpaque()->Handle : NULL_ASSET_HANDLE;
+		const AssetHandle transparent = CPUMaterial::GetDefaultTransparent() ? CPUMaterial::GetDefaultTransparent()->Handle : NULL_ASSET_HANDLE;
+		writer.Write<uint64_t>(model.Instances.size());
+		for (const Ref<CPUMaterialInstance> &instance: model.Instances) {
+			writer.Write(instance->Handle);
+			if (instance->Material == opaque) writer.Write(CachedMaterial::DefaultOpaque);
+			else if (instance->Material == transparent) writer.Write(CachedMaterial::DefaultTransparent);
+			else writer.Write(CachedMaterial::Handle);
+			writer.Write(instance->Material);
+			WriteSetEditions(writer, instance->SetEditions);
+			WritePushConstantEditions(writer, instance->PushConstantEditions);
+		}
+
+		// Meshes.
+		std::unordered_map<const CPUMesh *, uint32_t> meshIndices;
+		writer.Write<uint64_t>(model.Meshes.size());
+		for (const Ref<CPUMesh> &mesh: model.Meshes) {
+			meshIndices.emplace(mesh.get(), static_cast<uint32_t>(meshIndices.size()));
+			writer.Write(mesh->Handle);
+			writer.WriteString(mesh->Name);
+			writer.Write(mesh->Layout);
+			writer.WriteArray(mesh->Vertices);
+			writer.WriteArray(mesh->Indices);
+			writer.WriteArray(mesh->Lods);
+		}
+
+		// Nodes.
+		writer.Write<uint64_t>(model.RootNode);
+		writer.Write<uint64_t>(model.Nodes.size());
+		std::vector<uint32_t> nodeMeshes;
+		for (const CPUModel::Node &node: model.Nodes) {
+			writer.WriteString(node.name);
+			nodeMeshes.clear();
+			for (const Weak<CPUMesh> &mesh: node.meshes) {
+				const Ref<CPUMesh> lock = mesh.lock();
+				const auto it = lock ? meshIndices.find(lock.get()) : meshIndices.end();
+				if (it != meshIndices.end()) nodeMeshes.push_back(it->second);
+			}
+			writer.WriteArray(nodeMeshes);
+			writer.Write<uint8_t>(node.light.has_value());
+			writer.Write(node.light.value_or(Light{}));
+			writer.Write(node.worldMatrix);
+			writer.Write(node.LocalRotation);
+			writer.Write(node.LocalPosition);
+			writer.Write(node.LocalScale);
+			writer.Write<uint64_t>(node.parent.value_or(std::numeric_limits<uint64_t>::max()));
+			writer.WriteArray(node.children);
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(cachePath.parent_path(), error);
+		if (!FileSystem::WriteBinaryFile(cachePath, writer.GetView())) {
+			MGN_CORE_ERROR("Could not write the cooked model '{}'.", cachePath.string());
+			return false;
+		}
+		return true;
+	}
+
+	Ref<CPUModel> ModelCache::Read(const std::filesystem::path &cachePath, const uint64_t key) {
+		MGN_PROFILE_FUNCTION();
+		if (key == 0) return nullptr;
+
+		MappedFile file;
+		if (!std::filesystem::exists(cachePath) || !file.Open(cachePath)) return nullptr;
+
+		ModelCacheReader reader{file.GetView()};
+		const auto header = reader.Read<ModelCacheHeader>();
+		if (!reader.IsValid() || header.magic != c_Magic || header.version != c_Version || header.key != key) return nullptr;
+
+		Ref<CPUModel> model = CreateRef<CPUModel>();
+		// Old handle to new handle, so the assets of two loads of the same model don't share their handles.
+		std::unordered_map<AssetHandle, AssetHandle> handles;
+
+		const uint64_t shaderCount = reader.Read<uint64_t>();
+		for (uint64_t i = 0; i < shaderCount && reader.IsValid(); ++i) {
+			const auto handle = reader.Read<AssetHandle>();
+			const auto stage = reader.Read<ShaderStage>();
+			const auto source = reader.Read<FileSource>();
+			Ref<CPUFileShader> shader = CreateRef<CPUFileShader>(stage, Path{source, reader.ReadString()});
+			handles.emplace(handle, shader->Handle);
+			model->Shaders.push_back(std::move(shader));
+		}
+
+		const uint64_t textureCount = reader.Read<uint64_t>();
+		for (uint64_t i = 0; i < textureCount && reader.IsValid(); ++i) {
+			const auto handle = reader.Read<AssetHandle>();
+			const auto width = reader.Read<uint32_t>();
+			const auto height = reader.Read<uint32_t>();
+			const auto channels = reader.Read<uint32_t>();
+			const uint64_t size = reader.Read<uint64_t>();
+			if (!reader.IsValid() || size != static_cast<uint64_t>(width) * height * channels) return nullptr;
+
+			Ref<CPUTexture2D> texture = CreateRef<CPUTexture2D>();
+			texture->image.Allocate(width, height, channels);
+			reader.Read(texture->image.source.Get(), size);
+			handles.emplace(handle, texture->Handle);
+			model->Textures.push_back(std::move(texture));
+		}
+
+		const uint64_t instanceCount = reader.Read<uint64_t>();
+		for (uint64_t i = 0; i < instanceCount && reader.IsValid(); ++i) {
+			const auto handle = reader.Read<AssetHandle>();
+			const auto material = reader.Read<CachedMaterial>();
+			const auto materialHandle = reader.Read<AssetHandle>();
+
+			Ref<CPUMaterialInstance> instance = CreateRef<CPUMaterialInstance>();
+			switch (material) {
+				case CachedMaterial::DefaultOpaque: instance->Material = CPUMaterial::GetDefaultOpaque() ? CPUMaterial::GetDefaultOpaque()->Handle : NULL_ASSET_HANDLE; break;
+				case CachedMaterial::DefaultTransparent: instance->Material = CPUMaterial::GetDefaultTransparent() ? CPUMaterial::GetDefaultTransparent()->Handle : NULL_ASSET_HANDLE; break;
+				default: instance->Material = materialHandle; break;
+			}
+
+			const uint64_t setCount = reader.Read<uint64_t>();
+			for (uint64_t j = 0; j < setCount && reader.IsValid(); ++j) {
+				const auto position = reader.Read<CPUMaterialInstance::SetFieldPosition>();
+				auto buffer = reader.Read<CPUMaterialInstance::MaterialDataBuffer>();
+				RemapHandle(buffer, handles);
+				instance->SetEditions[position] = buffer;
+			}
+			const uint64_t pushConstantCount = reader.Read<uint64_t>();
+			for (uint64_t j = 0; j < pushConstantCount && reader.IsValid(); ++j) {
+				const auto position = reader.Read<CPUMaterialInstance::PushConstantFieldPosition>();
+				auto buffer = reader.Read<CPUMaterialInstance::MaterialDataBuffer>();
+				RemapHandle(buffer, handles);
+				instance->PushConstantEditions[position] = buffer;
+			}
+			handles.emplace(handle, instance->Handle);
+			model->Instances.push_back(std::move(instance));
+		}
+
+		const uint64_t meshCount = reader.Read<uint64_t>();
+		for (uint64_t i = 0; i < meshCount && reader.IsValid(); ++i) {
+			const auto handle = reader.Read<AssetHandle>();
+			Ref<CPUMesh> mesh = CreateRef<CPUMesh>();
+			mesh->Name = reader.ReadString();
+			mesh->Layout = reader.Read<VertexLayout>();
+			reader.ReadArray(mesh->Vertices);
+			reader.ReadArray(mesh->Indices);
+			reader.ReadArray(mesh->Lods);
+			mesh->CalcAABB();
+			for (LOD &lod: mesh->Lods) {
+				if (const auto it = handles.find(lod.materialInstance); it != handles.end()) {
+					lod.materialInstance = it->second;
+				}
+			}
+			handles.emplace(handle, mesh->Handle);
+			model->Meshes.push_back(std::move(mesh));
+		}
+
+		model->RootNode = reader.Read<uint64_t>();
+		const uint64_t nodeCount = reader.Read<uint64_t>();
+		std::vector<uint32_t> nodeMeshes;
+		for (uint64_t i = 0; i < nodeCount && reader.IsValid(); ++i) {
+			CPUModel::Node node{};
+			node.name = reader.ReadString();
+			reader.ReadArray(nodeMeshes);
+			for (const uint32_t mesh: nodeMeshes) {
+				if (mesh < model->Meshes.size()) node.meshes.push_back(model->Meshes[mesh]);
+			}
+			const bool hasLight = reader.Read<uint8_t>();
+			const auto light = reader.Read<Light>();
+			if (hasLight) node.light = light;
+			node.worldMatrix = reader.Read<Mat4>();
+			node.LocalRotation = reader.Read<Quat>();
+			node.LocalPosition = reader.Read<Vec3>();
+			node.LocalScale = reader.Read<Vec3>();
+			const auto parent = reader.Read<uint64_t>();
+			if (parent != std::numeric_limits<uint64_t>::max()) node.parent = parent;
+			reader.ReadArray(node.children);
+			model->Nodes.push_back(std::move(node));
+		}
+
+		// A child always comes after its parent, which also rules out the cycles 'LoadInScene' would loop on.
+		bool validHierarchy = true;
+		for (uint64_t i = 0; i < model->Nodes.size() && validHierarchy; ++i) {
+			const CPUModel::Node &node = model->Nodes[i];
+			validHierarchy = !node.parent || node.parent.value() < model->Nodes.size();
+			for (const uint64_t child: node.children) {
+				validHierarchy &= child > i && child < model->Nodes.size();
+			}
+		}
+
+		if (!reader.IsValid() || !validHierarchy || (!model->Nodes.empty() && model->RootNode >= model->Nodes.size())) {
+			MGN_CORE_ERROR("The cooked model '{}' is corrupted.", cachePath.string());
+			return nullptr;
+		}
+
+		return model;
+	}
+
+} // namespace Imagine
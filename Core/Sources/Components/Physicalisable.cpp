@@ -10,25 +10,49 @@
 #include "Imagine/Layers/PhysicsLayer.hpp"
 #include "Imagine/Physics/ObjectLayerPairFilter.hpp"
 #include "Imagine/Physics/PhysicsTypeHelpers.hpp"
+#include "Imagine/Physics/ShapeCache.hpp"
 #include "Imagine/Rendering/CPU/CPUMesh.hpp"
 #include "Imagine/ThirdParty/JoltPhysics.hpp"
 #include "Jolt/Physics/Collision/Shape/BoxShape.h"
 #include "Jolt/Physics/Collision/Shape/CapsuleShape.h"
+#include "Jolt/Physics/Collision/Shape/ConvexHullShape.h"
 #include "Jolt/Physics/Collision/Shape/CylinderShape.h"
 #include "Jolt/Physics/Collision/Shape/MeshShape.h"
 #include "Jolt/Physics/Collision/Shape/SphereShape.h"
 
 namespace Imagine::ColliderShapes
 {
-	const JPH::Shape* CreateShape(Box box)
+	namespace {
+		Ref<CPUMesh> GetMesh(const AssetHandle handle) {
+			const AssetField<CPUMesh> meshAsset {handle};
+			if (!meshAsset.IsValid()) {
+				return nullptr;
+			}
+			return meshAsset.GetAsset();
+		}
+
+		JPH::ShapeRefC GetResult(const JPH::ShapeSettings::ShapeResult &res, const char* type) {
+			if (!res.IsValid()) {
+				if (res.HasError()) {
+					MGN_CORE_ERROR("Error while creating the Physics {} Shape\n{}", type, res.GetError().c_str());
+				} else {
+					MGN_CORE_ERROR("Error while creating the Physics {} Shape", type);
+				}
+				return nullptr;
+			}
+			return res.Get();
+		}
+	}
+
+	JPH::ShapeRefC CreateShape(Box box)
 	{
 		return new JPH::BoxShape(JPH::Vec3Arg{box.Size.x * Real(0.5),box.Size.y * Real(0.5),box.Size.z * Real(0.5)});
 	}
-	const JPH::Shape* CreateShape(Sphere sphere)
+	JPH::ShapeRefC CreateShape(Sphere sphere)
 	{
 		return new JPH::SphereShape(sphere.Radius);
 	}
-	const JPH::Shape* CreateShape(Capsule capsule)
+	JPH::ShapeRefC CreateShape(Capsule capsule)
 	{
 		auto cylinderHeight = Math::Max(capsule.Height - (2*capsule.Radius), Real(0));
 		if(cylinderHeight >= REAL_EPSILON)
@@ -36,55 +60,58 @@ namespace Imagine::ColliderShapes
 		else
 			return new JPH::SphereShape(capsule.Radius);
 	}
-	const JPH::Shape *CreateShape(Cylinder cylinder) {
+	JPH::ShapeRefC CreateShape(Cylinder cylinder) {
 		return new JPH::CylinderShape(cylinder.Height * 0.5, cylinder.Radius);
 	}
 
-	// const JPH::Shape *CreateShape(Mesh m) {
-	// 	AssetField<CPUMesh> meshAsset {m.handle};
-	// 	if (!meshAsset.IsValid()) {
-	// 		return nullptr;
-	// 	}
-	// 	Ref<CPUMesh> mesh = meshAsset.GetAsset();
-	// 	if (!mesh) {
-	// 		return nullptr;
-	// 	}
-	//
-	// 	JPH::VertexList inVertices{mesh->Vertices.size()};
-	// 	for (int i = 0; i < mesh->Vertices.size(); ++i) {
-	// 		inVertices[i].x = mesh->Vertices[i].position.x;
-	// 		inVertices[i].y = mesh->Vertices[i].position.y;
-	// 		inVertices[i].z = mesh->Vertices[i].position.z;
-	// 	}
-	//
-	// 	const uint32_t trCount = mesh->Lods.back().count / 3;
-	// 	JPH::IndexedTriangleList inTriangles{trCount};
-	//
-	// 	uint32_t offset = mesh->Lods.back().index;
-	// 	for (uint32_t iTr = 0; iTr < trCount; ++iTr) {
-	// 		const uint32_t i0 = offset + iTr * 3 + 0;
-	// 		const uint32_t i1 = offset + iTr * 3 + 1;
-	// 		const uint32_t i2 = offset + iTr * 3 + 2;
-	// 		inTriangles[iTr].mIdx[0] = mesh->Indices[i0];
-	// 		inTriangles[iTr].mIdx[1] = mesh->Indices[i1];
-	// 		inTriangles[iTr].mIdx[2] = mesh->Indices[i2];
-	// 	}
-	//
-	// 	JPH::MeshShapeSettings settings{inVertices, inTriangles};
-	// 	JPH::Shape::ShapeResult res{};
-	// 	JPH::Shape* shape = new JPH::MeshShape(settings, res);
-	// 	if (!res.IsValid()) {
-	// 		if (res.HasError()) {
-	// 			MGN_CORE_ERROR("Error while creating the Physics Mesh Shape\n{}", res.GetError().c_str());
-	// 		} else {
-	// 			MGN_CORE_ERROR("Error while creating the Physics Mesh Shape");
-	// 		}
-	// 		delete shape;
-	// 		return nullptr;
-	// 	}
-	//
-	// 	return shape;
-	// }
+	JPH::ShapeRefC CreateShape(ConvexHull hull) {
+		const Ref<CPUMesh> mesh = GetMesh(hull.MeshHandle);
+		if (!mesh || mesh->Vertices.empty()) {
+			return nullptr;
+		}
+
+		JPH::Array<JPH::Vec3> points;
+		points.reserve(mesh->Vertices.size());
+		for (const Vertex &vertex: mesh->Vertices) {
+			points.push_back(JPH::Vec3{vertex.position.x, vertex.position.y, vertex.position.z});
+		}
+
+		const JPH::ConvexHullShapeSettings settings{points};
+		return GetResult(settings.Create(), "Convex Hull");
+	}
+
+	JPH::ShapeRefC CreateShape(Mesh m) {
+		const Ref<CPUMesh> mesh = GetMesh(m.MeshHandle);
+		if (!mesh) {
+			return nullptr;
+		}
+
+		JPH::VertexList inVertices(mesh->Vertices.size());
+		for (uint64_t i = 0; i < mesh->Vertices.size(); ++i) {
+			inVertices[i].x = mesh->Vertices[i].position.x;
+			inVertices[i].y = mesh->Vertices[i].position.y;
+			inVertices[i].z = mesh->Vertices[i].position.z;
+		}
+
+		// The triangles of the full detail LOD, the others share the vertices and are only simplified versions of it.
+		const uint32_t offset = mesh->Lods.empty() ? 0 : mesh->Lods.front().index;
+		const uint32_t count = mesh->Lods.empty() ? static_cast<uint32_t>(mesh->Indices.size()) : mesh->Lods.front().count;
+		const uint32_t trCount = count / 3;
+		if (trCount == 0) {
+			return nullptr;
+		}
+
+		JPH::IndexedTriangleList inTriangles(trCount);
+		for (uint32_t iTr = 0; iTr < trCount; ++iTr) {
+			const uint32_t i0 = offset + iTr * 3 + 0;
+			inTriangles[iTr].mIdx[0] = mesh->Indices[i0 + 0];
+			inTriangles[iTr].mIdx[1] = mesh->Indices[i0 + 1];
+			inTriangles[iTr].mIdx[2] = mesh->Indices[i0 + 2];
+		}
+
+		const JPH::MeshShapeSettings settings{std::move(inVertices), std::move(inTriangles)};
+		return GetResult(settings.Create(), "Mesh");
+	}
 } // namespace Imagine::ColliderShapes
 
 namespace Imagine {
@@ -137,7 +164,11 @@ namespace Imagine {
 		return JPH::EMotionType::Static;
 	}
 
-	const JPH::Shape *Physicalisable::GetShape() {
-		return std::visit([](auto &&args) { return ColliderShapes::CreateShape(args); }, Shape);
+	JPH::ShapeRefC Physicalisable::GetShape() const {
+		// Jolt can't compute the mass of a mesh shape, the dynamic bodies collide with its convex hull instead.
+		if (RBType == RB_Dynamic && std::holds_alternative<ColliderShapes::Mesh>(Shape)) {
+			return ShapeCache::GetShape(ColliderShapes::ConvexHull{std::get<ColliderShapes::Mesh>(Shape).MeshHandle});
+		}
+		return ShapeCache::GetShape(Shape);
 	}
 } // namespace Imagine
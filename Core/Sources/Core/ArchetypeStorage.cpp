@@ -0,0 +1,463 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Imagine/Core/ArchetypeStorage.hpp"
+
+namespace Imagine {
+
+	static inline uint32_t AlignUp(const uint32_t value, const uint32_t alignment) {
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	// ===== Chunk =====
+
+	ArchetypeStorage::Chunk::Chunk(const uint32_t byteSize) :
+		m_ByteSize(byteSize) {
+		m_Data = static_cast<uint8_t *>(::operator new(byteSize, std::align_val_t{c_ColumnAlignment}));
+	}
+
+	ArchetypeStorage::Chunk::~Chunk() {
+		if (m_Data) {
+			::operator delete(m_Data, std::align_val_t{c_ColumnAlignment});
+		}
+		m_Data = nullptr;
+		m_ByteSize = 0;
+	}
+
+	ArchetypeStorage::Chunk::Chunk(const Chunk &o) :
+		Chunk(o.m_ByteSize) {
+		memcpy(m_Data, o.m_Data, m_ByteSize);
+	}
+
+	ArchetypeStorage::Chunk &ArchetypeStorage::Chunk::operator=(const Chunk &o) {
+		if (this == &o) return *this;
+		Chunk copy{o};
+		swap(copy);
+		return *this;
+	}
+
+	ArchetypeStorage::Chunk::Chunk(Chunk &&o) noexcept {
+		swap(o);
+	}
+
+	ArchetypeStorage::Chunk &ArchetypeStorage::Chunk::operator=(Chunk &&o) noexcept {
+		swap(o);
+		return *this;
+	}
+
+	void ArchetypeStorage::Chunk::swap(Chunk &o) noexcept {
+		std::swap(m_Data, o.m_Data);
+		std::swap(m_ByteSize, o.m_ByteSize);
+	}
+
+	// ===== Archetype =====
+
+	uint32_t ArchetypeStorage::Archetype::GetColumn(const ComponentIndex component) const {
+		const auto it = std::lower_bound(components.cbegin(), components.cend(), component);
+		if (it == components.cend() || *it != component) return c_NullIndex;
+		return static_cast<uint32_t>(it - components.cbegin());
+	}
+
+	uint32_t ArchetypeStorage::Archetype::GetChunkCount(const uint32_t chunk) const {
+		const uint32_t first = chunk * chunkCapacity;
+		if (first >= count) return 0;
+		return std::min(chunkCapacity, count - first);
+	}
+
+	uint32_t *ArchetypeStorage::Archetype::GetEntities(const uint32_t chunk) {
+		return reinterpret_cast<uint32_t *>(chunks[chunk].Get());
+	}
+
+	const uint32_t *ArchetypeStorage::Archetype::GetEntities(const uint32_t chunk) const {
+		return reinterpret_cast<const uint32_t *>(chunks[chunk].Get());
+	}
+
+	void *ArchetypeStorage::Archetype::GetColumnData(const uint32_t column, const uint32_t chunk) {
+		return chunks[chunk].Get() + offsets[column];
+	}
+
+	const void *ArchetypeStorage::Archetype::GetColumnData(const uint32_t column, const uint32_t chunk) const {
+		return chunks[chunk].Get() + offsets[column];
+	}
+
+	void *ArchetypeStorage::Archetype::GetElement(const uint32_t column, const uint32_t row) {
+		const uint32_t chunk = row / chunkCapacity;
+		const uint32_t index = row % chunkCapacity;
+		return chunks[chunk].Get() + offsets[column] + (index * sizes[column]);
+	}
+
+	const void *ArchetypeStorage::Archetype::GetElement(const uint32_t column, const uint32_t row) const {
+		const uint32_t chunk = row / chunkCapacity;
+		const uint32_t index = row % chunkCapacity;
+		return chunks[chunk].Get() + offsets[column] + (index * sizes[column]);
+	}
+
+	// ===== ArchetypeStorage =====
+
+	ArchetypeStorage::~ArchetypeStorage() {
+		Clear();
+	}
+
+	ArchetypeStorage::ArchetypeStorage(const ArchetypeStorage &o) :
+		m_Components(o.m_Components), m_ComponentLookup(o.m_ComponentLookup), m_Archetypes(o.m_Archetypes), m_ArchetypeLookup(o.m_ArchetypeLookup), m_RootArchetypes(o.m_RootArchetypes), m_Locations(o.m_Locations) {
+		CopyConstructColumns(o);
+	}
+
+	ArchetypeStorage &ArchetypeStorage::operator=(const ArchetypeStorage &o) {
+		if (this == &o) return *this;
+		ArchetypeStorage copy{o};
+		swap(copy);
+		return *this;
+	}
+
+	ArchetypeStorage::ArchetypeStorage(ArchetypeStorage &&o) noexcept {
+		swap(o);
+	}
+
+	ArchetypeStorage &ArchetypeStorage::operator=(ArchetypeStorage &&o) noexcept {
+		swap(o);
+		return *this;
+	}
+
+	void ArchetypeStorage::swap(ArchetypeStorage &o) noexcept {
+		std::swap(m_Components, o.m_Components);
+		std::swap(m_ComponentLookup, o.m_ComponentLookup);
+		std::swap(m_Archetypes, o.m_Archetypes);
+		std::swap(m_ArchetypeLookup, o.m_ArchetypeLookup);
+		std::swap(m_RootArchetypes, o.m_RootArchetypes);
+		std::swap(m_Locations, o.m_Locations);
+	}
+
+	void ArchetypeStorage::CopyConstructColumns(const ArchetypeStorage &source) {
+		// The chunks have been copied bit by bit, we now call the copy constructors on top of the copied memory.
+		for (ArchetypeIndex index = 0; index < m_Archetypes.size(); ++index) {
+			Archetype &archetype = m_Archetypes[index];
+			const Archetype &other = source.m_Archetypes[index];
+			for (uint32_t column = 0; column < archetype.components.size(); ++column) {
+				const ComponentInfo &info = m_Components[archetype.components[column]];
+				if (!info.copy_constructor) continue;
+				for (uint32_t row = 0; row < archetype.count; ++row) {
+					info.copy_constructor(archetype.GetElement(column, row), info.size, ConstBufferView{other.GetElement(column, row), 0, info.size});
+				}
+			}
+		}
+	}
+
+	ArchetypeStorage::ComponentIndex ArchetypeStorage::RegisterComponent(const UUID id, const uint32_t size, void (*constructor)(void *, uint32_t), void (*destructor)(void *, uint32_t), void (*copy_constructor)(void *, uint32_t, ConstBufferView view)) {
+		if (const auto it = m_ComponentLookup.find(id); it != m_ComponentLookup.end()) {
+			return it->second;
+		}
+
+		MGN_CORE_CASSERT(m_Components.size() < c_MaxComponents, "The archetype storage cannot hold more than {} components.", c_MaxComponents);
+		if (m_Components.size() >= c_MaxComponents) return c_NullIndex;
+
+		const ComponentIndex index = static_cast<ComponentIndex>(m_Components.size());
+		m_Components.push_back({id, size, constructor, destructor, copy_constructor});
+		m_ComponentLookup[id] = index;
+		m_RootArchetypes.push_back(c_NullIndex);
+		return index;
+	}
+
+	bool ArchetypeStorage::IsRegistered(const UUID id) const {
+		return m_ComponentLookup.contains(id);
+	}
+
+	ArchetypeStorage::ComponentIndex ArchetypeStorage::GetComponentIndex(const UUID id) const {
+		const auto it = m_ComponentLookup.find(id);
+		return it == m_ComponentLookup.cend() ? c_NullIndex : it->second;
+	}
+
+	const ArchetypeStorage::ComponentInfo &ArchetypeStorage::GetComponentInfo(const ComponentIndex component) const {
+		return m_Components[component];
+	}
+
+	ArchetypeStorage::Signature ArchetypeStorage::MakeSignature(std::span<const ComponentIndex> query) const {
+		Signature signature{};
+		for (const ComponentIndex component: query) {
+			signature.set(component);
+		}
+		return signature;
+	}
+
+	ArchetypeStorage::ArchetypeIndex ArchetypeStorage::FindOrCreateArchetype(const Signature &signature) {
+		if (const auto it = m_ArchetypeLookup.find(signature); it != m_ArchetypeLookup.end()) {
+			return it->second;
+		}
+
+		Archetype archetype{};
+		archetype.signature = signature;
+		uint32_t bytesPerEntity = sizeof(uint32_t);
+		for (ComponentIndex i = 0; i < m_Components.size(); ++i) {
+			if (!signature.test(i)) continue;
+			archetype.components.push_back(i);
+			archetype.sizes.push_back(m_Components[i].size);
+			bytesPerEntity += m_Components[i].size;
+		}
+
+		// Each column is aligned, so we keep some room for the padding before computing how many entities a chunk can hold.
+		const uint32_t padding = c_ColumnAlignment * static_cast<uint32_t>(archetype.components.size() + 1);
+		archetype.chunkCapacity = c_ChunkByteSize > padding ? (c_ChunkByteSize - padding) / bytesPerEntity : 0;
+		// Components that are too big for a chunk get their own bigger chunks.
+		archetype.chunkCapacity = std::max(archetype.chunkCapacity, 1u);
+
+		uint32_t offset = AlignUp(archetype.chunkCapacity * sizeof(uint32_t), c_ColumnAlignment);
+		for (const uint32_t size: archetype.sizes) {
+			archetype.offsets.push_back(offset);
+			offset = AlignUp(offset + archetype.chunkCapacity * size, c_ColumnAlignment);
+		}
+		archetype.chunkByteSize = std::max(offset, c_ColumnAlignment);
+
+		const ArchetypeIndex index = static_cast<ArchetypeIndex>(m_Archetypes.size());
+		m_Archetypes.push_back(std::move(archetype));
+		m_ArchetypeLookup[signature] = index;
+		return index;
+	}
+
+	ArchetypeStorage::ArchetypeIndex ArchetypeStorage::GetAddTarget(const ArchetypeIndex from, const ComponentIndex component) {
+		if (from == c_NullIndex) {
+			if (m_RootArchetypes[component] == c_NullIndex) {
+				Signature signature{};
+				signature.set(component);
+				m_RootArchetypes[component] = FindOrCreateArchetype(signature);
+			}
+			return m_RootArchetypes[component];
+		}
+
+		if (const auto it = m_Archetypes[from].addEdges.find(component); it != m_Archetypes[from].addEdges.end()) {
+			return it->second;
+		}
+
+		Signature signature = m_Archetypes[from].signature;
+		signature.set(component);
+		const ArchetypeIndex to = FindOrCreateArchetype(signature);
+		// Not keeping a reference as the creation might have reallocated the archetypes.
+		m_Archetypes[from].addEdges[component] = to;
+		m_Archetypes[to].removeEdges[component] = from;
+		return to;
+	}
+
+	ArchetypeStorage::ArchetypeIndex ArchetypeStorage::GetRemoveTarget(const ArchetypeIndex from, const ComponentIndex component) {
+		if (const auto it = m_Archetypes[from].removeEdges.find(component); it != m_Archetypes[from].removeEdges.end()) {
+			return it->second;
+		}
+
+		Signature signature = m_Archetypes[from].signature;
+		signature.reset(component);
+		// An entity without any component is simply not stored.
+		if (signature.none()) return c_NullIndex;
+
+		const ArchetypeIndex to = FindOrCreateArchetype(signature);
+		m_Archetypes[from].removeEdges[component] = to;
+		m_Archetypes[to].addEdges[component] = from;
+		return to;
+	}
+
+	uint32_t ArchetypeStorage::PushRow(const ArchetypeIndex index, const uint32_t entity) {
+		Archetype &archetype = m_Archetypes[index];
+		const uint32_t row = archetype.count;
+		const uint32_t chunk = row / archetype.chunkCapacity;
+		if (chunk >= archetype.chunks.size()) {
+			archetype.chunks.emplace_back(archetype.chunkByteSize);
+		}
+		archetype.GetEntities(chunk)[row % archetype.chunkCapacity] = entity;
+		archetype.count += 1;
+		return row;
+	}
+
+	void ArchetypeStorage::RemoveRow(const ArchetypeIndex index, const uint32_t row, const bool destruct) {
+		Archetype &archetype = m_Archetypes[index];
+		MGN_CORE_MASSERT(row < archetype.count, "The row {} is out of bound.", row);
+
+		if (destruct) {
+			for (uint32_t column = 0; column < archetype.components.size(); ++column) {
+				const ComponentInfo &info = m_Components[archetype.components[column]];
+				if (info.destructor) {
+					info.destructor(archetype.GetElement(column, row), info.size);
+				}
+			}
+		}
+
+		// Only doing the expensive bit of work if we need to fill a hole.
+		const uint32_t last = archetype.count - 1;
+		if (row != last) {
+			for (uint32_t column = 0; column < archetype.components.size(); ++column) {
+				memcpy(archetype.GetElement(column, row), archetype.GetElement(column, last), archetype.sizes[column]);
+			}
+			const uint32_t movedEntity = archetype.GetEntities(last / archetype.chunkCapacity)[last % archetype.chunkCapacity];
+			archetype.GetEntities(row / archetype.chunkCapacity)[row % archetype.chunkCapacity] = movedEntity;
+			m_Locations[movedEntity].row = row;
+		}
+
+		archetype.count -= 1;
+		// Keep one empty chunk around so an entity bouncing in and out of an archetype doesn't reallocate every time.
+		if (archetype.chunks.size() >= 2 && archetype.count <= (archetype.chunks.size() - 2) * archetype.chunkCapacity) {
+			archetype.chunks.pop_back();
+		}
+	}
+
+	uint32_t ArchetypeStorage::MoveEntity(const uint32_t entity, const ArchetypeIndex to) {
+		const EntityLocation from = m_Locations[entity];
+		const uint32_t row = PushRow(to, entity);
+
+		if (from.archetype != c_NullIndex) {
+			Archetype &source = m_Archetypes[from.archetype];
+			Archetype &destination = m_Archetypes[to];
+			for (uint32_t column = 0; column < source.components.size(); ++column) {
+				const uint32_t dstColumn = destination.GetColumn(source.components[column]);
+				if (dstColumn == c_NullIndex) continue;
+				memcpy(destination.GetElement(dstColumn, row), source.GetElement(column, from.row), source.sizes[column]);
+			}
+			RemoveRow(from.archetype, from.row, false);
+		}
+
+		m_Locations[entity] = {to, row};
+		return row;
+	}
+
+	void *ArchetypeStorage::AddUninitialized(const uint32_t entity, const ComponentIndex component) {
+		if (entity >= m_Locations.size()) {
+			m_Locations.resize(entity + c_OverheadResize);
+		}
+
+		const EntityLocation location = m_Locations[entity];
+		if (location.archetype != c_NullIndex && m_Archetypes[location.archetype].signature.test(component)) {
+			return nullptr;
+		}
+
+		const ArchetypeIndex to = GetAddTarget(location.archetype, component);
+		const uint32_t row = MoveEntity(entity, to);
+		Archetype &archetype = m_Archetypes[to];
+		return archetype.GetElement(archetype.GetColumn(component), row);
+	}
+
+	void *ArchetypeStorage::Add(const uint32_t entity, const UUID componentId) {
+		const ComponentIndex component = GetComponentIndex(componentId);
+		if (component == c_NullIndex) return nullptr;
+
+		void *data = AddUninitialized(entity, component);
+		if (!data) return nullptr;
+
+		const ComponentInfo &info = m_Components[component];
+		if (info.constructor) {
+			info.constructor(data, info.size);
+		}
+		return data;
+	}
+
+	void *ArchetypeStorage::Add(const uint32_t entity, const UUID componentId, const ConstBufferView view) {
+		const ComponentIndex component = GetComponentIndex(componentId);
+		if (component == c_NullIndex) return nullptr;
+
+		void *data = AddUninitialized(entity, component);
+		if (!data) return nullptr;
+
+		const ComponentInfo &info = m_Components[component];
+		if (info.copy_constructor) {
+			info.copy_constructor(data, info.size, view);
+		}
+		else {
+			memcpy(data, view.Get(), std::min(view.Size(), static_cast<uint64_t>(info.size)));
+		}
+		return data;
+	}
+
+	bool ArchetypeStorage::Has(const uint32_t entity, const UUID componentId) const {
+		if (entity >= m_Locations.size()) return false;
+		const EntityLocation location = m_Locations[entity];
+		if (location.archetype == c_NullIndex) return false;
+		const ComponentIndex component = GetComponentIndex(componentId);
+		if (component == c_NullIndex) return false;
+		return m_Archetypes[location.archetype].signature.test(component);
+	}
+
+	bool ArchetypeStorage::Exist(const uint32_t entity) const {
+		return entity < m_Locations.size() && m_Locations[entity].archetype != c_NullIndex;
+	}
+
+	void *ArchetypeStorage::TryGet(const uint32_t entity, const UUID componentId) {
+		if (entity >= m_Locations.size()) return nullptr;
+		const EntityLocation location = m_Locations[entity];
+		if (location.archetype == c_NullIndex) return nullptr;
+		const ComponentIndex component = GetComponentIndex(componentId);
+		if (component == c_NullIndex) return nullptr;
+
+		Archetype &archetype = m_Archetypes[location.archetype];
+		const uint32_t column = archetype.GetColumn(component);
+		if (column == c_NullIndex) return nullptr;
+		return archetype.GetElement(column, location.row);
+	}
+
+	const void *ArchetypeStorage::TryGet(const uint32_t entity, const UUID componentId) const {
+		return const_cast<ArchetypeStorage *>(this)->TryGet(entity, componentId);
+	}
+
+	bool ArchetypeStorage::Remove(const uint32_t entity, const UUID componentId) {
+		if (!Has(entity, componentId)) return false;
+
+		const ComponentIndex component = GetComponentIndex(componentId);
+		const EntityLocation location = m_Locations[entity];
+		const ComponentInfo &info = m_Components[component];
+
+		{
+			Archetype &archetype = m_Archetypes[location.archetype];
+			if (info.destructor) {
+				info.destructor(archetype.GetElement(archetype.GetColumn(component), location.row), info.size);
+			}
+		}
+
+		const ArchetypeIndex to = GetRemoveTarget(location.archetype, component);
+		if (to == c_NullIndex) {
+			// The only component has already been destroyed, we just have to release the row.
+			RemoveRow(location.archetype, location.row, false);
+			m_Locations[entity] = {};
+		}
+		else {
+			MoveEntity(entity, to);
+		}
+		return true;
+	}
+
+	void ArchetypeStorage::RemoveEntity(const uint32_t entity) {
+		if (!Exist(entity)) return;
+		const EntityLocation location = m_Locations[entity];
+		RemoveRow(location.archetype, location.row, true);
+		m_Locations[entity] = {};
+	}
+
+	void ArchetypeStorage::Clear() {
+		for (Archetype &archetype: m_Archetypes) {
+			for (uint32_t column = 0; column < archetype.components.size(); ++column) {
+				const ComponentInfo &info = m_Components[archetype.components[column]];
+				if (!info.destructor) continue;
+				for (uint32_t row = 0; row < archetype.count; ++row) {
+					info.destructor(archetype.GetElement(column, row), info.size);
+				}
+			}
+			archetype.count = 0;
+			archetype.chunks.clear();
+		}
+		std::fill(m_Locations.begin(), m_Locations.end(), EntityLocation{});
+	}
+
+	void ArchetypeStorage::Reserve(const uint32_t entityCapacity) {
+		if (m_Locations.size() < entityCapacity) {
+			m_Locations.resize(entityCapacity);
+		}
+	}
+
+	uint32_t ArchetypeStorage::Count(const UUID componentId) const {
+		const ComponentIndex component = GetComponentIndex(componentId);
+		if (component == c_NullIndex) return 0;
+
+		uint32_t count = 0;
+		for (const Archetype &archetype: m_Archetypes) {
+			if (archetype.signature.test(component)) count += archetype.count;
+		}
+		return count;
+	}
+
+	ArchetypeStorage::EntityLocation ArchetypeStorage::GetLocation(const uint32_t entity) const {
+		return entity < m_Locations.size() ? m_Locations[entity] : EntityLocation{};
+	}
+} // namespace Imagine
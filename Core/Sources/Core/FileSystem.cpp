@@ -43,6 +43,15 @@ namespace Imagine {
 		return p.string();
 	}
 
+	std::string Path::normalized() const {
+		std::string normalized = FileSourceToString(source) + ':' + path.lexically_normal().generic_string();
+#ifdef _WIN32
+		// The Windows file system is case-insensitive.
+		std::transform(normalized.begin(), normalized.end(), normalized.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+#endif
+		return normalized;
+	}
+
 	void Path::swap(Path &other) noexcept {
 		std::swap(path, other.path);
 		std::swap(source, other.source);
@@ -63,6 +72,15 @@ namespace Imagine {
 				return {source, localPath};
 			}
 		}
+		{
+			const auto source = FileSource::EngineShaders;
+			const auto sourcePath = FileSystem::GetRootPath(source).make_preferred();
+			const std::string rootSourceStr = sourcePath.string();
+			if (pathStr.starts_with(rootSourceStr)) {
+				std::filesystem::path localPath = std::filesystem::relative(path, sourcePath);
+				return {source, localPath};
+			}
+		}
 		{
 			const auto source = FileSource::Engine;
 			const auto sourcePath = FileSystem::GetRootPath(source).make_preferred();
@@ -236,6 +254,7 @@ namespace Imagine {
 			case FileSource::Scripts:	{ return Project::GetScriptsDirectory(); }
 			case FileSource::Cache:		{ return Project::GetCacheDirectory(); }
 			case FileSource::External:		{ return ""; }
+			case FileSource::EngineShaders:	{ return s_EditorPath / "EngineShaders/"; }
 			default: break;
 		}
 		return Project::GetProjectFilePath().parent_path();
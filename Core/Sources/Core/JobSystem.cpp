@@ -0,0 +1,244 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Imagine/Core/JobSystem.hpp"
+#include "Imagine/Core/Logger.hpp"
+#include "Imagine/Core/SmartPointers.hpp"
+
+namespace Imagine {
+
+	// ===== ScratchAllocator =====
+
+	static inline constexpr std::align_val_t c_ScratchAlignment{64};
+
+	ScratchAllocator::ScratchAllocator(const uint64_t byteSize) :
+		m_ByteSize(byteSize) {
+		m_Data = static_cast<uint8_t *>(::operator new(m_ByteSize, c_ScratchAlignment));
+	}
+
+	ScratchAllocator::~ScratchAllocator() {
+		Reset();
+		::operator delete(m_Data, c_ScratchAlignment);
+	}
+
+	void *ScratchAllocator::Allocate(const uint64_t size, const uint64_t alignment) {
+		uint64_t offset = (m_Offset + alignment - 1) & ~(alignment - 1);
+		if (offset + size > m_ByteSize) {
+			// The current block is kept alive until the next reset as previous allocations may still be in use.
+			m_Retired.push_back(m_Data);
+			m_RetiredSize += m_Offset;
+			m_ByteSize = std::max(m_ByteSize * 2, size + alignment);
+			m_Data = static_cast<uint8_t *>(::operator new(m_ByteSize, c_ScratchAlignment));
+			offset = 0;
+			++m_HeapAllocationCount;
+		}
+		++m_AllocationCount;
+		m_Offset = offset + size;
+		return m_Data + offset;
+	}
+
+	void ScratchAllocator::Reset() {
+		for (uint8_t *block: m_Retired) {
+			::operator delete(block, c_ScratchAlignment);
+		}
+		m_Retired.clear();
+		m_RetiredSize = 0;
+		m_Offset = 0;
+		m_AllocationCount = 0;
+		m_HeapAllocationCount = 0;
+	}
+
+	// ===== JobSystem =====
+
+	namespace {
+		struct JobQueue {
+			std::mutex mutex;
+			std::deque<JobSystem::Job> jobs;
+		};
+
+		struct JobSystemData {
+			std::vector<std::thread> workers;
+			std::vector<Scope<JobQueue>> queues;
+
+			std::atomic<bool> running{false};
+			std::atomic<uint32_t> queued{0};
+			std::mutex sleepMutex;
+			std::condition_variable sleepCondition;
+		};
+
+		JobSystemData *s_Data{nullptr};
+		thread_local uint32_t t_ThreadIndex{JobSystem::c_InvalidThreadIndex};
+
+		uint32_t GetQueueIndex() {
+			// Threads that aren't part of the job system use the queue of the main thread.
+			return t_ThreadIndex == JobSystem::c_InvalidThreadIndex ? 0 : t_ThreadIndex;
+		}
+
+		bool TryPop(const uint32_t index, JobSystem::Job &job) {
+			JobQueue &queue = *s_Data->queues[index];
+			std::scoped_lock lock(queue.mutex);
+			if (queue.jobs.empty()) return false;
+			job = queue.jobs.back();
+			queue.jobs.pop_back();
+			return true;
+		}
+
+		bool TrySteal(const uint32_t thief, JobSystem::Job &job) {
+			const uint32_t count = static_cast<uint32_t>(s_Data->queues.size());
+			for (uint32_t i = 1; i < count; ++i) {
+				JobQueue &queue = *s_Data->queues[(thief + i) % count];
+				std::scoped_lock lock(queue.mutex);
+				if (queue.jobs.empty()) continue;
+				job = queue.jobs.front();
+				queue.jobs.pop_front();
+				return true;
+			}
+			return false;
+		}
+
+		bool TryExecuteOne(const uint32_t index) {
+			JobSystem::Job job;
+			if (!TryPop(index, job) && !TrySteal(index, job)) return false;
+
+			s_Data->queued.fetch_sub(1, std::memory_order_relaxed);
+			job.function(job.data, job.begin, job.end);
+			if (job.counter) {
+				job.counter->pending.fetch_sub(1, std::memory_order_release);
+			}
+			return true;
+		}
+
+		void WorkerLoop(const uint32_t index) {
+			t_ThreadIndex = index;
+			while (s_Data->running.load(std::memory_order_acquire)) {
+				if (TryExecuteOne(index)) continue;
+
+				// Spin a little before sleeping, the next batch often comes right after.
+				bool hasWork = false;
+				for (uint32_t spin = 0; spin < 64 && !hasWork; ++spin) {
+					std::this_thread::yield();
+					hasWork = s_Data->queued.load(std::memory_order_relaxed) > 0;
+				}
+				if (hasWork) continue;
+
+				std::unique_lock lock(s_Data->sleepMutex);
+				s_Data->sleepCondition.wait(lock, []() {
+					return !s_Data->running.load(std::memory_order_acquire) || s_Data->queued.load(std::memory_order_acquire) > 0;
+				});
+			}
+			t_ThreadIndex = JobSystem::c_InvalidThreadIndex;
+		}
+	} // namespace
+
+	void JobSystem::Initialize(const uint32_t workerCount) {
+		if (s_Data) {
+			MGN_CORE_WARNING("The job system is already initialized.");
+			return;
+		}
+
+		s_Data = new JobSystemData();
+		s_Data->running.store(true, std::memory_order_release);
+
+		const uint32_t threadCount = workerCount + 1;
+		s_Data->queues.reserve(threadCount);
+		for (uint32_t i = 0; i < threadCount; ++i) {
+			s_Data->queues.push_back(CreateScope<JobQueue>());
+		}
+
+		t_ThreadIndex = 0;
+		s_Data->workers.reserve(workerCount);
+		for (uint32_t i = 1; i < threadCount; ++i) {
+			s_Data->workers.emplace_back(WorkerLoop, i);
+		}
+	}
+
+	void JobSystem::Shutdown() {
+		if (!s_Data) return;
+
+		{
+			std::scoped_lock lock(s_Data->sleepMutex);
+			s_Data->running.store(false, std::memory_order_release);
+		}
+		s_Data->sleepCondition.notify_all();
+		for (std::thread &worker: s_Data->workers) {
+			worker.join();
+		}
+
+		// Nobody must be left waiting on a job that was never executed.
+		while (TryExecuteOne(0)) {
+		}
+
+		t_ThreadIndex = c_InvalidThreadIndex;
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	bool JobSystem::IsInitialized() {
+		return s_Data != nullptr;
+	}
+
+	uint32_t JobSystem::GetDefaultWorkerCount() {
+		const uint32_t hardware = std::thread::hardware_concurrency();
+		return hardware > 1 ? hardware - 1 : 0;
+	}
+
+	uint32_t JobSystem::GetWorkerCount() {
+		return s_Data ? static_cast<uint32_t>(s_Data->workers.size()) : 0;
+	}
+
+	uint32_t JobSystem::GetThreadCount() {
+		return GetWorkerCount() + 1;
+	}
+
+	uint32_t JobSystem::GetThreadIndex() {
+		return t_ThreadIndex;
+	}
+
+	void JobSystem::Submit(const Job *jobs, const uint32_t count) {
+		if (count == 0) return;
+
+		if (!s_Data) {
+			for (uint32_t i = 0; i < count; ++i) {
+				jobs[i].function(jobs[i].data, jobs[i].begin, jobs[i].end);
+			}
+			return;
+		}
+
+		{
+			// Taking the lock makes sure a worker about to sleep sees the new jobs.
+			// Counted before the jobs are visible, a thief would otherwise decrement the counter first and underflow it.
+			std::scoped_lock lock(s_Data->sleepMutex);
+			s_Data->queued.fetch_add(count, std::memory_order_release);
+		}
+
+		{
+			JobQueue &queue = *s_Data->queues[GetQueueIndex()];
+			std::scoped_lock lock(queue.mutex);
+			for (uint32_t i = 0; i < count; ++i) {
+				if (jobs[i].counter) {
+					jobs[i].counter->pending.fetch_add(1, std::memory_order_relaxed);
+				}
+				queue.jobs.push_back(jobs[i]);
+			}
+		}
+		if (count == 1) {
+			s_Data->sleepCondition.notify_one();
+		}
+		else {
+			s_Data->sleepCondition.notify_all();
+		}
+	}
+
+	void JobSystem::Wait(JobCounter &counter) {
+		if (!s_Data) return;
+
+		const uint32_t index = GetQueueIndex();
+		while (!counter.IsDone()) {
+			if (!TryExecuteOne(index)) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+} // namespace Imagine
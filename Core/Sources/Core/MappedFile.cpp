@@ -0,0 +1,131 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Imagine/Core/MappedFile.hpp"
+#include "Imagine/Core/Logger.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Imagine {
+
+	MappedFile::MappedFile(const std::filesystem::path &filePath) {
+		Open(filePath);
+	}
+
+	MappedFile::~MappedFile() {
+		Close();
+	}
+
+	MappedFile::MappedFile(MappedFile &&other) noexcept {
+		swap(other);
+	}
+
+	MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+		swap(other);
+		return *this;
+	}
+
+	void MappedFile::swap(MappedFile &other) noexcept {
+		std::swap(m_Data, other.m_Data);
+		std::swap(m_Size, other.m_Size);
+#ifdef _WIN32
+		std::swap(m_File, other.m_File);
+		std::swap(m_Mapping, other.m_Mapping);
+#endif
+	}
+
+#ifdef _WIN32
+	bool MappedFile::Open(const std::filesystem::path &filePath) {
+		Close();
+
+		HANDLE file = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			MGN_CORE_ERROR("Failed to open the file '{}'.", filePath.string());
+			return false;
+		}
+
+		LARGE_INTEGER size{};
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping) {
+			MGN_CORE_ERROR("Failed to map the file '{}'.", filePath.string());
+			CloseHandle(file);
+			return false;
+		}
+
+		const void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!data) {
+			MGN_CORE_ERROR("Failed to map the file '{}'.", filePath.string());
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_File = file;
+		m_Mapping = mapping;
+		m_Data = static_cast<const uint8_t *>(data);
+		m_Size = static_cast<uint64_t>(size.QuadPart);
+		return true;
+	}
+
+	void MappedFile::Close() {
+		if (m_Data) UnmapViewOfFile(m_Data);
+		if (m_Mapping) CloseHandle(m_Mapping);
+		if (m_File) CloseHandle(m_File);
+		m_Data = nullptr;
+		m_Mapping = nullptr;
+		m_File = nullptr;
+		m_Size = 0;
+	}
+#else
+	bool MappedFile::Open(const std::filesystem::path &filePath) {
+		Close();
+
+		const int file = open(filePath.c_str(), O_RDONLY);
+		if (file < 0) {
+			MGN_CORE_ERROR("Failed to open the file '{}'.", filePath.string());
+			return false;
+		}
+
+		struct stat info{};
+		if (fstat(file, &info) != 0 || info.st_size == 0) {
+			close(file);
+			return false;
+		}
+
+		void *data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		// The mapping stays valid once the descriptor is closed.
+		close(file);
+		if (data == MAP_FAILED) {
+			MGN_CORE_ERROR("Failed to map the file '{}'.", filePath.string());
+			return false;
+		}
+		madvise(data, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+		m_Data = static_cast<const uint8_t *>(data);
+		m_Size = static_cast<uint64_t>(info.st_size);
+		return true;
+	}
+
+	void MappedFile::Close() {
+		if (m_Data) munmap(const_cast<uint8_t *>(m_Data), static_cast<size_t>(m_Size));
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+#endif
+
+} // namespace Imagine
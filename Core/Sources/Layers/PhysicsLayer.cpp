@@ -3,6 +3,7 @@
 //
 
 #include "Imagine/Layers/PhysicsLayer.hpp"
+#include "Imagine/Core/Hash.hpp"
 #include "Imagine/Scene/Scene.hpp"
 #include "Imagine/ThirdParty/ImGui.hpp"
 
@@ -17,11 +18,13 @@
 #include <Jolt/Physics/Collision/Shape/SphereShape.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/StateRecorderImpl.h>
 #include <Jolt/RegisterTypes.h>
 
 #include "Imagine/Components/Physicalisable.hpp"
 #include "Imagine/Physics/PhysicsDebugRenderer.hpp"
 #include "Imagine/Physics/PhysicsTypeHelpers.hpp"
+#include "Imagine/Physics/ShapeCache.hpp"
 #include "Imagine/Rendering/Camera.hpp"
 #include "Imagine/Scene/SceneManager.hpp"
 #include "Jolt/Physics/Collision/Shape/MeshShape.h"
@@ -29,7 +32,46 @@
 
 namespace Imagine {
 
-	PhysicsLayer::PhysicsLayer() {
+	namespace {
+		constexpr uint32_t c_PhysicsSnapshotMagic = 0x504E474D; // "MGNP"
+		constexpr uint32_t c_PhysicsSnapshotVersion = 1;
+
+		/// The snapshot starts with this header, then come the bodies, the components and the state saved by Jolt.
+		struct PhysicsSnapshotHeader {
+			uint32_t magic{c_PhysicsSnapshotMagic};
+			uint32_t version{c_PhysicsSnapshotVersion};
+			FixedTimestepSettings settings{};
+			double accumulator{0.0};
+			uint32_t bodyCount{0};
+			uint32_t componentCount{0};
+		};
+
+		struct PhysicsSnapshotComponent {
+			UUID::Array64 scene{};
+			uint32_t entity{EntityID::NullID};
+			/// The index and sequence number of the BodyID.
+			uint32_t body{JPH::BodyID::cInvalidBodyID};
+			Physicalisable::ShapeVariant shape{};
+			Vec3 linearVelocity{0};
+			Vec3 angularVelocity{0};
+			Real friction{0};
+			Real gravityFactor{0};
+			RigidbodyType type{RB_Dynamic};
+			bool isAwake{true};
+		};
+
+		static_assert(std::is_trivially_copyable_v<PhysicsSnapshotHeader>);
+		static_assert(std::is_trivially_copyable_v<PhysicsSnapshotComponent>);
+
+		UUID::Array64 ToArray(const UUID &id) {
+			UUID::Array64 array{};
+			std::copy(id.cbegin64(), id.cend64(), array.begin());
+			return array;
+		}
+	} // namespace
+
+	PhysicsLayer::PhysicsLayer(const FixedTimestepSettings &settings) :
+		m_Timestep(settings) {
 	}
 
 	PhysicsLayer::~PhysicsLayer() {
@@ -45,6 +87,16 @@ namespace Imagine {
 		// If you implement your own default material (PhysicsMaterial::sDefault) make sure to initialize it before this function or else this function will create one for you.
 		JPH::RegisterTypes();
 
+		CreatePhysicsSystem();
+
+		// Draw Physics
+		if (JPH::DebugRenderer::sInstance == nullptr) {
+			JPH::DebugRenderer::sInstance = new PhysicsDebugRenderer();
+		}
+	}
+
+	void PhysicsLayer::CreatePhysicsSystem() {
+		m_BodyInterface = nullptr;
 		m_PhysicsSystem = CreateScope<JPH::PhysicsSystem>();
 
 		m_PhysicsSystem->Init(PhysicsLayer::cMaxBodies, PhysicsLayer::cNumBodyMutexes, PhysicsLayer::cMaxBodyPairs, PhysicsLayer::cMaxContactConstraints, m_BroadPhaseLayer, m_ObjectVsBroadphaseLayerFilter, m_ObjectVsObjectLayerFilter);
@@ -60,13 +112,8 @@ namespace Imagine {
 		m_PhysicsSystem->SetContactListener(&m_ContactListener);
 
 		// The main way to interact with the bodies in the physics system is through the body interface. There is a locking and a non-locking
-		// variant of this. We're going to use the locking version (even though we're not planning to access bodies from multiple threads)
-		m_BodyInterface = &m_PhysicsSystem->GetBodyInterface();
-
-		// Draw Physics
-		if (JPH::DebugRenderer::sInstance == nullptr) {
-			JPH::DebugRenderer::sInstance = new PhysicsDebugRenderer();
-		}
+		// variant of this. The bodies are never accessed while the system is updating, and the sync jobs touch different bodies, so the locks are useless.
+		m_BodyInterface = &m_PhysicsSystem->GetBodyInterfaceNoLock();
 	}
 	void PhysicsLayer::OnDetach() {
 
@@ -76,8 +123,17 @@ namespace Imagine {
 			JPH::DebugRenderer::sInstance = nullptr;
 		}
 
+		m_Recording.reset();
 		m_BodyInterface = nullptr;
 		m_PhysicsSystem.reset();
+		m_BodyStates.clear();
+		ShapeCache::Clear();
+
+		// The bodies are gone with the system.
+		{
+			auto lock = std::scoped_lock(s_DeletionMutex);
+			s_BodyToDelete.clear();
+		}
 
 		// Unregisters all types with the factory and cleans up the default material
 		JPH::UnregisterTypes();
@@ -103,29 +159,135 @@ namespace Imagine {
 		return s_Simulate;
 	}
 
+	void PhysicsLayer::SetSimulating(const bool simulate) {
+		s_Simulate = simulate;
+	}
+
 	void PhysicsLayer::OnUpdate(AppUpdateEvent &event) {
 		MGN_PROFILE_FUNCTION();
-		{
-			MGN_PROFILE_SCOPE("Delete Some Bodies");
-			auto lock = std::scoped_lock(s_DeletionMutex);
-			m_BodyInterface->RemoveBodies(s_BodyToDelete.data(), static_cast<int>(s_BodyToDelete.size()));
-			m_BodyInterface->DestroyBodies(s_BodyToDelete.data(), static_cast<int>(s_BodyToDelete.size()));
-			s_BodyToDelete.clear();
+		// A recording only covers a simulated run.
+		if (m_Recording && !s_Simulate) {
+			if (const std::optional<PhysicsRecording> recording = StopRecording()) {
+				recording->Write(PhysicsRecording::c_DefaultPath);
+			}
 		}
 
+		const double seconds = event.GetTimeStep().GetSeconds();
+		if (m_Recording) {
+			PhysicsRecordedFrame &frame = m_Recording->frames.emplace_back();
+			frame.deltaTime = seconds;
+			frame.firstDeletion = static_cast<uint32_t>(m_Recording->deletions.size());
+			frame.firstImpulse = static_cast<uint32_t>(m_Recording->impulses.size());
+		}
+
+		FlushDeletions();
+
 		if (s_Simulate) {
 			MGN_PROFILE_SCOPE("Physics Simulation");
-			const int cCollisionSteps = 4;
-			m_PhysicsSystem->Update(event.GetTimeStep().GetSeconds(), cCollisionSteps, &m_TempAllocator, &m_JobSystem);
+			// Don't catch up on the time spent paused.
+			if (!m_WasSimulating) m_Timestep.Reset();
+			Simulate(seconds);
 		}
+		else {
+			m_StepStats = {};
+		}
+		m_WasSimulating = s_Simulate;
 
 		{
 			MGN_PROFILE_SCOPE("Update All Scenes");
 			for (auto scene: SceneManager::GetLoadedScenes()) {
-				Update(scene.get(), event.GetTimeStep());
+				Synchronize(*scene);
+			}
+		}
+	}
+
+	void PhysicsLayer::FlushDeletions() {
+		MGN_PROFILE_FUNCTION();
+		auto lock = std::scoped_lock(s_DeletionMutex);
+		if (s_BodyToDelete.empty()) return;
+
+		if (m_Recording && !m_Recording->frames.empty()) {
+			for (const JPH::BodyID id: s_BodyToDelete) {
+				m_Recording->deletions.push_back(id.GetIndexAndSequenceNumber());
+			}
+			m_Recording->frames.back().deletionCount += static_cast<uint32_t>(s_BodyToDelete.size());
+		}
+
+		m_BodyInterface->RemoveBodies(s_BodyToDelete.data(), static_cast<int>(s_BodyToDelete.size()));
+		m_BodyInterface->DestroyBodies(s_BodyToDelete.data(), static_cast<int>(s_BodyToDelete.size()));
+		s_BodyToDelete.clear();
+	}
+
+	uint32_t PhysicsLayer::Simulate(const double seconds) {
+		MGN_PROFILE_FUNCTION();
+		const uint32_t steps = m_Timestep.Advance(seconds);
+		const float step = static_cast<float>(m_Timestep.GetStep());
+		const int collisionSteps = static_cast<int>(m_Timestep.GetSettings().CollisionSteps);
+
+		m_StepStats = {};
+		m_StepStats.steps = steps;
+		for (uint32_t i = 0; i < steps; ++i) {
+			// Only the state before the last step is interpolated from.
+			if (i + 1 == steps) SavePreviousStates();
+
+			MGN_PROFILE_SCOPE("Physics Step");
+			const auto start = std::chrono::high_resolution_clock::now();
+			m_PhysicsSystem->Update(step, collisionSteps, &m_TempAllocator, &m_JobSystem);
+			const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			++m_StepIndex;
+
+			m_StepStats.stepsMs += ms;
+			m_StepStats.maxStepMs = std::max(m_StepStats.maxStepMs, ms);
+		}
+
+		MGN_PROFILE_PLOT("Physics Steps", steps);
+		MGN_PROFILE_PLOT("Physics Step (us)", steps ? m_StepStats.stepsMs * 1000.0 / steps : 0.0);
+
+		GatherActiveBodies();
+		return steps;
+	}
+
+	void PhysicsLayer::SavePreviousStates() {
+		MGN_PROFILE_FUNCTION();
+		// The sleeping bodies don't move, the states saved for them are left untouched and expire.
+		m_PhysicsSystem->GetActiveBodies(JPH::EBodyType::RigidBody, m_ActiveBodies);
+		for (const JPH::BodyID id: m_ActiveBodies) {
+			const uint32_t index = id.GetIndex();
+			if (index >= m_BodyStates.size()) {
+				m_BodyStates.resize(index + 1);
 			}
+			BodyState &state = m_BodyStates[index];
+			state.id = id;
+			m_BodyInterface->GetPositionAndRotation(id, state.position, state.rotation);
+			state.step = m_StepIndex + 1;
 		}
 	}
+
+	void PhysicsLayer::GatherActiveBodies() {
+		MGN_PROFILE_FUNCTION();
+		++m_SyncFrame;
+		m_PhysicsSystem->GetActiveBodies(JPH::EBodyType::RigidBody, m_ActiveBodies);
+		for (const JPH::BodyID id: m_ActiveBodies) {
+			const uint32_t index = id.GetIndex();
+			if (index >= m_BodyStates.size()) {
+				m_BodyStates.resize(index + 1);
+			}
+			m_BodyStates[index].activeFrame = m_SyncFrame;
+		}
+	}
+
+	void PhysicsLayer::PrepareSyncJobs() {
+		const uint32_t threadCount = JobSystem::GetThreadCount();
+		if (m_SyncJobs.size() < threadCount) {
+			m_SyncJobs.resize(threadCount);
+		}
+		for (SyncJob &job: m_SyncJobs) {
+			job.entities.clear();
+			job.moves.clear();
+			job.velocities.clear();
+		}
+	}
+
 	void PhysicsLayer::OnRender(AppRenderEvent &event) {
 		if (!JPH::DebugRenderer::sInstance) return;
 		// TODO: Fetch the 'JPH::BodyManager::DrawSettings' from some project settings somewhere
@@ -165,72 +327,437 @@ namespace Imagine {
 			if (ImGui::Checkbox("Simulate", &s_Simulate) && s_Simulate) {
 				m_PhysicsSystem->OptimizeBroadPhase();
 			}
+
+			FixedTimestepSettings settings = m_Timestep.GetSettings();
+			const uint32_t step = 1;
+			const uint32_t fastStep = 10;
+			// The recording replays the whole run with the settings it started with.
+			ImGui::BeginDisabled(IsRecording());
+			bool changed = ImGui::InputScalar("Rate", ImGuiDataType_U32, &settings.Rate, &step, &fastStep, "%u");
+			changed |= ImGui::InputScalar("Max Sub Steps", ImGuiDataType_U32, &settings.MaxSubSteps, &step, &fastStep, "%u");
+			changed |= ImGui::InputScalar("Collision Steps", ImGuiDataType_U32, &settings.CollisionSteps, &step, &fastStep, "%u");
+			ImGui::EndDisabled();
+			if (changed) {
+				m_Timestep.SetSettings(settings);
+			}
+
+			const FixedTimestepStats &stats = m_Timestep.GetStats();
+			ImGui::Text("Steps: %u (%.3f ms, %.3f ms max)", m_StepStats.steps, m_StepStats.stepsMs, m_StepStats.maxStepMs);
+			ImGui::Text("Interpolation: %.2f", m_Timestep.GetAlpha());
+			ImGui::Text("Dropped: %.3f s in %llu frames", stats.droppedSeconds, static_cast<unsigned long long>(stats.clampedFrames));
+
+			ImGui::SeparatorText("Shapes");
+			const ShapeCacheStats shapes = ShapeCache::GetStats();
+			ImGui::Text("Shapes: %u (%.2f KB, %llu triangles)", shapes.shapes, static_cast<double>(shapes.bytes) / 1024.0, static_cast<unsigned long long>(shapes.triangles));
+			ImGui::Text("Hits: %llu, Misses: %llu", static_cast<unsigned long long>(shapes.hits), static_cast<unsigned long long>(shapes.misses));
+			if (ImGui::Button("Purge Unused Shapes")) {
+				ShapeCache::Purge();
+			}
+
+			ImGui::SeparatorText("Recording");
+			if (m_Recording) {
+				ImGui::Text("Frames: %llu", static_cast<unsigned long long>(m_Recording->frames.size()));
+				if (ImGui::Button("Stop Recording")) {
+					if (const std::optional<PhysicsRecording> recording = StopRecording()) {
+						recording->Write(PhysicsRecording::c_DefaultPath);
+					}
+				}
+			}
+			else {
+				ImGui::BeginDisabled(!s_Simulate);
+				if (ImGui::Button("Start Recording")) {
+					const std::vector<SceneManager::SceneRef> scenes = SceneManager::GetLoadedScenes();
+					StartRecording(scenes);
+				}
+				ImGui::EndDisabled();
+			}
+			ImGui::TextDisabled("Written to '%s', replay it with '--replay'.", PhysicsRecording::c_DefaultPath);
 		}
 		ImGui::End();
 #endif
 	}
 
-	void PhysicsLayer::Update(Scene *scene, TimeStep ts) {
+	void PhysicsLayer::Synchronize(Scene &scene) {
+		if (s_Simulate) {
+			SyncFromBodies(scene);
+		}
+		else {
+			if (m_InterpolatedScenes.erase(scene.GetID())) SnapToBodies(scene);
+			SyncToBodies(scene);
+		}
+	}
+
+	void PhysicsLayer::SyncToBodies(Scene &scene) {
+		MGN_PROFILE_FUNCTION();
+		PrepareSyncJobs();
 
-		if (!s_Simulate) {
-			MGN_PROFILE_SCOPE("Update Physics Components");
-			scene->ForEachWithComponent<Physicalisable>([this](Scene *scene, EntityID id, Physicalisable &comp) {
-				const TransformR trs = scene->GetTransform(id);
-				const Vec3 pos = trs.LocalPosition;
-				const Quat rot = trs.LocalRotation;
-				const Vec3 lin = comp.GetLinearVelocity();
-				const Vec3 ang = comp.GetRadAngularVelocity();
-				const JPH::EActivation activation = comp.GetActivation();
-
-				// if (!scene->BeginRelationship(id).IsRoot()) {
-				// 	scene->MoveToRoot(id);
-				// 	Entity& e = scene->GetEntity(id);
-				// 	e.LocalPosition = trs.GetWorldPosition();
-				// 	e.LocalRotation = trs.GetWorldRotation();
-				// 	e.LocalScale = trs.GetWorldScale();
-				// }
-
-				if (comp.BodyID.IsInvalid()) {
-					const JPH::Shape *shp = comp.GetShape();
-					if (!shp) return;
-					JPH::BodyCreationSettings creationSettings = {shp, JPH::RVec3Arg{pos.x, pos.y, pos.z}, JPH::QuatArg{rot.x, rot.y, rot.z, rot.w}, comp.GetMotionType(), comp.GetLayer()};
-					creationSettings.mAllowDynamicOrKinematic = true;
-					comp.BodyID = m_BodyInterface->CreateAndAddBody(creationSettings, activation);
-					m_BodyInterface->SetFriction(comp.BodyID, comp.GetFriction());
-					m_BodyInterface->SetGravityFactor(comp.BodyID, comp.GetGravityFactor());
-				}
-				else {
-					m_BodyInterface->SetPositionAndRotation(comp.BodyID, JPH::RVec3Arg{pos.x, pos.y, pos.z}, JPH::QuatArg{rot.x, rot.y, rot.z, rot.w}, comp.GetActivation());
-					if (comp.dirty) {
-						const JPH::Shape *shp = comp.GetShape();
-						m_BodyInterface->SetShape(comp.BodyID, shp, true, activation);
-						m_BodyInterface->SetMotionType(comp.BodyID, comp.GetMotionType(), activation);
-						m_BodyInterface->SetObjectLayer(comp.BodyID, comp.GetLayer());
-						m_BodyInterface->SetFriction(comp.BodyID, comp.GetFriction());
-						m_BodyInterface->SetGravityFactor(comp.BodyID, comp.GetGravityFactor());
-					}
+		{
+			MGN_PROFILE_SCOPE("Gather Moved Bodies");
+			const Scene &constScene = scene;
+			scene.ParallelForEachWithComponent<Physicalisable>([this, &constScene](const EntityID id, const Physicalisable &comp) {
+				// A thread outside of the job system only runs the batches inline, it can use the slot of the main thread.
+				const uint32_t thread = JobSystem::GetThreadIndex();
+				SyncJob &job = m_SyncJobs[thread == JobSystem::c_InvalidThreadIndex ? 0 : thread];
+				if (comp.BodyID.IsInvalid() || comp.dirty) {
+					job.entities.push_back(id);
+					return;
 				}
-				comp.dirty = false;
+
+				const Entity &entity = constScene.GetEntity(id);
+				const JPH::RVec3 position = Convert(entity.LocalPosition);
+				const JPH::Quat rotation = Convert(entity.LocalRotation);
+				JPH::RVec3 bodyPosition;
+				JPH::Quat bodyRotation;
+				m_BodyInterface->GetPositionAndRotation(comp.BodyID, bodyPosition, bodyRotation);
+				if (bodyPosition.IsClose(position) && bodyRotation.IsClose(rotation)) return;
+				job.moves.push_back({comp.BodyID, position, rotation, comp.GetActivation()});
 			});
 		}
+
+		{
+			MGN_PROFILE_SCOPE("Apply To Bodies");
+			for (SyncJob &job: m_SyncJobs) {
+				for (const BodyMove &move: job.moves) {
+					m_BodyInterface->SetPositionAndRotation(move.id, move.position, move.rotation, move.activation);
+				}
+				for (const EntityID id: job.entities) {
+					CreateOrRefreshBody(id, scene);
+				}
+			}
+		}
+	}
+
+	void PhysicsLayer::CreateOrRefreshBody(const EntityID id, Scene &scene) {
+		Physicalisable &comp = *scene.GetComponent<Physicalisable>(id);
+		const Entity &entity = std::as_const(scene).GetEntity(id);
+		const Vec3 pos = entity.LocalPosition;
+		const Quat rot = entity.LocalRotation;
+		const JPH::EActivation activation = comp.GetActivation();
+
+		const JPH::ShapeRefC shape = comp.GetShape();
+		if (!shape) return;
+
+		if (comp.BodyID.IsInvalid()) {
+			JPH::BodyCreationSettings creationSettings = {shape, JPH::RVec3Arg{pos.x, pos.y, pos.z}, JPH::QuatArg{rot.x, rot.y, rot.z, rot.w}, comp.GetMotionType(), comp.GetLayer()};
+			creationSettings.mAllowDynamicOrKinematic = true;
+			comp.BodyID = m_BodyInterface->CreateAndAddBody(creationSettings, activation);
+			m_BodyInterface->SetFriction(comp.BodyID, comp.GetFriction());
+			m_BodyInterface->SetGravityFactor(comp.BodyID, comp.GetGravityFactor());
+		}
 		else {
-			MGN_PROFILE_SCOPE("Update Scene Transform");
-			scene->ForEachWithComponent<Physicalisable>([this](Scene *scene, EntityID id, Physicalisable &comp) {
+			m_BodyInterface->SetPositionAndRotation(comp.BodyID, JPH::RVec3Arg{pos.x, pos.y, pos.z}, JPH::QuatArg{rot.x, rot.y, rot.z, rot.w}, activation);
+			m_BodyInterface->SetShape(comp.BodyID, shape, true, activation);
+			m_BodyInterface->SetMotionType(comp.BodyID, comp.GetMotionType(), activation);
+			m_BodyInterface->SetObjectLayer(comp.BodyID, comp.GetLayer());
+			m_BodyInterface->SetFriction(comp.BodyID, comp.GetFriction());
+			m_BodyInterface->SetGravityFactor(comp.BodyID, comp.GetGravityFactor());
+		}
+		comp.dirty = false;
+	}
+
+	void PhysicsLayer::SyncFromBodies(Scene &scene) {
+		MGN_PROFILE_FUNCTION();
+		PrepareSyncJobs();
+		m_InterpolatedScenes.insert(scene.GetID());
+
+		{
+			MGN_PROFILE_SCOPE("Write Active Bodies");
+			const Real alpha = static_cast<Real>(m_Timestep.GetAlpha());
+			scene.ParallelForEachWithComponent<Physicalisable>([this, &scene, alpha](const EntityID id, Physicalisable &comp) {
 				if (comp.BodyID.IsInvalid()) return;
-				const TransformR trs = scene->GetTransform(id);
-				const auto wpos = Convert(m_BodyInterface->GetPosition(comp.BodyID));
-				const auto wrot = Convert(m_BodyInterface->GetRotation(comp.BodyID));
-				Entity &entity = scene->GetEntity(id);
-				entity.LocalPosition = wpos;
-				entity.LocalRotation = wrot;
+				const uint32_t thread = JobSystem::GetThreadIndex();
+				SyncJob &job = m_SyncJobs[thread == JobSystem::c_InvalidThreadIndex ? 0 : thread];
+
 				const Vec3 lin = comp.GetLinearVelocity();
 				const Vec3 ang = comp.GetRadAngularVelocity();
-				m_BodyInterface->AddLinearAndAngularVelocity(comp.BodyID, JPH::Vec3(lin.x, lin.y, lin.z), JPH::Vec3(ang.x, ang.y, ang.z));
+				if (lin != Vec3(0) || ang != Vec3(0)) {
+					job.velocities.push_back({comp.BodyID, Convert(lin), Convert(ang)});
+					comp.SetLinearVelocity(Vec3(0));
+					comp.SetRadAngularVelocity(Vec3(0));
+				}
+
+				// The bodies neither active now nor before the last step haven't moved.
+				const uint32_t index = comp.BodyID.GetIndex();
+				if (index >= m_BodyStates.size()) return;
+				const BodyState &state = m_BodyStates[index];
+				const bool saved = state.id == comp.BodyID && state.step == m_StepIndex;
+				if (!saved && state.activeFrame != m_SyncFrame) return;
+
+				JPH::RVec3 position;
+				JPH::Quat rotation;
+				m_BodyInterface->GetPositionAndRotation(comp.BodyID, position, rotation);
+				Vec3 wpos = Convert(position);
+				Quat wrot = Convert(rotation);
+
+				// Blend with the state before the last step if the body was saved then.
+				if (saved) {
+					wpos = glm::mix(Convert(state.position), wpos, alpha);
+					wrot = glm::slerp(Convert(state.rotation), wrot, alpha);
+				}
+
+				if (!scene.WriteRootTransform(id, wpos, wrot)) {
+					job.entities.push_back(id);
+				}
+			});
+		}
+
+		{
+			MGN_PROFILE_SCOPE("Apply To Scene");
+			for (const SyncJob &job: m_SyncJobs) {
+				for (const EntityID id: job.entities) {
+					scene.MarkTransformDirty(id);
+				}
+				for (const BodyVelocity &velocity: job.velocities) {
+					m_BodyInterface->AddLinearAndAngularVelocity(velocity.id, velocity.linear, velocity.angular);
+				}
+				if (m_Recording && !m_Recording->frames.empty()) {
+					for (const BodyVelocity &velocity: job.velocities) {
+						m_Recording->impulses.push_back({velocity.id.GetIndexAndSequenceNumber(), {velocity.linear.GetX(), velocity.linear.GetY(), velocity.linear.GetZ()}, {velocity.angular.GetX(), velocity.angular.GetY(), velocity.angular.GetZ()}});
+					}
+					m_Recording->frames.back().impulseCount += static_cast<uint32_t>(job.velocities.size());
+				}
+			}
+			// Only the entities with children or not cached yet are left.
+			scene.CacheTransforms();
+		}
+	}
+
+	void PhysicsLayer::SnapToBodies(Scene &scene) {
+		MGN_PROFILE_FUNCTION();
+		PrepareSyncJobs();
+
+		scene.ParallelForEachWithComponent<Physicalisable>([this, &scene](const EntityID id, Physicalisable &comp) {
+			if (comp.BodyID.IsInvalid()) return;
+			const uint32_t thread = JobSystem::GetThreadIndex();
+			SyncJob &job = m_SyncJobs[thread == JobSystem::c_InvalidThreadIndex ? 0 : thread];
+
+			JPH::RVec3 position;
+			JPH::Quat rotation;
+			m_BodyInterface->GetPositionAndRotation(comp.BodyID, position, rotation);
+			if (!scene.WriteRootTransform(id, Convert(position), Convert(rotation))) {
+				job.entities.push_back(id);
+			}
+		});
+
+		for (const SyncJob &job: m_SyncJobs) {
+			for (const EntityID id: job.entities) {
+				scene.MarkTransformDirty(id);
+			}
+		}
+		scene.CacheTransforms();
+	}
+
+	std::vector<uint8_t> PhysicsLayer::SaveSnapshot(const std::span<const std::shared_ptr<Scene>> scenes) {
+		MGN_PROFILE_FUNCTION();
+		// The bodies waiting for deletion have no component left to give them back to.
+		FlushDeletions();
+
+		std::vector<PhysicsSnapshotComponent> components;
+		for (const std::shared_ptr<Scene> &scene: scenes) {
+			if (!scene) continue;
+			const UUID::Array64 sceneId = ToArray(scene->GetID());
+			std::as_const(*scene).ForEachWithComponent<Physicalisable>([&components, &sceneId](const Scene *, const EntityID id, const Physicalisable &comp) {
+				components.push_back({sceneId, id.id, comp.BodyID.GetIndexAndSequenceNumber(), comp.Shape, comp.LinearVelocity, comp.AngularVelocity, comp.Friction, comp.GravityFactor, comp.RBType, comp.IsAwake});
+			});
+		}
+
+		JPH::BodyIDVector bodies;
+		m_PhysicsSystem->GetBodies(bodies);
+
+		PhysicsSnapshotHeader header{};
+		header.settings = m_Timestep.GetSettings();
+		header.accumulator = m_Timestep.GetAccumulator();
+		header.bodyCount = static_cast<uint32_t>(bodies.size());
+		header.componentCount = static_cast<uint32_t>(components.size());
+
+		JPH::StateRecorderImpl recorder;
+		recorder.Write(header);
+
+		// The creation settings rebuild the bodies without the assets their shape came from.
+		JPH::BodyCreationSettings::ShapeToIDMap shapeMap;
+		JPH::BodyCreationSettings::MaterialToIDMap materialMap;
+		JPH::BodyCreationSettings::GroupFilterToIDMap groupFilterMap;
+		const JPH::BodyLockInterfaceNoLock &lockInterface = m_PhysicsSystem->GetBodyLockInterfaceNoLock();
+		for (const JPH::BodyID id: bodies) {
+			const JPH::BodyLockRead lock(lockInterface, id);
+			const JPH::Body &body = lock.GetBody();
+			recorder.Write(id.GetIndexAndSequenceNumber());
+			recorder.Write(body.IsActive());
+			body.GetBodyCreationSettings().SaveWithChildren(recorder, &shapeMap, &materialMap, &groupFilterMap);
+		}
+
+		for (const PhysicsSnapshotComponent &component: components) {
+			recorder.Write(component);
+		}
+
+		m_PhysicsSystem->SaveState(recorder);
+
+		const std::string data = recorder.GetData();
+		return {data.begin(), data.end()};
+	}
+
+	bool PhysicsLayer::RestoreSnapshot(const std::span<const uint8_t> snapshot, const std::span<const std::shared_ptr<Scene>> scenes) {
+		MGN_PROFILE_FUNCTION();
+		JPH::StateRecorderImpl recorder;
+		recorder.WriteBytes(snapshot.data(), snapshot.size());
+
+		PhysicsSnapshotHeader header{};
+		recorder.Read(header);
+		if (recorder.IsFailed() || header.magic != c_PhysicsSnapshotMagic || header.version != c_PhysicsSnapshotVersion) {
+			MGN_CORE_ERROR("[PhysicsLayer] The data is not a physics snapshot of version {}.", c_PhysicsSnapshotVersion);
+			return false;
+		}
 
-				comp.SetLinearVelocity(Vec3(0));
-				comp.SetRadAngularVelocity(Vec3(0));
+		// A new system starts with the same broad phase and caches each time the snapshot is restored, the simulation then runs the same.
+		CreatePhysicsSystem();
+		m_BodyStates.clear();
+		{
+			// The components that queued them belonged to the previous system.
+			auto lock = std::scoped_lock(s_DeletionMutex);
+			s_BodyToDelete.clear();
+		}
+		for (const std::shared_ptr<Scene> &scene: scenes) {
+			if (!scene) continue;
+			scene->ForEachWithComponent<Physicalisable>([](Scene *, EntityID, Physicalisable &comp) {
+				comp.BodyID = JPH::BodyID{};
+				comp.dirty = true;
 			});
-			scene->CacheTransforms();
 		}
+
+		JPH::BodyCreationSettings::IDToShapeMap shapeMap;
+		JPH::BodyCreationSettings::IDToMaterialMap materialMap;
+		JPH::BodyCreationSettings::IDToGroupFilterMap groupFilterMap;
+		for (uint32_t i = 0; i < header.bodyCount; ++i) {
+			uint32_t id{JPH::BodyID::cInvalidBodyID};
+			bool active{false};
+			recorder.Read(id);
+			recorder.Read(active);
+			const JPH::BodyCreationSettings::BCSResult settings = JPH::BodyCreationSettings::sRestoreWithChildren(recorder, shapeMap, materialMap, groupFilterMap);
+			if (recorder.IsFailed() || settings.HasError()) {
+				MGN_CORE_ERROR("[PhysicsLayer] The body {} of the physics snapshot is corrupted.", i);
+				CreatePhysicsSystem();
+				return false;
+			}
+
+			const JPH::Body *body = m_BodyInterface->CreateBodyWithID(JPH::BodyID{id}, settings.Get());
+			if (!body) {
+				MGN_CORE_ERROR("[PhysicsLayer] The body {} of the physics snapshot couldn't be created.", i);
+				CreatePhysicsSystem();
+				return false;
+			}
+			m_BodyInterface->AddBody(body->GetID(), active ? JPH::EActivation::Activate : JPH::EActivation::DontActivate);
+		}
+		m_PhysicsSystem->OptimizeBroadPhase();
+
+		std::vector<PhysicsSnapshotComponent> components(header.componentCount);
+		for (PhysicsSnapshotComponent &component: components) {
+			recorder.Read(component);
+		}
+
+		if (recorder.IsFailed() || !m_PhysicsSystem->RestoreState(recorder)) {
+			MGN_CORE_ERROR("[PhysicsLayer] The state of the physics snapshot is corrupted.");
+			CreatePhysicsSystem();
+			return false;
+		}
+
+		m_Timestep.SetSettings(header.settings);
+		m_Timestep.SetAccumulator(header.accumulator);
+		// The accumulator restored is kept by the next update.
+		m_WasSimulating = s_Simulate;
+		// The entities are moved to their body below.
+		m_InterpolatedScenes.clear();
+
+		for (const PhysicsSnapshotComponent &component: components) {
+			const auto it = std::ranges::find_if(scenes, [&component](const std::shared_ptr<Scene> &scene) {
+				return scene && ToArray(scene->GetID()) == component.scene;
+			});
+			if (it == scenes.end() || !(*it)->Exist(component.entity)) continue;
+
+			Scene &scene = **it;
+			Physicalisable &comp = *scene.GetOrAddComponent<Physicalisable>(component.entity);
+			comp.Shape = component.shape;
+			comp.RBType = component.type;
+			comp.LinearVelocity = component.linearVelocity;
+			comp.AngularVelocity = component.angularVelocity;
+			comp.Friction = component.friction;
+			comp.GravityFactor = component.gravityFactor;
+			comp.IsAwake = component.isAwake;
+			comp.BodyID = JPH::BodyID{component.body};
+			if (comp.BodyID.IsInvalid()) continue;
+
+			// The entities follow their body, the paused sync would otherwise move the bodies back.
+			JPH::RVec3 position;
+			JPH::Quat rotation;
+			m_BodyInterface->GetPositionAndRotation(comp.BodyID, position, rotation);
+			scene.SetLocalPosition(component.entity, Convert(position));
+			scene.SetLocalRotation(component.entity, Convert(rotation));
+			comp.dirty = false;
+		}
+
+		return true;
+	}
+
+	uint64_t PhysicsLayer::HashState() const {
+		MGN_PROFILE_FUNCTION();
+		JPH::StateRecorderImpl recorder;
+		m_PhysicsSystem->SaveState(recorder);
+		const std::string data = recorder.GetData();
+		return Hasher::xxHash64(ConstBufferView{data.data(), data.size()});
+	}
+
+	void PhysicsLayer::StartRecording(const std::span<const std::shared_ptr<Scene>> scenes) {
+		if (m_Recording) return;
+		if (!s_Simulate) {
+			MGN_CORE_WARNING("[PhysicsLayer] Only a simulated run can be recorded.");
+			return;
+		}
+
+		PhysicsRecording recording;
+		recording.snapshot = SaveSnapshot(scenes);
+		// The replay starts from the restored snapshot, the recorded run must too.
+		if (!RestoreSnapshot(recording.snapshot, scenes)) return;
+		m_Recording = std::move(recording);
+		MGN_CORE_INFO("[PhysicsLayer] Recording the simulation.");
+	}
+
+	std::optional<PhysicsRecording> PhysicsLayer::StopRecording() {
+		if (!m_Recording) return std::nullopt;
+		std::optional<PhysicsRecording> recording = std::move(m_Recording);
+		m_Recording.reset();
+		recording->finalHash = HashState();
+		MGN_CORE_INFO("[PhysicsLayer] Recorded {} frames of simulation.", recording->frames.size());
+		return recording;
+	}
+
+	PhysicsReplayStats PhysicsLayer::Replay(const PhysicsRecording &recording) {
+		MGN_PROFILE_FUNCTION();
+		PhysicsReplayStats stats{};
+		if (!RestoreSnapshot(recording.snapshot, {})) return stats;
+
+		// The bodies get exactly what they got in the recorded run, through the same calls.
+		std::vector<JPH::BodyID> deletions;
+		for (const PhysicsRecordedFrame &frame: recording.frames) {
+			if (frame.deletionCount) {
+				deletions.clear();
+				for (uint32_t i = 0; i < frame.deletionCount; ++i) {
+					deletions.emplace_back(recording.deletions[frame.firstDeletion + i]);
+				}
+				m_BodyInterface->RemoveBodies(deletions.data(), static_cast<int>(deletions.size()));
+				m_BodyInterface->DestroyBodies(deletions.data(), static_cast<int>(deletions.size()));
+			}
+
+			stats.steps += Simulate(frame.deltaTime);
+			stats.stepsMs += m_StepStats.stepsMs;
+			stats.maxStepMs = std::max(stats.maxStepMs, m_StepStats.maxStepMs);
+
+			for (uint32_t i = 0; i < frame.impulseCount; ++i) {
+				const PhysicsRecordedImpulse &impulse = recording.impulses[frame.firstImpulse + i];
+				m_BodyInterface->AddLinearAndAngularVelocity(JPH::BodyID{impulse.body}, JPH::Vec3{impulse.linear.x, impulse.linear.y, impulse.linear.z}, JPH::Vec3{impulse.angular.x, impulse.angular.y, impulse.angular.z});
+			}
+			++stats.frames;
+		}
+
+		stats.identical = HashState() == recording.finalHash;
+		return stats;
 	}
 } // namespace Imagine
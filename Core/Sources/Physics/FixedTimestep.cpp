@@ -0,0 +1,55 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Physics/FixedTimestep.hpp"
+
+namespace Imagine {
+
+	FixedTimestep::FixedTimestep(const FixedTimestepSettings &settings) {
+		SetSettings(settings);
+	}
+
+	void FixedTimestep::SetSettings(const FixedTimestepSettings &settings) {
+		m_Settings = settings;
+		m_Settings.Rate = std::max(m_Settings.Rate, 1u);
+		m_Settings.MaxSubSteps = std::max(m_Settings.MaxSubSteps, 1u);
+		m_Settings.CollisionSteps = std::max(m_Settings.CollisionSteps, 1u);
+
+		// The accumulator always holds less than a step.
+		const double step = GetStep();
+		if (m_Accumulator >= step) {
+			m_Accumulator = std::fmod(m_Accumulator, step);
+		}
+	}
+
+	uint32_t FixedTimestep::Advance(const double seconds) {
+		const double step = GetStep();
+		m_Accumulator += std::max(seconds, 0.0);
+
+		// A small tolerance so a frame lasting exactly a step doesn't alternate between 0 and 2 steps due to rounding.
+		const double steps = std::floor(m_Accumulator / step + 1e-9);
+		uint32_t count = static_cast<uint32_t>(std::min(steps, static_cast<double>(m_Settings.MaxSubSteps)));
+		m_Accumulator = std::max(m_Accumulator - static_cast<double>(count) * step, 0.0);
+
+		if (m_Accumulator >= step) {
+			// Keep the fraction of a step so the interpolation continues, the rest is lost.
+			const double kept = std::fmod(m_Accumulator, step);
+			m_Stats.droppedSeconds += m_Accumulator - kept;
+			++m_Stats.clampedFrames;
+			m_Accumulator = kept;
+		}
+
+		m_Stats.steps += count;
+		return count;
+	}
+
+	void FixedTimestep::Reset() {
+		m_Accumulator = 0.0;
+	}
+
+	void FixedTimestep::SetAccumulator(const double seconds) {
+		m_Accumulator = std::clamp(seconds, 0.0, std::nextafter(GetStep(), 0.0));
+	}
+
+} // namespace Imagine
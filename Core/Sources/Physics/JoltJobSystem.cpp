@@ -0,0 +1,92 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Imagine/Physics/JoltJobSystem.hpp"
+#include "Imagine/Core/JobSystem.hpp"
+
+namespace Imagine {
+
+	JoltJobSystem::JoltJobSystem(const JPH::uint maxJobs, const JPH::uint maxBarriers) :
+		JPH::JobSystemWithBarrier(maxBarriers) {
+		m_Jobs.Init(maxJobs, maxJobs);
+	}
+
+	int JoltJobSystem::GetMaxConcurrency() const {
+		return static_cast<int>(JobSystem::GetThreadCount());
+	}
+
+	JPH::JobHandle JoltJobSystem::CreateJob(const char *inName, const JPH::ColorArg inColor, const JobFunction &inJobFunction, const JPH::uint32 inNumDependencies) {
+		// Loop until we can get a job from the free list, same as the JPH::JobSystemThreadPool.
+		JPH::uint32 index;
+		for (;;) {
+			index = m_Jobs.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies);
+			if (index != AvailableJobs::cInvalidObjectIndex) break;
+			MGN_CORE_WARNING("No physics jobs available, waiting.");
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+		Job *job = &m_Jobs.Get(index);
+
+		// Construct handle to keep a reference, the job is queued below and may immediately complete.
+		JPH::JobHandle handle(job);
+
+		if (inNumDependencies == 0) {
+			QueueJob(job);
+		}
+
+		return handle;
+	}
+
+	void JoltJobSystem::QueueJob(Job *inJob) {
+		// Without workers nothing would ever drain the queue, the job runs right away as in the JPH::JobSystemSingleThreaded.
+		if (JobSystem::GetWorkerCount() == 0) {
+			RunJob(inJob);
+			return;
+		}
+
+		// The reference is released once the job has been executed.
+		inJob->AddRef();
+		const JobSystem::Job job{&JoltJobSystem::ExecuteJob, inJob, 0, 1, nullptr};
+		JobSystem::Submit(&job, 1);
+	}
+
+	void JoltJobSystem::QueueJobs(Job **inJobs, const JPH::uint inNumJobs) {
+		if (JobSystem::GetWorkerCount() == 0) {
+			for (JPH::uint i = 0; i < inNumJobs; ++i) {
+				RunJob(inJobs[i]);
+			}
+			return;
+		}
+
+		// Submitting by batch wakes the workers once instead of once per job.
+		std::array<JobSystem::Job, 64> jobs{};
+		uint32_t count = 0;
+		for (JPH::uint i = 0; i < inNumJobs; ++i) {
+			inJobs[i]->AddRef();
+			jobs[count++] = JobSystem::Job{&JoltJobSystem::ExecuteJob, inJobs[i], 0, 1, nullptr};
+			if (count == jobs.size()) {
+				JobSystem::Submit(jobs.data(), count);
+				count = 0;
+			}
+		}
+		JobSystem::Submit(jobs.data(), count);
+	}
+
+	void JoltJobSystem::FreeJob(Job *inJob) {
+		m_Jobs.DestructObject(inJob);
+	}
+
+	void JoltJobSystem::RunJob(Job *job) {
+		// Keep the job alive while it runs, its handles may be released by the job itself.
+		job->AddRef();
+		job->Execute();
+		job->Release();
+	}
+
+	void JoltJobSystem::ExecuteJob(void *data, uint32_t begin, uint32_t end) {
+		Job *job = static_cast<Job *>(data);
+		job->Execute();
+		job->Release();
+	}
+
+} // namespace Imagine
@@ -15,11 +15,11 @@
 namespace Imagine {
 	void PhysicsDebugRenderer::DrawLine(JPH::RVec3Arg inFrom, JPH::RVec3Arg inTo, JPH::ColorArg inColor) {
 		MGN_PROFILE_FUNCTION();
-		// TODO: Do something as that's way to slow
-		LineObject line;
-		line.points.push_back({{inFrom.GetX(), inFrom.GetY(), inFrom.GetZ()}});
-		line.points.push_back({{inTo.GetX(), inTo.GetY(), inTo.GetZ()}});
-		s_Lines.push_back(line);
+		Vertex *vertices = s_Lines.Append(2);
+		if (!vertices) return;
+		const Vec4 color = Convert(inColor);
+		vertices[0] = Vertex::PC({inFrom.GetX(), inFrom.GetY(), inFrom.GetZ()}, color);
+		vertices[1] = Vertex::PC({inTo.GetX(), inTo.GetY(), inTo.GetZ()}, color);
 	}
 
 	std::tuple<Imagine::Vertex, Imagine::Vertex, Imagine::Vertex> CreateTriangle(JPH::RVec3Arg inV1, JPH::RVec3Arg inV2, JPH::RVec3Arg inV3, JPH::ColorArg inColor) {
@@ -34,10 +34,9 @@ namespace Imagine {
 
 	void PhysicsDebugRenderer::DrawTriangle(JPH::RVec3Arg inV1, JPH::RVec3Arg inV2, JPH::RVec3Arg inV3, JPH::ColorArg inColor, ECastShadow inCastShadow) {
 		MGN_PROFILE_FUNCTION();
-		auto [a,b,c] = CreateTriangle(inV1, inV2, inV3, inColor);
-		s_Vertices.push_back(a);
-		s_Vertices.push_back(b);
-		s_Vertices.push_back(c);
+		Vertex *vertices = s_Triangles.Append(3);
+		if (!vertices) return;
+		std::tie(vertices[0], vertices[1], vertices[2]) = CreateTriangle(inV1, inV2, inV3, inColor);
 	}
 
 	void PhysicsDebugRenderer::DrawText3D(JPH::RVec3Arg inPosition, const std::string_view &inString, JPH::ColorArg inColor, float inHeight) {
@@ -0,0 +1,91 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Physics/PhysicsRecording.hpp"
+#include "Imagine/Core/FileSystem.hpp"
+#include "Imagine/Core/Logger.hpp"
+
+namespace Imagine {
+
+	namespace {
+		template<typename T>
+		void Append(std::vector<uint8_t> &bytes, const T *data, const uint64_t count) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			if (count == 0) return;
+			const auto *begin = reinterpret_cast<const uint8_t *>(data);
+			bytes.insert(bytes.end(), begin, begin + count * sizeof(T));
+		}
+
+		template<typename T>
+		bool Extract(const std::vector<uint8_t> &bytes, uint64_t &offset, std::vector<T> &data, const uint64_t count) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			if (count > (bytes.size() - offset) / sizeof(T)) return false;
+			data.resize(count);
+			if (count) memcpy(data.data(), bytes.data() + offset, count * sizeof(T));
+			offset += count * sizeof(T);
+			return true;
+		}
+	} // namespace
+
+	bool PhysicsRecording::Write(const std::filesystem::path &filePath) const {
+		PhysicsRecordingHeader header{};
+		header.snapshotSize = snapshot.size();
+		header.frameCount = frames.size();
+		header.deletionCount = deletions.size();
+		header.impulseCount = impulses.size();
+		header.finalHash = finalHash;
+
+		std::vector<uint8_t> bytes;
+		bytes.reserve(sizeof(header) + snapshot.size() + frames.size() * sizeof(PhysicsRecordedFrame) + deletions.size() * sizeof(uint32_t) + impulses.size() * sizeof(PhysicsRecordedImpulse));
+		Append(bytes, &header, 1);
+		Append(bytes, snapshot.data(), snapshot.size());
+		Append(bytes, frames.data(), frames.size());
+		Append(bytes, deletions.data(), deletions.size());
+		Append(bytes, impulses.data(), impulses.size());
+
+		if (!FileSystem::WriteBinaryFile(filePath, ConstBufferView{bytes.data(), bytes.size()})) {
+			MGN_CORE_ERROR("The physics recording couldn't be written to '{}'.", filePath.string());
+			return false;
+		}
+		return true;
+	}
+
+	std::optional<PhysicsRecording> PhysicsRecording::Read(const std::filesystem::path &filePath) {
+		const std::vector<uint8_t> bytes = FileSystem::ReadBinaryFileInVector(filePath);
+		if (bytes.size() < sizeof(PhysicsRecordingHeader)) {
+			MGN_CORE_ERROR("The file '{}' is too small to be a physics recording.", filePath.string());
+			return std::nullopt;
+		}
+
+		PhysicsRecordingHeader header;
+		memcpy(&header, bytes.data(), sizeof(header));
+		if (header.magic != c_PhysicsRecordingMagic || header.version != c_PhysicsRecordingVersion) {
+			MGN_CORE_ERROR("The file '{}' is not a physics recording of version {}.", filePath.string(), c_PhysicsRecordingVersion);
+			return std::nullopt;
+		}
+
+		PhysicsRecording recording;
+		recording.finalHash = header.finalHash;
+		uint64_t offset = sizeof(header);
+		bool valid =
+				Extract(bytes, offset, recording.snapshot, header.snapshotSize) &&
+				Extract(bytes, offset, recording.frames, header.frameCount) &&
+				Extract(bytes, offset, recording.deletions, header.deletionCount) &&
+				Extract(bytes, offset, recording.impulses, header.impulseCount);
+
+		for (uint64_t i = 0; i < recording.frames.size() && valid; ++i) {
+			const PhysicsRecordedFrame &frame = recording.frames[i];
+			valid = static_cast<uint64_t>(frame.firstDeletion) + frame.deletionCount <= recording.deletions.size() &&
+					static_cast<uint64_t>(frame.firstImpulse) + frame.impulseCount <= recording.impulses.size();
+		}
+
+		if (!valid) {
+			MGN_CORE_ERROR("The physics recording '{}' is corrupted.", filePath.string());
+			return std::nullopt;
+		}
+
+		return recording;
+	}
+
+} // namespace Imagine
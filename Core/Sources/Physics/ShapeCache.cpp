@@ -0,0 +1,138 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Physics/ShapeCache.hpp"
+
+#include "Imagine/Assets/AssetField.hpp"
+#include "Imagine/Rendering/CPU/CPUMesh.hpp"
+
+#include <cassert>
+
+namespace Imagine {
+
+	namespace {
+		struct ShapeKey {
+			uint32_t type{0};
+			std::array<Real, 3> dimensions{0, 0, 0};
+			AssetHandle mesh{NULL_ASSET_HANDLE};
+
+			bool operator==(const ShapeKey &other) const { return type == other.type && dimensions == other.dimensions && mesh == other.mesh; }
+		};
+
+		struct ShapeKeyHash {
+			uint64_t operator()(const ShapeKey &key) const {
+				uint64_t hash = std::hash<AssetHandle>{}(key.mesh) ^ key.type;
+				for (const Real dimension: key.dimensions) {
+					hash ^= std::hash<Real>{}(dimension) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+				}
+				return hash;
+			}
+		};
+
+		ShapeKey MakeKey(const ColliderShapes::Box &box) { return {Physicalisable::Box, {box.Size.x, box.Size.y, box.Size.z}}; }
+		ShapeKey MakeKey(const ColliderShapes::Sphere &sphere) { return {Physicalisable::Sphere, {sphere.Radius, 0, 0}}; }
+		ShapeKey MakeKey(const ColliderShapes::Capsule &capsule) { return {Physicalisable::Capsule, {capsule.Height, capsule.Radius, 0}}; }
+		ShapeKey MakeKey(const ColliderShapes::Cylinder &cylinder) { return {Physicalisable::Cylinder, {cylinder.Height, cylinder.Radius, 0}}; }
+		ShapeKey MakeKey(const ColliderShapes::ConvexHull &hull) { return {Physicalisable::ConvexHull, {0, 0, 0}, hull.MeshHandle}; }
+		ShapeKey MakeKey(const ColliderShapes::Mesh &mesh) { return {Physicalisable::Mesh, {0, 0, 0}, mesh.MeshHandle}; }
+
+		struct CachedShape {
+			JPH::ShapeRefC shape;
+			/// The mesh the shape was built from, a reloaded mesh gets a new shape.
+			Weak<CPUMesh> mesh;
+		};
+
+		struct ShapeCacheData {
+			std::mutex mutex;
+			std::unordered_map<ShapeKey, CachedShape, ShapeKeyHash> shapes;
+			ShapeCacheStats stats;
+
+			~ShapeCacheData() {
+				// The shapes must be released while Jolt is still alive, 'PhysicsLayer::OnDetach' clears the cache.
+				assert(shapes.empty());
+			}
+
+			void Release(const JPH::Shape &shape) {
+				const JPH::Shape::Stats shapeStats = shape.GetStats();
+				stats.bytes -= shapeStats.mSizeBytes;
+				stats.triangles -= shapeStats.mNumTriangles;
+				--stats.shapes;
+			}
+		};
+
+		ShapeCacheData &GetData() {
+			static ShapeCacheData s_Data;
+			return s_Data;
+		}
+	} // namespace
+
+	JPH::ShapeRefC ShapeCache::GetShape(const Physicalisable::ShapeVariant &shape) {
+		const ShapeKey key = std::visit([](const auto &args) { return MakeKey(args); }, shape);
+
+		// The shapes built from a mesh are only valid for the mesh currently loaded under the handle.
+		Ref<CPUMesh> mesh{nullptr};
+		if (key.mesh != NULL_ASSET_HANDLE) {
+			const AssetField<CPUMesh> meshAsset{key.mesh};
+			if (meshAsset.IsValid()) mesh = meshAsset.GetAsset();
+		}
+
+		ShapeCacheData &data = GetData();
+		auto lock = std::scoped_lock(data.mutex);
+		const auto it = data.shapes.find(key);
+		if (it != data.shapes.end()) {
+			if (it->second.mesh.lock() == mesh) {
+				++data.stats.hits;
+				return it->second.shape;
+			}
+			// The mesh was unloaded or reloaded since.
+			data.Release(*it->second.shape);
+			data.shapes.erase(it);
+		}
+
+		++data.stats.misses;
+		JPH::ShapeRefC created = std::visit([](const auto &args) { return ColliderShapes::CreateShape(args); }, shape);
+		// Not cached, a mesh not loaded yet can succeed later.
+		if (!created) return nullptr;
+
+		const JPH::Shape::Stats stats = created->GetStats();
+		data.stats.bytes += stats.mSizeBytes;
+		data.stats.triangles += stats.mNumTriangles;
+		++data.stats.shapes;
+		data.shapes.emplace(key, CachedShape{created, mesh});
+		return created;
+	}
+
+	uint32_t ShapeCache::Purge() {
+		ShapeCacheData &data = GetData();
+		auto lock = std::scoped_lock(data.mutex);
+		uint32_t released = 0;
+		for (auto it = data.shapes.begin(); it != data.shapes.end();) {
+			// The reference of the cache is the last one.
+			if (it->second.shape->GetRefCount() > 1) {
+				++it;
+				continue;
+			}
+			data.Release(*it->second.shape);
+			it = data.shapes.erase(it);
+			++released;
+		}
+		return released;
+	}
+
+	void ShapeCache::Clear() {
+		ShapeCacheData &data = GetData();
+		auto lock = std::scoped_lock(data.mutex);
+		data.shapes.clear();
+		data.stats.shapes = 0;
+		data.stats.bytes = 0;
+		data.stats.triangles = 0;
+	}
+
+	ShapeCacheStats ShapeCache::GetStats() {
+		ShapeCacheData &data = GetData();
+		auto lock = std::scoped_lock(data.mutex);
+		return data.stats;
+	}
+
+} // namespace Imagine
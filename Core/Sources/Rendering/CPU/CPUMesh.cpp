@@ -44,6 +44,7 @@ namespace Imagine {
 		Vertices.swap(o.Vertices);
 		Indices.swap(o.Indices);
 		Lods.swap(o.Lods);
+		std::swap(Layout, o.Layout);
 		std::swap(aabb, o.aabb);
 	}
 
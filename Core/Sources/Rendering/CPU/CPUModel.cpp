@@ -5,18 +5,39 @@
 #include "Imagine/Rendering/CPU/CPUModel.hpp"
 
 #include "Imagine/Assets/AssetManager.hpp"
+#include "Imagine/Assets/Importers/ModelCache.hpp"
 #include "Imagine/Components/Physicalisable.hpp"
 #include "Imagine/Components/Renderable.hpp"
 #include "Imagine/Rendering/CPU/CPUMaterialInstance.hpp"
+#include "Imagine/Rendering/MeshOptimizer.hpp"
 #include "Imagine/Rendering/Renderer.hpp"
 #include "Imagine/Scene/Scene.hpp"
 
 #include "Imagine/ThirdParty/Assimp.hpp"
 #include "Imagine/ThirdParty/Stb.hpp"
 
-#define LOAD_ASSET(ASSET) Imagine::Project::GetActive()->GetAssetManager()->AddAsset(ASSET);
+#define LOAD_ASSET(ASSET) do { if (Imagine::Project *project = Imagine::Project::GetActive()) project->GetAssetManager()->AddAsset(ASSET); } while (false)
 
 namespace Imagine {
+	namespace {
+		/// Add the assets of a cooked model to the asset manager, as done by 'ImportModel' while importing.
+		void RegisterModelAssets(const CPUModel &model) {
+			for (const Ref<CPUShader> &shader: model.Shaders) {
+				LOAD_ASSET(shader);
+			}
+			for (const Ref<CPUTexture2D> &texture: model.Textures) {
+				LOAD_ASSET(texture);
+			}
+			LOAD_ASSET(CPUMaterial::GetDefaultOpaque());
+			LOAD_ASSET(CPUMaterial::GetDefaultTransparent());
+			for (const Ref<CPUMaterialInstance> &instance: model.Instances) {
+				LOAD_ASSET(instance);
+			}
+			for (const Ref<CPUMesh> &mesh: model.Meshes) {
+				LOAD_ASSET(mesh);
+			}
+		}
+	} // namespace
 
 	bool CPUModel::LoadModelInGPU() {
 		Renderer* renderer = Renderer::Get();
@@ -61,6 +82,26 @@ namespace Imagine {
 	}
 
 	Ref<CPUModel> CPUModel::LoadModel(const std::filesystem::path &filePath) {
+		MGN_PROFILE_FUNCTION();
+		// The cooked models are stored in the cache directory of the project.
+		if (!Project::GetActive()) return ImportModel(filePath);
+
+		const uint64_t key = ModelCache::ComputeKey(filePath, ThirdParty::Assimp::GetSmoothPostProcess());
+		const std::filesystem::path cachePath = ModelCache::GetCachePath(filePath);
+		if (Ref<CPUModel> model = ModelCache::Read(cachePath, key)) {
+			model->modelPath = {FileSource::External, filePath};
+			RegisterModelAssets(*model);
+			return model;
+		}
+
+		Ref<CPUModel> model = ImportModel(filePath);
+		if (model && key) {
+			ModelCache::Write(*model, key, cachePath);
+		}
+		return model;
+	}
+
+	Ref<CPUModel> CPUModel::ImportModel(const std::filesystem::path &filePath) {
 		MGN_PROFILE_FUNCTION();
 		using namespace Imagine;
 		Assimp::Importer importer;
@@ -307,6 +348,7 @@ namespace Imagine {
 
 				mesh->Vertices = vertices;
 				mesh->Indices = indices;
+				mesh->CalcAABB();
 
 				LOD surface;
 				surface.index = 0;
@@ -314,6 +356,15 @@ namespace Imagine {
 				surface.materialInstance = model->Instances[aiMesh->mMaterialIndex]->Handle;
 
 				mesh->Lods.push_back(surface);
+				// The imported meshes keep full precision positions, the rest of the vertex is compressed.
+				mesh->Layout = VertexLayout::Compact;
+
+				const MeshOptimizationReport report = MeshOptimizer::Optimize(*mesh);
+				std::string lodTriangles;
+				for (const uint32_t triangles: report.lodTriangles) {
+					lodTriangles += fmt::format("{}{}", lodTriangles.empty() ? "" : ", ", triangles);
+				}
+				MGN_CORE_INFO("Mesh '{}' optimized: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, {} -> {} vertices, LOD triangles [{}].", mesh->Name, report.before.acmr, report.after.acmr, report.before.atvr, report.after.atvr, report.verticesBefore, report.verticesAfter, lodTriangles);
 				LOAD_ASSET(mesh);
 			}
 		}
@@ -439,9 +490,9 @@ namespace Imagine {
 
 			EntityID entityId = coreScene->CreateEntity(parentEntityID);
 			coreScene->SetName(entityId, node->name);
-			coreScene->GetEntity(entityId).LocalPosition = node->LocalPosition;
-			coreScene->GetEntity(entityId).LocalRotation = node->LocalRotation;
-			coreScene->GetEntity(entityId).LocalScale = node->LocalScale;
+			coreScene->SetLocalPosition(entityId, node->LocalPosition);
+			coreScene->SetLocalRotation(entityId, node->LocalRotation);
+			coreScene->SetLocalScale(entityId, node->LocalScale);
 
 			if (node->meshes.size() == 1) {
 				if (auto lock = node->meshes[0].lock()) {
@@ -451,7 +502,7 @@ namespace Imagine {
 					renderable->cpuMeshOrModel = meshHandle;
 
 					// Physicalisable* p = coreScene->AddComponent<Physicalisable>(entityId);
-					// p->Shape =  ColliderShapes::Mesh{AssetField<CPUMesh>{meshHandle}};
+					// p->Shape =  ColliderShapes::Mesh{meshHandle};
 					// p->RBType = RB_Static;
 				}
 
@@ -466,7 +517,7 @@ namespace Imagine {
 						MGN_CORE_CASSERT(renderable);
 						renderable->cpuMeshOrModel = meshHandle;
 						// Physicalisable* p = coreScene->AddComponent<Physicalisable>(meshChild);
-						// p->Shape =  ColliderShapes::Mesh{AssetField<CPUMesh>{meshHandle}};
+						// p->Shape =  ColliderShapes::Mesh{meshHandle};
 						// p->RBType = RB_Static;
 					}
 				}
@@ -0,0 +1,39 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Rendering/DebugDrawBuffer.hpp"
+
+namespace Imagine {
+
+	DebugDrawBuffer::DebugDrawBuffer(const uint32_t capacity) :
+		m_Vertices(capacity) {
+	}
+
+	Vertex *DebugDrawBuffer::Append(const uint32_t count) {
+		const uint64_t first = m_Count.fetch_add(count, std::memory_order_relaxed);
+		const uint64_t capacity = m_Vertices.size();
+		if (first + count <= capacity) return m_Vertices.data() + first;
+
+		// Only one append straddles the end, its part in the buffer is made of degenerate primitives.
+		if (first < capacity) {
+			std::fill(m_Vertices.begin() + static_cast<int64_t>(first), m_Vertices.end(), Vertex{});
+		}
+		return nullptr;
+	}
+
+	std::span<const Vertex> DebugDrawBuffer::GetVertices() const {
+		return {m_Vertices.data(), std::min<uint64_t>(m_Count.load(std::memory_order_acquire), m_Vertices.size())};
+	}
+
+	void DebugDrawBuffer::Reset() {
+		const uint64_t requested = m_Count.exchange(0, std::memory_order_relaxed);
+		if (requested <= m_Vertices.size()) return;
+
+		m_Dropped += requested - m_Vertices.size();
+		const uint64_t capacity = std::bit_ceil(requested);
+		MGN_CORE_WARNING("[DebugDrawBuffer] {} vertices were requested for a capacity of {}, growing to {}.", requested, m_Vertices.size(), capacity);
+		m_Vertices.resize(std::min<uint64_t>(capacity, std::numeric_limits<uint32_t>::max()));
+	}
+
+} // namespace Imagine
@@ -0,0 +1,91 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Rendering/DrawContext.hpp"
+
+namespace Imagine {
+
+	DrawContext::DrawContext(const uint64_t arenaSize) :
+		m_Arena(CreateScope<ScratchAllocator>(arenaSize)) {
+		OpaqueSurfaces = FrameArray<RenderObject>{m_Arena.get()};
+		LineVertices = FrameArray<Vertex>{m_Arena.get()};
+		LineIndices = FrameArray<uint32_t>{m_Arena.get()};
+		PointVertices = FrameArray<Vertex>{m_Arena.get()};
+	}
+
+	DrawContext::~DrawContext() = default;
+
+	void DrawContext::AddLine(const Vertex &from, const Vertex &to) {
+		const uint32_t first = LineVertices.size();
+		LineVertices.push_back(from);
+		LineVertices.push_back(to);
+		LineIndices.push_back(first);
+		LineIndices.push_back(first + 1);
+	}
+
+	void DrawContext::AddLineStrip(const std::span<const Vertex> points) {
+		if (points.size() < 2) return;
+		const uint32_t first = LineVertices.size();
+		const uint32_t segmentCount = static_cast<uint32_t>(points.size()) - 1;
+		LineVertices.Append(points);
+		LineIndices.reserve(LineIndices.size() + segmentCount * 2);
+		for (uint32_t i = 0; i < segmentCount; ++i) {
+			LineIndices.push_back(first + i);
+			LineIndices.push_back(first + i + 1);
+		}
+	}
+
+	void DrawContext::AddLines(const std::span<const Vertex> segments) {
+		const uint32_t first = LineVertices.size();
+		const uint32_t count = static_cast<uint32_t>(segments.size() & ~size_t{1});
+		LineVertices.Append(segments.first(count));
+		LineIndices.reserve(LineIndices.size() + count);
+		for (uint32_t i = 0; i < count; ++i) {
+			LineIndices.push_back(first + i);
+		}
+	}
+
+	void DrawContext::AddPoint(const Vertex &point) {
+		PointVertices.push_back(point);
+	}
+
+	GPUMesh *DrawContext::Retain(Ref<GPUMesh> mesh) {
+		GPUMesh *handle = mesh.get();
+		if (handle) m_Retained.push_back(std::move(mesh));
+		return handle;
+	}
+
+	void DrawContext::Clear() {
+		OpaqueSurfaces.clear();
+		LineVertices.clear();
+		LineIndices.clear();
+		PointVertices.clear();
+		DebugLines = {};
+		DebugTriangles = {};
+	}
+
+	void DrawContext::Reset() {
+		MGN_PROFILE_FUNCTION();
+		const uint32_t surfaceCount = OpaqueSurfaces.size();
+		const uint32_t lineVertexCount = LineVertices.size();
+		const uint32_t lineIndexCount = LineIndices.size();
+		const uint32_t pointCount = PointVertices.size();
+
+		OpaqueSurfaces.Release();
+		LineVertices.Release();
+		LineIndices.Release();
+		PointVertices.Release();
+		DebugLines = {};
+		DebugTriangles = {};
+		m_Retained.clear();
+		m_Arena->Reset();
+
+		// The arena keeps its largest block, so after a few frames a whole frame fits in it without going back to the heap.
+		OpaqueSurfaces.reserve(surfaceCount);
+		LineVertices.reserve(lineVertexCount);
+		LineIndices.reserve(lineIndexCount);
+		PointVertices.reserve(pointCount);
+	}
+
+} // namespace Imagine
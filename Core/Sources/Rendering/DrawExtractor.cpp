@@ -0,0 +1,175 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Imagine/Rendering/DrawExtractor.hpp"
+
+#include "Imagine/Assets/AssetManager.hpp"
+#include "Imagine/Components/Renderable.hpp"
+#include "Imagine/Core/JobSystem.hpp"
+#include "Imagine/Rendering/CPU/CPUMaterialInstance.hpp"
+#include "Imagine/Rendering/CPU/CPUModel.hpp"
+#include "Imagine/Rendering/DrawSort.hpp"
+#include "Imagine/Scene/Scene.hpp"
+
+namespace Imagine {
+
+	void DrawExtractor::ExtractRenderables(const Scene &scene, DrawContext &ctx) {
+		MGN_PROFILE_FUNCTION();
+		ValidateResolved();
+
+		const uint32_t threadCount = JobSystem::GetThreadCount();
+		if (m_ThreadContexts.size() < threadCount) {
+			m_ThreadContexts.resize(threadCount);
+			m_ThreadMisses.resize(threadCount);
+		}
+
+		{
+			MGN_PROFILE_SCOPE("Parallel Extraction");
+			scene.ParallelForEachWithComponent<Renderable>([this, &scene](const EntityID id, const Renderable &renderable) {
+				if (renderable.cpuMeshOrModel == NULL_ASSET_HANDLE) return;
+				// A thread outside of the job system only runs the batches inline, it can use the slot of the main thread.
+				const uint32_t index = JobSystem::GetThreadIndex();
+				const uint32_t thread = index == JobSystem::c_InvalidThreadIndex ? 0 : index;
+
+				const auto it = m_Resolved.find(renderable.cpuMeshOrModel);
+				if (it == m_Resolved.end()) {
+					m_ThreadMisses[thread].push_back({id, renderable.cpuMeshOrModel});
+					return;
+				}
+				Emit(it->second, scene.GetWorldTransform(id), m_ThreadContexts[thread]);
+			}, c_GrainSize);
+		}
+
+		{
+			MGN_PROFILE_SCOPE("Merge Extraction");
+			uint64_t surfaceCount = 0;
+			for (const DrawContext &threadCtx: m_ThreadContexts) {
+				surfaceCount += threadCtx.OpaqueSurfaces.size();
+			}
+			ctx.OpaqueSurfaces.reserve(ctx.OpaqueSurfaces.size() + static_cast<uint32_t>(surfaceCount));
+			for (DrawContext &threadCtx: m_ThreadContexts) {
+				ctx.OpaqueSurfaces.Append(threadCtx.OpaqueSurfaces);
+				// The thread contexts keep their memory, they stop allocating once they reached the size of a frame.
+				threadCtx.Clear();
+			}
+		}
+
+		{
+			MGN_PROFILE_SCOPE("Resolve Missing Assets");
+			// Assets not ready are only asked once per frame, whatever the number of renderables using them.
+			std::unordered_set<AssetHandle> notReady;
+			for (std::vector<Miss> &misses: m_ThreadMisses) {
+				for (const Miss &miss: misses) {
+					if (notReady.contains(miss.handle)) continue;
+					const ResolvedAsset *asset = Resolve(miss.handle);
+					if (!asset) {
+						notReady.insert(miss.handle);
+						continue;
+					}
+					Emit(*asset, scene.GetWorldTransform(miss.entity), ctx);
+				}
+				misses.clear();
+			}
+		}
+	}
+
+	void DrawExtractor::ExtractGizmos(const Scene &scene, DrawContext &ctx) {
+		MGN_PROFILE_FUNCTION();
+		const uint32_t lineCount = static_cast<uint32_t>(scene.Count()) * 3;
+		ctx.LineVertices.reserve(ctx.LineVertices.size() + lineCount * 2);
+		ctx.LineIndices.reserve(ctx.LineIndices.size() + lineCount * 2);
+		scene.ForEach([&ctx](const Scene *scene, const EntityID id) {
+			const auto trs = scene->GetTransform(id);
+			const auto pos = trs.GetWorldPosition();
+			ctx.AddLine(Vertex::PC(pos, Vec4(1, 0, 0, 1)), Vertex::PC(pos + trs.GetRight() * c_GizmoLength, Vec4(1, 0, 0, 1)));
+			ctx.AddLine(Vertex::PC(pos, Vec4(0, 1, 0, 1)), Vertex::PC(pos + trs.GetUp() * c_GizmoLength, Vec4(0, 1, 0, 1)));
+			ctx.AddLine(Vertex::PC(pos, Vec4(0, 0, 1, 1)), Vertex::PC(pos + trs.GetForward() * c_GizmoLength, Vec4(0, 0, 1, 1)));
+		});
+	}
+
+	void DrawExtractor::SetSurfaces(const AssetHandle handle, std::vector<RenderObject> surfaces) {
+		for (RenderObject &surface: surfaces) {
+			if (!surface.sortKey) surface.sortKey = DrawSortKey::Make(DrawSortKey::Opaque, NULL_ASSET_HANDLE, NULL_ASSET_HANDLE, surface.mesh);
+		}
+		m_Resolved[handle] = ResolvedAsset{std::move(surfaces), {}, true};
+	}
+
+	void DrawExtractor::Clear() {
+		m_Resolved.clear();
+		m_Released.clear();
+	}
+
+	void DrawExtractor::ValidateResolved() {
+		m_Released.clear();
+		if (!Project::GetActive()) return;
+		std::erase_if(m_Resolved, [this](auto &pair) {
+			if (pair.second.pinned || (pair.second.complete && AssetManager::IsAssetLoaded(pair.first))) return false;
+			std::move(pair.second.meshes.begin(), pair.second.meshes.end(), std::back_inserter(m_Released));
+			return true;
+		});
+	}
+
+	const DrawExtractor::ResolvedAsset *DrawExtractor::Resolve(const AssetHandle handle) {
+		if (!Project::GetActive()) return nullptr;
+
+		// Assets not loaded yet are skipped instead of stalling the frame.
+		const Ref<Asset> asset = AssetManager::TryGetAsset(handle);
+		if (!asset) return nullptr;
+
+		ResolvedAsset resolved{};
+		switch (asset->GetType()) {
+			case AssetType::Model: {
+				const Ref<CPUModel> cpuModel = CastPtr<CPUModel>(asset);
+				if (!cpuModel || !cpuModel->LoadModelInGPU()) return nullptr;
+				for (const CPUModel::Node &node: cpuModel->Nodes) {
+					for (const Weak<CPUMesh> &mesh: node.meshes) {
+						if (const Ref<CPUMesh> lock = mesh.lock(); lock && lock->gpu) {
+							AddSurface(resolved, node.worldMatrix, *lock);
+						}
+						else {
+							resolved.complete = false;
+						}
+					}
+				}
+			} break;
+			case AssetType::Mesh: {
+				const Ref<CPUMesh> cpuMesh = CastPtr<CPUMesh>(asset);
+				if (!cpuMesh) return nullptr;
+				cpuMesh->LoadMeshInGPU();
+				if (!cpuMesh->gpu) return nullptr;
+				AddSurface(resolved, Math::Identity<Mat4>(), *cpuMesh);
+			} break;
+			default:
+				return nullptr;
+		}
+
+		return &(m_Resolved[handle] = std::move(resolved));
+	}
+
+	void DrawExtractor::AddSurface(ResolvedAsset &asset, const Mat4 &transform, CPUMesh &mesh) {
+		if (!mesh.aabb.IsValid()) mesh.CalcAABB();
+		RenderObject &surface = asset.surfaces.emplace_back(transform, mesh.gpu.get());
+		surface.bounds = mesh.aabb;
+		surface.lodCount = std::max<uint32_t>(1, static_cast<uint32_t>(mesh.Lods.size()));
+
+		// The state of the surface is the one of its first LOD, the depth is added by the culling.
+		const AssetHandle instanceHandle = mesh.Lods.empty() ? NULL_ASSET_HANDLE : mesh.Lods.front().materialInstance;
+		AssetHandle material = NULL_ASSET_HANDLE;
+		if (instanceHandle != NULL_ASSET_HANDLE) {
+			const Ref<Asset> instance = AssetManager::TryGetAsset(instanceHandle);
+			if (!instance) asset.complete = false;
+			else if (instance->GetType() == AssetType::MaterialInstance) material = CastPtr<CPUMaterialInstance>(instance)->Material;
+		}
+		surface.sortKey = DrawSortKey::Make(DrawSortKey::Opaque, material, instanceHandle, mesh.gpu.get());
+		asset.meshes.push_back(mesh.gpu);
+	}
+
+	void DrawExtractor::Emit(const ResolvedAsset &asset, const Mat4 &world, DrawContext &ctx) {
+		for (const RenderObject &surface: asset.surfaces) {
+			RenderObject &object = ctx.OpaqueSurfaces.emplace_back(surface);
+			object.transform = world * surface.transform;
+		}
+	}
+
+} // namespace Imagine
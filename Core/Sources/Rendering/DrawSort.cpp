@@ -0,0 +1,84 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Rendering/DrawSort.hpp"
+
+#include <bit>
+
+namespace Imagine {
+
+	namespace {
+		constexpr uint32_t c_DigitBits = 8;
+		constexpr uint32_t c_DigitCount = 1u << c_DigitBits;
+		constexpr uint32_t c_PassCount = 64 / c_DigitBits;
+	} // namespace
+
+	uint64_t DrawSortKey::Make(const uint32_t pass, const AssetHandle pipeline, const AssetHandle material, const void *mesh) {
+		const uint64_t passBits = static_cast<uint64_t>(pass) & ((uint64_t{1} << c_PassBits) - 1);
+		return (passBits << c_PassShift) |
+			   (Fold(std::hash<AssetHandle>{}(pipeline), c_PipelineBits) << c_PipelineShift) |
+			   (Fold(std::hash<AssetHandle>{}(material), c_MaterialBits) << c_MaterialShift) |
+			   (Fold(reinterpret_cast<uintptr_t>(mesh), c_MeshBits) << c_MeshShift);
+	}
+
+	uint64_t DrawSortKey::WithDepth(const uint64_t key, const float distance) {
+		// The bits of a positive float are ordered like the float, the top bits are a logarithmic depth.
+		const uint32_t bits = std::bit_cast<uint32_t>(std::max(distance, 0.0f));
+		return (key & ~(c_DepthMask << c_DepthShift)) | (static_cast<uint64_t>(bits >> (32 - c_DepthBits)) << c_DepthShift);
+	}
+
+	uint64_t DrawSortKey::WithLod(const uint64_t key, const uint32_t lod) {
+		const uint64_t bits = std::min<uint64_t>(lod, c_LodMask);
+		return (key & ~(c_LodMask << c_LodShift)) | (bits << c_LodShift);
+	}
+
+	uint64_t DrawSortKey::Fold(const uint64_t value, const uint32_t bits) {
+		if (value == 0) return 0;
+		return (value * 0x9E3779B97F4A7C15ull) >> (64 - bits);
+	}
+
+	void DrawSorter::Sort(DrawContext &ctx) {
+		MGN_PROFILE_FUNCTION();
+		FrameArray<RenderObject> &surfaces = ctx.OpaqueSurfaces;
+		const uint32_t count = surfaces.size();
+		if (count < 2) return;
+
+		m_Entries.resize(count);
+		m_Swap.resize(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			m_Entries[i] = {surfaces[i].sortKey, i};
+		}
+
+		std::array<std::array<uint32_t, c_DigitCount>, c_PassCount> histograms{};
+		for (const Entry &entry: m_Entries) {
+			for (uint32_t pass = 0; pass < c_PassCount; ++pass) {
+				++histograms[pass][(entry.key >> (pass * c_DigitBits)) & (c_DigitCount - 1)];
+			}
+		}
+
+		for (uint32_t pass = 0; pass < c_PassCount; ++pass) {
+			std::array<uint32_t, c_DigitCount> &histogram = histograms[pass];
+			// Every key has the same digit, the pass wouldn't move anything.
+			if (histogram[(m_Entries.front().key >> (pass * c_DigitBits)) & (c_DigitCount - 1)] == count) continue;
+
+			uint32_t offset = 0;
+			for (uint32_t &bucket: histogram) {
+				const uint32_t size = bucket;
+				bucket = offset;
+				offset += size;
+			}
+			for (const Entry &entry: m_Entries) {
+				m_Swap[histogram[(entry.key >> (pass * c_DigitBits)) & (c_DigitCount - 1)]++] = entry;
+			}
+			std::swap(m_Entries, m_Swap);
+		}
+
+		m_Sorted.resize(count);
+		for (uint32_t i = 0; i < count; ++i) {
+			m_Sorted[i] = surfaces[m_Entries[i].index];
+		}
+		std::memcpy(surfaces.data(), m_Sorted.data(), sizeof(RenderObject) * count);
+	}
+
+} // namespace Imagine
@@ -0,0 +1,168 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Imagine/Rendering/FrustumCuller.hpp"
+
+#include "Imagine/Core/JobSystem.hpp"
+#include "Imagine/Core/SIMD.hpp"
+#include "Imagine/Rendering/DrawSort.hpp"
+
+namespace Imagine {
+
+	namespace {
+		constexpr uint8_t c_Culled = 0xFF;
+		/// Half extents given to the surfaces without valid bounds so they're never culled.
+		constexpr float c_Unbounded = 1e18f;
+		/// Avoid the division by zero when the camera is at the center of a surface.
+		constexpr float c_MinDistanceSquared = 1e-6f;
+	} // namespace
+
+	Frustum Frustum::FromViewProjection(const Mat4 &viewProjection) {
+		// The rows of the matrix, as a plane is a combination of the rows of the clip space transform.
+		const glm::fmat4 rows = glm::transpose(glm::fmat4(viewProjection));
+		Frustum frustum;
+		frustum.planes[Left] = rows[3] + rows[0];
+		frustum.planes[Right] = rows[3] - rows[0];
+		frustum.planes[Bottom] = rows[3] + rows[1];
+		frustum.planes[Top] = rows[3] - rows[1];
+		frustum.planes[Near] = rows[2];
+		frustum.planes[Far] = rows[3] - rows[2];
+		for (glm::fvec4 &plane: frustum.planes) {
+			plane /= glm::length(glm::fvec3(plane));
+		}
+		return frustum;
+	}
+
+	bool Frustum::Intersects(const glm::fvec3 &center, const glm::fvec3 &extents) const {
+		for (const glm::fvec4 &plane: planes) {
+			const glm::fvec3 normal{plane};
+			if (glm::dot(normal, center) + plane.w + glm::dot(glm::abs(normal), extents) < 0) return false;
+		}
+		return true;
+	}
+
+	void FrustumCuller::Cull(const Mat4 &view, const Mat4 &projection, DrawContext &ctx) {
+		MGN_PROFILE_FUNCTION();
+		FrameArray<RenderObject> &surfaces = ctx.OpaqueSurfaces;
+		const uint32_t count = surfaces.size();
+		if (count == 0) return;
+
+		const Frustum frustum = Frustum::FromViewProjection(projection * view);
+		const glm::fvec3 eye{glm::inverse(glm::fmat4(view))[3]};
+		const float projectionScale = std::abs(static_cast<float>(projection[1][1]));
+		m_Lods.resize(count);
+		m_Distances.resize(count);
+
+		{
+			MGN_PROFILE_SCOPE("Test Batches");
+			const uint32_t batchCount = (count + SIMD::c_Width - 1) / SIMD::c_Width;
+			JobSystem::ParallelFor(batchCount, c_GrainSize / SIMD::c_Width, [&](const uint32_t begin, const uint32_t end) {
+				for (uint32_t batch = begin; batch < end; ++batch) {
+					CullBatch(frustum, eye, projectionScale, surfaces, batch * SIMD::c_Width);
+				}
+			});
+		}
+
+		{
+			MGN_PROFILE_SCOPE("Compact Surfaces");
+			uint32_t visible = 0;
+			for (uint32_t i = 0; i < count; ++i) {
+				const uint8_t lod = m_Lods[i];
+				if (lod == c_Culled) continue;
+				if (visible != i) surfaces[visible] = surfaces[i];
+				surfaces[visible].lod = lod;
+				surfaces[visible].sortKey = DrawSortKey::WithDepth(DrawSortKey::WithLod(surfaces[visible].sortKey, lod), m_Distances[i]);
+				++m_Stats.lods[std::min<uint32_t>(lod, CullingStats::c_MaxLods - 1)];
+				++visible;
+			}
+			surfaces.resize(visible);
+
+			m_Stats.tested += count;
+			m_Stats.visible += visible;
+			m_Stats.culled += count - visible;
+		}
+	}
+
+	void FrustumCuller::CullBatch(const Frustum &frustum, const glm::fvec3 &eye, const float projectionScale, const std::span<const RenderObject> surfaces, const uint32_t first) {
+		const uint32_t lanes = std::min<uint32_t>(SIMD::c_Width, static_cast<uint32_t>(surfaces.size()) - first);
+
+		// World space bounds of the batch, one array per axis.
+		alignas(16) float center[3][SIMD::c_Width];
+		alignas(16) float extents[3][SIMD::c_Width];
+		for (uint32_t lane = 0; lane < SIMD::c_Width; ++lane) {
+			// The unused lanes of the last batch are tested too, their result is ignored.
+			glm::fvec3 c{eye};
+			glm::fvec3 e{0};
+			if (lane < lanes) {
+				const RenderObject &surface = surfaces[first + lane];
+				const glm::fmat4 world{surface.transform};
+				if (surface.bounds.IsValid()) {
+					c = glm::fvec3(world * glm::fvec4(glm::fvec3(surface.bounds.GetCenter()), 1));
+					const glm::fmat3 absolute{glm::abs(glm::fvec3(world[0])), glm::abs(glm::fvec3(world[1])), glm::abs(glm::fvec3(world[2]))};
+					e = absolute * glm::fvec3(surface.bounds.GetHalfSize());
+				} else {
+					c = glm::fvec3(world[3]);
+					e = glm::fvec3(c_Unbounded);
+				}
+			}
+			for (uint32_t axis = 0; axis < 3; ++axis) {
+				center[axis][lane] = c[axis];
+				extents[axis][lane] = e[axis];
+			}
+		}
+
+		const SIMD::Float4 cx = SIMD::Load(center[0]);
+		const SIMD::Float4 cy = SIMD::Load(center[1]);
+		const SIMD::Float4 cz = SIMD::Load(center[2]);
+		const SIMD::Float4 ex = SIMD::Load(extents[0]);
+		const SIMD::Float4 ey = SIMD::Load(extents[1]);
+		const SIMD::Float4 ez = SIMD::Load(extents[2]);
+		const SIMD::Float4 zero = SIMD::Set(0);
+
+		// A box is outside when it's entirely behind one of the planes.
+		SIMD::Float4 outside = zero;
+		for (const glm::fvec4 &plane: frustum.planes) {
+			const SIMD::Float4 distance = SIMD::MulAdd(cx, SIMD::Set(plane.x), SIMD::MulAdd(cy, SIMD::Set(plane.y), SIMD::MulAdd(cz, SIMD::Set(plane.z), SIMD::Set(plane.w))));
+			const SIMD::Float4 radius = SIMD::MulAdd(ex, SIMD::Set(std::abs(plane.x)), SIMD::MulAdd(ey, SIMD::Set(std::abs(plane.y)), ez * SIMD::Set(std::abs(plane.z))));
+			outside = SIMD::Or(outside, SIMD::Less(distance + radius, zero));
+		}
+		const uint32_t culled = SIMD::MoveMask(outside);
+
+		// Projected size of the bounding sphere of the box.
+		const SIMD::Float4 dx = cx - SIMD::Set(eye.x);
+		const SIMD::Float4 dy = cy - SIMD::Set(eye.y);
+		const SIMD::Float4 dz = cz - SIMD::Set(eye.z);
+		const SIMD::Float4 distanceSquared = SIMD::MulAdd(dx, dx, SIMD::MulAdd(dy, dy, dz * dz));
+		const SIMD::Float4 radiusSquared = SIMD::MulAdd(ex, ex, SIMD::MulAdd(ey, ey, ez * ez));
+		alignas(16) float screenSize[SIMD::c_Width];
+		SIMD::Store(screenSize, SIMD::Sqrt(radiusSquared / SIMD::Max(distanceSquared, SIMD::Set(c_MinDistanceSquared))) * SIMD::Set(projectionScale));
+		alignas(16) float distances[SIMD::c_Width];
+		SIMD::Store(distances, distanceSquared);
+
+		for (uint32_t lane = 0; lane < lanes; ++lane) {
+			m_Distances[first + lane] = distances[lane];
+			m_Lods[first + lane] = (culled >> lane) & 1 ? c_Culled : static_cast<uint8_t>(SelectLod(screenSize[lane], surfaces[first + lane].lodCount, LodScreenSize));
+		}
+	}
+
+	uint32_t FrustumCuller::SelectLod(const float screenSize, const uint32_t lodCount, const float lodScreenSize) {
+		// The last value is reserved for the culled surfaces.
+		const uint32_t lastLod = std::min<uint32_t>(lodCount, c_Culled) - 1;
+		if (lodCount <= 1 || screenSize >= lodScreenSize) return 0;
+		if (screenSize <= 0) return lastLod;
+		const float lod = 1 + std::floor(std::log2(lodScreenSize / screenSize));
+		return lod >= static_cast<float>(lastLod) ? lastLod : static_cast<uint32_t>(lod);
+	}
+
+	void FrustumCuller::ResetStats() {
+		m_Stats = {};
+	}
+
+	void FrustumCuller::ReportStats() const {
+		MGN_PROFILE_PLOT("Culling Tested", m_Stats.tested);
+		MGN_PROFILE_PLOT("Culling Visible", m_Stats.visible);
+		MGN_PROFILE_PLOT("Culling Culled", m_Stats.culled);
+	}
+
+} // namespace Imagine
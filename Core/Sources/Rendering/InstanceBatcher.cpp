@@ -0,0 +1,95 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Rendering/InstanceBatcher.hpp"
+
+#include "Imagine/Core/JobSystem.hpp"
+#include "Imagine/Core/SIMD.hpp"
+
+namespace Imagine {
+
+	namespace {
+		/// Determinant under which a matrix is considered singular, its normal matrix is left unscaled.
+		constexpr float c_MinDeterminant = 1e-12f;
+	} // namespace
+
+	void InstanceBatcher::Build(const std::span<const RenderObject> surfaces) {
+		MGN_PROFILE_FUNCTION();
+		m_Batches.clear();
+		for (uint32_t i = 0; i < surfaces.size(); ++i) {
+			const RenderObject &surface = surfaces[i];
+			if (!m_Batches.empty()) {
+				InstanceBatch &batch = m_Batches.back();
+				if (batch.mesh == surface.mesh && batch.lod == surface.lod) {
+					++batch.count;
+					continue;
+				}
+			}
+			m_Batches.push_back(InstanceBatch{surface.mesh, surface.lod, i, 1});
+		}
+	}
+
+	void InstanceBatcher::WriteInstances(const std::span<const RenderObject> surfaces, GPUInstanceData *instances) {
+		MGN_PROFILE_FUNCTION();
+		const uint32_t count = static_cast<uint32_t>(surfaces.size());
+		if (count == 0) return;
+
+		const uint32_t batchCount = (count + SIMD::c_Width - 1) / SIMD::c_Width;
+		JobSystem::ParallelFor(batchCount, c_GrainSize / SIMD::c_Width, [&](const uint32_t begin, const uint32_t end) {
+			for (uint32_t batch = begin; batch < end; ++batch) {
+				WriteBatch(surfaces, batch * SIMD::c_Width, instances);
+			}
+		});
+	}
+
+	void InstanceBatcher::WriteBatch(const std::span<const RenderObject> surfaces, const uint32_t first, GPUInstanceData *instances) {
+		const uint32_t lanes = std::min<uint32_t>(SIMD::c_Width, static_cast<uint32_t>(surfaces.size()) - first);
+
+		// The first three columns of the matrices, one lane per surface. The missing lanes are identities.
+		alignas(16) float columns[3][3][SIMD::c_Width];
+		for (uint32_t lane = 0; lane < SIMD::c_Width; ++lane) {
+			const glm::fmat4 world = lane < lanes ? glm::fmat4(surfaces[first + lane].transform) : glm::fmat4(1.0f);
+			for (uint32_t c = 0; c < 3; ++c) {
+				for (uint32_t r = 0; r < 3; ++r) {
+					columns[c][r][lane] = world[c][r];
+				}
+			}
+		}
+
+		const SIMD::Float4 ax = SIMD::Load(columns[0][0]), ay = SIMD::Load(columns[0][1]), az = SIMD::Load(columns[0][2]);
+		const SIMD::Float4 bx = SIMD::Load(columns[1][0]), by = SIMD::Load(columns[1][1]), bz = SIMD::Load(columns[1][2]);
+		const SIMD::Float4 cx = SIMD::Load(columns[2][0]), cy = SIMD::Load(columns[2][1]), cz = SIMD::Load(columns[2][2]);
+
+		// The columns of the inverse transpose of a 3x3 matrix are the cross products of its columns over its determinant.
+		const SIMD::Float4 bcx = by * cz - bz * cy, bcy = bz * cx - bx * cz, bcz = bx * cy - by * cx;
+		const SIMD::Float4 cax = cy * az - cz * ay, cay = cz * ax - cx * az, caz = cx * ay - cy * ax;
+		const SIMD::Float4 abx = ay * bz - az * by, aby = az * bx - ax * bz, abz = ax * by - ay * bx;
+		const SIMD::Float4 determinant = SIMD::MulAdd(ax, bcx, SIMD::MulAdd(ay, bcy, az * bcz));
+		const SIMD::Float4 singular = SIMD::Less(SIMD::Abs(determinant), SIMD::Set(c_MinDeterminant));
+		const SIMD::Float4 inverse = SIMD::Set(1.0f) / SIMD::Select(singular, SIMD::Set(1.0f), determinant);
+
+		alignas(16) float normals[3][3][SIMD::c_Width];
+		SIMD::Store(normals[0][0], bcx * inverse);
+		SIMD::Store(normals[0][1], bcy * inverse);
+		SIMD::Store(normals[0][2], bcz * inverse);
+		SIMD::Store(normals[1][0], cax * inverse);
+		SIMD::Store(normals[1][1], cay * inverse);
+		SIMD::Store(normals[1][2], caz * inverse);
+		SIMD::Store(normals[2][0], abx * inverse);
+		SIMD::Store(normals[2][1], aby * inverse);
+		SIMD::Store(normals[2][2], abz * inverse);
+
+		for (uint32_t lane = 0; lane < lanes; ++lane) {
+			GPUInstanceData &instance = instances[first + lane];
+			instance.worldMatrix = glm::fmat4(surfaces[first + lane].transform);
+			instance.normalMatrix = glm::fmat4(1.0f);
+			for (uint32_t c = 0; c < 3; ++c) {
+				for (uint32_t r = 0; r < 3; ++r) {
+					instance.normalMatrix[c][r] = normals[c][r][lane];
+				}
+			}
+		}
+	}
+
+} // namespace Imagine
@@ -0,0 +1,271 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Rendering/LightClusters.hpp"
+
+#include <bit>
+
+#include "Imagine/Core/JobSystem.hpp"
+#include "Imagine/Core/SIMD.hpp"
+
+namespace Imagine {
+
+	namespace {
+		enum Bound : uint32_t {
+			MinX,
+			MinY,
+			MinZ,
+			MaxX,
+			MaxY,
+			MaxZ,
+		};
+
+		/// Bounds of the padding of the rows, far enough that no sphere reaches them.
+		constexpr float c_Empty = 1e18f;
+
+		uint32_t GetTile(const float ndc, const uint32_t tiles) {
+			const float tile = (std::clamp(ndc, -1.0f, 1.0f) * 0.5f + 0.5f) * static_cast<float>(tiles);
+			return std::min(static_cast<uint32_t>(tile), tiles - 1);
+		}
+	} // namespace
+
+	void LightClusters::SetSettings(const LightClusterSettings &settings) {
+		MGN_CORE_CASSERT(settings.TilesX > 0 && settings.TilesY > 0 && settings.Slices > 0, "The cluster grid can't be empty.");
+		MGN_CORE_CASSERT(settings.NearPlane > 0 && settings.FarPlane > settings.NearPlane, "The depth range of the clusters is invalid.");
+		m_Settings = settings;
+		m_BoundsDirty = true;
+	}
+
+	void LightClusters::Build(const std::span<const Light> lights, const Mat4 &view, const Mat4 &projection, const uint32_t width, const uint32_t height) {
+		MGN_PROFILE_FUNCTION();
+		const glm::fmat4 viewMatrix{view};
+		const glm::fmat4 projectionMatrix{projection};
+		if (m_BoundsDirty || projectionMatrix != m_BoundsProjection) {
+			BuildBounds(projectionMatrix);
+		}
+
+		m_Stats = {};
+		m_Stats.lights = static_cast<uint32_t>(lights.size());
+
+		// The directional lights first, the others keep their order.
+		m_Lights.clear();
+		m_Lights.reserve(lights.size());
+		for (const Light &light: lights) {
+			if (light.type == LIGHT_DIRECTIONAL) m_Lights.push_back(light);
+		}
+		const uint32_t directionalCount = static_cast<uint32_t>(m_Lights.size());
+		for (const Light &light: lights) {
+			if (light.type != LIGHT_DIRECTIONAL) m_Lights.push_back(light);
+		}
+		m_Stats.directionalLights = directionalCount;
+
+		const float sliceScale = static_cast<float>(m_Settings.Slices) / std::log(m_Settings.FarPlane / m_Settings.NearPlane);
+		m_Grid.size = {m_Settings.TilesX, m_Settings.TilesY, m_Settings.Slices, directionalCount};
+		m_Grid.tileScale = {static_cast<float>(m_Settings.TilesX) / static_cast<float>(std::max(width, 1u)), static_cast<float>(m_Settings.TilesY) / static_cast<float>(std::max(height, 1u)), 0, 0};
+		m_Grid.slice = {sliceScale, -std::log(m_Settings.NearPlane) * sliceScale, m_Settings.NearPlane, m_Settings.FarPlane};
+
+		const uint32_t lightCount = static_cast<uint32_t>(m_Lights.size());
+		const uint32_t jobCount = (lightCount - directionalCount + c_GrainSize - 1) / c_GrainSize;
+		if (m_JobHits.size() < jobCount) m_JobHits.resize(jobCount);
+
+		{
+			MGN_PROFILE_SCOPE("Assign Lights");
+			std::atomic<uint32_t> culled{0};
+			JobSystem::ParallelFor(jobCount, 1, [&](const uint32_t begin, const uint32_t end) {
+				for (uint32_t job = begin; job < end; ++job) {
+					std::vector<Hit> &hits = m_JobHits[job];
+					hits.clear();
+					const uint32_t first = directionalCount + job * c_GrainSize;
+					const uint32_t last = std::min(first + c_GrainSize, lightCount);
+					uint32_t jobCulled = 0;
+					for (uint32_t light = first; light < last; ++light) {
+						if (!AssignLight(m_Lights[light], light, viewMatrix, projectionMatrix, hits)) ++jobCulled;
+					}
+					culled.fetch_add(jobCulled, std::memory_order_relaxed);
+				}
+			});
+			m_Stats.culledLights = culled.load(std::memory_order_relaxed);
+		}
+
+		{
+			MGN_PROFILE_SCOPE("Sort Indices");
+			// Counting sort by cluster. The jobs are read in order, so the lights of a cluster stay sorted.
+			const uint32_t clusterCount = GetClusterCount();
+			m_Counts.assign(clusterCount, 0);
+			for (uint32_t job = 0; job < jobCount; ++job) {
+				for (const Hit &hit: m_JobHits[job]) {
+					++m_Counts[hit.cluster];
+				}
+			}
+
+			m_Clusters.resize(clusterCount);
+			uint32_t offset = 0;
+			for (uint32_t cluster = 0; cluster < clusterCount; ++cluster) {
+				const uint32_t count = std::min(m_Counts[cluster], m_Settings.MaxLightsPerCluster);
+				m_Stats.droppedIndices += m_Counts[cluster] - count;
+				m_Stats.maxLightsInCluster = std::max(m_Stats.maxLightsInCluster, count);
+				m_Stats.occupiedClusters += count > 0;
+				m_Clusters[cluster] = {offset, 0};
+				offset += count;
+			}
+
+			// The first lights of a full cluster are kept.
+			m_Indices.resize(offset);
+			for (uint32_t job = 0; job < jobCount; ++job) {
+				for (const Hit &hit: m_JobHits[job]) {
+					GPULightCluster &cluster = m_Clusters[hit.cluster];
+					if (cluster.count < m_Settings.MaxLightsPerCluster) {
+						m_Indices[cluster.offset + cluster.count++] = hit.light;
+					}
+				}
+			}
+			m_Stats.indices = offset;
+		}
+	}
+
+	void LightClusters::BuildBounds(const glm::fmat4 &projection) {
+		MGN_PROFILE_FUNCTION();
+		static_assert(c_RowAlignment == SIMD::c_Width, "The rows must hold whole SIMD groups.");
+		m_BoundsProjection = projection;
+		m_BoundsDirty = false;
+
+		const uint32_t tilesX = m_Settings.TilesX;
+		const uint32_t tilesY = m_Settings.TilesY;
+		const uint32_t slices = m_Settings.Slices;
+		const uint32_t stride = GetRowStride();
+
+		// The view space rays through the corners of the tiles, scaled to a depth of 1.
+		const glm::fmat4 inverse = glm::inverse(projection);
+		std::vector<glm::fvec3> rays((tilesX + 1) * (tilesY + 1));
+		for (uint32_t y = 0; y <= tilesY; ++y) {
+			for (uint32_t x = 0; x <= tilesX; ++x) {
+				const glm::fvec2 ndc{static_cast<float>(x) / static_cast<float>(tilesX) * 2.0f - 1.0f, static_cast<float>(y) / static_cast<float>(tilesY) * 2.0f - 1.0f};
+				const glm::fvec4 point = inverse * glm::fvec4(ndc, 0, 1);
+				const glm::fvec3 ray = glm::fvec3(point) / point.w;
+				rays[y * (tilesX + 1) + x] = ray / (projection * glm::fvec4(ray, 1)).w;
+			}
+		}
+
+		for (std::vector<float> &bound: m_Bounds) {
+			bound.assign(static_cast<size_t>(stride) * tilesY * slices, 0);
+		}
+		const float ratio = m_Settings.FarPlane / m_Settings.NearPlane;
+		for (uint32_t slice = 0; slice < slices; ++slice) {
+			const float depths[2] = {
+					m_Settings.NearPlane * std::pow(ratio, static_cast<float>(slice) / static_cast<float>(slices)),
+					m_Settings.NearPlane * std::pow(ratio, static_cast<float>(slice + 1) / static_cast<float>(slices)),
+			};
+			for (uint32_t y = 0; y < tilesY; ++y) {
+				const uint32_t row = (slice * tilesY + y) * stride;
+				for (uint32_t x = 0; x < stride; ++x) {
+					glm::fvec3 min{c_Empty};
+					glm::fvec3 max{-c_Empty};
+					if (x < tilesX) {
+						const glm::fvec3 corners[4] = {rays[y * (tilesX + 1) + x], rays[y * (tilesX + 1) + x + 1], rays[(y + 1) * (tilesX + 1) + x], rays[(y + 1) * (tilesX + 1) + x + 1]};
+						for (const glm::fvec3 &corner: corners) {
+							for (const float depth: depths) {
+								min = glm::min(min, corner * depth);
+								max = glm::max(max, corner * depth);
+							}
+						}
+					}
+					for (uint32_t axis = 0; axis < 3; ++axis) {
+						m_Bounds[MinX + axis][row + x] = min[axis];
+						m_Bounds[MaxX + axis][row + x] = max[axis];
+					}
+				}
+			}
+		}
+	}
+
+	bool LightClusters::AssignLight(const Light &light, const uint32_t index, const glm::fmat4 &view, const glm::fmat4 &projection, std::vector<Hit> &hits) const {
+		const float radius = glm::length(glm::fvec3(light.direction));
+		if (!(radius > 0)) return false;
+
+		const glm::fvec3 center{view * glm::fvec4(light.position, 1)};
+		const float depth = (projection * glm::fvec4(center, 1)).w;
+		const float nearPlane = m_Settings.NearPlane;
+		const float farPlane = m_Settings.FarPlane;
+		if (depth + radius < nearPlane || depth - radius > farPlane) return false;
+
+		// The tiles covered by the projection of the box around the sphere. A box crossing the near plane can cover the whole screen.
+		glm::fvec2 ndcMin{-1};
+		glm::fvec2 ndcMax{1};
+		if (depth - radius > nearPlane) {
+			ndcMin = glm::fvec2{std::numeric_limits<float>::max()};
+			ndcMax = glm::fvec2{std::numeric_limits<float>::lowest()};
+			for (uint32_t corner = 0; corner < 8; ++corner) {
+				const glm::fvec3 offset{corner & 1 ? radius : -radius, corner & 2 ? radius : -radius, corner & 4 ? radius : -radius};
+				const glm::fvec4 clip = projection * glm::fvec4(center + offset, 1);
+				const glm::fvec2 ndc = glm::fvec2(clip) / clip.w;
+				ndcMin = glm::min(ndcMin, ndc);
+				ndcMax = glm::max(ndcMax, ndc);
+			}
+			if (ndcMax.x < -1 || ndcMax.y < -1 || ndcMin.x > 1 || ndcMin.y > 1) return false;
+		}
+
+		const uint32_t firstX = GetTile(ndcMin.x, m_Settings.TilesX);
+		const uint32_t lastX = GetTile(ndcMax.x, m_Settings.TilesX);
+		const uint32_t firstY = GetTile(ndcMin.y, m_Settings.TilesY);
+		const uint32_t lastY = GetTile(ndcMax.y, m_Settings.TilesY);
+		const uint32_t firstSlice = GetSlice(std::max(depth - radius, nearPlane));
+		const uint32_t lastSlice = GetSlice(std::min(depth + radius, farPlane));
+
+		// Distance between the center and the boxes of the candidate clusters, by groups of the SIMD width along the rows.
+		const SIMD::Float4 cx = SIMD::Set(center.x);
+		const SIMD::Float4 cy = SIMD::Set(center.y);
+		const SIMD::Float4 cz = SIMD::Set(center.z);
+		const SIMD::Float4 radiusSquared = SIMD::Set(radius * radius);
+		const SIMD::Float4 zero = SIMD::Set(0);
+		const uint32_t stride = GetRowStride();
+		const uint32_t firstGroup = firstX / SIMD::c_Width * SIMD::c_Width;
+		const uint64_t hitCount = hits.size();
+		for (uint32_t slice = firstSlice; slice <= lastSlice; ++slice) {
+			for (uint32_t y = firstY; y <= lastY; ++y) {
+				const uint32_t row = slice * m_Settings.TilesY + y;
+				const uint32_t offset = row * stride;
+				for (uint32_t x = firstGroup; x <= lastX; x += SIMD::c_Width) {
+					const SIMD::Float4 dx = SIMD::Max(SIMD::Max(SIMD::LoadUnaligned(&m_Bounds[MinX][offset + x]) - cx, cx - SIMD::LoadUnaligned(&m_Bounds[MaxX][offset + x])), zero);
+					const SIMD::Float4 dy = SIMD::Max(SIMD::Max(SIMD::LoadUnaligned(&m_Bounds[MinY][offset + x]) - cy, cy - SIMD::LoadUnaligned(&m_Bounds[MaxY][offset + x])), zero);
+					const SIMD::Float4 dz = SIMD::Max(SIMD::Max(SIMD::LoadUnaligned(&m_Bounds[MinZ][offset + x]) - cz, cz - SIMD::LoadUnaligned(&m_Bounds[MaxZ][offset + x])), zero);
+					uint32_t mask = SIMD::MoveMask(SIMD::LessEqual(SIMD::MulAdd(dx, dx, SIMD::MulAdd(dy, dy, dz * dz)), radiusSquared));
+					while (mask) {
+						const uint32_t tile = x + static_cast<uint32_t>(std::countr_zero(mask));
+						mask &= mask - 1;
+						if (tile < firstX || tile > lastX) continue;
+						hits.push_back({row * m_Settings.TilesX + tile, index});
+					}
+				}
+			}
+		}
+		return hits.size() > hitCount;
+	}
+
+	uint32_t LightClusters::GetSlice(const float depth) const {
+		const float slice = std::log(depth) * m_Grid.slice.x + m_Grid.slice.y;
+		if (!(slice > 0)) return 0;
+		return std::min(static_cast<uint32_t>(slice), m_Settings.Slices - 1);
+	}
+
+	uint32_t LightClusters::GetClusterIndex(const glm::fvec4 &clip) const {
+		if (!(clip.w >= m_Settings.NearPlane) || clip.w > m_Settings.FarPlane) return c_OutsideGrid;
+		const float x = clip.x / clip.w;
+		const float y = clip.y / clip.w;
+		if (x < -1 || x > 1 || y < -1 || y > 1) return c_OutsideGrid;
+		return (GetSlice(clip.w) * m_Settings.TilesY + GetTile(y, m_Settings.TilesY)) * m_Settings.TilesX + GetTile(x, m_Settings.TilesX);
+	}
+
+	std::span<const uint32_t> LightClusters::GetClusterLights(const uint32_t cluster) const {
+		const GPULightCluster &range = m_Clusters[cluster];
+		return std::span<const uint32_t>{m_Indices}.subspan(range.offset, range.count);
+	}
+
+	void LightClusters::ReportStats() const {
+		MGN_PROFILE_PLOT("Lights", m_Stats.lights);
+		MGN_PROFILE_PLOT("Lights Culled", m_Stats.culledLights);
+		MGN_PROFILE_PLOT("Light Indices", m_Stats.indices);
+		MGN_PROFILE_PLOT("Light Indices Dropped", m_Stats.droppedIndices);
+	}
+
+} // namespace Imagine
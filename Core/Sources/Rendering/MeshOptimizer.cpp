@@ -0,0 +1,89 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Rendering/MeshOptimizer.hpp"
+
+#include <meshoptimizer.h>
+
+namespace Imagine {
+
+	namespace {
+		MeshStatistics Measure(const std::span<const uint32_t> indices, const uint64_t vertexCount) {
+			if (indices.empty() || vertexCount == 0) return {};
+			const meshopt_VertexCacheStatistics cache = meshopt_analyzeVertexCache(indices.data(), indices.size(), vertexCount, MeshOptimizer::c_CacheSize, 0, 0);
+			const meshopt_VertexFetchStatistics fetch = meshopt_analyzeVertexFetch(indices.data(), indices.size(), vertexCount, sizeof(Vertex));
+			return {cache.acmr, cache.atvr, fetch.overfetch};
+		}
+
+		std::span<const uint32_t> GetFirstLod(const CPUMesh &mesh) {
+			if (mesh.Lods.empty()) return mesh.Indices;
+			const LOD &lod = mesh.Lods.front();
+			return std::span<const uint32_t>{mesh.Indices}.subspan(lod.index, lod.count);
+		}
+	} // namespace
+
+	MeshStatistics MeshOptimizer::Analyze(const CPUMesh &mesh) {
+		return Measure(GetFirstLod(mesh), mesh.Vertices.size());
+	}
+
+	MeshOptimizationReport MeshOptimizer::Optimize(CPUMesh &mesh, const MeshOptimizerSettings &settings) {
+		MGN_PROFILE_FUNCTION();
+		MeshOptimizationReport report{};
+		report.before = Analyze(mesh);
+		report.verticesBefore = static_cast<uint32_t>(mesh.Vertices.size());
+
+		const AssetHandle materialInstance = mesh.Lods.empty() ? NULL_ASSET_HANDLE : mesh.Lods.front().materialInstance;
+		const std::span<const uint32_t> source = GetFirstLod(mesh);
+		if (source.size() < 3 || mesh.Vertices.empty()) return report;
+
+		// Remove the duplicated vertices and the ones no triangle uses.
+		std::vector<uint32_t> remap(mesh.Vertices.size());
+		const uint64_t vertexCount = meshopt_generateVertexRemap(remap.data(), source.data(), source.size(), mesh.Vertices.data(), mesh.Vertices.size(), sizeof(Vertex));
+
+		std::vector<Vertex> vertices(vertexCount);
+		meshopt_remapVertexBuffer(vertices.data(), mesh.Vertices.data(), mesh.Vertices.size(), sizeof(Vertex), remap.data());
+		std::vector<uint32_t> lod(source.size());
+		meshopt_remapIndexBuffer(lod.data(), source.data(), source.size(), remap.data());
+
+		meshopt_optimizeVertexCache(lod.data(), lod.data(), lod.size(), vertexCount);
+		meshopt_optimizeOverdraw(lod.data(), lod.data(), lod.size(), &vertices[0].position.x, vertexCount, sizeof(Vertex), settings.overdrawThreshold);
+
+		std::vector<uint32_t> indices = lod;
+		std::vector<LOD> lods{LOD{0, static_cast<uint32_t>(lod.size()), materialInstance}};
+
+		// Each LOD is simplified from the previous one, and stays in the vertex buffer of the full mesh.
+		std::vector<uint32_t> simplified(lod.size());
+		for (uint32_t i = 0; i < settings.lodCount; ++i) {
+			const uint64_t target = static_cast<uint64_t>(static_cast<float>(lod.size()) * settings.lodReduction) / 3 * 3;
+			if (target < 3) break;
+
+			float error = 0;
+			const uint64_t count = meshopt_simplify(simplified.data(), lod.data(), lod.size(), &vertices[0].position.x, vertexCount, sizeof(Vertex), target, settings.lodError, 0, &error);
+			// Stop once the error bound prevents any real reduction.
+			if (count == 0 || count > lod.size() * 9 / 10) break;
+
+			lod.assign(simplified.begin(), simplified.begin() + static_cast<std::ptrdiff_t>(count));
+			meshopt_optimizeVertexCache(lod.data(), lod.data(), lod.size(), vertexCount);
+
+			lods.push_back(LOD{static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(lod.size()), materialInstance});
+			indices.insert(indices.end(), lod.begin(), lod.end());
+		}
+
+		// The full mesh comes first, so the vertices follow its order.
+		mesh.Vertices.resize(vertexCount);
+		const uint64_t fetched = meshopt_optimizeVertexFetch(mesh.Vertices.data(), indices.data(), indices.size(), vertices.data(), vertexCount, sizeof(Vertex));
+		mesh.Vertices.resize(fetched);
+		mesh.Indices = std::move(indices);
+		mesh.Lods = std::move(lods);
+
+		report.after = Analyze(mesh);
+		report.verticesAfter = static_cast<uint32_t>(mesh.Vertices.size());
+		report.lodTriangles.reserve(mesh.Lods.size());
+		for (const LOD &l: mesh.Lods) {
+			report.lodTriangles.push_back(l.count / 3);
+		}
+		return report;
+	}
+
+} // namespace Imagine
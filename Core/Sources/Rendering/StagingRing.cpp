@@ -0,0 +1,78 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Rendering/StagingRing.hpp"
+
+namespace Imagine {
+
+	StagingRing::StagingRing(const uint64_t capacity) {
+		Reset(capacity);
+	}
+
+	void StagingRing::Reset(const uint64_t capacity) {
+		m_Capacity = capacity;
+		m_Head = 0;
+		m_Tail = 0;
+		m_Used = 0;
+		m_OpenSize = 0;
+		m_Batches.clear();
+	}
+
+	std::optional<uint64_t> StagingRing::Allocate(const uint64_t size, const uint64_t alignment) {
+		MGN_CORE_CASSERT(alignment && (alignment & (alignment - 1)) == 0, "The alignment {} is not a power of two.", alignment);
+		if (size > m_Capacity) return std::nullopt;
+
+		if (m_Used == 0) {
+			m_Head = 0;
+			m_Tail = 0;
+		}
+		else if (m_Head == m_Tail) {
+			// Every byte is in use.
+			return std::nullopt;
+		}
+
+		uint64_t offset = (m_Head + alignment - 1) & ~(alignment - 1);
+		if (m_Head >= m_Tail) {
+			// The free space is at the end of the range, then before the tail.
+			if (offset + size > m_Capacity) {
+				if (size > m_Tail) return std::nullopt;
+				offset = 0;
+			}
+		}
+		else if (offset + size > m_Tail) {
+			return std::nullopt;
+		}
+
+		// The padding, including the end of the range skipped by a wrap, is freed with the allocation.
+		const uint64_t used = offset >= m_Head ? offset + size - m_Head : m_Capacity - m_Head + size;
+		m_Used += used;
+		m_OpenSize += used;
+		m_Head = offset + size;
+		if (m_Head == m_Capacity) m_Head = 0;
+		return offset;
+	}
+
+	bool StagingRing::Close(const uint64_t value) {
+		if (m_OpenSize == 0) return false;
+		MGN_CORE_CASSERT(m_Batches.empty() || m_Batches.back().value < value, "The batch value {} is not above the previous one.", value);
+		m_Batches.push_back({m_Head, m_OpenSize, value});
+		m_OpenSize = 0;
+		return true;
+	}
+
+	void StagingRing::Retire(const uint64_t completedValue) {
+		while (!m_Batches.empty() && m_Batches.front().value <= completedValue) {
+			const Batch &batch = m_Batches.front();
+			m_Tail = batch.end;
+			m_Used -= batch.size;
+			m_Batches.pop_front();
+		}
+	}
+
+	std::optional<uint64_t> StagingRing::GetOldestValue() const {
+		if (m_Batches.empty()) return std::nullopt;
+		return m_Batches.front().value;
+	}
+
+} // namespace Imagine
@@ -0,0 +1,280 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "Imagine/Rendering/VertexPacker.hpp"
+
+#include "Imagine/Core/SIMD.hpp"
+
+namespace Imagine {
+
+	namespace {
+		// The vertex is loaded as five rows of four floats.
+		static_assert(offsetof(Vertex, uv_x) == 3 * sizeof(float));
+		static_assert(offsetof(Vertex, normal) == 4 * sizeof(float));
+		static_assert(offsetof(Vertex, uv_y) == 7 * sizeof(float));
+		static_assert(offsetof(Vertex, tangent) == 8 * sizeof(float));
+		static_assert(offsetof(Vertex, bitangent) == 12 * sizeof(float));
+		static_assert(offsetof(Vertex, color) == 16 * sizeof(float));
+		static_assert(sizeof(CompactVertex) == 24);
+		static_assert(sizeof(QuantizedVertex) == 16);
+
+		constexpr float c_Snorm16 = 32767.0f;
+		constexpr float c_Snorm8 = 127.0f;
+		constexpr float c_Unorm16 = 65535.0f;
+		constexpr float c_Unorm8 = 255.0f;
+
+		/// A group of SIMD::c_Width vertices, one per lane.
+		struct VertexLanes {
+			SIMD::Float4 px, py, pz, u;
+			SIMD::Float4 nx, ny, nz, v;
+			SIMD::Float4 tx, ty, tz, tw;
+			SIMD::Float4 bx, by, bz, bw;
+			SIMD::Float4 r, g, b, a;
+		};
+
+		/// Load up to SIMD::c_Width vertices, the missing lanes repeat the last vertex.
+		VertexLanes LoadLanes(const Vertex *vertices, const uint64_t count) {
+			const float *rows[SIMD::c_Width];
+			for (uint64_t i = 0; i < SIMD::c_Width; ++i) {
+				rows[i] = reinterpret_cast<const float *>(vertices + std::min(i, count - 1));
+			}
+
+			VertexLanes lanes;
+			const auto load = [&rows](const uint64_t offset, SIMD::Float4 &x, SIMD::Float4 &y, SIMD::Float4 &z, SIMD::Float4 &w) {
+				x = SIMD::LoadUnaligned(rows[0] + offset);
+				y = SIMD::LoadUnaligned(rows[1] + offset);
+				z = SIMD::LoadUnaligned(rows[2] + offset);
+				w = SIMD::LoadUnaligned(rows[3] + offset);
+				SIMD::Transpose(x, y, z, w);
+			};
+			load(0, lanes.px, lanes.py, lanes.pz, lanes.u);
+			load(4, lanes.nx, lanes.ny, lanes.nz, lanes.v);
+			load(8, lanes.tx, lanes.ty, lanes.tz, lanes.tw);
+			load(12, lanes.bx, lanes.by, lanes.bz, lanes.bw);
+			load(16, lanes.r, lanes.g, lanes.b, lanes.a);
+			return lanes;
+		}
+
+		/// Project the direction on the octahedron and unfold its lower half, both coordinates are in [-1, 1].
+		void EncodeOctahedral(const SIMD::Float4 x, const SIMD::Float4 y, const SIMD::Float4 z, SIMD::Float4 &u, SIMD::Float4 &v) {
+			// The null vectors end up on the upper pole instead of dividing by zero.
+			const SIMD::Float4 length = SIMD::Max(SIMD::Abs(x) + SIMD::Abs(y) + SIMD::Abs(z), SIMD::Set(1e-20f));
+			const SIMD::Float4 ox = x / length;
+			const SIMD::Float4 oy = y / length;
+			const SIMD::Float4 lower = SIMD::Less(z, SIMD::Set(0.0f));
+			u = SIMD::Select(lower, SIMD::CopySign(SIMD::Set(1.0f) - SIMD::Abs(oy), ox), ox);
+			v = SIMD::Select(lower, SIMD::CopySign(SIMD::Set(1.0f) - SIMD::Abs(ox), oy), oy);
+		}
+
+		SIMD::Int4 ToSnorm(const SIMD::Float4 value, const float scale) {
+			return SIMD::RoundToInt(SIMD::Min(SIMD::Max(value, SIMD::Set(-1.0f)), SIMD::Set(1.0f)) * SIMD::Set(scale));
+		}
+
+		SIMD::Int4 ToUnorm(const SIMD::Float4 value, const float scale) {
+			return SIMD::RoundToInt(SIMD::Min(SIMD::Max(value, SIMD::Set(0.0f)), SIMD::Set(1.0f)) * SIMD::Set(scale));
+		}
+
+		/// Float to half float, rounded to the nearest even. The values too large for a half become infinite.
+		SIMD::Int4 ToHalf(const SIMD::Float4 value) {
+			const SIMD::Int4 bits = SIMD::AsInt(value);
+			const SIMD::Int4 sign = bits & SIMD::SetInt(INT32_MIN);
+			const SIMD::Int4 magnitude = bits & SIMD::SetInt(INT32_MAX);
+
+			const SIMD::Int4 overflow = SIMD::Greater(magnitude, SIMD::SetInt(((127 + 16) << 23) - 1));
+			const SIMD::Int4 infinite = SIMD::Select(SIMD::Greater(magnitude, SIMD::SetInt(0x7F800000)), SIMD::SetInt(0x7E00), SIMD::SetInt(0x7C00));
+
+			// The float addition aligns the mantissa of the subnormals on the one of the half, and rounds it.
+			const SIMD::Int4 magic = SIMD::SetInt((127 - 15 + 23 - 10 + 1) << 23);
+			const SIMD::Int4 subnormal = SIMD::AsInt(SIMD::AsFloat(magnitude) + SIMD::AsFloat(magic)) - magic;
+
+			// The exponent is rebiased, and the mantissa rounded to even before its lower bits are dropped.
+			const SIMD::Int4 odd = SIMD::ShiftRight<13>(magnitude) & SIMD::SetInt(1);
+			const SIMD::Int4 bias = SIMD::SetInt(static_cast<int32_t>((static_cast<uint32_t>(15 - 127) << 23) + 0xFFF));
+			const SIMD::Int4 normal = SIMD::ShiftRight<13>(magnitude + bias + odd);
+
+			const SIMD::Int4 isSubnormal = SIMD::Greater(SIMD::SetInt(113 << 23), magnitude);
+			return SIMD::Select(overflow, infinite, SIMD::Select(isSubnormal, subnormal, normal)) | SIMD::ShiftRight<16>(sign);
+		}
+
+		SIMD::Int4 Pack16(const SIMD::Int4 low, const SIMD::Int4 high) {
+			return (low & SIMD::SetInt(0xFFFF)) | SIMD::ShiftLeft<16>(high);
+		}
+
+		SIMD::Int4 Pack8(const SIMD::Int4 x, const SIMD::Int4 y, const SIMD::Int4 z, const SIMD::Int4 w) {
+			const SIMD::Int4 mask = SIMD::SetInt(0xFF);
+			return (x & mask) | SIMD::ShiftLeft<8>(y & mask) | SIMD::ShiftLeft<16>(z & mask) | SIMD::ShiftLeft<24>(w);
+		}
+
+		float FromHalf(const uint32_t half) {
+			const uint32_t exponent = (half >> 10) & 0x1F;
+			const uint32_t mantissa = half & 0x3FF;
+			float value;
+			if (exponent == 0) {
+				value = std::ldexp(static_cast<float>(mantissa), -24);
+			}
+			else if (exponent == 0x1F) {
+				value = mantissa ? std::numeric_limits<float>::quiet_NaN() : std::numeric_limits<float>::infinity();
+			}
+			else {
+				const uint32_t bits = ((exponent + 127 - 15) << 23) | (mantissa << 13);
+				std::memcpy(&value, &bits, sizeof(float));
+			}
+			return (half & 0x8000) ? -value : value;
+		}
+
+		float FromSnorm(const int32_t value, const float scale) {
+			return std::max(static_cast<float>(value) / scale, -1.0f);
+		}
+
+		glm::fvec3 DecodeOctahedral(const float u, const float v) {
+			glm::fvec3 direction{u, v, 1.0f - std::abs(u) - std::abs(v)};
+			const float fold = std::max(-direction.z, 0.0f);
+			direction.x += direction.x >= 0.0f ? -fold : fold;
+			direction.y += direction.y >= 0.0f ? -fold : fold;
+			return glm::normalize(direction);
+		}
+
+		glm::fvec3 DecodeOctahedral16(const uint32_t packed) {
+			return DecodeOctahedral(FromSnorm(static_cast<int16_t>(packed & 0xFFFF), c_Snorm16), FromSnorm(static_cast<int16_t>(packed >> 16), c_Snorm16));
+		}
+
+		glm::fvec3 DecodeOctahedral8(const uint32_t packed) {
+			return DecodeOctahedral(FromSnorm(static_cast<int8_t>(packed & 0xFF), c_Snorm8), FromSnorm(static_cast<int8_t>((packed >> 8) & 0xFF), c_Snorm8));
+		}
+	} // namespace
+
+	uint64_t VertexPacker::GetVertexSize(const VertexLayout layout) {
+		switch (layout) {
+			case VertexLayout::Full: return sizeof(Vertex);
+			case VertexLayout::Compact: return sizeof(CompactVertex);
+			case VertexLayout::Quantized: return sizeof(QuantizedVertex);
+		}
+		return sizeof(Vertex);
+	}
+
+	PackedVertices VertexPacker::Pack(const std::span<const Vertex> vertices, const VertexLayout layout) {
+		MGN_PROFILE_FUNCTION();
+		PackedVertices packed;
+		packed.layout = layout;
+		packed.count = vertices.size();
+		packed.vertices.resize(vertices.size() * GetVertexSize(layout));
+		if (vertices.empty()) return packed;
+
+		if (layout == VertexLayout::Full) {
+			std::memcpy(packed.vertices.data(), vertices.data(), packed.vertices.size());
+			return packed;
+		}
+
+		const bool white = std::all_of(vertices.begin(), vertices.end(), [](const Vertex &vertex) { return vertex.color == glm::fvec4{1, 1, 1, 1}; });
+		if (!white) packed.colors.resize(vertices.size());
+
+		glm::fvec3 inverseScale{1, 1, 1};
+		if (layout == VertexLayout::Quantized) {
+			glm::fvec3 min = vertices.front().position;
+			glm::fvec3 max = vertices.front().position;
+			for (const Vertex &vertex: vertices) {
+				min = glm::min(min, vertex.position);
+				max = glm::max(max, vertex.position);
+			}
+			packed.positionOffset = min;
+			packed.positionScale = max - min;
+			for (int i = 0; i < 3; ++i) {
+				inverseScale[i] = packed.positionScale[i] > 0.0f ? 1.0f / packed.positionScale[i] : 0.0f;
+			}
+		}
+
+		std::byte *output = packed.vertices.data();
+		for (uint64_t first = 0; first < vertices.size(); first += SIMD::c_Width) {
+			const uint64_t count = std::min<uint64_t>(SIMD::c_Width, vertices.size() - first);
+			const VertexLanes lanes = LoadLanes(vertices.data() + first, count);
+
+			SIMD::Float4 nu, nv, tu, tv;
+			EncodeOctahedral(lanes.nx, lanes.ny, lanes.nz, nu, nv);
+			EncodeOctahedral(lanes.tx, lanes.ty, lanes.tz, tu, tv);
+
+			// The bitangent is rebuilt as 'cross(normal, tangent)', flipped when it points the other way.
+			const SIMD::Float4 cx = lanes.ny * lanes.tz - lanes.nz * lanes.ty;
+			const SIMD::Float4 cy = lanes.nz * lanes.tx - lanes.nx * lanes.tz;
+			const SIMD::Float4 cz = lanes.nx * lanes.ty - lanes.ny * lanes.tx;
+			const SIMD::Int4 flipped = SIMD::AsInt(SIMD::Less(cx * lanes.bx + cy * lanes.by + cz * lanes.bz, SIMD::Set(0.0f))) & SIMD::SetInt(1);
+
+			alignas(16) uint32_t words[4][SIMD::c_Width];
+			SIMD::StoreUnaligned(words[3], Pack16(ToHalf(lanes.u), ToHalf(lanes.v)));
+
+			if (layout == VertexLayout::Compact) {
+				SIMD::StoreUnaligned(words[0], Pack16(ToSnorm(nu, c_Snorm16), ToSnorm(nv, c_Snorm16)));
+				SIMD::StoreUnaligned(words[1], (Pack16(ToSnorm(tu, c_Snorm16), ToSnorm(tv, c_Snorm16)) & SIMD::SetInt(~1)) | flipped);
+				for (uint64_t i = 0; i < count; ++i) {
+					const CompactVertex vertex{vertices[first + i].position, words[0][i], words[1][i], words[3][i]};
+					std::memcpy(output + (first + i) * sizeof(CompactVertex), &vertex, sizeof(CompactVertex));
+				}
+			}
+			else {
+				const SIMD::Int4 x = ToUnorm((lanes.px - SIMD::Set(packed.positionOffset.x)) * SIMD::Set(inverseScale.x), c_Unorm16);
+				const SIMD::Int4 y = ToUnorm((lanes.py - SIMD::Set(packed.positionOffset.y)) * SIMD::Set(inverseScale.y), c_Unorm16);
+				const SIMD::Int4 z = ToUnorm((lanes.pz - SIMD::Set(packed.positionOffset.z)) * SIMD::Set(inverseScale.z), c_Unorm16);
+				SIMD::StoreUnaligned(words[0], Pack16(x, y));
+				SIMD::StoreUnaligned(words[1], z | SIMD::ShiftLeft<16>(Pack8(ToSnorm(nu, c_Snorm8), ToSnorm(nv, c_Snorm8), SIMD::SetInt(0), SIMD::SetInt(0))));
+				SIMD::StoreUnaligned(words[2], Pack8(ToSnorm(tu, c_Snorm8), ToSnorm(tv, c_Snorm8), flipped, SIMD::SetInt(0)));
+				for (uint64_t i = 0; i < count; ++i) {
+					const QuantizedVertex vertex{words[0][i], words[1][i], words[2][i], words[3][i]};
+					std::memcpy(output + (first + i) * sizeof(QuantizedVertex), &vertex, sizeof(QuantizedVertex));
+				}
+			}
+
+			if (!white) {
+				const SIMD::Int4 color = Pack8(ToUnorm(lanes.r, c_Unorm8), ToUnorm(lanes.g, c_Unorm8), ToUnorm(lanes.b, c_Unorm8), ToUnorm(lanes.a, c_Unorm8));
+				SIMD::StoreUnaligned(words[0], color);
+				std::memcpy(packed.colors.data() + first, words[0], count * sizeof(uint32_t));
+			}
+		}
+
+		return packed;
+	}
+
+	std::vector<Vertex> VertexPacker::Unpack(const PackedVertices &packed) {
+		std::vector<Vertex> vertices(packed.count);
+		if (packed.layout == VertexLayout::Full) {
+			std::memcpy(vertices.data(), packed.vertices.data(), std::min<uint64_t>(packed.vertices.size(), vertices.size() * sizeof(Vertex)));
+			return vertices;
+		}
+
+		for (uint64_t i = 0; i < packed.count; ++i) {
+			Vertex &vertex = vertices[i];
+			glm::fvec3 tangent;
+			bool flipped;
+			uint32_t uv;
+			if (packed.layout == VertexLayout::Compact) {
+				CompactVertex compact;
+				std::memcpy(&compact, packed.vertices.data() + i * sizeof(CompactVertex), sizeof(CompactVertex));
+				vertex.position = compact.position;
+				vertex.normal = DecodeOctahedral16(compact.normal);
+				tangent = DecodeOctahedral16(compact.tangent);
+				flipped = compact.tangent & 1;
+				uv = compact.uv;
+			}
+			else {
+				QuantizedVertex quantized;
+				std::memcpy(&quantized, packed.vertices.data() + i * sizeof(QuantizedVertex), sizeof(QuantizedVertex));
+				const glm::fvec3 unorm{static_cast<float>(quantized.positionXY & 0xFFFF), static_cast<float>(quantized.positionXY >> 16), static_cast<float>(quantized.positionZNormal & 0xFFFF)};
+				vertex.position = packed.positionOffset + unorm / c_Unorm16 * packed.positionScale;
+				vertex.normal = DecodeOctahedral8(quantized.positionZNormal >> 16);
+				tangent = DecodeOctahedral8(quantized.tangent);
+				flipped = (quantized.tangent >> 16) & 1;
+				uv = quantized.uv;
+			}
+
+			vertex.tangent = glm::fvec4{tangent, 0};
+			vertex.bitangent = glm::fvec4{glm::cross(vertex.normal, tangent) * (flipped ? -1.0f : 1.0f), 0};
+			vertex.uv_x = FromHalf(uv & 0xFFFF);
+			vertex.uv_y = FromHalf(uv >> 16);
+			if (!packed.colors.empty()) {
+				const uint32_t color = packed.colors[i];
+				vertex.color = glm::fvec4{color & 0xFF, (color >> 8) & 0xFF, (color >> 16) & 0xFF, color >> 24} / c_Unorm8;
+			}
+		}
+		return vertices;
+	}
+
+} // namespace Imagine
@@ -0,0 +1,188 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "Imagine/Scene/BinaryScene.hpp"
+#include "Imagine/Core/Logger.hpp"
+
+namespace Imagine {
+
+	BinarySceneFile::BinarySceneFile(const std::filesystem::path &filePath) {
+		Open(filePath);
+	}
+
+	bool BinarySceneFile::Open(const std::filesystem::path &filePath) {
+		Close();
+		if (!m_File.Open(filePath)) return false;
+
+		if (m_File.Size() < sizeof(BinarySceneHeader)) {
+			MGN_CORE_ERROR("The file '{}' is too small to be a binary scene.", filePath.string());
+			Close();
+			return false;
+		}
+
+		const auto *header = reinterpret_cast<const BinarySceneHeader *>(m_File.Get());
+		if (header->magic != c_BinarySceneMagic || header->version != c_BinarySceneVersion) {
+			MGN_CORE_ERROR("The file '{}' is not a binary scene of version {}.", filePath.string(), c_BinarySceneVersion);
+			Close();
+			return false;
+		}
+
+		const bool valid =
+				IsInFile(header->entityIds, sizeof(uint32_t)) &&
+				IsInFile(header->entities, sizeof(Entity)) &&
+				IsInFile(header->nameOffsets, sizeof(uint32_t)) &&
+				IsInFile(header->names, sizeof(char)) &&
+				IsInFile(header->roots, sizeof(EntityID)) &&
+				IsInFile(header->parentIds, sizeof(uint32_t)) &&
+				IsInFile(header->parents, sizeof(Parent)) &&
+				IsInFile(header->childIds, sizeof(uint32_t)) &&
+				IsInFile(header->children, sizeof(Child)) &&
+				IsInFile(header->siblingIds, sizeof(uint32_t)) &&
+				IsInFile(header->siblings, sizeof(Sibling)) &&
+				IsInFile(header->components, sizeof(BinarySceneComponent)) &&
+				header->entityIds.count == header->entities.count &&
+				header->nameOffsets.count == header->entities.count + 1 &&
+				header->parentIds.count == header->parents.count &&
+				header->childIds.count == header->children.count &&
+				header->siblingIds.count == header->siblings.count;
+
+		if (!valid) {
+			MGN_CORE_ERROR("The binary scene '{}' is corrupted.", filePath.string());
+			Close();
+			return false;
+		}
+
+		m_Header = header;
+		for (const BinarySceneComponent &component: GetComponents()) {
+			if (!IsInFile(component.name, sizeof(char)) || !IsInFile(component.ids, sizeof(uint32_t)) || !IsInFile(component.data, component.size) || component.ids.count != component.data.count) {
+				MGN_CORE_ERROR("The binary scene '{}' is corrupted.", filePath.string());
+				Close();
+				return false;
+			}
+		}
+
+		const std::span<const uint32_t> nameOffsets = GetArray<uint32_t>(header->nameOffsets);
+		bool validNames = nameOffsets.back() <= header->names.count;
+		for (uint32_t i = 1; i < nameOffsets.size() && validNames; ++i) {
+			validNames = nameOffsets[i - 1] <= nameOffsets[i];
+		}
+		if (!validNames || !IsValidHierarchy()) {
+			MGN_CORE_ERROR("The binary scene '{}' is corrupted.", filePath.string());
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void BinarySceneFile::Close() {
+		m_Header = nullptr;
+		m_File.Close();
+	}
+
+	bool BinarySceneFile::IsInFile(const BinarySceneArray &array, const uint64_t stride) const {
+		if (array.count == 0) return true;
+		return array.stride == stride && array.offset % c_BinarySceneAlignment == 0 && array.offset <= m_File.Size() && array.ByteSize() <= m_File.Size() - array.offset;
+	}
+
+	bool BinarySceneFile::IsValidHierarchy() const {
+		const std::span<const uint32_t> entityIds = GetArray<uint32_t>(m_Header->entityIds);
+		const std::span<const Entity> entities = GetArray<Entity>(m_Header->entities);
+
+		// The dense index of each entity id, every id being bounded so is the table.
+		std::vector<uint32_t> indices;
+		for (uint32_t i = 0; i < entityIds.size(); ++i) {
+			const uint32_t id = entityIds[i];
+			if (id >= c_BinarySceneMaxEntityId || entities[i].Id.id != id) return false;
+			if (id >= indices.size()) indices.resize(id + 1, EntityID::NullID);
+			if (indices[id] != EntityID::NullID) return false;
+			indices[id] = i;
+		}
+		const auto isEntity = [&indices](const uint32_t id) { return id < indices.size() && indices[id] != EntityID::NullID; };
+
+		// Each sparse set holds an id once, and only the ids of the entities.
+		std::vector<uint8_t> seen(indices.size());
+		const auto areEntities = [&](const std::span<const uint32_t> ids) {
+			std::fill(seen.begin(), seen.end(), 0);
+			for (const uint32_t id: ids) {
+				if (!isEntity(id) || seen[id]++) return false;
+			}
+			return true;
+		};
+		const std::span<const uint32_t> roots = GetArray<uint32_t>(m_Header->roots);
+		const std::span<const uint32_t> parentIds = GetArray<uint32_t>(m_Header->parentIds);
+		const std::span<const uint32_t> childIds = GetArray<uint32_t>(m_Header->childIds);
+		const std::span<const uint32_t> siblingIds = GetArray<uint32_t>(m_Header->siblingIds);
+		if (!areEntities(roots) || !areEntities(parentIds) || !areEntities(childIds) || !areEntities(siblingIds)) return false;
+		for (const BinarySceneComponent &component: GetComponents()) {
+			if (!areEntities(GetArray<uint32_t>(component.ids))) return false;
+		}
+
+		std::vector<uint32_t> parentOf(indices.size(), EntityID::NullID);
+		std::vector<uint32_t> firstChildOf(indices.size(), EntityID::NullID);
+		std::vector<uint32_t> nextOf(indices.size(), EntityID::NullID);
+		const std::span<const Parent> parents = GetArray<Parent>(m_Header->parents);
+		const std::span<const Child> children = GetArray<Child>(m_Header->children);
+		const std::span<const Sibling> siblings = GetArray<Sibling>(m_Header->siblings);
+		for (uint32_t i = 0; i < parents.size(); ++i) {
+			if (!isEntity(parents[i].parent.id)) return false;
+			parentOf[parentIds[i]] = parents[i].parent.id;
+		}
+		for (uint32_t i = 0; i < children.size(); ++i) {
+			if (!isEntity(children[i].firstChild.id)) return false;
+			firstChildOf[childIds[i]] = children[i].firstChild.id;
+		}
+		for (uint32_t i = 0; i < siblings.size(); ++i) {
+			if ((siblings[i].previous.IsValid() && !isEntity(siblings[i].previous.id)) || (siblings[i].next.IsValid() && !isEntity(siblings[i].next.id))) return false;
+			nextOf[siblingIds[i]] = siblings[i].next.id;
+		}
+
+		// Walk the hierarchy as 'Scene::RebuildHierarchyOrder' does: every entity is reached once, from a root or its parent.
+		// A cycle reaches an entity twice, or makes a list of siblings longer than the scene.
+		std::fill(seen.begin(), seen.end(), 0);
+		std::vector<uint32_t> stack;
+		stack.reserve(entityIds.size());
+		for (const uint32_t root: roots) {
+			if (parentOf[root] != EntityID::NullID) return false;
+			stack.push_back(root);
+		}
+		uint32_t reached = 0;
+		while (!stack.empty()) {
+			const uint32_t id = stack.back();
+			stack.pop_back();
+			if (seen[id]++) return false;
+			++reached;
+			for (uint32_t child = firstChildOf[id]; child != EntityID::NullID; child = nextOf[child]) {
+				if (parentOf[child] != id || stack.size() >= entityIds.size()) return false;
+				stack.push_back(child);
+			}
+		}
+		return reached == entityIds.size();
+	}
+
+	const BinarySceneComponent *BinarySceneFile::FindComponent(const UUID id) const {
+		for (const BinarySceneComponent &component: GetComponents()) {
+			if (UUID{component.id[0], component.id[1]} == id) {
+				return &component;
+			}
+		}
+		return nullptr;
+	}
+
+	std::string_view BinarySceneFile::GetComponentName(const BinarySceneComponent &component) const {
+		const std::span<const char> name = GetArray<char>(component.name);
+		return {name.data(), name.size()};
+	}
+
+	ConstBufferView BinarySceneFile::GetComponentData(const BinarySceneComponent &component) const {
+		return ConstBufferView{m_File.Get(), component.data.offset, component.data.ByteSize()};
+	}
+
+	std::string_view BinarySceneFile::GetName(const uint32_t entityIndex) const {
+		const std::span<const uint32_t> offsets = GetArray<uint32_t>(m_Header->nameOffsets);
+		const std::span<const char> names = GetArray<char>(m_Header->names);
+		return {names.data() + offsets[entityIndex], offsets[entityIndex + 1] - offsets[entityIndex]};
+	}
+
+} // namespace Imagine
@@ -17,7 +17,10 @@
 #include <utility>
 #endif
 namespace Imagine {
-	Scene::Scene() : Asset() {
+	Scene::Scene() : Scene(ComponentStorage::SparseSet) {
+	}
+
+	Scene::Scene(const ComponentStorage storage) : Asset(), m_ComponentStorage(storage) {
 		RegisterType<Renderable>();
 		RegisterType<Physicalisable>();
 		RegisterType<Light>();
@@ -36,6 +39,8 @@ namespace Imagine {
 		m_SparseEntities.Get(id.id).Id = id;
 		m_Names.Create(id.id, "Entity " + id.string());
 		m_Roots.insert(id);
+		MarkTransformDirty(id);
+		m_HierarchyChanged = true;
 		return id;
 	}
 
@@ -49,6 +54,8 @@ namespace Imagine {
 		else {
 			m_Roots.insert(id);
 		}
+		MarkTransformDirty(id);
+		m_HierarchyChanged = true;
 		return id;
 	}
 
@@ -59,6 +66,22 @@ namespace Imagine {
 	const Entity &Scene::GetEntity(const EntityID id) const {
 		return m_SparseEntities.Get(id.id);
 	}
+
+	void Scene::SetLocalPosition(const EntityID id, const Vec3 &position) {
+		m_SparseEntities.Get(id.id).LocalPosition = position;
+		MarkTransformDirty(id);
+	}
+
+	void Scene::SetLocalRotation(const EntityID id, const Quat &rotation) {
+		m_SparseEntities.Get(id.id).LocalRotation = rotation;
+		MarkTransformDirty(id);
+	}
+
+	void Scene::SetLocalScale(const EntityID id, const Vec3 &scale) {
+		m_SparseEntities.Get(id.id).LocalScale = scale;
+		MarkTransformDirty(id);
+	}
+
 	bool Scene::Exist(EntityID id) const {
 		return m_SparseEntities.Exist(id.id);
 	}
@@ -79,19 +102,39 @@ namespace Imagine {
 			for (auto &[uuid, rawSparseSet]: m_CustomComponents) {
 				rawSparseSet.Remove(id.id);
 			}
+			m_Archetypes.RemoveEntity(id.id);
 			m_Names.Remove(id.id);
 			m_Siblings.Remove(id.id);
 			m_Parents.Remove(id.id);
 			m_Children.Remove(id.id);
-			m_WorldTransform.Remove(id.id);
+			if (id.id < m_HierarchyIndices.size()) {
+				m_HierarchyIndices[id.id] = c_InvalidHierarchyIndex;
+			}
 		}
+		m_HierarchyChanged = true;
 	}
 
 	void Scene::Clear() {
 		for (auto &[uuid, rawSparseSet]: m_CustomComponents) {
 			rawSparseSet.Clear();
 		}
+		m_Archetypes.Clear();
 		m_SparseEntities.Clear();
+
+		m_Roots.clear();
+		m_Parents.Clear();
+		m_Children.Clear();
+		m_Siblings.Clear();
+		m_Names.Clear();
+
+		m_HierarchyOrder.clear();
+		m_HierarchyParents.clear();
+		m_HierarchyLevels.clear();
+		m_HierarchyIndices.clear();
+		m_WorldTransforms.clear();
+		m_TransformStamps.clear();
+		m_HasDirtyTransforms = false;
+		m_HierarchyChanged = false;
 	}
 	std::string Scene::GetName(EntityID entityId) const {
 		auto *name = m_Names.TryGet(entityId.id);
@@ -192,7 +235,7 @@ namespace Imagine {
 		return scene->GetEntity(current);
 	}
 	const Entity &Scene::RelationshipIterator::Get() const {
-		return scene->GetEntity(current);
+		return std::as_const(*scene).GetEntity(current);
 	}
 	bool Scene::RelationshipIterator::IsRoot() const {
 		return std::find(scene->m_Roots.cbegin(), scene->m_Roots.cend(), current) != scene->m_Roots.cend();
@@ -312,11 +355,16 @@ namespace Imagine {
 		else {
 			m_Roots.insert(child.id);
 		}
+
+		MarkTransformDirty(child);
+		m_HierarchyChanged = true;
 	}
 
 	void Scene::MoveToRoot(EntityID entity) {
 		RemoveParent(entity);
 		m_Roots.insert(entity);
+		MarkTransformDirty(entity);
+		m_HierarchyChanged = true;
 	}
 
 	void Scene::RemoveParent(EntityID child) {
@@ -378,22 +426,136 @@ namespace Imagine {
 		}
 	}
 
+	void Scene::MarkTransformDirty(const EntityID id) {
+		if (id.id >= m_TransformStamps.size()) {
+			m_TransformStamps.resize(id.id + 1, 0);
+		}
+		m_TransformStamps[id.id] = m_TransformStamp;
+		m_HasDirtyTransforms = true;
+	}
+
+	bool Scene::IsTransformDirty(const EntityID id) const {
+		return id.id < m_TransformStamps.size() && m_TransformStamps[id.id] == m_TransformStamp;
+	}
+
+	bool Scene::WriteRootTransform(const EntityID id, const Vec3 &position, const Quat &rotation) {
+		Entity &entity = m_SparseEntities.Get(id.id);
+		entity.LocalPosition = position;
+		entity.LocalRotation = rotation;
+
+		// The children would need their world transform recomputed, the hierarchy order is only valid once rebuilt.
+		const uint32_t index = m_HierarchyChanged ? c_InvalidHierarchyIndex : GetHierarchyIndex(id);
+		if (index == c_InvalidHierarchyIndex || m_HierarchyParents[index] != c_InvalidHierarchyIndex) return false;
+		const Child *child = m_Children.TryGet(id.id);
+		if (child && child->firstChild.IsValid()) return false;
+
+		m_WorldTransforms[index] = TransformR{position, rotation, entity.LocalScale, Mat4(1)};
+		return true;
+	}
+
+	uint32_t Scene::GetHierarchyIndex(const EntityID id) const {
+		return id.id < m_HierarchyIndices.size() ? m_HierarchyIndices[id.id] : c_InvalidHierarchyIndex;
+	}
+
+	void Scene::RebuildHierarchyOrder() {
+		std::vector<EntityID> order;
+		std::vector<uint32_t> parents;
+		std::vector<uint32_t> levels;
+		order.reserve(m_SparseEntities.Count());
+		parents.reserve(m_SparseEntities.Count());
+
+		for (const EntityID root: m_Roots) {
+			order.push_back(root);
+			parents.push_back(c_InvalidHierarchyIndex);
+		}
+
+		// Breadth first, so every depth level ends up contiguous.
+		levels.push_back(0);
+		uint32_t begin = 0;
+		while (begin < order.size()) {
+			const uint32_t end = static_cast<uint32_t>(order.size());
+			levels.push_back(end);
+			for (uint32_t i = begin; i < end; ++i) {
+				const Child *child = m_Children.TryGet(order[i].id);
+				EntityID current = child ? child->firstChild : EntityID::NullID;
+				while (current.IsValid()) {
+					order.push_back(current);
+					parents.push_back(i);
+					const Sibling *sibling = m_Siblings.TryGet(current.id);
+					current = sibling ? sibling->next : EntityID::NullID;
+				}
+			}
+			begin = end;
+		}
+
+		// The world transforms of the entities that didn't move in the hierarchy are still valid.
+		std::vector<TransformR> world(order.size());
+		std::vector<uint32_t> indices(m_TransformStamps.size(), c_InvalidHierarchyIndex);
+		for (uint32_t i = 0; i < order.size(); ++i) {
+			const EntityID id = order[i];
+			const uint32_t previous = GetHierarchyIndex(id);
+			if (previous != c_InvalidHierarchyIndex) {
+				world[i] = m_WorldTransforms[previous];
+			}
+			else {
+				MarkTransformDirty(id);
+			}
+			if (id.id >= indices.size()) {
+				indices.resize(id.id + 1, c_InvalidHierarchyIndex);
+			}
+			indices[id.id] = i;
+		}
+
+		m_HierarchyOrder = std::move(order);
+		m_HierarchyParents = std::move(parents);
+		m_HierarchyLevels = std::move(levels);
+		m_HierarchyIndices = std::move(indices);
+		m_WorldTransforms = std::move(world);
+		m_HierarchyChanged = false;
+	}
+
 	void Scene::CacheTransforms() {
-		TransformR trs{};
-		ForEach<TransformR>(trs, [](const TransformR &parentTrs, Scene *scene, const EntityID id) {
-			const TransformR worldTrs{scene->GetEntity(id).LocalPosition, scene->GetEntity(id).LocalRotation, scene->GetEntity(id).LocalScale, parentTrs.PositionLocalToWorld};
-			scene->m_WorldTransform.GetOrCreate(id.id) = worldTrs;
-			return worldTrs;
-		});
+		if (m_HierarchyChanged) {
+			RebuildHierarchyOrder();
+		}
+		if (!m_HasDirtyTransforms) return;
+
+		// A recomputed entity takes the current stamp so its children, one level below, get recomputed as well.
+		const uint32_t stamp = m_TransformStamp;
+		for (uint32_t level = 0; level + 1 < m_HierarchyLevels.size(); ++level) {
+			const uint32_t levelBegin = m_HierarchyLevels[level];
+			const uint32_t levelCount = m_HierarchyLevels[level + 1] - levelBegin;
+			JobSystem::ParallelFor(levelCount, c_TransformGrainSize, [this, levelBegin, stamp](const uint32_t begin, const uint32_t end) {
+				for (uint32_t i = levelBegin + begin; i < levelBegin + end; ++i) {
+					const EntityID id = m_HierarchyOrder[i];
+					const uint32_t parent = m_HierarchyParents[i];
+					const bool parentDirty = parent != c_InvalidHierarchyIndex && m_TransformStamps[m_HierarchyOrder[parent].id] == stamp;
+					if (!parentDirty && m_TransformStamps[id.id] != stamp) continue;
+
+					m_TransformStamps[id.id] = stamp;
+					const Entity &entity = m_SparseEntities.Get(id.id);
+					const Mat4 parentMatrix = parent != c_InvalidHierarchyIndex ? m_WorldTransforms[parent].PositionLocalToWorld : Mat4(1);
+					m_WorldTransforms[i] = TransformR{entity.LocalPosition, entity.LocalRotation, entity.LocalScale, parentMatrix};
+				}
+			});
+		}
+
+		// Moving to the next stamp clears every dirty flag at once.
+		m_HasDirtyTransforms = false;
+		if (++m_TransformStamp == 0) {
+			std::fill(m_TransformStamps.begin(), m_TransformStamps.end(), 0);
+			m_TransformStamp = 1;
+		}
 	}
+
 	Mat4 Scene::GetWorldTransform(const EntityID id) const {
-		const TransformR *trs = m_WorldTransform.TryGet(id.id);
-		return trs ? trs->PositionLocalToWorld : Mat4(0);
+		const uint32_t index = GetHierarchyIndex(id);
+		return index != c_InvalidHierarchyIndex ? m_WorldTransforms[index].PositionLocalToWorld : Mat4(0);
 	}
 
 	TransformR Scene::GetTransform(const EntityID id) const {
-		const TransformR *trs = m_WorldTransform.TryGet(id.id);
-		return trs ? *trs : TransformR();
+		const uint32_t index = GetHierarchyIndex(id);
+		return index != c_InvalidHierarchyIndex ? m_WorldTransforms[index] : TransformR();
 	}
 	void Scene::SendImGuiCommands() {
 #ifdef MGN_IMGUI
@@ -464,7 +626,8 @@ namespace Imagine {
 
 					ImGui::SeparatorText("Transform");
 					{
-						Entity &e = GetEntity(m_SelectedEntity);
+						// Edited on a copy, the transform is only flagged as dirty when a field changes.
+						Entity e = std::as_const(*this).GetEntity(m_SelectedEntity);
 						static auto degRot = glm::eulerAngles(e.LocalRotation) * Math::RadToDeg;
 						if (HasComponent<Physicalisable>(m_SelectedEntity) && PhysicsLayer::IsSimulating()) {
 							ImGui::BeginDisabled(true);
@@ -475,32 +638,36 @@ namespace Imagine {
 							ImGui::EndDisabled();
 						}
 						else {
-							ImGui::DragFloat3("Position", Math::ValuePtr(e.LocalPosition), 0.1, 0, 0, "%.3f");
+							if (ImGui::DragFloat3("Position", Math::ValuePtr(e.LocalPosition), 0.1, 0, 0, "%.3f")) {
+								SetLocalPosition(m_SelectedEntity, e.LocalPosition);
+							}
 							if (ImGui::DragFloat3("Rotation", Math::ValuePtr(degRot), 1, 0, 0, "%.2f")) {
 								e.LocalRotation = Math::Normalize(Quat(degRot * Math::DegToRad));
+								SetLocalRotation(m_SelectedEntity, e.LocalRotation);
 							}
 							if (ImGui::IsItemDeactivatedAfterEdit()) {
 								degRot = glm::eulerAngles(e.LocalRotation) * Math::RadToDeg;
 							}
-							ImGui::DragFloat3("Scale", Math::ValuePtr(e.LocalScale), 0.1, 0, 0, "%.3f");
+							if (ImGui::DragFloat3("Scale", Math::ValuePtr(e.LocalScale), 0.1, 0, 0, "%.3f")) {
+								SetLocalScale(m_SelectedEntity, e.LocalScale);
+							}
 						}
 					}
 					ImGui::Separator();
 					if (ImGui::Button("Add Component"))
 						ImGui::OpenPopup("add_component_popup");
 
-					for (auto &[id, cc]: m_CustomComponents) {
-						if (!cc.Exist(m_SelectedEntity.id)) continue;
+					for (const auto &[id, metadata]: m_CustomComponentsMetadata) {
+						if (!HasComponent(m_SelectedEntity, id)) continue;
 						ImGui::PushID(*id.cbegin());
-						const auto &metadata = m_CustomComponentsMetadata.at(id);
 						if (m_CustomComponentsImGui.contains(id)) {
-							m_CustomComponentsImGui.at(id)(cc.GetView(m_SelectedEntity.id));
+							m_CustomComponentsImGui.at(id)(GetComponent(m_SelectedEntity, id));
 						}
 						else {
 							ImGui::SeparatorText(metadata.name.c_str());
 						}
 						if (ImGui::Button("Remove")) {
-							cc.Remove(m_SelectedEntity.id);
+							RemoveComponent(m_SelectedEntity, id);
 						}
 						ImGui::PopID();
 					}
@@ -508,10 +675,9 @@ namespace Imagine {
 					if (ImGui::BeginPopup("add_component_popup")) {
 						ImGui::SeparatorText("Add Components");
 
-						for (const auto &[id, cc]: m_CustomComponents) {
-							if (cc.Exist(m_SelectedEntity.id)) continue;
+						for (const auto &[id, metadata]: m_CustomComponentsMetadata) {
+							if (HasComponent(m_SelectedEntity, id)) continue;
 							ImGui::PushID(*id.cbegin());
-							const auto &metadata = m_CustomComponentsMetadata.at(id);
 							if (ImGui::Selectable(metadata.name.c_str())) {
 								AddComponent(m_SelectedEntity.id, id);
 							}
@@ -582,6 +748,13 @@ namespace Imagine {
 		}
 	}
 
+	void Scene::ForEach(std::function<void(const Scene *scene, EntityID entity)> func) const {
+		for (uint32_t i = 0; i < m_SparseEntities.Count(); ++i) {
+			const EntityID id{m_SparseEntities.GetID(i)};
+			func(this, id);
+		}
+	}
+
 	EntityID Scene::Find(const std::function<bool(Scene *, EntityID id)> &func) {
 		for (uint32_t i = 0; i < m_SparseEntities.Count(); ++i) {
 			const EntityID id{m_SparseEntities.GetID(i)};
@@ -615,12 +788,25 @@ namespace Imagine {
 		}
 	}
 	void Scene::ForEachWithComponent(UUID id, std::function<void(Scene *scene, EntityID entityId, BufferView component)> func) {
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			const ArchetypeStorage::ComponentIndex query[1]{m_Archetypes.GetComponentIndex(id)};
+			if (query[0] == ArchetypeStorage::c_NullIndex) return;
+			const uint32_t size = m_Archetypes.GetComponentInfo(query[0]).size;
+			m_Archetypes.ForEachChunk(query, [this, &func, size](const ArchetypeStorage::ChunkView &view) {
+				uint8_t *components = view.Column<uint8_t>(0);
+				for (uint32_t i = 0; i < view.count; ++i) {
+					func(this, EntityID{view.entities[i]}, BufferView{components + (i * size), 0, size});
+				}
+			});
+			return;
+		}
+
 		if (!m_CustomComponents.contains(id)) return;
 
 		auto &components = m_CustomComponents.at(id);
 
 		auto beg = components.begin();
-		auto end = components.begin();
+		auto end = components.end();
 		for (auto it = beg; it != end; ++it) {
 			EntityID entity{it.GetID()};
 			BufferView bv = it.GetView();
@@ -628,12 +814,25 @@ namespace Imagine {
 		}
 	}
 	void Scene::ForEachWithComponent(UUID id, std::function<void(const Scene *scene, EntityID entityId, ConstBufferView component)> func) const {
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			const ArchetypeStorage::ComponentIndex query[1]{m_Archetypes.GetComponentIndex(id)};
+			if (query[0] == ArchetypeStorage::c_NullIndex) return;
+			const uint32_t size = m_Archetypes.GetComponentInfo(query[0]).size;
+			m_Archetypes.ForEachChunk(query, [this, &func, size](const ArchetypeStorage::ChunkView &view) {
+				const uint8_t *components = view.Column<const uint8_t>(0);
+				for (uint32_t i = 0; i < view.count; ++i) {
+					func(this, EntityID{view.entities[i]}, ConstBufferView{components + (i * size), 0, size});
+				}
+			});
+			return;
+		}
+
 		if (!m_CustomComponents.contains(id)) return;
 
 		auto &components = m_CustomComponents.at(id);
 
 		auto beg = components.cbegin();
-		auto end = components.cbegin();
+		auto end = components.cend();
 		for (auto it = beg; it != end; ++it) {
 			EntityID entity{it.GetID()};
 			ConstBufferView bv = it.GetConstView();
@@ -641,6 +840,10 @@ namespace Imagine {
 		}
 	}
 	uint64_t Scene::CountComponents(UUID componentID) const {
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			return m_Archetypes.Count(componentID);
+		}
+
 		if (!m_CustomComponents.contains(componentID)) return 0;
 
 		const auto &cc = m_CustomComponents.at(componentID);
@@ -676,6 +879,11 @@ namespace Imagine {
 				copy_constructor != nullptr,
 		};
 
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			m_Archetypes.RegisterComponent(componentId, static_cast<uint32_t>(size), constructor, destructor, copy_constructor);
+			return;
+		}
+
 		m_CustomComponents[componentId] = RawSparseSet<uint32_t>{static_cast<uint32_t>(size), c_EntityPrepareCount};
 		auto &components = m_CustomComponents.at(componentId);
 		if (constructor) components.SetConstructor(constructor);
@@ -684,6 +892,15 @@ namespace Imagine {
 	}
 
 	BufferView Scene::AddComponent(const EntityID entityId, const UUID componentId) {
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			if (!m_Archetypes.IsRegistered(componentId)) {
+				MGN_CORE_ERROR("The component {} doesn't exist.", componentId.string());
+				return BufferView{};
+			}
+			void *data = m_Archetypes.Add(entityId.id, componentId);
+			return data ? BufferView{data, 0, m_CustomComponentsMetadata.at(componentId).size} : BufferView{};
+		}
+
 		if (!m_CustomComponents.contains(componentId)) {
 			MGN_CORE_ERROR("The component {} doesn't exist.", componentId.string());
 			return BufferView{};
@@ -705,6 +922,15 @@ namespace Imagine {
 	}
 
 	BufferView Scene::AddComponent(const EntityID entityId, const UUID componentId, const ConstBufferView view) {
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			if (!m_Archetypes.IsRegistered(componentId)) {
+				MGN_CORE_ERROR("The component id {} doesn't exist.", componentId.string());
+				return BufferView{};
+			}
+			void *data = m_Archetypes.Add(entityId.id, componentId, view);
+			return data ? BufferView{data, 0, m_CustomComponentsMetadata.at(componentId).size} : BufferView{};
+		}
+
 		if (!m_CustomComponents.contains(componentId)) {
 			MGN_CORE_ERROR("The component id {} doesn't exist.", componentId.string());
 			return BufferView{};
@@ -725,6 +951,18 @@ namespace Imagine {
 	}
 
 	BufferView Scene::GetComponent(const EntityID entityId, const UUID componentId) {
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			if (!m_Archetypes.IsRegistered(componentId)) {
+				MGN_CORE_ERROR("The component id {} doesn't exist.", componentId.string());
+				return BufferView{};
+			}
+			if (void *data = m_Archetypes.TryGet(entityId.id, componentId)) {
+				return BufferView{data, 0, m_CustomComponentsMetadata.at(componentId).size};
+			}
+			MGN_CORE_ERROR("The component '{}' hasn't been added to the entity '{}'.", m_CustomComponentsMetadata.at(componentId).name, GetName(entityId));
+			return {};
+		}
+
 		if (!m_CustomComponents.contains(componentId)) {
 			MGN_CORE_ERROR("The component id {} doesn't exist.", componentId.string());
 			return BufferView{};
@@ -741,6 +979,18 @@ namespace Imagine {
 	}
 
 	ConstBufferView Scene::GetComponent(const EntityID entityId, const UUID componentId) const {
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			if (!m_Archetypes.IsRegistered(componentId)) {
+				MGN_CORE_ERROR("The component id {} doesn't exist.", componentId.string());
+				return ConstBufferView{};
+			}
+			if (const void *data = m_Archetypes.TryGet(entityId.id, componentId)) {
+				return ConstBufferView{data, 0, m_CustomComponentsMetadata.at(componentId).size};
+			}
+			MGN_CORE_ERROR("The component '{}' hasn't been added to the entity '{}'.", m_CustomComponentsMetadata.at(componentId).name, GetName(entityId));
+			return {};
+		}
+
 		if (!m_CustomComponents.contains(componentId)) {
 			MGN_CORE_ERROR("The component id {} doesn't exist.", componentId.string());
 			return ConstBufferView{};
@@ -758,6 +1008,15 @@ namespace Imagine {
 
 
 	BufferView Scene::TryGetComponent(const EntityID entityId, const UUID componentId) {
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			if (!m_Archetypes.IsRegistered(componentId)) {
+				MGN_CORE_ERROR("The component id {} doesn't exist.", componentId.string());
+				return BufferView{};
+			}
+			void *data = m_Archetypes.TryGet(entityId.id, componentId);
+			return data ? BufferView{data, 0, m_CustomComponentsMetadata.at(componentId).size} : BufferView{};
+		}
+
 		if (!m_CustomComponents.contains(componentId)) {
 			MGN_CORE_ERROR("The component id {} doesn't exist.", componentId.string());
 			return BufferView{};
@@ -773,6 +1032,15 @@ namespace Imagine {
 	}
 
 	ConstBufferView Scene::TryGetComponent(const EntityID entityId, const UUID componentId) const {
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			if (!m_Archetypes.IsRegistered(componentId)) {
+				MGN_CORE_ERROR("The component id {} doesn't exist.", componentId.string());
+				return ConstBufferView{};
+			}
+			const void *data = m_Archetypes.TryGet(entityId.id, componentId);
+			return data ? ConstBufferView{data, 0, m_CustomComponentsMetadata.at(componentId).size} : ConstBufferView{};
+		}
+
 		if (!m_CustomComponents.contains(componentId)) {
 			MGN_CORE_ERROR("The component id {} doesn't exist.", componentId.string());
 			return ConstBufferView{};
@@ -788,6 +1056,12 @@ namespace Imagine {
 	}
 
 	BufferView Scene::GetOrAddComponent(EntityID entityId, UUID componentId) {
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			if (m_Archetypes.Has(entityId.id, componentId)) {
+				return TryGetComponent(entityId, componentId);
+			}
+			return AddComponent(entityId, componentId);
+		}
 
 		if (!m_CustomComponents.contains(componentId)) {
 			MGN_CORE_ERROR("The component id {} doesn't exist.", componentId.string());
@@ -808,6 +1082,10 @@ namespace Imagine {
 		return {};
 	}
 	bool Scene::HasComponent(EntityID entityId, UUID componentId) const {
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			return m_Archetypes.Has(entityId.id, componentId);
+		}
+
 		if (!m_CustomComponents.contains(componentId)) {
 			return false;
 		}
@@ -816,6 +1094,14 @@ namespace Imagine {
 	}
 
 	bool Scene::RemoveComponent(EntityID entityId, UUID componentId) {
+		if (m_ComponentStorage == ComponentStorage::Archetype) {
+			if (!m_Archetypes.IsRegistered(componentId)) {
+				return false;
+			}
+			m_Archetypes.Remove(entityId.id, componentId);
+			return true;
+		}
+
 		if (!m_CustomComponents.contains(componentId)) {
 			return false;
 		}
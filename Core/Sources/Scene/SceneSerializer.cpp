@@ -3,6 +3,8 @@
 //
 
 #include "Imagine/Scene/SceneSerializer.hpp"
+#include "Imagine/Components/Physicalisable.hpp"
+#include "Imagine/Scene/BinaryScene.hpp"
 #include "Imagine/Scene/Scene.hpp"
 #include "Imagine/ThirdParty/YamlCpp.hpp"
 #include "Imagine/ThirdParty/YamlCpp/YAML_SCENE.hpp"
@@ -22,15 +24,14 @@ namespace Imagine {
 
 		// Components Serialization
 		{
-			for (auto &[ccId, cc]: scene->m_CustomComponents) {
-				const Scene::Metadata &metadata = scene->m_CustomComponentsMetadata.at(ccId);
+			for (const auto &[ccId, metadata]: scene->m_CustomComponentsMetadata) {
 				const std::filesystem::path ccPath = componentsPath / (metadata.id.raw_string() + ".mgn");
 				YAML::Emitter out;
 				out << YAML::BeginMap;
 				{
 					out << KEYVAL("Type", "Component");
 					out << KEYVAL("Metadata", metadata);
-					out << KEYVAL("Count", cc.Count());
+					out << KEYVAL("Count", scene->CountComponents(ccId));
 				}
 				out << YAML::EndMap;
 				ThirdParty::YamlCpp::WriteYamlFile(ccPath, out);
@@ -55,10 +56,11 @@ namespace Imagine {
 					out << KEYVAL("Local Scale", e.LocalScale);
 					out << KEYVAL("Custom Components", YAML::BeginMap);
 					{
-						for (auto &[ccId, cc]: scene->m_CustomComponents) {
-							if (!cc.Exist(id)) continue;
-							const Scene::Metadata &metadata = scene->m_CustomComponentsMetadata.at(ccId);
-							out << KEYVAL(metadata.id, cc.GetConstView(id));
+						const Scene *constScene = scene;
+						for (const auto &[ccId, metadata]: scene->m_CustomComponentsMetadata) {
+							const ConstBufferView view = constScene->TryGetComponent(EntityID{id}, ccId);
+							if (!view.IsValid()) continue;
+							out << KEYVAL(metadata.id, view);
 						}
 					}
 					out << YAML::EndMap;
@@ -131,6 +133,7 @@ namespace Imagine {
 			const std::string name = node["Name"].as<std::string>();
 			scene->m_SparseEntities.Create(eId.id, e);
 			scene->m_Names.Create(eId.id, name);
+			scene->MarkTransformDirty(eId);
 
 			if (auto relationshipNode = node["Relationship"]) {
 				const bool isRoot = relationshipNode["Root"].as<bool>();
@@ -176,6 +179,238 @@ namespace Imagine {
 			}
 		}
 
+		scene->m_HierarchyChanged = true;
 		return scene;
 	}
+
+	namespace {
+		/// Append the arrays of a binary scene in memory, each aligned on 'c_BinarySceneAlignment'.
+		class BinarySceneWriter {
+		public:
+			/// Reserve 'size' zeroed bytes to be filled later and return their offset.
+			uint64_t Reserve(const uint64_t size) {
+				const uint64_t offset = Align();
+				m_Bytes.resize(offset + size, 0);
+				return offset;
+			}
+
+			BinarySceneArray Write(const void *data, const uint32_t count, const uint32_t stride) {
+				const BinarySceneArray array{Align(), count, stride};
+				if (array.ByteSize()) {
+					m_Bytes.insert(m_Bytes.end(), static_cast<const uint8_t *>(data), static_cast<const uint8_t *>(data) + array.ByteSize());
+				}
+				return array;
+			}
+
+			template<typename T>
+			BinarySceneArray Write(const std::vector<T> &data) {
+				static_assert(std::is_trivially_copyable_v<T>);
+				return Write(data.data(), static_cast<uint32_t>(data.size()), sizeof(T));
+			}
+
+			template<typename T>
+			void Set(const uint64_t offset, const T &value) {
+				memcpy(m_Bytes.data() + offset, &value, sizeof(T));
+			}
+
+			[[nodiscard]] ConstBufferView GetView() const { return ConstBufferView{m_Bytes.data(), m_Bytes.size()}; }
+
+		private:
+			uint64_t Align() {
+				const uint64_t offset = (m_Bytes.size() + c_BinarySceneAlignment - 1) & ~(c_BinarySceneAlignment - 1);
+				m_Bytes.resize(offset, 0);
+				return offset;
+			}
+
+		private:
+			std::vector<uint8_t> m_Bytes;
+		};
+
+		template<typename T>
+		void GatherSparseSet(const SparseSet<T, uint32_t> &set, std::vector<uint32_t> &ids, std::vector<T> &data) {
+			ids.reserve(set.Count());
+			data.reserve(set.Count());
+			for (uint32_t i = 0; i < set.Count(); ++i) {
+				const uint32_t id = set.GetID(i);
+				ids.push_back(id);
+				data.push_back(set.Get(id));
+			}
+		}
+
+		/// A loaded component has no body yet, the PhysicsLayer creates it on the next sync.
+		void ResetRuntimeState(Physicalisable &physicalisable) {
+			physicalisable.BodyID = JPH::BodyID{};
+			physicalisable.dirty = true;
+		}
+
+		UUID::Array64 ToArray(const UUID &id) {
+			UUID::Array64 array{};
+			std::copy(id.cbegin64(), id.cend64(), array.begin());
+			return array;
+		}
+	} // namespace
+
+	bool SceneSerializer::SerializeBinary(const Scene *scene, const std::filesystem::path &filePath) {
+		if (!scene) return false;
+
+		BinarySceneWriter writer;
+		BinarySceneHeader header{};
+		header.handle = ToArray(scene->Handle.GetID());
+
+		const uint64_t headerOffset = writer.Reserve(sizeof(BinarySceneHeader));
+		const uint32_t componentCount = static_cast<uint32_t>(scene->m_CustomComponentsMetadata.size());
+		header.components = BinarySceneArray{writer.Reserve(sizeof(BinarySceneComponent) * componentCount), componentCount, sizeof(BinarySceneComponent)};
+
+		// Entities and their names.
+		{
+			std::vector<uint32_t> ids;
+			std::vector<Entity> entities;
+			GatherSparseSet(scene->m_SparseEntities, ids, entities);
+			if (!ids.empty() && *std::max_element(ids.begin(), ids.end()) >= c_BinarySceneMaxEntityId) {
+				MGN_CORE_ERROR("The scene has entity ids above {}, it can't be written as a binary scene.", c_BinarySceneMaxEntityId);
+				return false;
+			}
+
+			std::vector<uint32_t> nameOffsets;
+			std::vector<char> names;
+			nameOffsets.reserve(ids.size() + 1);
+			for (const uint32_t id: ids) {
+				nameOffsets.push_back(static_cast<uint32_t>(names.size()));
+				if (const std::string *name = scene->m_Names.TryGet(id)) {
+					names.insert(names.end(), name->begin(), name->end());
+				}
+			}
+			nameOffsets.push_back(static_cast<uint32_t>(names.size()));
+
+			header.entityIds = writer.Write(ids);
+			header.entities = writer.Write(entities);
+			header.nameOffsets = writer.Write(nameOffsets);
+			header.names = writer.Write(names);
+		}
+
+		// Relationships.
+		{
+			const std::vector<EntityID> roots{scene->m_Roots.begin(), scene->m_Roots.end()};
+			header.roots = writer.Write(roots);
+
+			std::vector<uint32_t> parentIds, childIds, siblingIds;
+			std::vector<Parent> parents;
+			std::vector<Child> children;
+			std::vector<Sibling> siblings;
+			GatherSparseSet(scene->m_Parents, parentIds, parents);
+			GatherSparseSet(scene->m_Children, childIds, children);
+			GatherSparseSet(scene->m_Siblings, siblingIds, siblings);
+			header.parentIds = writer.Write(parentIds);
+			header.parents = writer.Write(parents);
+			header.childIds = writer.Write(childIds);
+			header.children = writer.Write(children);
+			header.siblingIds = writer.Write(siblingIds);
+			header.siblings = writer.Write(siblings);
+		}
+
+		// Components, works for both storages.
+		{
+			uint32_t index = 0;
+			std::vector<uint32_t> ids;
+			std::vector<uint8_t> data;
+			for (const auto &[ccId, metadata]: scene->m_CustomComponentsMetadata) {
+				ids.clear();
+				data.clear();
+				scene->ForEachWithComponent(ccId, [&ids, &data](const Scene *, const EntityID id, const ConstBufferView component) {
+					ids.push_back(id.id);
+					data.insert(data.end(), component.Get<uint8_t>(), component.Get<uint8_t>() + component.Size());
+				});
+
+				// The BodyIDs belong to the running physics world, they aren't written.
+				if (ccId == UUIDFromType<Physicalisable>()) {
+					for (uint64_t offset = 0; offset < data.size(); offset += metadata.size) {
+						ResetRuntimeState(*reinterpret_cast<Physicalisable *>(data.data() + offset));
+					}
+				}
+
+				BinarySceneComponent component{};
+				component.id = ToArray(ccId);
+				component.size = metadata.size;
+				component.hasConstructor = metadata.hasConstructor;
+				component.hasDestructor = metadata.hasDestructor;
+				component.hasCopyConstructor = metadata.hasCopyConstructor;
+				component.name = writer.Write(metadata.name.data(), static_cast<uint32_t>(metadata.name.size()), sizeof(char));
+				component.ids = writer.Write(ids);
+				component.data = writer.Write(data.data(), static_cast<uint32_t>(ids.size()), static_cast<uint32_t>(metadata.size));
+				writer.Set(header.components.offset + sizeof(BinarySceneComponent) * index++, component);
+			}
+		}
+
+		writer.Set(headerOffset, header);
+		return FileSystem::WriteBinaryFile(filePath, writer.GetView());
+	}
+
+	Scene *SceneSerializer::DeserializeBinary(const std::filesystem::path &filePath) {
+		BinarySceneFile file;
+		if (!file.Open(filePath)) return nullptr;
+		const BinarySceneHeader &header = file.GetHeader();
+
+		Scene *scene = new Scene();
+		scene->Handle = AssetHandle{file.GetHandle()};
+
+		for (const BinarySceneComponent &component: file.GetComponents()) {
+			const UUID id{component.id[0], component.id[1]};
+			if (!scene->m_CustomComponents.contains(id)) {
+				scene->m_CustomComponentsMetadata[id] = Scene::Metadata{
+						std::string{file.GetComponentName(component)},
+						id,
+						component.size,
+						component.hasConstructor != 0,
+						component.hasDestructor != 0,
+						component.hasCopyConstructor != 0,
+				};
+				scene->m_CustomComponents[id] = RawSparseSet<>{static_cast<uint32_t>(component.size), component.ids.count};
+			}
+
+			RawSparseSet<> &components = scene->m_CustomComponents.at(id);
+			if (components.GetDataSize() != component.size) {
+				MGN_CORE_WARNING("The component '{}' has a size of {} in the scene but {} in the engine, it is skipped.", file.GetComponentName(component), component.size, components.GetDataSize());
+				continue;
+			}
+			components.Assign(file.GetArray<uint32_t>(component.ids).data(), file.GetComponentData(component).Get(), component.ids.count);
+		}
+
+		const std::span<const uint32_t> entityIds = file.GetArray<uint32_t>(header.entityIds);
+		const std::span<const Entity> entities = file.GetArray<Entity>(header.entities);
+		scene->m_SparseEntities.Assign(entityIds.data(), entities.data(), header.entities.count);
+
+		std::vector<std::string> names;
+		names.reserve(entityIds.size());
+		for (uint32_t i = 0; i < entityIds.size(); ++i) {
+			names.emplace_back(file.GetName(i));
+		}
+		scene->m_Names.Assign(entityIds.data(), std::move(names), header.entities.count);
+
+		for (const EntityID root: file.GetArray<EntityID>(header.roots)) {
+			scene->m_Roots.insert(root);
+		}
+		scene->m_Parents.Assign(file.GetArray<uint32_t>(header.parentIds).data(), file.GetArray<Parent>(header.parents).data(), header.parents.count);
+		scene->m_Children.Assign(file.GetArray<uint32_t>(header.childIds).data(), file.GetArray<Child>(header.children).data(), header.children.count);
+		scene->m_Siblings.Assign(file.GetArray<uint32_t>(header.siblingIds).data(), file.GetArray<Sibling>(header.siblings).data(), header.siblings.count);
+
+		// The bodies belong to the physics world that was running when the scene was written, the PhysicsLayer creates new ones.
+		scene->Query<Physicalisable>().Each([](const EntityID, Physicalisable &physicalisable) {
+			ResetRuntimeState(physicalisable);
+		});
+
+		// Every entity is new to the transform cache, rebuilding the hierarchy flags them all.
+		scene->m_HierarchyChanged = true;
+		return scene;
+	}
+
+	bool SceneSerializer::ConvertReadableToBinary(const std::filesystem::path &folderPath, const std::filesystem::path &filePath) {
+		Scene *scene = DeserializeReadable(folderPath);
+		if (!scene) {
+			MGN_CORE_ERROR("The folder '{}' doesn't contain a readable scene.", folderPath.string());
+			return false;
+		}
+		const bool result = SerializeBinary(scene, filePath);
+		delete scene;
+		return result;
+	}
 } // namespace Imagine
@@ -16,6 +16,7 @@
 
 #define BIND_RW_VAL(CLASS_TYPE, TYPE, property) [](const CLASS_TYPE *t) -> TYPE { return t->property; }, [](CLASS_TYPE *t, TYPE v) { t->property = v; }
 #define BIND_R_VAL(CLASS_TYPE, TYPE, property) [](const CLASS_TYPE *t) -> TYPE { return t->property; }
+#define BIND_RW_TRANSFORM(TYPE, property) [](const Entity *t) -> TYPE { return t->property; }, [](Entity *t, TYPE v) { t->property = v; SceneManager::GetMainScene()->MarkTransformDirty(t->Id); }
 
 namespace Imagine {
 	LuaScript::Log::local_time LuaScript::Log::Now() {
@@ -403,23 +404,23 @@ namespace Imagine {
 
 		// EntityType["id"] = BIND_R_VAL(Entity, EntityID, Id);
 
-		EntityType["position_x"] = sol::property(BIND_RW_VAL(Entity, float, LocalPosition.x));
-		EntityType["position_y"] = sol::property(BIND_RW_VAL(Entity, float, LocalPosition.y));
-		EntityType["position_z"] = sol::property(BIND_RW_VAL(Entity, float, LocalPosition.z));
-		EntityType["position"] = &Entity::LocalPosition;
+		EntityType["position_x"] = sol::property(BIND_RW_TRANSFORM(float, LocalPosition.x));
+		EntityType["position_y"] = sol::property(BIND_RW_TRANSFORM(float, LocalPosition.y));
+		EntityType["position_z"] = sol::property(BIND_RW_TRANSFORM(float, LocalPosition.z));
+		EntityType["position"] = sol::property(BIND_RW_TRANSFORM(Vec3, LocalPosition));
 
-		EntityType["rotation_x"] = sol::property(BIND_RW_VAL(Entity, float, LocalRotation.x));
-		EntityType["rotation_y"] = sol::property(BIND_RW_VAL(Entity, float, LocalRotation.y));
-		EntityType["rotation_z"] = sol::property(BIND_RW_VAL(Entity, float, LocalRotation.z));
-		EntityType["rotation_w"] = sol::property(BIND_RW_VAL(Entity, float, LocalRotation.w));
-		EntityType["rotation"] = &Entity::LocalRotation;
+		EntityType["rotation_x"] = sol::property(BIND_RW_TRANSFORM(float, LocalRotation.x));
+		EntityType["rotation_y"] = sol::property(BIND_RW_TRANSFORM(float, LocalRotation.y));
+		EntityType["rotation_z"] = sol::property(BIND_RW_TRANSFORM(float, LocalRotation.z));
+		EntityType["rotation_w"] = sol::property(BIND_RW_TRANSFORM(float, LocalRotation.w));
+		EntityType["rotation"] = sol::property(BIND_RW_TRANSFORM(Quat, LocalRotation));
 
-		EntityType["scale_x"] = sol::property(BIND_RW_VAL(Entity, float, LocalScale.x));
-		EntityType["scale_y"] = sol::property(BIND_RW_VAL(Entity, float, LocalScale.y));
-		EntityType["scale_z"] = sol::property(BIND_RW_VAL(Entity, float, LocalScale.z));
-		EntityType["scale"] = &Entity::LocalScale;
+		EntityType["scale_x"] = sol::property(BIND_RW_TRANSFORM(float, LocalScale.x));
+		EntityType["scale_y"] = sol::property(BIND_RW_TRANSFORM(float, LocalScale.y));
+		EntityType["scale_z"] = sol::property(BIND_RW_TRANSFORM(float, LocalScale.z));
+		EntityType["scale"] = sol::property(BIND_RW_TRANSFORM(Vec3, LocalScale));
 
-		EntityType["SetEuler"] = [](Entity *e, float x, float y, float z) { e->LocalRotation = Quat(Vec3{x, y, z} * Math::DegToRad); };
+		EntityType["SetEuler"] = [](Entity *e, float x, float y, float z) { SceneManager::GetMainScene()->SetLocalRotation(e->Id, Quat(Vec3{x, y, z} * Math::DegToRad)); };
 
 		(*m_State)["FindEntityByName"] = [](const std::string &name) -> sol::optional<uint32_t> {
 			const auto result = SceneManager::GetMainScene()->Find([&name](Scene *scene, EntityID id) {
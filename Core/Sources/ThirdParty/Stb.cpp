@@ -100,6 +100,11 @@ namespace Imagine::ThirdParty::Stb {
 				return Imagine::Image<float>{};
 			}
 		}
+
+		bool WritePng(const char *path, const Imagine::Image<uint8_t> &image) {
+			if (image.width == 0 || image.height == 0 || image.channels == 0) return false;
+			return stbi_write_png(path, (int) image.width, (int) image.height, (int) image.channels, image.source.Get(), (int) (image.width * image.channels)) != 0;
+		}
 	} // namespace Image
 
 	namespace Perlin {
@@ -17,20 +17,30 @@ layout(buffer_reference, std430) readonly buffer VertexBuffer{
     Vertex vertices[];
 };
 
+struct InstanceData {
+    mat4 worldMatrix;
+    mat4 normalMatrix;
+};
+
+layout(buffer_reference, std430) readonly buffer InstanceBuffer{
+    InstanceData instances[];
+};
+
 //push constants block
 layout( push_constant ) uniform constants
 {
-    mat4 render_matrix;
     VertexBuffer vertexBuffer;
+    InstanceBuffer instanceBuffer;
 } PushConstants;
 
 void main()
 {
     //load vertex data from device adress
     Vertex v = PushConstants.vertexBuffer.vertices[gl_VertexIndex];
+    mat4 render_matrix = PushConstants.instanceBuffer.instances[gl_InstanceIndex].worldMatrix;
 
     //output data
-    gl_Position = PushConstants.render_matrix *vec4(v.position, 1.0f);
+    gl_Position = render_matrix *vec4(v.position, 1.0f);
     outColor = v.color.xyz;
     outUV.x = v.uv_x;
     outUV.y = v.uv_y;
@@ -4,41 +4,22 @@
 #extension GL_EXT_buffer_reference : require
 
 #include "input_structures.glsl"
+#include "vertex_layouts.glsl"
 
 layout (location = 0) out vec3 outNormal;
 layout (location = 1) out vec3 outColor;
 layout (location = 2) out vec2 outUV;
 
-struct Vertex {
-    vec3 position;
-    float uv_x;
-    vec3 normal;
-    float uv_y;
-    vec4 tangent;
-    vec4 bitangent;
-    vec4 color;
-};
-
-layout(buffer_reference, std430) readonly buffer VertexBuffer{
-    Vertex vertices[];
-};
-
-//push constants block
-layout( push_constant ) uniform constants
-{
-    mat4 render_matrix;
-    VertexBuffer vertexBuffer;
-} PushConstants;
-
 void main()
 {
-    Vertex v = PushConstants.vertexBuffer.vertices[gl_VertexIndex];
+    Vertex v = LoadVertex(gl_VertexIndex);
+    mat4 render_matrix = PushConstants.instanceBuffer.instances[gl_InstanceIndex].worldMatrix;
 
     vec4 position = vec4(v.position, 1.0f);
 
-    gl_Position =  sceneData.viewproj * PushConstants.render_matrix *position;
+    gl_Position =  sceneData.viewproj * render_matrix *position;
 
-    outNormal = (PushConstants.render_matrix * vec4(v.normal, 0.f)).xyz;
+    outNormal = (render_matrix * vec4(v.normal, 0.f)).xyz;
     outColor = v.color.xyz * materialData.colorFactors.xyz;
     outUV.x = v.uv_x;
     outUV.y = v.uv_y;
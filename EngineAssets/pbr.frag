@@ -57,6 +57,71 @@ vec3 getNormalFromNormalMap() {
     return N;
 }
 
+// The cluster of the fragment, its depth being the w of its clip position.
+uint getCluster()
+{
+    ClusterGrid grid = lightData.grid;
+    uvec2 tile = min(uvec2(gl_FragCoord.xy * grid.tileScale.xy), grid.size.xy - 1);
+    float depth = (sceneData.viewproj * vec4(position, 1.0)).w;
+    uint slice = uint(clamp(log(max(depth, grid.slice.z)) * grid.slice.x + grid.slice.y, 0.0, float(grid.size.z - 1)));
+    return (slice * grid.size.y + tile.y) * grid.size.x + tile.x;
+}
+
+vec3 shadeLight(Light light, vec3 N, vec3 V, vec3 F0, vec3 albedo, float metallic, float roughness)
+{
+    vec3 radiance;
+    vec3 L;
+    if(light.type == LIGHT_POINT)
+    {
+        L = normalize(light.position - position);
+        vec3 lightPos = light.position.xyz;
+        float dst = distance(lightPos, position);
+        float range = max(length(light.direction.xyz), Epsilon);
+        float lightIntensity = max(light.color.w, 0);
+        lightIntensity =  lightIntensity / ((1) + (0.09) * dst + (0.032) * (dst * dst));
+        lightIntensity = lightIntensity * clamp((1-(dst / range)) * 10, 0., 1.);
+        radiance = light.color.rgb * lightIntensity;
+    } else if(light.type == LIGHT_DIRECTIONAL) {
+        L = -normalize(light.direction.xyz);
+        float intensity = max(light.color.w, 0);
+        radiance = light.color.rgb * intensity;
+    } else if(light.type == LIGHT_SPOT) {
+        float range = max(length(light.direction.xyz), Epsilon);
+        float cutOff = light.direction.w;
+        vec3 lightDir = -normalize(light.direction.xyz);
+        vec3 lightPos = light.position.xyz;
+        L = normalize(lightPos - position);
+        if(dot(L , lightDir) <= cos(cutOff))
+        {
+            return vec3(0.0);
+        }
+
+        // calculate per-light radiance
+        float dst = distance(lightPos, position);
+        float lightIntensity = max(light.color.w, 0);
+        lightIntensity =  lightIntensity / ((1) + (0.09) * dst + (0.032) * (dst * dst));
+        lightIntensity = lightIntensity * clamp((1-(dst / range)) * 10, 0., 1.);
+        radiance = light.color.rgb * lightIntensity;
+    }
+
+    vec3 H = normalize(V + L);
+    // cook-torrance brdf
+    float NDF = DistributionGGX(N, H, roughness);
+    float G   = GeometrySmith(N, V, L, roughness);
+    vec3 F    = fresnelSchlick(max(dot(H, V), 0.0), F0);
+
+    vec3 kS = F;
+    vec3 kD = vec3(1.0) - kS;
+    kD *= 1.0 - metallic;
+
+    vec3 numerator    = NDF * G * F;
+    float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
+    vec3 specular     = numerator / denominator;
+
+    float NdotL = max(dot(N, L), 0.0);
+    return (kD * albedo / PI + specular) * radiance * NdotL;
+}
+
 void main()
 {
     vec3 albedo     = pow(texture(albedoTexture, texcoord).rgb, vec3(2.2)) * materialData.TintColor.rgb;
@@ -74,62 +139,16 @@ void main()
 
     // reflectance equation
     vec3 Lo = vec3(0.0);
-    for(int i = 0; i < lightData.lightCount; ++i)
+    uint directionalCount = lightData.grid.size.w;
+    for(uint i = 0; i < directionalCount; ++i)
     {
-        Light light = lightData.lights[i];
-        vec3 radiance;
-        vec3 L;
-        if(light.type == LIGHT_POINT)
-        {
-            L = normalize(light.position - position);
-            vec3 lightColor = light.color.rgb;
-            vec3 lightPos = light.position.xyz;
-            float dst = distance(lightPos, position);
-            float range = max(length(light.direction.xyz), Epsilon);
-            float lightIntensity = max(light.color.w, 0);
-            lightIntensity =  lightIntensity / ((1) + (0.09) * dst + (0.032) * (dst * dst));
-            lightIntensity = lightIntensity * clamp((1-(dst / range)) * 10, 0., 1.);
-            radiance = light.color.rgb * lightIntensity;
-        } else if(light.type == LIGHT_DIRECTIONAL) {
-            L = -normalize(light.direction.xyz);
-            float intensity = max(light.color.w, 0);
-            radiance = light.color.rgb * intensity;
-        } else if(light.type == LIGHT_SPOT) {
-            float range = max(length(light.direction.xyz), Epsilon);
-            float cutOff = light.direction.w;
-            vec3 lightDir = -normalize(light.direction.xyz);
-            vec3 lightPos = light.position.xyz;
-            L = normalize(lightPos - position);
-            if(dot(L , lightDir) <= cos(cutOff))
-            {
-                continue;
-            }
-
-            // calculate per-light radiance
-            float dst = distance(lightPos, position);
-            float lightIntensity = max(light.color.w, 0);
-            lightIntensity =  lightIntensity / ((1) + (0.09) * dst + (0.032) * (dst * dst));
-            lightIntensity = lightIntensity * clamp((1-(dst / range)) * 10, 0., 1.);
-            radiance = light.color.rgb * lightIntensity;
-        }
-
-        vec3 H = normalize(V + L);
-        // cook-torrance brdf
-        float NDF = DistributionGGX(N, H, roughness);
-        float G   = GeometrySmith(N, V, L, roughness);
-        vec3 F    = fresnelSchlick(max(dot(H, V), 0.0), F0);
-
-        vec3 kS = F;
-        vec3 kD = vec3(1.0) - kS;
-        kD *= 1.0 - metallic;
-
-        vec3 numerator    = NDF * G * F;
-        float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
-        vec3 specular     = numerator / denominator;
+        Lo += shadeLight(lightData.lights[i], N, V, F0, albedo, metallic, roughness);
+    }
 
-        // add to outgoing radiance Lo
-        float NdotL = max(dot(N, L), 0.0);
-        Lo += (kD * albedo / PI + specular) * radiance * NdotL;
+    uvec2 cluster = lightClusters.clusters[getCluster()];
+    for(uint i = 0; i < cluster.y; ++i)
+    {
+        Lo += shadeLight(lightData.lights[lightIndices.indices[cluster.x + i]], N, V, F0, albedo, metallic, roughness);
     }
 
     vec3 ambient = vec3(0.03) * albedo * ao;
@@ -1,13 +1,3 @@
-struct Vertex {
-    vec3 position;
-    float uv_x;
-    vec3 normal;
-    float uv_y;
-    vec4 tangent;
-    vec4 bitangent;
-    vec4 color;
-};
-
 #define LIGHT_POINT 0
 #define LIGHT_DIRECTIONAL 1
 #define LIGHT_SPOT 2
@@ -30,13 +20,28 @@ layout(set = 0, binding = 0) uniform  SceneData{
     vec4 sunlightColor;
 } sceneData;
 
-#define MaxLight 32
+// See GPUClusterGrid.
+struct ClusterGrid {
+    uvec4 size; // tiles x, tiles y, slices, directional lights
+    vec4 tileScale;
+    vec4 slice; // scale, bias, near, far
+};
 
+// The directional lights come first, the others are found through the cluster of the fragment.
 layout(set = 0, binding = 1) readonly buffer LightData {
-    Light lights[MaxLight];
-    int lightCount;
+    ClusterGrid grid;
+    Light lights[];
 } lightData;
 
+// The range of light indices of each cluster, offset and count.
+layout(set = 0, binding = 2) readonly buffer LightClusters {
+    uvec2 clusters[];
+} lightClusters;
+
+layout(set = 0, binding = 3) readonly buffer LightIndices {
+    uint indices[];
+} lightIndices;
+
 layout(set = 1, binding = 0) uniform GLTFMaterialData{
     vec4 TintColor;
     vec4 Emissive;
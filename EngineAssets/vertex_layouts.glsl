@@ -0,0 +1,106 @@
+// Vertex fetch for every VertexLayout, the layout of the mesh is given by the push constants.
+// Requires GL_EXT_buffer_reference.
+
+#define VERTEX_LAYOUT_FULL 0u
+#define VERTEX_LAYOUT_COMPACT 1u
+#define VERTEX_LAYOUT_QUANTIZED 2u
+
+struct Vertex {
+    vec3 position;
+    float uv_x;
+    vec3 normal;
+    float uv_y;
+    vec4 tangent;
+    vec4 bitangent;
+    vec4 color;
+};
+
+struct CompactVertex {
+    float position_x;
+    float position_y;
+    float position_z;
+    uint normal;
+    uint tangent;
+    uint uv;
+};
+
+layout(buffer_reference, std430) readonly buffer VertexBuffer{
+    Vertex vertices[];
+};
+
+layout(buffer_reference, std430) readonly buffer CompactVertexBuffer{
+    CompactVertex vertices[];
+};
+
+layout(buffer_reference, std430) readonly buffer QuantizedVertexBuffer{
+    uvec4 vertices[];
+};
+
+layout(buffer_reference, std430) readonly buffer ColorBuffer{
+    uint colors[];
+};
+
+struct InstanceData {
+    mat4 worldMatrix;
+    mat4 normalMatrix;
+};
+
+layout(buffer_reference, std430) readonly buffer InstanceBuffer{
+    InstanceData instances[];
+};
+
+//push constants block
+layout( push_constant ) uniform constants
+{
+    VertexBuffer vertexBuffer;
+    InstanceBuffer instanceBuffer;
+    ColorBuffer colorBuffer;
+    uint vertexLayout;
+    uint hasColors;
+    vec4 positionOffset;
+    vec4 positionScale;
+} PushConstants;
+
+vec3 DecodeOctahedral(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float fold = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -fold : fold;
+    n.y += n.y >= 0.0 ? -fold : fold;
+    return normalize(n);
+}
+
+Vertex LoadVertex(int index)
+{
+    if (PushConstants.vertexLayout == VERTEX_LAYOUT_FULL) {
+        return PushConstants.vertexBuffer.vertices[index];
+    }
+
+    Vertex v;
+    vec3 tangent;
+    float flip;
+    vec2 uv;
+    if (PushConstants.vertexLayout == VERTEX_LAYOUT_COMPACT) {
+        CompactVertex c = CompactVertexBuffer(PushConstants.vertexBuffer).vertices[index];
+        v.position = vec3(c.position_x, c.position_y, c.position_z);
+        v.normal = DecodeOctahedral(unpackSnorm2x16(c.normal));
+        tangent = DecodeOctahedral(unpackSnorm2x16(c.tangent));
+        flip = (c.tangent & 1u) != 0u ? -1.0 : 1.0;
+        uv = unpackHalf2x16(c.uv);
+    } else {
+        uvec4 q = QuantizedVertexBuffer(PushConstants.vertexBuffer).vertices[index];
+        vec3 unorm = vec3(q.x & 0xFFFFu, q.x >> 16, q.y & 0xFFFFu) / 65535.0;
+        v.position = PushConstants.positionOffset.xyz + unorm * PushConstants.positionScale.xyz;
+        v.normal = DecodeOctahedral(unpackSnorm4x8(q.y).zw);
+        tangent = DecodeOctahedral(unpackSnorm4x8(q.z).xy);
+        flip = ((q.z >> 16) & 1u) != 0u ? -1.0 : 1.0;
+        uv = unpackHalf2x16(q.w);
+    }
+
+    v.uv_x = uv.x;
+    v.uv_y = uv.y;
+    v.tangent = vec4(tangent, 0.0);
+    v.bitangent = vec4(cross(v.normal, tangent) * flip, 0.0);
+    v.color = PushConstants.hasColors != 0u ? unpackUnorm4x8(PushConstants.colorBuffer.colors[index]) : vec4(1.0);
+    return v;
+}
@@ -0,0 +1,140 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Assets/AssetImporter.hpp"
+#include "Imagine/Assets/FileAssetManager.hpp"
+
+class TestScriptAsset final : public Asset {
+public:
+	MGN_IMPLEMENT_ASSET(AssetType::Script);
+};
+
+TEST(AssetManager, PathIndex) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	FileAssetManager manager;
+	std::vector<AssetHandle> handles;
+	for (int i = 0; i < 100; ++i) {
+		Ref<TestScriptAsset> asset = CreateRef<TestScriptAsset>();
+		ASSERT_TRUE(manager.AddAsset(asset, Path{FileSource::Scripts, fmt::format("Folder/script_{}.lua", i)}));
+		handles.push_back(asset->Handle);
+	}
+
+	AssetHandle handle{NULL_ASSET_HANDLE};
+	ASSERT_TRUE(manager.IsAssetImported(Path{FileSource::Scripts, "Folder/script_42.lua"}, &handle));
+	ASSERT_EQ(handle, handles[42]);
+	// The lookups are done on the normalized path.
+	ASSERT_TRUE(manager.IsAssetImported(Path{FileSource::Scripts, "Folder/../Folder/./script_42.lua"}, &handle));
+	ASSERT_EQ(handle, handles[42]);
+	ASSERT_FALSE(manager.IsAssetImported(Path{FileSource::Assets, "Folder/script_42.lua"}));
+	ASSERT_FALSE(manager.IsAssetImported(Path{FileSource::Scripts, "Folder/script_100.lua"}));
+
+	manager.SetPath(handles[42], Path{FileSource::Scripts, "Other/renamed.lua"});
+	ASSERT_FALSE(manager.IsAssetImported(Path{FileSource::Scripts, "Folder/script_42.lua"}));
+	ASSERT_TRUE(manager.IsAssetImported(Path{FileSource::Scripts, "Other/renamed.lua"}, &handle));
+	ASSERT_EQ(handle, handles[42]);
+	ASSERT_EQ(manager.GetMetadata(Path{FileSource::Scripts, "Other/renamed.lua"})->Handle, handles[42]);
+
+	ASSERT_TRUE(manager.RemoveAsset(handles[42]));
+	ASSERT_FALSE(manager.IsAssetImported(Path{FileSource::Scripts, "Other/renamed.lua"}));
+	ASSERT_FALSE(manager.GetMetadata(Path{FileSource::Scripts, "Other/renamed.lua"}).has_value());
+	ASSERT_EQ(manager.GetRegistrySize(), 99);
+
+	Log::Shutdown();
+}
+
+TEST(AssetManager, Streaming) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	FileAssetManager manager;
+	// A single worker makes the import order follow the priorities.
+	manager.SetStreamingWorkerCount(1);
+
+	// The assets are registered but not loaded.
+	auto registerAsset = [&manager](const std::string &name) {
+		Ref<TestScriptAsset> asset = CreateRef<TestScriptAsset>();
+		manager.AddAsset(asset, Path{FileSource::Scripts, name});
+		manager.UnloadAsset(asset->Handle);
+		return asset->Handle;
+	};
+	const AssetHandle blocking = registerAsset("blocking.lua");
+	const AssetHandle low = registerAsset("low.lua");
+	const AssetHandle normal = registerAsset("normal.lua");
+	const AssetHandle high = registerAsset("high.lua");
+	const AssetHandle failing = registerAsset("failing.lua");
+	ASSERT_FALSE(manager.IsAssetLoaded(blocking));
+
+	std::mutex mutex;
+	std::vector<AssetHandle> importOrder;
+	std::atomic<bool> release{false};
+	Ref<TestScriptAsset> subAsset = CreateRef<TestScriptAsset>();
+	AssetImporter::RegisterImporter(AssetType::Script, [&](const AssetMetadata &metadata) -> Ref<Asset> {
+		{
+			std::scoped_lock lock(mutex);
+			importOrder.push_back(metadata.Handle);
+		}
+		if (metadata.Handle == blocking) {
+			while (!release.load()) {
+				std::this_thread::yield();
+			}
+			// Assets added by an importer are only visible once the main thread updated the requests.
+			manager.AddAsset(subAsset);
+		}
+		if (metadata.Handle == failing) return nullptr;
+		return CreateRef<TestScriptAsset>();
+	});
+
+	const Ref<AssetRequest> blockingRequest = manager.RequestAsset(blocking);
+	while (blockingRequest->GetState() == AssetLoadState::Pending) {
+		std::this_thread::yield();
+	}
+	ASSERT_EQ(blockingRequest->GetState(), AssetLoadState::Loading);
+
+	const Ref<AssetRequest> lowRequest = manager.RequestAsset(low, AssetLoadPriority::Low);
+	const Ref<AssetRequest> normalRequest = manager.RequestAsset(normal, AssetLoadPriority::Normal);
+	const Ref<AssetRequest> highRequest = manager.RequestAsset(high, AssetLoadPriority::Low);
+	// Concurrent requests of the same asset are merged, raising the priority if needed.
+	ASSERT_EQ(manager.RequestAsset(low, AssetLoadPriority::Low), lowRequest);
+	ASSERT_EQ(manager.RequestAsset(high, AssetLoadPriority::High), highRequest);
+	ASSERT_EQ(highRequest->GetPriority(), AssetLoadPriority::High);
+	ASSERT_EQ(manager.GetRequestCount(), 4);
+
+	// The non-blocking access doesn't wait for the import.
+	ASSERT_EQ(manager.TryGetAsset(normal), nullptr);
+	ASSERT_EQ(normalRequest->GetAsset(), nullptr);
+
+	release.store(true);
+	lowRequest->Wait();
+	normalRequest->Wait();
+	highRequest->Wait();
+	ASSERT_TRUE(lowRequest->IsReady());
+	ASSERT_EQ(importOrder, (std::vector<AssetHandle>{blocking, high, normal, low}));
+
+	ASSERT_FALSE(manager.IsAssetLoaded(subAsset->Handle));
+	manager.UpdateRequests();
+	ASSERT_TRUE(manager.IsAssetLoaded(subAsset->Handle));
+	for (const AssetHandle handle: {blocking, low, normal, high}) {
+		ASSERT_TRUE(manager.IsAssetLoaded(handle));
+		ASSERT_EQ(manager.TryGetAsset(handle)->Handle, handle);
+	}
+	ASSERT_EQ(manager.GetRequestCount(), 0);
+
+	// A failed import is kept and not retried by the next requests.
+	const Ref<AssetRequest> failingRequest = manager.RequestAsset(failing);
+	failingRequest->Wait();
+	ASSERT_EQ(failingRequest->GetState(), AssetLoadState::Failed);
+	manager.UpdateRequests();
+	ASSERT_EQ(manager.TryGetAsset(failing), nullptr);
+	ASSERT_EQ(manager.RequestAsset(failing), failingRequest);
+	ASSERT_EQ(importOrder.size(), 5);
+
+	// Unloading forgets the failure, the synchronous access imports the asset again.
+	manager.UnloadAsset(failing);
+	ASSERT_EQ(manager.GetAsset(failing), nullptr);
+	ASSERT_EQ(importOrder.size(), 6);
+
+	AssetImporter::RegisterImporter(AssetType::Script, nullptr);
+	Log::Shutdown();
+}
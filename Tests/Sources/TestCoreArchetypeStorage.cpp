@@ -0,0 +1,160 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Core/ArchetypeStorage.hpp"
+
+struct ArchPosition {
+	float x{0}, y{0}, z{0};
+};
+
+struct ArchVelocity {
+	float x{0}, y{0}, z{0};
+};
+
+using ArchCounter = InstanceCount<int>;
+
+template<typename T>
+static ArchetypeStorage::ComponentIndex RegisterArchetypeComponent(ArchetypeStorage &storage) {
+	return storage.RegisterComponent(
+			UUIDFromType<T>(),
+			sizeof(T),
+			[](void *data, uint32_t size) { new (data) T(); },
+			[](void *data, uint32_t size) { reinterpret_cast<T *>(data)->~T(); },
+			[](void *data, uint32_t size, ConstBufferView view) { new (data) T(view.As<T>()); });
+}
+
+TEST(CoreArchetypeStorage, AddGetRemove) {
+	ArchetypeStorage storage;
+	const auto pos = RegisterArchetypeComponent<ArchPosition>(storage);
+	const auto vel = RegisterArchetypeComponent<ArchVelocity>(storage);
+	ASSERT_NE(pos, vel);
+	ASSERT_EQ(pos, RegisterArchetypeComponent<ArchPosition>(storage));
+
+	constexpr uint32_t count = 2000;
+	for (uint32_t i = 0; i < count; ++i) {
+		auto *p = static_cast<ArchPosition *>(storage.Add(i, UUIDFromType<ArchPosition>()));
+		ASSERT_NE(p, nullptr);
+		p->x = static_cast<float>(i);
+		if (i % 2 == 0) {
+			const ArchVelocity v{1, static_cast<float>(i), 0};
+			ASSERT_NE(storage.Add(i, UUIDFromType<ArchVelocity>(), ConstBufferView{&v, 0, sizeof(v)}), nullptr);
+		}
+	}
+
+	ASSERT_EQ(storage.Add(0, UUIDFromType<ArchPosition>()), nullptr);
+	ASSERT_EQ(storage.Count(UUIDFromType<ArchPosition>()), count);
+	ASSERT_EQ(storage.Count(UUIDFromType<ArchVelocity>()), count / 2);
+	ASSERT_EQ(storage.GetArchetypeCount(), 2);
+
+	// Moving an entity between archetypes must keep its data.
+	for (uint32_t i = 0; i < count; ++i) {
+		const auto *p = static_cast<const ArchPosition *>(storage.TryGet(i, UUIDFromType<ArchPosition>()));
+		ASSERT_NE(p, nullptr);
+		ASSERT_EQ(p->x, static_cast<float>(i));
+		const auto *v = static_cast<const ArchVelocity *>(storage.TryGet(i, UUIDFromType<ArchVelocity>()));
+		if (i % 2 == 0) {
+			ASSERT_NE(v, nullptr);
+			ASSERT_EQ(v->y, static_cast<float>(i));
+		}
+		else {
+			ASSERT_EQ(v, nullptr);
+		}
+	}
+
+	for (uint32_t i = 0; i < count; i += 4) {
+		ASSERT_TRUE(storage.Remove(i, UUIDFromType<ArchVelocity>()));
+		ASSERT_FALSE(storage.Has(i, UUIDFromType<ArchVelocity>()));
+		ASSERT_TRUE(storage.Has(i, UUIDFromType<ArchPosition>()));
+	}
+	ASSERT_FALSE(storage.Remove(1, UUIDFromType<ArchVelocity>()));
+	ASSERT_EQ(storage.Count(UUIDFromType<ArchVelocity>()), count / 4);
+
+	for (uint32_t i = 0; i < count; ++i) {
+		const auto *p = static_cast<const ArchPosition *>(storage.TryGet(i, UUIDFromType<ArchPosition>()));
+		ASSERT_NE(p, nullptr);
+		ASSERT_EQ(p->x, static_cast<float>(i));
+	}
+
+	storage.RemoveEntity(3);
+	ASSERT_FALSE(storage.Exist(3));
+	ASSERT_EQ(storage.Count(UUIDFromType<ArchPosition>()), count - 1);
+
+	ASSERT_TRUE(storage.Remove(5, UUIDFromType<ArchPosition>()));
+	ASSERT_FALSE(storage.Exist(5));
+}
+
+TEST(CoreArchetypeStorage, ForEachChunk) {
+	ArchetypeStorage storage;
+	const auto pos = RegisterArchetypeComponent<ArchPosition>(storage);
+	const auto vel = RegisterArchetypeComponent<ArchVelocity>(storage);
+
+	constexpr uint32_t count = 5000;
+	for (uint32_t i = 0; i < count; ++i) {
+		storage.Add(i, UUIDFromType<ArchPosition>());
+		if (i % 3 == 0) {
+			const ArchVelocity v{1, 2, 3};
+			storage.Add(i, UUIDFromType<ArchVelocity>(), ConstBufferView{&v, 0, sizeof(v)});
+		}
+	}
+
+	const std::array<ArchetypeStorage::ComponentIndex, 2> query{pos, vel};
+	uint32_t visited = 0;
+	storage.ForEachChunk(query, [&visited](const ArchetypeStorage::ChunkView &view) {
+		ArchPosition *positions = view.Column<ArchPosition>(0);
+		const ArchVelocity *velocities = view.Column<ArchVelocity>(1);
+		for (uint32_t i = 0; i < view.count; ++i) {
+			positions[i].x += velocities[i].x;
+			EXPECT_EQ(view.entities[i] % 3, 0);
+		}
+		visited += view.count;
+	});
+	ASSERT_EQ(visited, (count + 2) / 3);
+
+	for (uint32_t i = 0; i < count; ++i) {
+		const auto *p = static_cast<const ArchPosition *>(storage.TryGet(i, UUIDFromType<ArchPosition>()));
+		ASSERT_EQ(p->x, i % 3 == 0 ? 1.0f : 0.0f);
+	}
+}
+
+TEST(CoreArchetypeStorage, RAII) {
+	ASSERT_EQ(ArchCounter::s_InstanceCount, 0);
+	{
+		ArchetypeStorage storage;
+		RegisterArchetypeComponent<ArchCounter>(storage);
+		RegisterArchetypeComponent<ArchPosition>(storage);
+
+		for (uint32_t i = 0; i < 100; ++i) {
+			storage.Add(i, UUIDFromType<ArchCounter>());
+		}
+		ASSERT_EQ(ArchCounter::s_InstanceCount, 100);
+
+		// Changing archetype relocates the component without creating or destroying it.
+		for (uint32_t i = 0; i < 50; ++i) {
+			storage.Add(i, UUIDFromType<ArchPosition>());
+		}
+		ASSERT_EQ(ArchCounter::s_InstanceCount, 100);
+
+		{
+			ArchetypeStorage copy{storage};
+			ASSERT_EQ(ArchCounter::s_InstanceCount, 200);
+		}
+		ASSERT_EQ(ArchCounter::s_InstanceCount, 100);
+
+		for (uint32_t i = 0; i < 10; ++i) {
+			storage.Remove(i, UUIDFromType<ArchCounter>());
+		}
+		ASSERT_EQ(ArchCounter::s_InstanceCount, 90);
+
+		storage.RemoveEntity(20);
+		ASSERT_EQ(ArchCounter::s_InstanceCount, 89);
+
+		storage.Clear();
+		ASSERT_EQ(ArchCounter::s_InstanceCount, 0);
+
+		storage.Add(0, UUIDFromType<ArchCounter>());
+		ASSERT_EQ(ArchCounter::s_InstanceCount, 1);
+	}
+	ASSERT_EQ(ArchCounter::s_InstanceCount, 0);
+}
@@ -0,0 +1,68 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Core/JobSystem.hpp"
+
+TEST(CoreJobSystem, ParallelFor) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	// Without initialization, everything must run on the calling thread.
+	{
+		uint64_t sum = 0;
+		JobSystem::ParallelFor(1000, 16, [&sum](const uint32_t begin, const uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) sum += i;
+		});
+		ASSERT_EQ(sum, 999 * 1000 / 2);
+	}
+
+	JobSystem::Initialize(4);
+	ASSERT_TRUE(JobSystem::IsInitialized());
+	ASSERT_EQ(JobSystem::GetThreadCount(), 5);
+	ASSERT_EQ(JobSystem::GetThreadIndex(), 0);
+
+	constexpr uint32_t count = 100'000;
+	std::vector<uint32_t> values(count, 0);
+	std::atomic<uint64_t> sum{0};
+	JobSystem::ParallelFor(count, 64, [&values, &sum](const uint32_t begin, const uint32_t end) {
+		uint64_t local = 0;
+		for (uint32_t i = begin; i < end; ++i) {
+			values[i] += 1;
+			local += i;
+		}
+		sum.fetch_add(local, std::memory_order_relaxed);
+	});
+	ASSERT_EQ(sum.load(), static_cast<uint64_t>(count - 1) * count / 2);
+	ASSERT_TRUE(std::ranges::all_of(values, [](const uint32_t value) { return value == 1; }));
+
+	// A job waiting on another batch must keep the workers busy instead of dead-locking.
+	std::atomic<uint32_t> nested{0};
+	JobSystem::ParallelFor(32, 1, [&nested](const uint32_t begin, const uint32_t end) {
+		JobSystem::ParallelFor(100, 10, [&nested](const uint32_t b, const uint32_t e) {
+			nested.fetch_add(e - b, std::memory_order_relaxed);
+		});
+	});
+	ASSERT_EQ(nested.load(), 3200);
+
+	JobSystem::Shutdown();
+	ASSERT_FALSE(JobSystem::IsInitialized());
+
+	Log::Shutdown();
+}
+
+TEST(CoreJobSystem, Scratch) {
+	ScratchAllocator scratch{256};
+	auto *first = scratch.Allocate<uint64_t>(8);
+	ASSERT_EQ(reinterpret_cast<uintptr_t>(first) % alignof(uint64_t), 0);
+	first[7] = 42;
+
+	// Growing must not invalidate the previous allocations.
+	auto *second = scratch.Allocate<uint8_t>(1024);
+	second[1023] = 1;
+	ASSERT_EQ(first[7], 42);
+	ASSERT_GE(scratch.GetUsedSize(), 64 + 1024);
+
+	scratch.Reset();
+	ASSERT_EQ(scratch.GetUsedSize(), 0);
+}
@@ -0,0 +1,71 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Rendering/DebugDrawBuffer.hpp"
+
+TEST(DebugDrawBuffer, AppendFromTheJobs) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	JobSystem::Initialize(3);
+
+	constexpr uint32_t count = 10'000;
+	DebugDrawBuffer buffer{count * 2};
+	JobSystem::ParallelFor(count, 64, [&buffer](const uint32_t begin, const uint32_t end) {
+		for (uint32_t i = begin; i < end; ++i) {
+			Vertex *vertices = buffer.Append(2);
+			ASSERT_NE(vertices, nullptr);
+			vertices[0] = Vertex::PC({static_cast<float>(i), 0, 0}, {1, 0, 0, 1});
+			vertices[1] = Vertex::PC({static_cast<float>(i), 1, 0}, {1, 0, 0, 1});
+		}
+	});
+
+	// Every segment is kept whole, in whatever order the jobs appended them.
+	const std::span<const Vertex> vertices = buffer.GetVertices();
+	ASSERT_EQ(vertices.size(), count * 2);
+	uint64_t sum = 0;
+	for (uint32_t i = 0; i < vertices.size(); i += 2) {
+		ASSERT_EQ(vertices[i].position.x, vertices[i + 1].position.x);
+		ASSERT_EQ(vertices[i + 1].position.y, 1);
+		sum += static_cast<uint64_t>(vertices[i].position.x);
+	}
+	ASSERT_EQ(sum, static_cast<uint64_t>(count) * (count - 1) / 2);
+
+	buffer.Reset();
+	ASSERT_TRUE(buffer.GetVertices().empty());
+	ASSERT_EQ(buffer.GetCapacity(), count * 2);
+	ASSERT_EQ(buffer.GetDroppedCount(), 0);
+
+	JobSystem::Shutdown();
+	Log::Shutdown();
+}
+
+TEST(DebugDrawBuffer, GrowAfterAnOverflow) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	DebugDrawBuffer buffer{8};
+	for (uint32_t i = 0; i < 2; ++i) {
+		Vertex *vertices = buffer.Append(3);
+		ASSERT_NE(vertices, nullptr);
+		std::fill_n(vertices, 3, Vertex::PC({1, 1, 1}, {1, 1, 1, 1}));
+	}
+
+	// The triangle straddling the end is dropped, its two vertices in the buffer are degenerate.
+	ASSERT_EQ(buffer.Append(3), nullptr);
+	ASSERT_EQ(buffer.Append(3), nullptr);
+	const std::span<const Vertex> vertices = buffer.GetVertices();
+	ASSERT_EQ(vertices.size(), 8);
+	ASSERT_EQ(vertices[6].position, vertices[7].position);
+	ASSERT_EQ(buffer.GetRequestedCount(), 12);
+
+	// The next frame fits everything the last one asked for.
+	buffer.Reset();
+	ASSERT_EQ(buffer.GetDroppedCount(), 4);
+	ASSERT_EQ(buffer.GetCapacity(), 16);
+	for (uint32_t i = 0; i < 4; ++i) {
+		ASSERT_NE(buffer.Append(3), nullptr);
+	}
+	ASSERT_EQ(buffer.GetVertices().size(), 12);
+
+	Log::Shutdown();
+}
@@ -0,0 +1,89 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Rendering/DrawContext.hpp"
+
+namespace {
+	class TestGPUMesh final : public GPUMesh {
+	public:
+		virtual ~TestGPUMesh() override = default;
+		virtual uint64_t GetID() override { return 0; }
+	};
+
+	void FillFrame(DrawContext &ctx, const uint32_t count) {
+		for (uint32_t i = 0; i < count; ++i) {
+			ctx.OpaqueSurfaces.emplace_back(Math::Translate(Math::Identity<Mat4>(), Vec3(static_cast<Real>(i), 0, 0)), nullptr);
+			ctx.AddLine(Vertex::PC(Vec3(0), Vec4(1)), Vertex::PC(Vec3(1), Vec4(1)));
+			ctx.AddPoint(Vertex::PC(Vec3(static_cast<Real>(i)), Vec4(1)));
+		}
+	}
+} // namespace
+
+TEST(DrawContext, Lines) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	DrawContext ctx;
+	const Vertex strip[] = {Vertex::PC(Vec3(0), Vec4(1)), Vertex::PC(Vec3(1), Vec4(1)), Vertex::PC(Vec3(2), Vec4(1))};
+	ctx.AddLineStrip(strip);
+	ctx.AddLines(strip);
+	ctx.AddLine(strip[0], strip[2]);
+
+	// Two segments for the strip, one for the odd count of vertices of 'AddLines' and one for the line.
+	ASSERT_EQ(ctx.LineVertices.size(), 3 + 2 + 2);
+	const uint32_t expected[] = {0, 1, 1, 2, 3, 4, 5, 6};
+	ASSERT_EQ(ctx.LineIndices.size(), std::size(expected));
+	for (uint32_t i = 0; i < std::size(expected); ++i) {
+		EXPECT_EQ(ctx.LineIndices[i], expected[i]);
+	}
+
+	ctx.Clear();
+	EXPECT_TRUE(ctx.LineVertices.empty());
+	EXPECT_TRUE(ctx.LineIndices.empty());
+
+	Log::Shutdown();
+}
+
+TEST(DrawContext, SteadyFrames) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	constexpr uint32_t count = 10'000;
+	DrawContext ctx{1024};
+	// The first frames grow the arena until it fits a whole frame.
+	for (uint32_t frame = 0; frame < 4; ++frame) {
+		ctx.Reset();
+		FillFrame(ctx, count);
+	}
+
+	ctx.Reset();
+	FillFrame(ctx, count);
+	EXPECT_EQ(ctx.GetHeapAllocationCount(), 0);
+	// Only the lists reserved by the reset.
+	EXPECT_EQ(ctx.GetAllocationCount(), 4);
+	ASSERT_EQ(ctx.OpaqueSurfaces.size(), count);
+	EXPECT_EQ(ctx.OpaqueSurfaces[count - 1].transform[3][0], static_cast<Real>(count - 1));
+	EXPECT_EQ(ctx.PointVertices.size(), count);
+
+	Log::Shutdown();
+}
+
+TEST(DrawContext, Retain) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	DrawContext ctx;
+	Weak<GPUMesh> weak;
+	{
+		Ref<GPUMesh> mesh = CreateRef<TestGPUMesh>();
+		weak = mesh;
+		ctx.OpaqueSurfaces.emplace_back(Math::Identity<Mat4>(), ctx.Retain(std::move(mesh)));
+	}
+	EXPECT_FALSE(weak.expired());
+	EXPECT_EQ(ctx.OpaqueSurfaces[0].mesh, weak.lock().get());
+
+	ctx.Reset();
+	EXPECT_TRUE(weak.expired());
+	EXPECT_TRUE(ctx.OpaqueSurfaces.empty());
+
+	Log::Shutdown();
+}
@@ -0,0 +1,69 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Components/Renderable.hpp"
+#include "Imagine/Rendering/DrawExtractor.hpp"
+
+class TestGPUMesh final : public GPUMesh {
+public:
+	explicit TestGPUMesh(const uint64_t id) : m_ID(id) {}
+	virtual ~TestGPUMesh() override = default;
+	virtual uint64_t GetID() override { return m_ID; }
+
+private:
+	uint64_t m_ID;
+};
+
+TEST(DrawExtractor, Renderables) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	JobSystem::Initialize(3);
+
+	constexpr uint32_t count = 10'000;
+	const AssetHandle model{};
+	const AssetHandle mesh{};
+	const AssetHandle unresolved{};
+
+	const Ref<GPUMesh> meshes[] = {CreateRef<TestGPUMesh>(0), CreateRef<TestGPUMesh>(1), CreateRef<TestGPUMesh>(2)};
+	DrawExtractor extractor;
+	extractor.SetSurfaces(model, {RenderObject{Math::Identity<Mat4>(), meshes[0].get()}, RenderObject{Math::Identity<Mat4>(), meshes[1].get()}});
+	extractor.SetSurfaces(mesh, {RenderObject{Math::Identity<Mat4>(), meshes[2].get()}});
+	ASSERT_EQ(extractor.GetResolvedCount(), 2);
+
+	Scene scene;
+	for (uint32_t i = 0; i < count; ++i) {
+		const EntityID id = scene.CreateEntity();
+		scene.SetLocalPosition(id, Vec3(static_cast<Real>(i), 0, 0));
+		const AssetHandle handles[] = {model, mesh, unresolved, NULL_ASSET_HANDLE};
+		scene.AddComponent<Renderable>(id, handles[i % 4]);
+	}
+	scene.CacheTransforms();
+
+	// The unresolved asset is skipped without a project, every other renderable gives its surfaces.
+	DrawContext ctx;
+	extractor.ExtractRenderables(scene, ctx);
+	ASSERT_EQ(ctx.OpaqueSurfaces.size(), count / 4 * 3);
+
+	uint64_t positions = 0;
+	for (const RenderObject &surface: ctx.OpaqueSurfaces) {
+		positions += static_cast<uint64_t>(surface.transform[3][0]);
+	}
+	uint64_t expected = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		if (i % 4 == 0) expected += 2 * i;
+		else if (i % 4 == 1) expected += i;
+	}
+	ASSERT_EQ(positions, expected);
+
+	ctx.Clear();
+	DrawExtractor::ExtractGizmos(scene, ctx);
+	ASSERT_EQ(ctx.LineVertices.size(), count * 3 * 2);
+	ASSERT_EQ(ctx.LineIndices.size(), count * 3 * 2);
+
+	extractor.Clear();
+	ASSERT_EQ(extractor.GetResolvedCount(), 0);
+
+	JobSystem::Shutdown();
+	Log::Shutdown();
+}
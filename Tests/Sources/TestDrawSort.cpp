@@ -0,0 +1,91 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Rendering/DrawSort.hpp"
+
+TEST(DrawSort, Keys) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	const int meshes[2]{};
+	const uint64_t key = DrawSortKey::Make(DrawSortKey::Opaque, NULL_ASSET_HANDLE, NULL_ASSET_HANDLE, &meshes[0]);
+	EXPECT_EQ(key & DrawSortKey::c_DepthMask, 0);
+	EXPECT_NE(key, DrawSortKey::Make(DrawSortKey::Opaque, NULL_ASSET_HANDLE, NULL_ASSET_HANDLE, &meshes[1]));
+	EXPECT_EQ(DrawSortKey::Make(1, NULL_ASSET_HANDLE, NULL_ASSET_HANDLE, nullptr) >> DrawSortKey::c_PassShift, 1);
+
+	// The depth only changes the lowest bits and keeps the closest draws first.
+	const uint64_t closest = DrawSortKey::WithDepth(key, 1.0f);
+	const uint64_t farthest = DrawSortKey::WithDepth(key, 100.0f);
+	EXPECT_LT(closest, farthest);
+	EXPECT_EQ(closest & ~DrawSortKey::c_DepthMask, key);
+	EXPECT_EQ(DrawSortKey::WithDepth(farthest, 1.0f), closest);
+
+	// The LOD sits between the mesh and the depth, it leaves both of them untouched.
+	const uint64_t lod = DrawSortKey::WithLod(closest, 2);
+	EXPECT_EQ((lod >> DrawSortKey::c_LodShift) & DrawSortKey::c_LodMask, 2);
+	EXPECT_EQ(lod >> DrawSortKey::c_MeshShift, key >> DrawSortKey::c_MeshShift);
+	EXPECT_EQ(lod & DrawSortKey::c_DepthMask, closest & DrawSortKey::c_DepthMask);
+	EXPECT_LT(DrawSortKey::WithLod(farthest, 0), lod);
+	EXPECT_EQ(DrawSortKey::WithLod(lod, 0), closest);
+	EXPECT_EQ((DrawSortKey::WithLod(key, 100) >> DrawSortKey::c_LodShift) & DrawSortKey::c_LodMask, DrawSortKey::c_LodMask);
+
+	Log::Shutdown();
+}
+
+TEST(DrawSort, LodsOfAMesh) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	// The LODs of a single mesh at interleaved depths, each LOD must end up contiguous and sorted by depth.
+	constexpr uint32_t count = 300;
+	constexpr uint32_t lodCount = 3;
+	const int mesh{};
+	const uint64_t key = DrawSortKey::Make(DrawSortKey::Opaque, NULL_ASSET_HANDLE, NULL_ASSET_HANDLE, &mesh);
+	DrawContext ctx;
+	for (uint32_t i = 0; i < count; ++i) {
+		RenderObject &surface = ctx.OpaqueSurfaces.emplace_back(Math::Identity<Mat4>(), nullptr);
+		surface.lod = i % lodCount;
+		surface.sortKey = DrawSortKey::WithDepth(DrawSortKey::WithLod(key, surface.lod), static_cast<float>(count - i));
+	}
+
+	DrawSorter sorter;
+	sorter.Sort(ctx);
+	ASSERT_EQ(ctx.OpaqueSurfaces.size(), count);
+	uint32_t lodChanges = 0;
+	for (uint32_t i = 1; i < count; ++i) {
+		const RenderObject &previous = ctx.OpaqueSurfaces[i - 1];
+		const RenderObject &current = ctx.OpaqueSurfaces[i];
+		ASSERT_LE(previous.lod, current.lod);
+		lodChanges += previous.lod != current.lod;
+		if (previous.lod == current.lod) ASSERT_LE(previous.sortKey & DrawSortKey::c_DepthMask, current.sortKey & DrawSortKey::c_DepthMask);
+	}
+	EXPECT_EQ(lodChanges, lodCount - 1);
+
+	Log::Shutdown();
+}
+
+TEST(DrawSort, Sort) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	constexpr uint32_t count = 10'000;
+	DrawContext ctx;
+	for (uint32_t i = 0; i < count; ++i) {
+		RenderObject &surface = ctx.OpaqueSurfaces.emplace_back(Math::Identity<Mat4>(), nullptr);
+		// Few distinct keys so the order of the equal ones is checked too.
+		const uint64_t hash = DrawSortKey::Fold(i + 1, 64);
+		surface.sortKey = (hash >> 58) << 40 | (hash & 3);
+		surface.lod = i;
+	}
+
+	DrawSorter sorter;
+	sorter.Sort(ctx);
+	ASSERT_EQ(ctx.OpaqueSurfaces.size(), count);
+	for (uint32_t i = 1; i < count; ++i) {
+		const RenderObject &previous = ctx.OpaqueSurfaces[i - 1];
+		const RenderObject &current = ctx.OpaqueSurfaces[i];
+		ASSERT_LE(previous.sortKey, current.sortKey);
+		if (previous.sortKey == current.sortKey) ASSERT_LT(previous.lod, current.lod);
+	}
+
+	Log::Shutdown();
+}
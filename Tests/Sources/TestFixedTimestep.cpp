@@ -0,0 +1,82 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Physics/FixedTimestep.hpp"
+
+TEST(FixedTimestep, AccumulateTheFrames) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	FixedTimestepSettings settings;
+	settings.Rate = 60;
+	FixedTimestep timestep{settings};
+
+	// Two frames at 120 fps make one step.
+	EXPECT_EQ(timestep.Advance(1.0 / 120.0), 0);
+	EXPECT_NEAR(timestep.GetAlpha(), 0.5, 1e-6);
+	EXPECT_EQ(timestep.Advance(1.0 / 120.0), 1);
+	EXPECT_NEAR(timestep.GetAlpha(), 0.0, 1e-6);
+
+	// A frame at exactly the rate always makes one step.
+	for (uint32_t i = 0; i < 600; ++i) {
+		ASSERT_EQ(timestep.Advance(1.0 / 60.0), 1);
+	}
+
+	// The remainder is kept for the next frame.
+	EXPECT_EQ(timestep.Advance(0.025), 1);
+	EXPECT_NEAR(timestep.GetAlpha(), 0.5, 1e-6);
+	EXPECT_EQ(timestep.Advance(0.025), 2);
+	EXPECT_NEAR(timestep.GetAlpha(), 0.0, 1e-6);
+
+	EXPECT_EQ(timestep.GetStats().steps, 604);
+	EXPECT_EQ(timestep.GetStats().clampedFrames, 0);
+
+	Log::Shutdown();
+}
+
+TEST(FixedTimestep, ClampTheHitches) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	FixedTimestepSettings settings;
+	settings.Rate = 100;
+	settings.MaxSubSteps = 4;
+	FixedTimestep timestep{settings};
+
+	// A second long frame runs 4 steps, the fraction of a step is kept and the rest is dropped.
+	EXPECT_EQ(timestep.Advance(1.005), 4);
+	EXPECT_NEAR(timestep.GetAlpha(), 0.5, 1e-6);
+	EXPECT_EQ(timestep.GetStats().clampedFrames, 1);
+	EXPECT_NEAR(timestep.GetStats().droppedSeconds, 0.96, 1e-6);
+
+	// The next frames aren't affected.
+	EXPECT_EQ(timestep.Advance(0.005), 1);
+	EXPECT_EQ(timestep.Advance(0.01), 1);
+	EXPECT_EQ(timestep.GetStats().clampedFrames, 1);
+
+	// Negative times are ignored.
+	EXPECT_EQ(timestep.Advance(-1.0), 0);
+
+	Log::Shutdown();
+}
+
+TEST(FixedTimestep, ChangeTheRate) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	FixedTimestep timestep;
+	EXPECT_EQ(timestep.Advance(0.0125), 0);
+
+	// The accumulator stays below a step and the settings stay valid.
+	FixedTimestepSettings settings;
+	settings.Rate = 100;
+	settings.MaxSubSteps = 0;
+	timestep.SetSettings(settings);
+	EXPECT_EQ(timestep.GetSettings().MaxSubSteps, 1);
+	EXPECT_LT(timestep.GetAlpha(), 1.0);
+	EXPECT_NEAR(timestep.GetAccumulator(), 0.0025, 1e-6);
+
+	timestep.Reset();
+	EXPECT_EQ(timestep.GetAccumulator(), 0.0);
+
+	Log::Shutdown();
+}
@@ -0,0 +1,64 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Application/FrameCapture.hpp"
+
+TEST(FrameCapture, CameraPath) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	const std::vector<CameraKey> path = {
+			CameraKey{0, Vec3{0, 0, 0}, 0, 0},
+			CameraKey{1, Vec3{10, 0, 0}, 10, 90},
+			CameraKey{3, Vec3{10, 20, 0}, 30, 90},
+	};
+
+	const CameraKey before = FrameCapture::Evaluate(path, -1);
+	EXPECT_EQ(before.Position, Vec3(0, 0, 0));
+
+	const CameraKey middle = FrameCapture::Evaluate(path, Real(0.5));
+	EXPECT_NEAR(middle.Position.x, 5, 1e-4);
+	EXPECT_NEAR(middle.Pitch, 5, 1e-4);
+	EXPECT_NEAR(middle.Yaw, 45, 1e-4);
+
+	const CameraKey second = FrameCapture::Evaluate(path, 2);
+	EXPECT_NEAR(second.Position.x, 10, 1e-4);
+	EXPECT_NEAR(second.Position.y, 10, 1e-4);
+	EXPECT_NEAR(second.Pitch, 20, 1e-4);
+
+	const CameraKey after = FrameCapture::Evaluate(path, 10);
+	EXPECT_EQ(after.Position, Vec3(10, 20, 0));
+
+	EXPECT_EQ(FrameCapture::Evaluate({}, 1).Position, Vec3(0));
+
+	Log::Shutdown();
+}
+
+TEST(FrameCapture, Timings) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	CaptureParameters parameters{};
+	parameters.FrameCount = 3;
+	FrameCapture capture{parameters};
+	EXPECT_FALSE(capture.IsDone());
+
+	for (uint32_t i = 0; i < 3; ++i) {
+		FrameTimings timings{};
+		timings.extraction = 1.0 + i;
+		timings.raster = 2.0;
+		timings.frame = 4.0 + i;
+		capture.Record(timings);
+	}
+	EXPECT_TRUE(capture.IsDone());
+	ASSERT_EQ(capture.GetFrames().size(), 3);
+
+	const std::string json = capture.TimingsToJson(64, 32);
+	EXPECT_NE(json.find("\"frameCount\": 3"), std::string::npos);
+	EXPECT_NE(json.find("\"width\": 64"), std::string::npos);
+	EXPECT_NE(json.find("\"extraction\": {\"mean\": 2.0000, \"min\": 1.0000, \"max\": 3.0000}"), std::string::npos);
+	EXPECT_NE(json.find("\"raster\": {\"mean\": 2.0000"), std::string::npos);
+	EXPECT_NE(json.find("\"present\": {\"mean\": 0.0000"), std::string::npos);
+
+	Log::Shutdown();
+}
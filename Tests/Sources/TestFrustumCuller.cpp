@@ -0,0 +1,127 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Rendering/FrustumCuller.hpp"
+
+static RenderObject CreateBox(const Vec3 &position, const uint32_t lodCount = 1) {
+	RenderObject surface{Math::Translate(Math::Identity<Mat4>(), position), nullptr};
+	surface.bounds = BoundingBox{Vec3(-1), Vec3(1)};
+	surface.lodCount = lodCount;
+	return surface;
+}
+
+TEST(FrustumCuller, Visibility) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	// The camera is at the origin and looks toward +Z.
+	const Mat4 view = Math::Identity<Mat4>();
+	const Mat4 projection = glm::perspective(glm::radians(Real(70)), Real(1), Real(0.1), Real(1000));
+
+	DrawContext ctx;
+	ctx.OpaqueSurfaces.push_back(CreateBox({0, 0, 10}));
+	ctx.OpaqueSurfaces.push_back(CreateBox({0, 0, -10}));
+	ctx.OpaqueSurfaces.push_back(CreateBox({100, 0, 10}));
+	ctx.OpaqueSurfaces.push_back(CreateBox({0, 0, 2000}));
+	ctx.OpaqueSurfaces.push_back(CreateBox({5, 5, 10}));
+	RenderObject unbounded = CreateBox({0, 0, -10});
+	unbounded.bounds = BoundingBox{};
+	ctx.OpaqueSurfaces.push_back(unbounded);
+
+	FrustumCuller culler;
+	culler.Cull(view, projection, ctx);
+
+	// The visible surfaces keep their order.
+	ASSERT_EQ(ctx.OpaqueSurfaces.size(), 3);
+	ASSERT_EQ(ctx.OpaqueSurfaces[0].transform[3][2], 10);
+	ASSERT_EQ(ctx.OpaqueSurfaces[1].transform[3][0], 5);
+	ASSERT_FALSE(ctx.OpaqueSurfaces[2].bounds.IsValid());
+
+	ASSERT_EQ(culler.GetStats().tested, 6);
+	ASSERT_EQ(culler.GetStats().visible, 3);
+	ASSERT_EQ(culler.GetStats().culled, 3);
+
+	culler.ResetStats();
+	ASSERT_EQ(culler.GetStats().tested, 0);
+
+	Log::Shutdown();
+}
+
+TEST(FrustumCuller, MatchesScalarTest) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	JobSystem::Initialize(3);
+
+	const Mat4 view = glm::lookAt(Vec3(3, 2, -5), Vec3(0, 0, 20), Vec3(0, 1, 0));
+	const Mat4 projection = glm::perspective(glm::radians(Real(60)), Real(16) / Real(9), Real(0.1), Real(200));
+	const Frustum frustum = Frustum::FromViewProjection(projection * view);
+
+	// Pseudo random boxes around the camera, the count isn't a multiple of the batch size.
+	constexpr uint32_t count = 10'003;
+	uint32_t seed = 12345;
+	const auto random = [&seed](const Real min, const Real max) {
+		seed = seed * 1664525u + 1013904223u;
+		return min + (max - min) * static_cast<Real>(seed >> 8) / static_cast<Real>(1u << 24);
+	};
+
+	DrawContext ctx;
+	std::vector<Vec3> positions;
+	for (uint32_t i = 0; i < count; ++i) {
+		positions.emplace_back(random(-150, 150), random(-150, 150), random(-150, 250));
+		ctx.OpaqueSurfaces.push_back(CreateBox(positions.back()));
+		// Only used to find the index of the surface back after the culling.
+		ctx.OpaqueSurfaces.back().lodCount = i;
+	}
+
+	FrustumCuller culler;
+	culler.Cull(view, projection, ctx);
+
+	std::vector<bool> visible(count, false);
+	for (const RenderObject &surface: ctx.OpaqueSurfaces) {
+		visible[surface.lodCount] = true;
+	}
+	for (uint32_t i = 0; i < count; ++i) {
+		// The boxes touching a plane may go either way depending on the rounding.
+		float margin = std::numeric_limits<float>::max();
+		for (const glm::fvec4 &plane: frustum.planes) {
+			margin = std::min(margin, glm::dot(glm::fvec3(plane), glm::fvec3(positions[i])) + plane.w + glm::dot(glm::abs(glm::fvec3(plane)), glm::fvec3(1)));
+		}
+		if (std::abs(margin) < 1e-3f) continue;
+		ASSERT_EQ(visible[i], frustum.Intersects(glm::fvec3(positions[i]), glm::fvec3(1))) << "Box " << i;
+	}
+	ASSERT_EQ(culler.GetStats().visible + culler.GetStats().culled, count);
+
+	JobSystem::Shutdown();
+	Log::Shutdown();
+}
+
+TEST(FrustumCuller, LodSelection) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	const Mat4 view = Math::Identity<Mat4>();
+	const Mat4 projection = glm::perspective(glm::radians(Real(70)), Real(1), Real(0.1), Real(1000));
+
+	DrawContext ctx;
+	ctx.OpaqueSurfaces.push_back(CreateBox({0, 0, 2}, 3));
+	ctx.OpaqueSurfaces.push_back(CreateBox({0, 0, 10}, 3));
+	ctx.OpaqueSurfaces.push_back(CreateBox({0, 0, 100}, 3));
+	ctx.OpaqueSurfaces.push_back(CreateBox({0, 0, 100}, 1));
+
+	FrustumCuller culler;
+	culler.Cull(view, projection, ctx);
+	ASSERT_EQ(ctx.OpaqueSurfaces.size(), 4);
+	ASSERT_EQ(ctx.OpaqueSurfaces[0].lod, 0);
+	ASSERT_EQ(ctx.OpaqueSurfaces[1].lod, 1);
+	ASSERT_EQ(ctx.OpaqueSurfaces[2].lod, 2);
+	ASSERT_EQ(ctx.OpaqueSurfaces[3].lod, 0);
+	ASSERT_EQ(culler.GetStats().lods[0], 2);
+	ASSERT_EQ(culler.GetStats().lods[1], 1);
+	ASSERT_EQ(culler.GetStats().lods[2], 1);
+
+	ASSERT_EQ(FrustumCuller::SelectLod(1.0f, 4, 0.25f), 0);
+	ASSERT_EQ(FrustumCuller::SelectLod(0.2f, 4, 0.25f), 1);
+	ASSERT_EQ(FrustumCuller::SelectLod(0.1f, 4, 0.25f), 2);
+	ASSERT_EQ(FrustumCuller::SelectLod(0.0f, 4, 0.25f), 3);
+
+	Log::Shutdown();
+}
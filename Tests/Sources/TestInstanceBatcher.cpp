@@ -0,0 +1,110 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Rendering/DrawSort.hpp"
+#include "Imagine/Rendering/InstanceBatcher.hpp"
+
+namespace {
+	class TestGPUMesh final : public GPUMesh {
+	public:
+		virtual ~TestGPUMesh() override = default;
+		virtual uint64_t GetID() override { return 0; }
+	};
+} // namespace
+
+TEST(InstanceBatcher, Batches) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	TestGPUMesh meshes[2];
+	std::vector<RenderObject> surfaces;
+	for (uint32_t i = 0; i < 5; ++i) surfaces.emplace_back(Math::Identity<Mat4>(), &meshes[0]);
+	surfaces.emplace_back(Math::Identity<Mat4>(), &meshes[0]).lod = 1;
+	for (uint32_t i = 0; i < 3; ++i) surfaces.emplace_back(Math::Identity<Mat4>(), &meshes[1]);
+	// Not next to the others, so it starts its own batch.
+	surfaces.emplace_back(Math::Identity<Mat4>(), &meshes[0]);
+
+	InstanceBatcher batcher;
+	batcher.Build(surfaces);
+	const std::vector<InstanceBatch> &batches = batcher.GetBatches();
+	ASSERT_EQ(batches.size(), 4);
+	EXPECT_EQ(batches[0].mesh, &meshes[0]);
+	EXPECT_EQ(batches[0].first, 0);
+	EXPECT_EQ(batches[0].count, 5);
+	EXPECT_EQ(batches[1].lod, 1);
+	EXPECT_EQ(batches[1].first, 5);
+	EXPECT_EQ(batches[1].count, 1);
+	EXPECT_EQ(batches[2].mesh, &meshes[1]);
+	EXPECT_EQ(batches[2].count, 3);
+	EXPECT_EQ(batches[3].first, 9);
+	EXPECT_EQ(batches[3].count, 1);
+
+	batcher.Build({});
+	EXPECT_TRUE(batcher.GetBatches().empty());
+
+	Log::Shutdown();
+}
+
+TEST(InstanceBatcher, SortedLods) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	// Two meshes whose LODs are interleaved by their depth, once sorted each LOD of a mesh is a single batch.
+	TestGPUMesh meshes[2];
+	DrawContext ctx;
+	for (uint32_t i = 0; i < 64; ++i) {
+		GPUMesh *mesh = &meshes[i % 2];
+		RenderObject &surface = ctx.OpaqueSurfaces.emplace_back(Math::Identity<Mat4>(), mesh);
+		surface.lod = (i / 2) % 4;
+		const uint64_t key = DrawSortKey::Make(DrawSortKey::Opaque, NULL_ASSET_HANDLE, NULL_ASSET_HANDLE, mesh);
+		surface.sortKey = DrawSortKey::WithDepth(DrawSortKey::WithLod(key, surface.lod), static_cast<float>(i));
+	}
+
+	DrawSorter sorter;
+	sorter.Sort(ctx);
+	InstanceBatcher batcher;
+	batcher.Build({ctx.OpaqueSurfaces.data(), ctx.OpaqueSurfaces.size()});
+	const std::vector<InstanceBatch> &batches = batcher.GetBatches();
+	ASSERT_EQ(batches.size(), 2 * 4);
+	for (const InstanceBatch &batch: batches) {
+		EXPECT_EQ(batch.count, 64 / 8);
+		for (uint32_t i = batch.first; i < batch.first + batch.count; ++i) {
+			EXPECT_EQ(ctx.OpaqueSurfaces[i].mesh, batch.mesh);
+			EXPECT_EQ(ctx.OpaqueSurfaces[i].lod, batch.lod);
+		}
+	}
+
+	Log::Shutdown();
+}
+
+TEST(InstanceBatcher, NormalMatrices) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	// Not a multiple of the SIMD width, so the last batch is partial.
+	std::vector<RenderObject> surfaces;
+	for (uint32_t i = 0; i < 7; ++i) {
+		const Real angle = static_cast<Real>(i) * Real(0.7);
+		Mat4 transform = Math::Translate(Math::Identity<Mat4>(), Vec3(static_cast<Real>(i), 2, -3));
+		transform = glm::rotate(transform, angle, glm::normalize(Vec3(1, static_cast<Real>(i), 2)));
+		transform = glm::scale(transform, Vec3(1 + static_cast<Real>(i), Real(0.5), 2));
+		surfaces.emplace_back(transform, nullptr);
+	}
+
+	std::vector<GPUInstanceData> instances(surfaces.size());
+	InstanceBatcher::WriteInstances(surfaces, instances.data());
+
+	for (uint32_t i = 0; i < surfaces.size(); ++i) {
+		const glm::fmat4 world{surfaces[i].transform};
+		const glm::fmat3 expected = glm::transpose(glm::inverse(glm::fmat3(world)));
+		const glm::fmat3 normal{instances[i].normalMatrix};
+		for (uint32_t c = 0; c < 3; ++c) {
+			for (uint32_t r = 0; r < 3; ++r) {
+				EXPECT_NEAR(normal[c][r], expected[c][r], 1e-4f);
+			}
+		}
+		EXPECT_EQ(instances[i].worldMatrix, world);
+		EXPECT_EQ(instances[i].normalMatrix[3], glm::fvec4(0, 0, 0, 1));
+	}
+
+	Log::Shutdown();
+}
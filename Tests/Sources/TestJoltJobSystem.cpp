@@ -0,0 +1,61 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Physics/BroadPhaseLayerInterface.hpp"
+#include "Imagine/Physics/JoltJobSystem.hpp"
+#include "Imagine/Physics/ObjectLayerPairFilter.hpp"
+#include "Imagine/Physics/ObjectVsBroadPhaseLayerFilter.hpp"
+
+#include <Jolt/Core/Factory.h>
+#include <Jolt/Core/Memory.h>
+#include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/RegisterTypes.h>
+
+TEST(JoltJobSystem, StepWithoutWorkers) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	JPH::RegisterDefaultAllocator();
+	JPH::Factory::sInstance = new JPH::Factory();
+	JPH::RegisterTypes();
+
+	// What a single core host gets by default, nothing drains the queues in the background.
+	JobSystem::Initialize(0);
+	ASSERT_EQ(JobSystem::GetWorkerCount(), 0);
+	{
+		// Every step creates several jobs, the pool would run dry if they weren't freed.
+		constexpr JPH::uint maxJobs = 64;
+		JoltJobSystem jobSystem{maxJobs, JPH::cMaxPhysicsBarriers};
+		JPH::TempAllocatorImpl tempAllocator{1024 * 1024};
+		BroadPhaseLayerInterface broadPhaseLayer;
+		ObjectVsBroadPhaseLayerFilter objectVsBroadPhaseFilter;
+		ObjectLayerPairFilter objectLayerPairFilter;
+
+		JPH::PhysicsSystem system;
+		system.Init(1024, 0, 1024, 1024, broadPhaseLayer, objectVsBroadPhaseFilter, objectLayerPairFilter);
+		JPH::BodyInterface &bodies = system.GetBodyInterfaceNoLock();
+		bodies.CreateAndAddBody({new JPH::BoxShape(JPH::Vec3(10, 1, 10)), JPH::RVec3::sZero(), JPH::Quat::sIdentity(), JPH::EMotionType::Static, PhysicalLayers::NON_MOVING}, JPH::EActivation::DontActivate);
+		std::vector<JPH::BodyID> spheres;
+		for (uint32_t i = 0; i < 8; ++i) {
+			spheres.push_back(bodies.CreateAndAddBody({new JPH::SphereShape(0.5f), JPH::RVec3(static_cast<float>(i) * 1.1f - 4, 3, 0), JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, PhysicalLayers::MOVING}, JPH::EActivation::Activate));
+		}
+
+		for (uint32_t i = 0; i < maxJobs * 4; ++i) {
+			ASSERT_EQ(system.Update(1.0f / 60.0f, 1, &tempAllocator, &jobSystem), JPH::EPhysicsUpdateError::None);
+		}
+
+		// The spheres fell and rest on the ground.
+		for (const JPH::BodyID id: spheres) {
+			EXPECT_NEAR(bodies.GetPosition(id).GetY(), 1.5f, 0.05f);
+		}
+	}
+	JobSystem::Shutdown();
+
+	JPH::UnregisterTypes();
+	delete JPH::Factory::sInstance;
+	JPH::Factory::sInstance = nullptr;
+	Log::Shutdown();
+}
@@ -0,0 +1,157 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Rendering/LightClusters.hpp"
+
+namespace {
+	constexpr uint32_t c_Width = 1920;
+	constexpr uint32_t c_Height = 1080;
+
+	Mat4 CreateProjection() {
+		Mat4 projection = glm::perspective(glm::radians(Real(Camera::c_FieldOfView)), Real(c_Width) / Real(c_Height), Real(Camera::c_NearPlane), Real(Camera::c_FarPlane));
+		projection[1][1] *= -1;
+		return projection;
+	}
+
+	Light CreateLight(const LightType type, const glm::fvec3 &position, const float range) {
+		Light light;
+		light.type = type;
+		light.position = position;
+		light.direction = {0, -range, 0, 0.5f};
+		return light;
+	}
+} // namespace
+
+TEST(LightClusters, DirectionalLightsFirst) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	// The camera is at the origin and looks toward +Z.
+	const std::vector<Light> lights{
+			CreateLight(LIGHT_POINT, {0, 0, 10}, 5),
+			CreateLight(LIGHT_DIRECTIONAL, {0, 0, 0}, 1),
+			CreateLight(LIGHT_SPOT, {1, 0, 20}, 5),
+			CreateLight(LIGHT_DIRECTIONAL, {0, 0, 0}, 2),
+	};
+
+	LightClusters clusters;
+	clusters.Build(lights, Math::Identity<Mat4>(), CreateProjection(), c_Width, c_Height);
+
+	ASSERT_EQ(clusters.GetLights().size(), 4);
+	EXPECT_EQ(clusters.GetGrid().size.w, 2);
+	EXPECT_EQ(clusters.GetLights()[0].direction.y, -1);
+	EXPECT_EQ(clusters.GetLights()[1].direction.y, -2);
+	EXPECT_EQ(clusters.GetLights()[2].type, LIGHT_POINT);
+	EXPECT_EQ(clusters.GetLights()[3].type, LIGHT_SPOT);
+	EXPECT_EQ(clusters.GetStats().directionalLights, 2);
+	EXPECT_EQ(clusters.GetStats().culledLights, 0);
+
+	// The directional lights aren't in the clusters.
+	EXPECT_GT(clusters.GetIndices().size(), 0);
+	for (const uint32_t index: clusters.GetIndices()) {
+		EXPECT_GE(index, 2);
+	}
+
+	Log::Shutdown();
+}
+
+TEST(LightClusters, CullLightsOutsideOfTheView) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	const std::vector<Light> lights{
+			CreateLight(LIGHT_POINT, {0, 0, 10}, 2),
+			CreateLight(LIGHT_POINT, {0, 0, -50}, 5),
+			CreateLight(LIGHT_POINT, {1000, 0, 10}, 5),
+			CreateLight(LIGHT_SPOT, {0, 0, 20000}, 5),
+			CreateLight(LIGHT_POINT, {0, 0, 10}, 0),
+	};
+
+	LightClusters clusters;
+	clusters.Build(lights, Math::Identity<Mat4>(), CreateProjection(), c_Width, c_Height);
+
+	EXPECT_EQ(clusters.GetStats().culledLights, 4);
+	ASSERT_GT(clusters.GetIndices().size(), 0);
+	for (const uint32_t index: clusters.GetIndices()) {
+		EXPECT_EQ(index, 0);
+	}
+
+	// A point in front of the camera is in the slice of its depth.
+	const Mat4 projection = CreateProjection();
+	const uint32_t cluster = clusters.GetClusterIndex(glm::fvec4(projection * Vec4(0, 0, 10, 1)));
+	ASSERT_NE(cluster, LightClusters::c_OutsideGrid);
+	EXPECT_EQ(clusters.GetClusterLights(cluster).size(), 1);
+	EXPECT_EQ(clusters.GetClusterIndex(glm::fvec4(projection * Vec4(0, 0, -10, 1))), LightClusters::c_OutsideGrid);
+
+	Log::Shutdown();
+}
+
+TEST(LightClusters, ClustersAreConservative) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	const Mat4 view = glm::lookAt(Vec3(10, 20, -30), Vec3(0, 0, 50), Vec3(0, 1, 0));
+	const Mat4 projection = CreateProjection();
+	const glm::fmat4 viewProjection{projection * view};
+
+	std::vector<Light> lights;
+	uint32_t seed = 1;
+	const auto random = [&seed](const float min, const float max) {
+		seed = seed * 1664525u + 1013904223u;
+		return min + (max - min) * static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+	};
+	for (uint32_t i = 0; i < 500; ++i) {
+		lights.push_back(CreateLight(i % 2 ? LIGHT_SPOT : LIGHT_POINT, {random(-100, 100), random(-20, 40), random(-40, 300)}, random(0.5f, 20)));
+	}
+
+	LightClusterSettings settings;
+	settings.MaxLightsPerCluster = static_cast<uint32_t>(lights.size());
+	LightClusters clusters;
+	clusters.SetSettings(settings);
+	clusters.Build(lights, view, projection, c_Width, c_Height);
+	EXPECT_EQ(clusters.GetStats().droppedIndices, 0);
+
+	// Every point lit by a light is in a cluster holding the light.
+	uint32_t tested = 0;
+	for (uint32_t light = 0; light < lights.size(); ++light) {
+		const float range = glm::length(glm::fvec3(lights[light].direction));
+		for (uint32_t sample = 0; sample < 64; ++sample) {
+			const glm::fvec3 direction{random(-1, 1), random(-1, 1), random(-1, 1)};
+			if (glm::length(direction) > 1) continue;
+			const glm::fvec3 point = lights[light].position + direction * (range * 0.99f);
+			const uint32_t cluster = clusters.GetClusterIndex(viewProjection * glm::fvec4(point, 1));
+			if (cluster == LightClusters::c_OutsideGrid) continue;
+			const std::span<const uint32_t> indices = clusters.GetClusterLights(cluster);
+			EXPECT_TRUE(std::binary_search(indices.begin(), indices.end(), light));
+			++tested;
+		}
+	}
+	EXPECT_GT(tested, 1000);
+
+	Log::Shutdown();
+}
+
+TEST(LightClusters, CapTheClusters) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	const std::vector<Light> lights(20, CreateLight(LIGHT_POINT, {0, 0, 10}, 1));
+
+	LightClusterSettings settings;
+	settings.MaxLightsPerCluster = 8;
+	LightClusters clusters;
+	clusters.SetSettings(settings);
+	clusters.Build(lights, Math::Identity<Mat4>(), CreateProjection(), c_Width, c_Height);
+
+	EXPECT_EQ(clusters.GetStats().maxLightsInCluster, 8);
+	EXPECT_EQ(clusters.GetStats().droppedIndices, (20 - 8) * clusters.GetStats().occupiedClusters);
+
+	// The first lights are kept.
+	const uint32_t cluster = clusters.GetClusterIndex(glm::fvec4(CreateProjection() * Vec4(0, 0, 10, 1)));
+	ASSERT_NE(cluster, LightClusters::c_OutsideGrid);
+	const std::span<const uint32_t> indices = clusters.GetClusterLights(cluster);
+	ASSERT_EQ(indices.size(), 8);
+	for (uint32_t i = 0; i < indices.size(); ++i) {
+		EXPECT_EQ(indices[i], i);
+	}
+
+	Log::Shutdown();
+}
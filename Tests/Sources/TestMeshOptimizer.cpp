@@ -0,0 +1,74 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Rendering/MeshOptimizer.hpp"
+
+namespace {
+	/// A bumpy grid of 'size' x 'size' quads with its triangles shuffled, and a copy of its first vertex left unused.
+	CPUMesh MakeShuffledGrid(const uint32_t size) {
+		std::vector<std::array<uint32_t, 3>> triangles;
+		for (uint32_t y = 0; y < size; ++y) {
+			for (uint32_t x = 0; x < size; ++x) {
+				const uint32_t i = y * (size + 1) + x;
+				triangles.push_back({i, i + size + 1, i + 1});
+				triangles.push_back({i + 1, i + size + 1, i + size + 2});
+			}
+		}
+		for (uint32_t i = static_cast<uint32_t>(triangles.size()) - 1; i > 0; --i) {
+			std::swap(triangles[i], triangles[(i * 2654435761u) % (i + 1)]);
+		}
+
+		CPUMesh mesh;
+		for (uint32_t z = 0; z <= size; ++z) {
+			for (uint32_t x = 0; x <= size; ++x) {
+				Vertex &vertex = mesh.Vertices.emplace_back();
+				vertex.position = {static_cast<float>(x), 0.01f * std::sin(static_cast<float>(x)) * std::cos(static_cast<float>(z)), static_cast<float>(z)};
+			}
+		}
+		mesh.Vertices.push_back(mesh.Vertices.front());
+		for (const auto &triangle: triangles) {
+			mesh.Indices.insert(mesh.Indices.end(), triangle.begin(), triangle.end());
+		}
+		mesh.Lods.emplace_back(0u, static_cast<uint32_t>(mesh.Indices.size()), AssetHandle{1, 2});
+		return mesh;
+	}
+} // namespace
+
+TEST(MeshOptimizer, Optimize) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	CPUMesh mesh = MakeShuffledGrid(64);
+	const uint32_t triangles = static_cast<uint32_t>(mesh.Indices.size() / 3);
+	const MeshOptimizationReport report = MeshOptimizer::Optimize(mesh);
+
+	// The unused vertex is removed.
+	EXPECT_EQ(report.verticesBefore, 65 * 65 + 1);
+	EXPECT_EQ(report.verticesAfter, 65 * 65);
+	EXPECT_EQ(mesh.Vertices.size(), report.verticesAfter);
+
+	EXPECT_GT(report.before.acmr, 2.0f);
+	EXPECT_LT(report.after.acmr, 1.0f);
+	EXPECT_LT(report.after.atvr, report.before.atvr);
+	EXPECT_LT(report.after.overfetch, report.before.overfetch);
+
+	ASSERT_GT(mesh.Lods.size(), 1);
+	ASSERT_EQ(report.lodTriangles.size(), mesh.Lods.size());
+	EXPECT_EQ(report.lodTriangles.front(), triangles);
+	uint32_t end = 0;
+	for (uint32_t i = 0; i < mesh.Lods.size(); ++i) {
+		const LOD &lod = mesh.Lods[i];
+		EXPECT_EQ(lod.index, end);
+		EXPECT_EQ(lod.count % 3, 0);
+		EXPECT_EQ(lod.materialInstance, AssetHandle(1, 2));
+		if (i > 0) EXPECT_LT(lod.count, mesh.Lods[i - 1].count);
+		end += lod.count;
+	}
+	EXPECT_EQ(end, mesh.Indices.size());
+	for (const uint32_t index: mesh.Indices) {
+		ASSERT_LT(index, mesh.Vertices.size());
+	}
+
+	Log::Shutdown();
+}
@@ -0,0 +1,139 @@
+//
+// Created by ianpo on 17/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Assets/Importers/ModelCache.hpp"
+#include "Imagine/Rendering/CPU/CPUMaterialInstance.hpp"
+
+static Ref<CPUModel> CreateTestModel() {
+	Ref<CPUModel> model = CreateRef<CPUModel>();
+	model->Shaders.push_back(CreateRef<CPUFileShader>(ShaderStage::Vertex, Path{FileSource::Assets, "pbr.vert.spv"}));
+
+	Ref<CPUTexture2D> texture = CreateRef<CPUTexture2D>();
+	texture->image.Allocate(4, 2, 4);
+	for (uint32_t i = 0; i < texture->image.source.Size(); ++i) {
+		texture->image.source.Get<uint8_t>()[i] = static_cast<uint8_t>(i);
+	}
+	model->Textures.push_back(texture);
+
+	Ref<CPUMaterialInstance> instance = CreateRef<CPUMaterialInstance>();
+	instance->PushSet({1, 1, 0}, texture->Handle);
+	instance->PushSet({1, 0, 0}, glm::fvec4(0.5f, 0.25f, 1, 1));
+	model->Instances.push_back(instance);
+
+	Ref<CPUMesh> mesh = CreateRef<CPUMesh>();
+	mesh->Name = "Triangle";
+	mesh->Vertices = {Vertex{Vec3{0, 0, 0}}, Vertex{Vec3{1, 0, 0}}, Vertex{Vec3{0, 1, 0}}};
+	mesh->Indices = {0, 1, 2};
+	mesh->Lods.push_back(LOD{0, 3, instance->Handle});
+	model->Meshes.push_back(mesh);
+
+	CPUModel::Node root{};
+	root.name = "Root";
+	root.children.push_back(1);
+	model->Nodes.push_back(root);
+
+	CPUModel::Node child{};
+	child.name = "Child";
+	child.parent = 0;
+	child.meshes.push_back(mesh);
+	child.LocalPosition = Vec3{1, 2, 3};
+	child.light = Light{};
+	model->Nodes.push_back(child);
+	return model;
+}
+
+TEST(ModelCache, RoundTrip) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	const std::filesystem::path root = std::filesystem::temp_directory_path() / "imagine_test_model_cache";
+	std::filesystem::remove_all(root);
+	const std::filesystem::path cooked = root / fmt::format("model{}", ModelCache::c_Extension);
+
+	const Ref<CPUModel> model = CreateTestModel();
+	constexpr uint64_t key = 0x1234;
+	ASSERT_TRUE(ModelCache::Write(*model, key, cooked));
+
+	ASSERT_EQ(ModelCache::Read(cooked, key + 1), nullptr);
+	ASSERT_EQ(ModelCache::Read(root / "missing.mgnmodel", key), nullptr);
+
+	const Ref<CPUModel> loaded = ModelCache::Read(cooked, key);
+	ASSERT_NE(loaded, nullptr);
+	ASSERT_EQ(loaded->Shaders.size(), 1);
+	ASSERT_EQ(loaded->Textures.size(), 1);
+	ASSERT_EQ(loaded->Instances.size(), 1);
+	ASSERT_EQ(loaded->Meshes.size(), 1);
+	ASSERT_EQ(loaded->Nodes.size(), 2);
+
+	const Image<uint8_t> &image = loaded->Textures[0]->image;
+	ASSERT_EQ(image.width, 4);
+	ASSERT_EQ(image.height, 2);
+	ASSERT_EQ(image.channels, 4);
+	ASSERT_EQ(memcmp(image.source.Get(), model->Textures[0]->image.source.Get(), image.source.Size()), 0);
+
+	// The assets get new handles and the references between them follow.
+	const Ref<CPUMesh> &mesh = loaded->Meshes[0];
+	ASSERT_NE(mesh->Handle, model->Meshes[0]->Handle);
+	ASSERT_NE(loaded->Textures[0]->Handle, model->Textures[0]->Handle);
+	ASSERT_EQ(mesh->Name, "Triangle");
+	ASSERT_EQ(mesh->Indices, model->Meshes[0]->Indices);
+	ASSERT_EQ(mesh->Vertices.size(), 3);
+	ASSERT_EQ(mesh->Vertices[1].position, Vec3(1, 0, 0));
+	ASSERT_EQ(mesh->Lods.size(), 1);
+	ASSERT_EQ(mesh->Lods[0].count, 3);
+	ASSERT_EQ(mesh->Lods[0].materialInstance, loaded->Instances[0]->Handle);
+
+	const CPUMaterialInstance::MaterialDataBuffer &textureField = loaded->Instances[0]->SetEditions.at({1, 1, 0});
+	AssetHandle textureHandle{NULL_ASSET_HANDLE};
+	memcpy(&textureHandle, textureField.data(), sizeof(AssetHandle));
+	ASSERT_EQ(textureHandle, loaded->Textures[0]->Handle);
+	ASSERT_EQ(loaded->Instances[0]->SetEditions.at({1, 0, 0}), model->Instances[0]->SetEditions.at({1, 0, 0}));
+
+	const CPUModel::Node &child = loaded->Nodes[1];
+	ASSERT_EQ(child.name, "Child");
+	ASSERT_EQ(child.parent, std::optional<uint64_t>{0});
+	ASSERT_FALSE(loaded->Nodes[0].parent.has_value());
+	ASSERT_EQ(loaded->Nodes[0].children, std::vector<uint64_t>{1});
+	ASSERT_EQ(child.LocalPosition, Vec3(1, 2, 3));
+	ASSERT_TRUE(child.light.has_value());
+	ASSERT_EQ(child.meshes.size(), 1);
+	ASSERT_EQ(child.meshes[0].lock(), mesh);
+
+	// A truncated file is rejected.
+	std::filesystem::resize_file(cooked, std::filesystem::file_size(cooked) / 2);
+	ASSERT_EQ(ModelCache::Read(cooked, key), nullptr);
+
+	std::filesystem::remove_all(root);
+	Log::Shutdown();
+}
+
+TEST(ModelCache, RejectInvalidHierarchy) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	const std::filesystem::path root = std::filesystem::temp_directory_path() / "imagine_test_model_cache_hierarchy";
+	std::filesystem::remove_all(root);
+	const std::filesystem::path cooked = root / fmt::format("model{}", ModelCache::c_Extension);
+	constexpr uint64_t key = 0x1234;
+
+	// A child out of the nodes.
+	Ref<CPUModel> model = CreateTestModel();
+	model->Nodes[1].children.push_back(2);
+	ASSERT_TRUE(ModelCache::Write(*model, key, cooked));
+	ASSERT_EQ(ModelCache::Read(cooked, key), nullptr);
+
+	// A cycle, the child has its parent as child.
+	model = CreateTestModel();
+	model->Nodes[1].children.push_back(0);
+	ASSERT_TRUE(ModelCache::Write(*model, key, cooked));
+	ASSERT_EQ(ModelCache::Read(cooked, key), nullptr);
+
+	// A parent out of the nodes.
+	model = CreateTestModel();
+	model->Nodes[1].parent = 5;
+	ASSERT_TRUE(ModelCache::Write(*model, key, cooked));
+	ASSERT_EQ(ModelCache::Read(cooked, key), nullptr);
+
+	std::filesystem::remove_all(root);
+	Log::Shutdown();
+}
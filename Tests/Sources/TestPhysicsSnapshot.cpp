@@ -0,0 +1,186 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Components/Physicalisable.hpp"
+#include "Imagine/Layers/PhysicsLayer.hpp"
+#include "Imagine/Physics/PhysicsTypeHelpers.hpp"
+#include "Imagine/Scene/SceneManager.hpp"
+
+#include <Jolt/Core/Memory.h>
+
+namespace {
+	/// A ground and a stack of spheres falling on it, the bodies created by a paused sync.
+	void FillScene(Scene &scene, PhysicsLayer &layer) {
+		const EntityID ground = scene.CreateEntity();
+		Physicalisable *groundComp = scene.AddComponent<Physicalisable>(ground);
+		groundComp->Shape = ColliderShapes::Box{Vec3(50, 1, 50)};
+		groundComp->RBType = RB_Static;
+
+		for (uint32_t i = 0; i < 64; ++i) {
+			const EntityID id = scene.CreateEntity();
+			scene.SetLocalPosition(id, Vec3(static_cast<Real>(i % 4) * 0.9, 2 + static_cast<Real>(i / 4) * 1.1, static_cast<Real>(i % 3) * 0.3));
+			scene.AddComponent<Physicalisable>(id)->Shape = ColliderShapes::Sphere{0.5};
+		}
+		scene.CacheTransforms();
+
+		PhysicsLayer::SetSimulating(false);
+		layer.Synchronize(scene);
+		PhysicsLayer::SetSimulating(true);
+	}
+} // namespace
+
+TEST(PhysicsSnapshot, RestoreTheWorld) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	JPH::RegisterDefaultAllocator();
+	JobSystem::Initialize(3);
+
+	PhysicsLayer layer;
+	layer.OnAttach();
+	{
+		const std::vector<Scene::Ref> scenes{std::make_shared<Scene>()};
+		Scene &scene = *scenes.front();
+		FillScene(scene, layer);
+		for (uint32_t i = 0; i < 30; ++i) {
+			layer.Simulate(1.0 / 60.0);
+			layer.Synchronize(scene);
+		}
+
+		const std::vector<uint8_t> snapshot = layer.SaveSnapshot(scenes);
+		const uint64_t hash = layer.HashState();
+		ASSERT_FALSE(snapshot.empty());
+
+		// Break the world, the snapshot brings it back.
+		for (uint32_t i = 0; i < 30; ++i) {
+			layer.Simulate(1.0 / 60.0);
+			layer.Synchronize(scene);
+		}
+		const EntityID removed{1};
+		scene.RemoveComponent<Physicalisable>(removed);
+		ASSERT_NE(layer.HashState(), hash);
+
+		ASSERT_TRUE(layer.RestoreSnapshot(snapshot, scenes));
+		EXPECT_EQ(layer.HashState(), hash);
+
+		// Every component got its body back, with the entity where the body is.
+		uint32_t components = 0;
+		scene.Query<Physicalisable>().Each([&](const EntityID id, Physicalisable &comp) {
+			++components;
+			ASSERT_FALSE(comp.BodyID.IsInvalid());
+			EXPECT_FALSE(comp.dirty);
+			const JPH::RVec3 position = layer.GetPhysicsSystem().GetBodyInterfaceNoLock().GetPosition(comp.BodyID);
+			EXPECT_EQ(std::as_const(scene).GetEntity(id).LocalPosition, Convert(position));
+		});
+		EXPECT_EQ(components, 65);
+		EXPECT_EQ(layer.GetPhysicsSystem().GetNumBodies(), 65);
+
+		// A corrupted snapshot leaves an empty world and no body to the components.
+		std::vector<uint8_t> corrupted = snapshot;
+		corrupted.resize(corrupted.size() / 2);
+		EXPECT_FALSE(layer.RestoreSnapshot(corrupted, scenes));
+		EXPECT_EQ(layer.GetPhysicsSystem().GetNumBodies(), 0);
+		scene.Query<Physicalisable>().Each([](const EntityID, Physicalisable &comp) {
+			EXPECT_TRUE(comp.BodyID.IsInvalid());
+		});
+	}
+	PhysicsLayer::SetSimulating(false);
+	layer.OnDetach();
+
+	JobSystem::Shutdown();
+	Log::Shutdown();
+}
+
+TEST(PhysicsSnapshot, PauseKeepsTheBodies) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	JPH::RegisterDefaultAllocator();
+	JobSystem::Initialize(3);
+
+	PhysicsLayer layer;
+	layer.OnAttach();
+	{
+		Scene scene;
+		FillScene(scene, layer);
+		// Frames shorter than a step, the entities are written between two states of the bodies.
+		for (uint32_t i = 0; i < 20; ++i) {
+			layer.Simulate(1.0 / 100.0);
+			layer.Synchronize(scene);
+		}
+		ASSERT_GT(layer.GetTimestep().GetAlpha(), 0);
+
+		std::vector<std::pair<JPH::BodyID, JPH::RVec3>> bodies;
+		scene.Query<Physicalisable>().Each([&](const EntityID, Physicalisable &comp) {
+			bodies.emplace_back(comp.BodyID, layer.GetPhysicsSystem().GetBodyInterfaceNoLock().GetPosition(comp.BodyID));
+		});
+
+		// The paused sync leaves the bodies where they are and moves the entities onto them.
+		PhysicsLayer::SetSimulating(false);
+		layer.Synchronize(scene);
+		for (const auto &[body, position]: bodies) {
+			EXPECT_EQ(layer.GetPhysicsSystem().GetBodyInterfaceNoLock().GetPosition(body), position);
+		}
+		scene.Query<Physicalisable>().Each([&](const EntityID id, Physicalisable &comp) {
+			const JPH::RVec3 position = layer.GetPhysicsSystem().GetBodyInterfaceNoLock().GetPosition(comp.BodyID);
+			EXPECT_EQ(std::as_const(scene).GetEntity(id).LocalPosition, Convert(position));
+		});
+	}
+	layer.OnDetach();
+
+	JobSystem::Shutdown();
+	Log::Shutdown();
+}
+
+TEST(PhysicsSnapshot, ReplayTheRecording) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	JPH::RegisterDefaultAllocator();
+	JobSystem::Initialize(3);
+	SceneManager::Intialize();
+
+	PhysicsLayer layer;
+	layer.OnAttach();
+	{
+		const Scene::Ref scene = SceneManager::CreateScene();
+		FillScene(*scene, layer);
+		const std::vector<Scene::Ref> scenes = SceneManager::GetLoadedScenes();
+
+		layer.StartRecording(scenes);
+		ASSERT_TRUE(layer.IsRecording());
+		for (uint32_t i = 0; i < 120; ++i) {
+			// An uneven frame time, some impulses and a deletion, all of them to be replayed.
+			if (i % 20 == 0) scene->GetComponent<Physicalisable>(EntityID{2 + i / 20})->SetLinearVelocity(Vec3(0, 5, 0));
+			if (i == 60) scene->RemoveComponent<Physicalisable>(EntityID{10});
+			AppUpdateEvent update{TimeStep{i % 3 == 0 ? 1.0 / 30.0 : 1.0 / 144.0}};
+			layer.OnEvent(update);
+		}
+		const std::optional<PhysicsRecording> recording = layer.StopRecording();
+		ASSERT_TRUE(recording.has_value());
+		ASSERT_EQ(recording->frames.size(), 120);
+		EXPECT_EQ(recording->impulses.size(), 6);
+		EXPECT_EQ(recording->deletions.size(), 1);
+
+		// Through a file, as the headless replay does.
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "ImagineTestPhysicsRecording.bin";
+		ASSERT_TRUE(recording->Write(path));
+		const std::optional<PhysicsRecording> read = PhysicsRecording::Read(path);
+		std::filesystem::remove(path);
+		ASSERT_TRUE(read.has_value());
+		EXPECT_EQ(read->snapshot, recording->snapshot);
+		EXPECT_EQ(read->finalHash, recording->finalHash);
+
+		const PhysicsReplayStats stats = layer.Replay(read.value());
+		EXPECT_EQ(stats.frames, 120);
+		EXPECT_GT(stats.steps, 0);
+		EXPECT_TRUE(stats.identical);
+
+		// The replay is the same each time.
+		EXPECT_TRUE(layer.Replay(read.value()).identical);
+
+		SceneManager::UnloadScene(scene);
+	}
+	PhysicsLayer::SetSimulating(false);
+	layer.OnDetach();
+
+	SceneManager::Shutdown();
+	JobSystem::Shutdown();
+	Log::Shutdown();
+}
@@ -0,0 +1,188 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Rendering/Camera.hpp"
+#include "Imagine/Rendering/Renderer.hpp"
+
+#if defined(MGN_RENDERER_CPU)
+
+namespace {
+	constexpr uint32_t c_Size = 64;
+	const glm::fvec4 c_Red{1, 0, 0, 1};
+	const glm::fvec4 c_Green{0, 1, 0, 1};
+
+	/// A square facing the camera, its half size being 'fraction' of the half height of the view at 'depth'.
+	/// The normals face the sun of the renderer, so the surface keeps its vertex color.
+	CPUMesh Square(const float fraction, const float depth, const glm::fvec4 &color) {
+		const float half = depth * std::tan(glm::radians(35.0f)) * fraction;
+		std::vector<Vertex> vertices{
+				Vertex::PC({-half, -half, -depth}, color),
+				Vertex::PC({half, -half, -depth}, color),
+				Vertex::PC({half, half, -depth}, color),
+				Vertex::PC({-half, half, -depth}, color),
+		};
+		return CPUMesh{std::move(vertices), {0, 1, 2, 0, 2, 3}};
+	}
+
+	Image<uint8_t> Render(Renderer &renderer, const std::vector<Ref<GPUMesh>> &meshes) {
+		Image<uint8_t> image;
+		if (!renderer.BeginDraw({}, {})) return image;
+		DrawContext ctx;
+		for (const Ref<GPUMesh> &mesh: meshes) {
+			ctx.OpaqueSurfaces.emplace_back(Math::Identity<Mat4>(), mesh.get());
+		}
+		renderer.Draw(ctx);
+		renderer.EndDraw();
+		EXPECT_TRUE(renderer.ReadColor(image));
+		return image;
+	}
+
+	bool IsColor(const Image<uint8_t> &image, const uint32_t x, const uint32_t y, const glm::fvec4 &color) {
+		for (uint32_t c = 0; c < 4; ++c) {
+			if (image(x, y, c) != static_cast<uint8_t>(color[c] * 255.0f)) return false;
+		}
+		return true;
+	}
+
+	uint32_t CountColor(const Image<uint8_t> &image, const glm::fvec4 &color) {
+		uint32_t count = 0;
+		for (uint32_t y = 0; y < image.height; ++y) {
+			for (uint32_t x = 0; x < image.width; ++x) {
+				count += IsColor(image, x, y, color);
+			}
+		}
+		return count;
+	}
+
+	/// A headless CPU renderer of 'c_Size' by 'c_Size' pixels, looking down -Z from the origin.
+	Scope<Renderer> CreateRenderer() {
+		ApplicationParameters params{};
+		params.Renderer = RendererParameters{};
+		params.Renderer->Width = c_Size;
+		params.Renderer->Height = c_Size;
+		return Scope<Renderer>{Renderer::Create(params)};
+	}
+} // namespace
+
+TEST(Rasterizer, Coverage) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	JobSystem::Initialize(3);
+	Camera *previousCamera = Camera::s_MainCamera;
+	Camera::s_MainCamera = nullptr;
+	{
+		const Scope<Renderer> renderer = CreateRenderer();
+		ASSERT_TRUE(renderer);
+
+		// Half of the view, the edges fall between the pixels 15 and 16, and 47 and 48.
+		const Ref<GPUMesh> square = renderer->LoadMesh(Square(0.5f, 2, c_Red));
+		const Image<uint8_t> image = Render(*renderer, {square});
+		ASSERT_EQ(image.width, c_Size);
+		ASSERT_EQ(image.height, c_Size);
+		ASSERT_EQ(image.channels, 4);
+
+		EXPECT_EQ(CountColor(image, c_Red), 32 * 32);
+		EXPECT_TRUE(IsColor(image, 16, 16, c_Red));
+		EXPECT_TRUE(IsColor(image, 47, 47, c_Red));
+		EXPECT_FALSE(IsColor(image, 15, 32, c_Red));
+		EXPECT_FALSE(IsColor(image, 48, 32, c_Red));
+		EXPECT_FALSE(IsColor(image, 32, 15, c_Red));
+		EXPECT_FALSE(IsColor(image, 32, 48, c_Red));
+
+		// The diagonal shared by the two triangles goes through the centers of the pixels, one of them owns each pixel.
+		for (uint32_t i = 16; i < 48; ++i) {
+			EXPECT_TRUE(IsColor(image, i, c_Size - 1 - i, c_Red));
+		}
+	}
+	Camera::s_MainCamera = previousCamera;
+	JobSystem::Shutdown();
+	Log::Shutdown();
+}
+
+TEST(Rasterizer, DepthTest) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	JobSystem::Initialize(3);
+	Camera *previousCamera = Camera::s_MainCamera;
+	Camera::s_MainCamera = nullptr;
+	{
+		const Scope<Renderer> renderer = CreateRenderer();
+		ASSERT_TRUE(renderer);
+
+		// A small red square in front of a larger green one.
+		const Ref<GPUMesh> nearSquare = renderer->LoadMesh(Square(0.5f, 2, c_Red));
+		const Ref<GPUMesh> farSquare = renderer->LoadMesh(Square(0.75f, 4, c_Green));
+
+		// The nearest surface is kept whatever the order of the draws.
+		for (const std::vector<Ref<GPUMesh>> &order: {std::vector{nearSquare, farSquare}, std::vector{farSquare, nearSquare}}) {
+			const Image<uint8_t> image = Render(*renderer, order);
+			EXPECT_EQ(CountColor(image, c_Red), 32 * 32);
+			EXPECT_EQ(CountColor(image, c_Green), 48 * 48 - 32 * 32);
+			EXPECT_TRUE(IsColor(image, 32, 32, c_Red));
+			EXPECT_TRUE(IsColor(image, 10, 32, c_Green));
+		}
+
+		// At the same depth, the surface drawn first is kept.
+		const Ref<GPUMesh> sameDepth = renderer->LoadMesh(Square(0.5f, 2, c_Green));
+		EXPECT_EQ(CountColor(Render(*renderer, {nearSquare, sameDepth}), c_Red), 32 * 32);
+		EXPECT_EQ(CountColor(Render(*renderer, {sameDepth, nearSquare}), c_Green), 32 * 32);
+	}
+	Camera::s_MainCamera = previousCamera;
+	JobSystem::Shutdown();
+	Log::Shutdown();
+}
+
+TEST(Rasterizer, SameImageWhateverTheThreadCount) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	Camera *previousCamera = Camera::s_MainCamera;
+	Camera::s_MainCamera = nullptr;
+	{
+		const Scope<Renderer> renderer = CreateRenderer();
+		ASSERT_TRUE(renderer);
+
+		// Many overlapping triangles spread over the tiles, some of them at the same depth.
+		std::vector<Vertex> vertices;
+		std::vector<uint32_t> indices;
+		uint32_t seed = 12345;
+		const auto random = [&seed]() {
+			seed = seed * 1664525u + 1013904223u;
+			return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+		};
+		for (uint32_t i = 0; i < 512; ++i) {
+			const float depth = 2.0f + static_cast<float>(i % 8);
+			const glm::fvec4 color{random(), random(), random(), 1};
+			for (uint32_t v = 0; v < 3; ++v) {
+				indices.push_back(static_cast<uint32_t>(vertices.size()));
+				vertices.push_back(Vertex::PC({(random() * 2 - 1) * depth, (random() * 2 - 1) * depth, -depth}, color));
+			}
+		}
+		const Ref<GPUMesh> mesh = renderer->LoadMesh(CPUMesh{std::move(vertices), std::move(indices)});
+
+		JobSystem::Initialize(0);
+		const Image<uint8_t> reference = Render(*renderer, {mesh});
+		JobSystem::Shutdown();
+		ASSERT_EQ(reference.width, c_Size);
+
+		for (const uint32_t workers: {1u, 3u, 7u}) {
+			JobSystem::Initialize(workers);
+			const Image<uint8_t> image = Render(*renderer, {mesh});
+			JobSystem::Shutdown();
+
+			ASSERT_EQ(image.width, reference.width);
+			ASSERT_EQ(image.height, reference.height);
+			uint32_t different = 0;
+			for (uint32_t y = 0; y < c_Size; ++y) {
+				for (uint32_t x = 0; x < c_Size; ++x) {
+					for (uint32_t c = 0; c < 4; ++c) {
+						different += image(x, y, c) != reference(x, y, c);
+					}
+				}
+			}
+			EXPECT_EQ(different, 0) << "with " << workers << " workers";
+		}
+	}
+	Camera::s_MainCamera = previousCamera;
+	Log::Shutdown();
+}
+
+#endif
@@ -3,6 +3,7 @@
 //
 
 #include "GlobalUsefullTests.hpp"
+#include "Imagine/Components/Physicalisable.hpp"
 
 struct Physcs {
 	Physcs() = default;
@@ -153,3 +154,442 @@ TEST(CoreScene, Persistence) {
 
 	Log::Shutdown();
 }
+
+TEST(CoreScene, ArchetypeStorage) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	{
+		Scene scene{Scene::ComponentStorage::Archetype};
+		ASSERT_EQ(scene.GetComponentStorage(), Scene::ComponentStorage::Archetype);
+
+		scene.RegisterType<PhyscsCounter>();
+		scene.RegisterType<RenderCounter>();
+		scene.Prepare(50);
+
+		EntityID ids[50];
+		for (int i = 0; i < 50; ++i) {
+			ids[i] = scene.CreateEntity();
+			scene.AddComponent<PhyscsCounter>(ids[i]);
+			scene.GetComponent<PhyscsCounter>(ids[i])->vel = Vec3(static_cast<Real>(i));
+			if (i % 2 == 0) {
+				EXPECT_TRUE(scene.AddComponent<RenderCounter>(ids[i]));
+			}
+		}
+		ASSERT_EQ(PhyscsCounter::s_InstanceCount, 50);
+		ASSERT_EQ(RenderCounter::s_InstanceCount, 25);
+		ASSERT_EQ(scene.CountComponents<PhyscsCounter>(), 50);
+		ASSERT_EQ(scene.CountComponents<RenderCounter>(), 25);
+		EXPECT_FALSE(scene.AddComponent<PhyscsCounter>(ids[0]));
+
+		// Adding a component moves the entity to another archetype, the data must follow.
+		for (int i = 0; i < 50; ++i) {
+			const PhyscsCounter *comp = scene.GetComponent<PhyscsCounter>(ids[i]);
+			ASSERT_TRUE(comp != nullptr);
+			ASSERT_EQ(Vec3{static_cast<Real>(i)}, comp->vel);
+			ASSERT_EQ(scene.HasComponent<RenderCounter>(ids[i]), i % 2 == 0);
+		}
+
+		uint32_t visited = 0;
+		scene.ForEachWithComponent<PhyscsCounter>([&visited](Scene *, EntityID, PhyscsCounter &) { ++visited; });
+		ASSERT_EQ(visited, 50);
+
+		visited = 0;
+		scene.ForEachWithComponent(UUIDFromType<RenderCounter>(), [&visited](Scene *, EntityID, BufferView view) {
+			EXPECT_EQ(view.Size(), sizeof(RenderCounter));
+			++visited;
+		});
+		ASSERT_EQ(visited, 25);
+
+		for (int i = 0; i < 10; ++i) {
+			scene.RemoveComponent<RenderCounter>(ids[i]);
+		}
+		ASSERT_EQ(RenderCounter::s_InstanceCount, 20);
+		ASSERT_EQ(PhyscsCounter::s_InstanceCount, 50);
+
+		scene.DestroyEntity(ids[49]);
+		ASSERT_EQ(PhyscsCounter::s_InstanceCount, 49);
+
+		{
+			Scene copy{scene};
+			ASSERT_EQ(PhyscsCounter::s_InstanceCount, 98);
+			ASSERT_EQ(Vec3{static_cast<Real>(12)}, copy.GetComponent<PhyscsCounter>(ids[12])->vel);
+		}
+		ASSERT_EQ(PhyscsCounter::s_InstanceCount, 49);
+	}
+
+	ASSERT_EQ(PhyscsCounter::s_InstanceCount, 0);
+	ASSERT_EQ(RenderCounter::s_InstanceCount, 0);
+
+	Log::Shutdown();
+}
+
+static void TestSceneQuery(const Scene::ComponentStorage storage) {
+	Scene scene{storage};
+	scene.RegisterType<Physcs>();
+	scene.RegisterType<Render>();
+
+	EntityID ids[60];
+	for (int i = 0; i < 60; ++i) {
+		ids[i] = scene.CreateEntity();
+		scene.AddComponent<Physcs>(ids[i], Vec3(static_cast<Real>(i)));
+		if (i % 3 == 0) scene.AddComponent<Render>(ids[i]);
+	}
+
+	uint32_t visited = 0;
+	for (auto [id, physics, render]: scene.Query<Physcs, Render>()) {
+		ASSERT_TRUE(scene.HasComponent<Render>(id));
+		ASSERT_EQ(physics.vel, scene.GetComponent<Physcs>(id)->vel);
+		physics.vel += Vec3(1);
+		++visited;
+	}
+	ASSERT_EQ(visited, 20);
+
+	visited = 0;
+	scene.Query<Render, Physcs>().Each([&scene, &visited](const EntityID id, Render &render, Physcs &physics) {
+		EXPECT_EQ(physics.vel, scene.GetComponent<Physcs>(id)->vel);
+		++visited;
+	});
+	ASSERT_EQ(visited, 20);
+
+	const Scene &constScene = scene;
+	visited = 0;
+	constScene.Query<Physcs>().Each([&visited](const EntityID id, const Physcs &physics) { ++visited; });
+	ASSERT_EQ(visited, 60);
+
+	auto view = scene.Query<Physcs, Render>();
+	ASSERT_TRUE(view.Contains(ids[3]));
+	ASSERT_FALSE(view.Contains(ids[4]));
+	ASSERT_EQ(scene.GetComponent<Physcs>(ids[3])->vel, Vec3(4));
+	ASSERT_EQ(scene.GetComponent<Physcs>(ids[4])->vel, Vec3(4));
+}
+
+TEST(CoreScene, Query) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	TestSceneQuery(Scene::ComponentStorage::SparseSet);
+	TestSceneQuery(Scene::ComponentStorage::Archetype);
+
+	Log::Shutdown();
+}
+
+TEST(CoreScene, ParallelForEachWithComponent) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	JobSystem::Initialize(3);
+
+	for (const Scene::ComponentStorage storage: {Scene::ComponentStorage::SparseSet, Scene::ComponentStorage::Archetype}) {
+		Scene scene{storage};
+		scene.RegisterType<Physcs>();
+		scene.Prepare(5000);
+		for (int i = 0; i < 5000; ++i) {
+			const EntityID id = scene.CreateEntity();
+			scene.AddComponent<Physcs>(id, Vec3(static_cast<Real>(i)));
+		}
+
+		std::atomic<uint32_t> visited{0};
+		scene.ParallelForEachWithComponent<Physcs>([&visited](const EntityID id, Physcs &physics) {
+			physics.vel.x += 1;
+			visited.fetch_add(1, std::memory_order_relaxed);
+		}, 64);
+		ASSERT_EQ(visited.load(), 5000);
+
+		const Scene &constScene = scene;
+		std::atomic<uint32_t> matching{0};
+		constScene.ParallelForEachWithComponent<Physcs>([&matching](const EntityID id, const Physcs &physics) {
+			if (physics.vel.x == physics.vel.y + 1) matching.fetch_add(1, std::memory_order_relaxed);
+		});
+		ASSERT_EQ(matching.load(), 5000);
+	}
+
+	JobSystem::Shutdown();
+	Log::Shutdown();
+}
+
+static Vec3 GetWorldPosition(const Scene &scene, const EntityID id) {
+	return Vec3(scene.GetWorldTransform(id)[3]);
+}
+
+TEST(CoreScene, TransformCache) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	Scene scene;
+	const EntityID root = scene.CreateEntity();
+	const EntityID child = scene.CreateEntity(root);
+	const EntityID grandChild = scene.CreateEntity(child);
+	const EntityID other = scene.CreateEntity();
+	scene.SetLocalPosition(root, {1, 0, 0});
+	scene.SetLocalPosition(child, {0, 2, 0});
+	scene.SetLocalPosition(grandChild, {0, 0, 3});
+	Entity &otherEntity = scene.GetEntity(other);
+	otherEntity.LocalPosition = {4, 0, 0};
+
+	scene.CacheTransforms();
+	ASSERT_FALSE(scene.IsTransformDirty(root));
+	ASSERT_EQ(GetWorldPosition(scene, grandChild), Vec3(1, 2, 3));
+	ASSERT_EQ(GetWorldPosition(scene, other), Vec3(4, 0, 0));
+
+	// Moving the root must recompute the whole subtree.
+	scene.SetLocalPosition(root, {5, 0, 0});
+	ASSERT_TRUE(scene.IsTransformDirty(root));
+	ASSERT_FALSE(scene.IsTransformDirty(grandChild));
+	scene.CacheTransforms();
+	ASSERT_EQ(GetWorldPosition(scene, child), Vec3(5, 2, 0));
+	ASSERT_EQ(GetWorldPosition(scene, grandChild), Vec3(5, 2, 3));
+
+	// A write through the mutable access isn't flagged, the entity keeps its cached transform.
+	otherEntity.LocalPosition = {6, 0, 0};
+	scene.CacheTransforms();
+	ASSERT_EQ(GetWorldPosition(scene, other), Vec3(4, 0, 0));
+	scene.MarkTransformDirty(other);
+	scene.CacheTransforms();
+	ASSERT_EQ(GetWorldPosition(scene, other), Vec3(6, 0, 0));
+
+	// The setters flag the entity, the const access doesn't.
+	ASSERT_EQ(std::as_const(scene).GetEntity(other).LocalPosition, Vec3(6, 0, 0));
+	ASSERT_FALSE(scene.IsTransformDirty(other));
+	scene.SetLocalPosition(other, {7, 0, 0});
+	ASSERT_TRUE(scene.IsTransformDirty(other));
+	scene.CacheTransforms();
+	ASSERT_EQ(GetWorldPosition(scene, other), Vec3(7, 0, 0));
+	scene.SetLocalScale(other, Vec3(2));
+	scene.SetLocalRotation(other, Quat(Vec3(0, glm::radians(Real(90)), 0)));
+	ASSERT_TRUE(scene.IsTransformDirty(other));
+	scene.CacheTransforms();
+	ASSERT_EQ(std::as_const(scene).GetEntity(other).LocalScale, Vec3(2));
+	ASSERT_NEAR(scene.GetWorldTransform(other)[0][0], 0, 1e-5);
+	ASSERT_NEAR(scene.GetWorldTransform(other)[0][2], -2, 1e-5);
+	scene.SetLocalPosition(other, {6, 0, 0});
+	scene.SetLocalScale(other, Vec3(1));
+	scene.SetLocalRotation(other, Math::Identity<Quat>());
+	scene.CacheTransforms();
+
+	// Changing the hierarchy.
+	scene.MoveToRoot(grandChild);
+	scene.CacheTransforms();
+	ASSERT_EQ(GetWorldPosition(scene, grandChild), Vec3(0, 0, 3));
+	scene.AddToChild(other, child);
+	scene.CacheTransforms();
+	ASSERT_EQ(GetWorldPosition(scene, child), Vec3(6, 2, 0));
+
+	scene.DestroyEntity(other);
+	scene.CacheTransforms();
+	ASSERT_EQ(scene.GetWorldTransform(child), Mat4(0));
+	ASSERT_EQ(GetWorldPosition(scene, root), Vec3(5, 0, 0));
+
+	Log::Shutdown();
+}
+
+TEST(CoreScene, WriteRootTransform) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	Scene scene;
+	const EntityID root = scene.CreateEntity();
+	const EntityID parent = scene.CreateEntity();
+	const EntityID child = scene.CreateEntity(parent);
+	scene.CacheTransforms();
+
+	// A root without children gets its world transform right away.
+	ASSERT_TRUE(scene.WriteRootTransform(root, {1, 2, 3}, Math::Identity<Quat>()));
+	ASSERT_FALSE(scene.IsTransformDirty(root));
+	ASSERT_EQ(GetWorldPosition(scene, root), Vec3(1, 2, 3));
+
+	// The others are left to the next cache update.
+	ASSERT_FALSE(scene.WriteRootTransform(parent, {4, 0, 0}, Math::Identity<Quat>()));
+	ASSERT_FALSE(scene.WriteRootTransform(child, {0, 5, 0}, Math::Identity<Quat>()));
+	scene.MarkTransformDirty(parent);
+	scene.CacheTransforms();
+	ASSERT_EQ(GetWorldPosition(scene, child), Vec3(4, 5, 0));
+
+	// Not cached yet.
+	const EntityID created = scene.CreateEntity();
+	ASSERT_FALSE(scene.WriteRootTransform(created, {6, 0, 0}, Math::Identity<Quat>()));
+	scene.CacheTransforms();
+	ASSERT_EQ(GetWorldPosition(scene, created), Vec3(6, 0, 0));
+
+	Log::Shutdown();
+}
+
+TEST(CoreScene, TransformCacheParallel) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	JobSystem::Initialize(3);
+
+	constexpr uint32_t rootCount = 2000;
+	constexpr uint32_t depth = 4;
+	Scene scene;
+	scene.Prepare(rootCount * depth);
+	std::vector<EntityID> roots;
+	std::vector<EntityID> leaves;
+	for (uint32_t i = 0; i < rootCount; ++i) {
+		EntityID parent = EntityID::NullID;
+		for (uint32_t d = 0; d < depth; ++d) {
+			parent = scene.CreateEntity(parent);
+			scene.SetLocalPosition(parent, {static_cast<Real>(i), 1, 0});
+			if (d == 0) roots.push_back(parent);
+		}
+		leaves.push_back(parent);
+	}
+
+	scene.CacheTransforms();
+	for (uint32_t i = 0; i < rootCount; ++i) {
+		ASSERT_EQ(GetWorldPosition(scene, leaves[i]), Vec3(static_cast<Real>(i * depth), depth, 0));
+	}
+
+	for (uint32_t i = 0; i < rootCount; i += 2) {
+		scene.SetLocalPosition(roots[i], {static_cast<Real>(i), 1, 1});
+	}
+	scene.CacheTransforms();
+	for (uint32_t i = 0; i < rootCount; ++i) {
+		ASSERT_EQ(GetWorldPosition(scene, leaves[i]).z, i % 2 == 0 ? 1 : 0);
+	}
+
+	JobSystem::Shutdown();
+	Log::Shutdown();
+}
+
+TEST(CoreScene, BinarySerialization) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "imagine_test_scene.mgnb";
+	{
+		Scene scene;
+		scene.RegisterType<Physcs>();
+		std::vector<EntityID> ids;
+		for (int i = 0; i < 100; ++i) {
+			const EntityID id = scene.CreateEntity(i % 10 == 0 ? EntityID{EntityID::NullID} : ids[i - i % 10]);
+			scene.SetName(id, "Entity_" + std::to_string(i));
+			scene.SetLocalPosition(id, Vec3(1, static_cast<Real>(i), 0));
+			if (i % 3 == 0) scene.AddComponent<Physcs>(id, Vec3(static_cast<Real>(i)));
+			ids.push_back(id);
+		}
+		scene.DestroyEntity(ids[55]);
+		ASSERT_TRUE(SceneSerializer::SerializeBinary(&scene, path));
+	}
+
+	{
+		BinarySceneFile file{path};
+		ASSERT_TRUE(file.IsValid());
+		ASSERT_EQ(file.GetHeader().entities.count, 99);
+		const BinarySceneComponent *component = file.FindComponent(UUIDFromType<Physcs>());
+		ASSERT_NE(component, nullptr);
+		ASSERT_EQ(component->ids.count, 33);
+		ASSERT_EQ(file.GetComponentData(*component).Count<Physcs>(), 33);
+	}
+
+	Scene *loaded = SceneSerializer::DeserializeBinary(path);
+	ASSERT_NE(loaded, nullptr);
+	loaded->CacheTransforms();
+	for (uint32_t i = 0; i < 100; ++i) {
+		const EntityID id{i};
+		if (i == 55) {
+			ASSERT_FALSE(loaded->Exist(id));
+			continue;
+		}
+		ASSERT_TRUE(loaded->Exist(id));
+		ASSERT_EQ(loaded->GetName(id), "Entity_" + std::to_string(i));
+		const Vec3 expected = i % 10 == 0 ? Vec3(1, static_cast<Real>(i), 0) : Vec3(2, static_cast<Real>(i + i - i % 10), 0);
+		ASSERT_EQ(Vec3(loaded->GetWorldTransform(id)[3]), expected);
+		ASSERT_EQ(loaded->HasComponent<Physcs>(id), i % 3 == 0);
+		if (i % 3 == 0) {
+			ASSERT_EQ(loaded->GetComponent<Physcs>(id)->vel, Vec3(static_cast<Real>(i)));
+		}
+	}
+
+	// The freed id must be reused before any new one.
+	ASSERT_EQ(loaded->CreateEntity().id, 55);
+	ASSERT_EQ(loaded->CreateEntity().id, 100);
+
+	delete loaded;
+	std::filesystem::remove(path);
+	Log::Shutdown();
+}
+
+TEST(CoreScene, BinarySerializationCorrupted) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "imagine_test_scene_corrupted.mgnb";
+	{
+		Scene scene;
+		scene.RegisterType<Physcs>();
+		std::vector<EntityID> ids;
+		for (int i = 0; i < 20; ++i) {
+			const EntityID id = scene.CreateEntity(i % 5 == 0 ? EntityID{EntityID::NullID} : ids[i - i % 5]);
+			if (i % 2 == 0) scene.AddComponent<Physcs>(id, Vec3(static_cast<Real>(i)));
+			ids.push_back(id);
+		}
+		// A physics component written with a body, as while simulating.
+		Physicalisable *physicalisable = scene.AddComponent<Physicalisable>(ids[3]);
+		physicalisable->BodyID = JPH::BodyID{42};
+		physicalisable->dirty = false;
+		ASSERT_TRUE(SceneSerializer::SerializeBinary(&scene, path));
+		physicalisable->BodyID = JPH::BodyID{};
+	}
+	const std::vector<uint8_t> valid = FileSystem::ReadBinaryFileInVector(path);
+	BinarySceneHeader header;
+	memcpy(&header, valid.data(), sizeof(header));
+
+	{
+		// The loaded component waits for a new body.
+		Scene *loaded = SceneSerializer::DeserializeBinary(path);
+		ASSERT_NE(loaded, nullptr);
+		const Physicalisable *physicalisable = loaded->GetComponent<Physicalisable>(EntityID{3});
+		ASSERT_NE(physicalisable, nullptr);
+		EXPECT_TRUE(physicalisable->BodyID.IsInvalid());
+		EXPECT_TRUE(physicalisable->dirty);
+		delete loaded;
+	}
+
+	const auto at = [](std::vector<uint8_t> &bytes, const BinarySceneArray &array, const uint32_t index) {
+		return reinterpret_cast<uint32_t *>(bytes.data() + array.offset + static_cast<uint64_t>(index) * array.stride);
+	};
+	const auto isRejected = [&](const std::function<void(std::vector<uint8_t> &)> &corrupt) {
+		std::vector<uint8_t> bytes = valid;
+		corrupt(bytes);
+		FileSystem::WriteBinaryFile(path, ConstBufferView{bytes.data(), bytes.size()});
+		Scene *loaded = SceneSerializer::DeserializeBinary(path);
+		delete loaded;
+		return loaded == nullptr;
+	};
+
+	// An entity id far above the others would allocate gigabytes of sparse array.
+	EXPECT_TRUE(isRejected([&](std::vector<uint8_t> &bytes) { *at(bytes, header.entityIds, 0) = 0xFFFFFFFE; }));
+	// An id listed twice.
+	EXPECT_TRUE(isRejected([&](std::vector<uint8_t> &bytes) { *at(bytes, header.entityIds, 1) = *at(bytes, header.entityIds, 0); }));
+	// Ids that aren't entities.
+	EXPECT_TRUE(isRejected([&](std::vector<uint8_t> &bytes) { *at(bytes, header.parents, 0) = 1000; }));
+	EXPECT_TRUE(isRejected([&](std::vector<uint8_t> &bytes) { *at(bytes, header.childIds, 0) = 0xFFFFFFFE; }));
+	EXPECT_TRUE(isRejected([&](std::vector<uint8_t> &bytes) { at(bytes, header.siblings, 0)[1] = 1000; }));
+	EXPECT_TRUE(isRejected([&](std::vector<uint8_t> &bytes) {
+		BinarySceneComponent component;
+		memcpy(&component, bytes.data() + header.components.offset, sizeof(component));
+		*at(bytes, component.ids, 0) = 0xFFFFFFFE;
+	}));
+
+	// A list of siblings looping on itself would never end the hierarchy walk.
+	EXPECT_TRUE(isRejected([&](std::vector<uint8_t> &bytes) {
+		for (uint32_t i = 0; i < header.siblings.count; ++i) {
+			uint32_t *sibling = at(bytes, header.siblings, i);
+			if (sibling[1] == EntityID::NullID) {
+				sibling[1] = *at(bytes, header.siblingIds, i);
+				return;
+			}
+		}
+	}));
+	// A parent cycle: a root becomes the child of its own child.
+	EXPECT_TRUE(isRejected([&](std::vector<uint8_t> &bytes) {
+		const uint32_t root = *at(bytes, header.childIds, 0);
+		const uint32_t child = *at(bytes, header.children, 0);
+		for (uint32_t i = 0; i < header.roots.count; ++i) {
+			if (*at(bytes, header.roots, i) == root) *at(bytes, header.roots, i) = child;
+		}
+		for (uint32_t i = 0; i < header.parentIds.count; ++i) {
+			if (*at(bytes, header.parentIds, i) != child) continue;
+			*at(bytes, header.parentIds, i) = root;
+			*at(bytes, header.parents, i) = child;
+		}
+	}));
+
+	// Untouched, it still loads.
+	EXPECT_FALSE(isRejected([](std::vector<uint8_t> &) {}));
+
+	std::filesystem::remove(path);
+	Log::Shutdown();
+}
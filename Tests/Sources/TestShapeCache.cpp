@@ -0,0 +1,62 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Physics/ShapeCache.hpp"
+
+#include <Jolt/Core/Memory.h>
+
+TEST(ShapeCache, ShareTheShapes) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	JPH::RegisterDefaultAllocator();
+	ShapeCache::Clear();
+
+	Physicalisable a;
+	a.Shape = ColliderShapes::Box{Vec3(1, 2, 3)};
+	Physicalisable b = a;
+	Physicalisable c;
+	c.Shape = ColliderShapes::Box{Vec3(1, 2, 4)};
+	Physicalisable d;
+	d.Shape = ColliderShapes::Sphere{1};
+
+	const JPH::ShapeRefC shapeA = a.GetShape();
+	ASSERT_NE(shapeA, nullptr);
+	EXPECT_EQ(shapeA, b.GetShape());
+	EXPECT_NE(shapeA, c.GetShape());
+	EXPECT_NE(shapeA, d.GetShape());
+	EXPECT_EQ(shapeA->GetSubType(), JPH::EShapeSubType::Box);
+	EXPECT_EQ(d.GetShape()->GetSubType(), JPH::EShapeSubType::Sphere);
+
+	const ShapeCacheStats stats = ShapeCache::GetStats();
+	EXPECT_EQ(stats.shapes, 3);
+	EXPECT_GT(stats.bytes, 0);
+
+	ShapeCache::Clear();
+	Log::Shutdown();
+}
+
+TEST(ShapeCache, PurgeTheUnusedShapes) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+	JPH::RegisterDefaultAllocator();
+	ShapeCache::Clear();
+
+	JPH::ShapeRefC used = ShapeCache::GetShape(ColliderShapes::Capsule{2, 0.5});
+	ShapeCache::GetShape(ColliderShapes::Cylinder{2, 0.5});
+	EXPECT_EQ(ShapeCache::GetStats().shapes, 2);
+
+	// Only the cylinder is released, the capsule is still referenced.
+	EXPECT_EQ(ShapeCache::Purge(), 1);
+	EXPECT_EQ(ShapeCache::GetStats().shapes, 1);
+	EXPECT_EQ(ShapeCache::GetShape(ColliderShapes::Capsule{2, 0.5}), used);
+
+	// The meshes not loaded aren't cached, they could be later.
+	EXPECT_EQ(ShapeCache::GetShape(ColliderShapes::Mesh{}), nullptr);
+	EXPECT_EQ(ShapeCache::GetStats().shapes, 1);
+
+	used = nullptr;
+	EXPECT_EQ(ShapeCache::Purge(), 1);
+	EXPECT_EQ(ShapeCache::GetStats().shapes, 0);
+
+	Log::Shutdown();
+}
@@ -0,0 +1,68 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Rendering/StagingRing.hpp"
+
+TEST(StagingRing, AllocateAndRetire) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	StagingRing ring{1024};
+	EXPECT_EQ(ring.Allocate(100, 16), 0);
+	EXPECT_EQ(ring.Allocate(100, 16), 112);
+	EXPECT_EQ(ring.GetUsedSize(), 212);
+	EXPECT_TRUE(ring.HasOpenBatch());
+
+	EXPECT_TRUE(ring.Close(1));
+	EXPECT_FALSE(ring.Close(2));
+	EXPECT_FALSE(ring.HasOpenBatch());
+	EXPECT_EQ(ring.GetOldestValue(), 1);
+
+	EXPECT_EQ(ring.Allocate(800, 16), 224);
+	EXPECT_FALSE(ring.Allocate(100, 16).has_value());
+	EXPECT_TRUE(ring.Close(2));
+
+	// Nothing is freed until the GPU is done with the batch.
+	ring.Retire(0);
+	EXPECT_EQ(ring.GetUsedSize(), 1024);
+	ring.Retire(1);
+	EXPECT_EQ(ring.GetUsedSize(), 812);
+	EXPECT_EQ(ring.GetOldestValue(), 2);
+
+	ring.Retire(2);
+	EXPECT_EQ(ring.GetUsedSize(), 0);
+	EXPECT_FALSE(ring.GetOldestValue().has_value());
+	EXPECT_FALSE(ring.Allocate(2048).has_value());
+
+	Log::Shutdown();
+}
+
+TEST(StagingRing, Wrap) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	StagingRing ring{1000};
+	EXPECT_EQ(ring.Allocate(400, 1), 0);
+	ring.Close(1);
+	EXPECT_EQ(ring.Allocate(400, 1), 400);
+	ring.Close(2);
+	ring.Retire(1);
+
+	// The 200 bytes left at the end are too small, the allocation wraps to the freed beginning.
+	EXPECT_EQ(ring.Allocate(300, 1), 0);
+	EXPECT_EQ(ring.GetUsedSize(), 900);
+	EXPECT_FALSE(ring.Allocate(200, 1).has_value());
+	EXPECT_EQ(ring.Allocate(100, 1), 300);
+	EXPECT_FALSE(ring.Allocate(1, 1).has_value());
+	ring.Close(3);
+
+	ring.Retire(2);
+	EXPECT_EQ(ring.GetUsedSize(), 600);
+	EXPECT_FALSE(ring.Allocate(401, 1).has_value());
+	EXPECT_EQ(ring.Allocate(400, 1), 400);
+	ring.Close(4);
+	ring.Retire(4);
+	EXPECT_EQ(ring.GetUsedSize(), 0);
+
+	Log::Shutdown();
+}
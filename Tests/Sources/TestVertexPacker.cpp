@@ -0,0 +1,107 @@
+//
+// Created by ianpo on 18/10/2026.
+//
+
+#include "GlobalUsefullTests.hpp"
+#include "Imagine/Rendering/VertexPacker.hpp"
+
+namespace {
+	/// Vertices on a spiral with an orthonormal tangent frame, every third bitangent flipped.
+	std::vector<Vertex> MakeVertices(const uint32_t count, const bool white) {
+		std::vector<Vertex> vertices;
+		for (uint32_t i = 0; i < count; ++i) {
+			const float a = static_cast<float>(i) * 0.7f;
+			const float b = static_cast<float>(i) * 1.3f;
+			const glm::fvec3 normal = glm::normalize(glm::fvec3{std::sin(a) * std::cos(b), std::sin(a) * std::sin(b), std::cos(a)});
+			const glm::fvec3 tangent = glm::normalize(glm::cross(normal, std::abs(normal.y) < 0.9f ? glm::fvec3{0, 1, 0} : glm::fvec3{1, 0, 0}));
+
+			Vertex &vertex = vertices.emplace_back();
+			vertex.position = {std::sin(a) * 10.0f, std::cos(b) * 3.0f, static_cast<float>(i) * 0.25f - 4.0f};
+			vertex.normal = normal;
+			vertex.tangent = glm::fvec4{tangent, 0};
+			vertex.bitangent = glm::fvec4{glm::cross(normal, tangent) * (i % 3 == 0 ? -1.0f : 1.0f), 0};
+			vertex.uv_x = std::sin(b) * 2.0f;
+			vertex.uv_y = static_cast<float>(i) / static_cast<float>(count);
+			if (!white) vertex.color = {vertex.uv_y, 0.5f, 1.0f - vertex.uv_y, 1.0f};
+		}
+		return vertices;
+	}
+
+	void ExpectRoundTrip(const VertexLayout layout, const float positionError, const float minDot) {
+		// Not a multiple of the SIMD width, so the last group is partial.
+		const std::vector<Vertex> vertices = MakeVertices(37, false);
+		const PackedVertices packed = VertexPacker::Pack(vertices, layout);
+		ASSERT_EQ(packed.vertices.size(), vertices.size() * VertexPacker::GetVertexSize(layout));
+		ASSERT_EQ(packed.colors.size(), vertices.size());
+
+		const std::vector<Vertex> unpacked = VertexPacker::Unpack(packed);
+		ASSERT_EQ(unpacked.size(), vertices.size());
+		for (uint64_t i = 0; i < vertices.size(); ++i) {
+			const Vertex &expected = vertices[i];
+			const Vertex &vertex = unpacked[i];
+			EXPECT_NEAR(vertex.position.x, expected.position.x, positionError);
+			EXPECT_NEAR(vertex.position.y, expected.position.y, positionError);
+			EXPECT_NEAR(vertex.position.z, expected.position.z, positionError);
+			EXPECT_GT(glm::dot(vertex.normal, expected.normal), minDot);
+			EXPECT_GT(glm::dot(glm::fvec3(vertex.tangent), glm::fvec3(expected.tangent)), minDot);
+			EXPECT_GT(glm::dot(glm::fvec3(vertex.bitangent), glm::fvec3(expected.bitangent)), minDot);
+			EXPECT_NEAR(vertex.uv_x, expected.uv_x, 1e-3f);
+			EXPECT_NEAR(vertex.uv_y, expected.uv_y, 1e-3f);
+			EXPECT_NEAR(vertex.color.r, expected.color.r, 0.5f / 255.0f + 1e-5f);
+			EXPECT_NEAR(vertex.color.b, expected.color.b, 0.5f / 255.0f + 1e-5f);
+		}
+	}
+} // namespace
+
+TEST(VertexPacker, Compact) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	ExpectRoundTrip(VertexLayout::Compact, 0.0f, 0.9999f);
+
+	Log::Shutdown();
+}
+
+TEST(VertexPacker, Quantized) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	// The positions span 20 units, a step of the unorm16 is about 0.0003.
+	ExpectRoundTrip(VertexLayout::Quantized, 2e-4f, 0.999f);
+
+	Log::Shutdown();
+}
+
+TEST(VertexPacker, WhiteMeshesHaveNoColors) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	const std::vector<Vertex> vertices = MakeVertices(10, true);
+	for (const VertexLayout layout: {VertexLayout::Compact, VertexLayout::Quantized}) {
+		const PackedVertices packed = VertexPacker::Pack(vertices, layout);
+		EXPECT_TRUE(packed.colors.empty());
+		EXPECT_EQ(packed.GetSize(), vertices.size() * VertexPacker::GetVertexSize(layout));
+		for (const Vertex &vertex: VertexPacker::Unpack(packed)) {
+			EXPECT_EQ(vertex.color, glm::fvec4(1, 1, 1, 1));
+		}
+	}
+
+	const PackedVertices full = VertexPacker::Pack(vertices, VertexLayout::Full);
+	ASSERT_EQ(full.vertices.size(), vertices.size() * sizeof(Vertex));
+	EXPECT_EQ(std::memcmp(full.vertices.data(), vertices.data(), full.vertices.size()), 0);
+
+	Log::Shutdown();
+}
+
+TEST(VertexPacker, LanesAreIndependent) {
+	Log::Init({std::nullopt, c_DefaultLogPattern, true});
+
+	// A vertex is packed the same whatever its place in its SIMD group.
+	const std::vector<Vertex> vertices = MakeVertices(11, false);
+	const PackedVertices packed = VertexPacker::Pack(vertices, VertexLayout::Compact);
+	for (uint64_t i = 0; i < vertices.size(); ++i) {
+		const PackedVertices single = VertexPacker::Pack(std::span<const Vertex>{&vertices[i], 1}, VertexLayout::Compact);
+		ASSERT_EQ(single.vertices.size(), sizeof(CompactVertex));
+		EXPECT_EQ(std::memcmp(single.vertices.data(), packed.vertices.data() + i * sizeof(CompactVertex), sizeof(CompactVertex)), 0);
+		EXPECT_EQ(single.colors.front(), packed.colors[i]);
+	}
+
+	Log::Shutdown();
+}